@@ -12,7 +12,7 @@ public class CustomPlugin extends Plugin {
   }
 
   @Override
-  public void onHangup(String reason) {
+  public void onHangup(String reason, Bundle context) {
 
   }
 
@@ -6,6 +6,8 @@ import com.github.helloiampau.janus.generated.Platform;
 import com.github.helloiampau.janus.generated.Protocol;
 import com.github.helloiampau.janus.generated.ProtocolDelegate;
 
+import java.util.ArrayList;
+
 public class CustomProtocol extends Protocol {
 
   @Override
@@ -23,6 +25,11 @@ public class CustomProtocol extends Protocol {
 
   }
 
+  @Override
+  public void dispatchBatch(ArrayList<Bundle> payloads) {
+
+  }
+
   @Override
   public void hangup() {
 
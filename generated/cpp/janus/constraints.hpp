@@ -5,6 +5,7 @@
 
 #include "sdp_constraints.hpp"
 #include "video_constraints.hpp"
+#include <cstdint>
 #include <utility>
 
 namespace Janus {
@@ -12,11 +13,14 @@ namespace Janus {
 struct Constraints final {
     SdpConstraints sdp;
     VideoConstraints video;
+    int32_t ice_candidate_pool_size;
 
     Constraints(SdpConstraints sdp_,
-                VideoConstraints video_)
+                VideoConstraints video_,
+                int32_t ice_candidate_pool_size_)
     : sdp(std::move(sdp_))
     , video(std::move(video_))
+    , ice_candidate_pool_size(std::move(ice_candidate_pool_size_))
     {}
 };
 
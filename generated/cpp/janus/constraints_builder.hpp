@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 
 namespace Janus {
 
@@ -29,6 +30,10 @@ public:
 
     virtual std::shared_ptr<ConstraintsBuilder> video(int32_t width, int32_t height, int32_t fps) = 0;
 
+    virtual std::shared_ptr<ConstraintsBuilder> encoding(const std::string & rid, double scale_down, int32_t max_bitrate, int32_t max_fps) = 0;
+
+    virtual std::shared_ptr<ConstraintsBuilder> ice_candidate_pool(int32_t size) = 0;
+
     virtual std::shared_ptr<ConstraintsBuilder> send_only() = 0;
 
     virtual std::shared_ptr<ConstraintsBuilder> receive_only() = 0;
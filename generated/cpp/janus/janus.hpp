@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Janus {
 
@@ -25,6 +26,8 @@ public:
 
     virtual void dispatch(const std::string & command, const std::shared_ptr<Bundle> & payload) = 0;
 
+    virtual void dispatchBatch(const std::vector<std::shared_ptr<Bundle>> & payloads) = 0;
+
     static std::shared_ptr<Janus> create(const std::shared_ptr<JanusConf> & conf, const std::shared_ptr<Platform> & platform, const std::shared_ptr<ProtocolDelegate> & delegate);
 };
 
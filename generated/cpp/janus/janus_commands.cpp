@@ -29,6 +29,28 @@ std::string const JanusCommands::STOP = {"uSYwffonCO"};
 
 std::string const JanusCommands::JOIN = {"YleGo5pJm9"};
 
+std::string const JanusCommands::PARTICIPANTS = {"fFS7B38sc3"};
+
+std::string const JanusCommands::VIEWPORT = {"2U2fhimrgT"};
+
+std::string const JanusCommands::SPEAKERS = {"j5grvop2Gj"};
+
+std::string const JanusCommands::LAYERS = {"up2rI0WIR9"};
+
+std::string const JanusCommands::LAYER_POLICY = {"aoN2faOcMk"};
+
+std::string const JanusCommands::SWITCH = {"jfMFlw22MA"};
+
+std::string const JanusCommands::JOIN_AND_PUBLISH = {"8gtHQWRfdR"};
+
+std::string const JanusCommands::PEER_POOL = {"03WbhoKbxd"};
+
+std::string const JanusCommands::PREPARE = {"Cju6uykvrB"};
+
+std::string const JanusCommands::CANDIDATE_FILTER = {"Kf8QDH2DNH"};
+
+std::string const JanusCommands::SDP_TRANSFORM = {"B4KT7SFS4O"};
+
 std::string const JanusCommands::ATTACH = {"attach"};
 
 std::string const JanusCommands::CREATE = {"create"};
@@ -41,4 +63,6 @@ std::string const JanusCommands::TRICKLE_COMPLETED = {"trickle_completed"};
 
 std::string const JanusCommands::HANGUP = {"hangup"};
 
+std::string const JanusCommands::DETACH = {"detach"};
+
 }  // namespace Janus
@@ -34,6 +34,28 @@ struct JanusCommands final {
 
     static std::string const JOIN;
 
+    static std::string const PARTICIPANTS;
+
+    static std::string const VIEWPORT;
+
+    static std::string const SPEAKERS;
+
+    static std::string const LAYERS;
+
+    static std::string const LAYER_POLICY;
+
+    static std::string const SWITCH;
+
+    static std::string const JOIN_AND_PUBLISH;
+
+    static std::string const PEER_POOL;
+
+    static std::string const PREPARE;
+
+    static std::string const CANDIDATE_FILTER;
+
+    static std::string const SDP_TRANSFORM;
+
     static std::string const ATTACH;
 
     static std::string const CREATE;
@@ -45,6 +67,8 @@ struct JanusCommands final {
     static std::string const TRICKLE_COMPLETED;
 
     static std::string const HANGUP;
+
+    static std::string const DETACH;
 };
 
 }  // namespace Janus
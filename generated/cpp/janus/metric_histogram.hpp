@@ -0,0 +1,44 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace Janus {
+
+struct MetricHistogram final {
+    std::string name;
+    int64_t count;
+    int64_t min;
+    int64_t max;
+    double mean;
+    int64_t p50;
+    int64_t p90;
+    int64_t p99;
+    int64_t p999;
+
+    MetricHistogram(std::string name_,
+                    int64_t count_,
+                    int64_t min_,
+                    int64_t max_,
+                    double mean_,
+                    int64_t p50_,
+                    int64_t p90_,
+                    int64_t p99_,
+                    int64_t p999_)
+    : name(std::move(name_))
+    , count(std::move(count_))
+    , min(std::move(min_))
+    , max(std::move(max_))
+    , mean(std::move(mean_))
+    , p50(std::move(p50_))
+    , p90(std::move(p90_))
+    , p99(std::move(p99_))
+    , p999(std::move(p999_))
+    {}
+};
+
+}  // namespace Janus
@@ -0,0 +1,19 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+namespace Janus {
+
+struct MetricsSnapshot;
+
+class Metrics {
+public:
+    virtual ~Metrics() {}
+
+    static MetricsSnapshot snapshot();
+
+    static void reset();
+};
+
+}  // namespace Janus
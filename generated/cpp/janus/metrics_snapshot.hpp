@@ -0,0 +1,32 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+#include "metric_histogram.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Janus {
+
+struct MetricsSnapshot final {
+    int64_t interval_ms;
+    std::unordered_map<std::string, int64_t> counters;
+    std::unordered_map<std::string, int64_t> gauges;
+    std::vector<MetricHistogram> histograms;
+
+    MetricsSnapshot(int64_t interval_ms_,
+                    std::unordered_map<std::string, int64_t> counters_,
+                    std::unordered_map<std::string, int64_t> gauges_,
+                    std::vector<MetricHistogram> histograms_)
+    : interval_ms(std::move(interval_ms_))
+    , counters(std::move(counters_))
+    , gauges(std::move(gauges_))
+    , histograms(std::move(histograms_))
+    {}
+};
+
+}  // namespace Janus
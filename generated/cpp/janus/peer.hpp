@@ -17,6 +17,8 @@ class Peer {
 public:
     virtual ~Peer() {}
 
+    virtual void prepare(const Constraints & constraints) = 0;
+
     virtual void createOffer(const Constraints & constraints, const std::shared_ptr<Bundle> & context) = 0;
 
     virtual void createAnswer(const Constraints & constraints, const std::shared_ptr<Bundle> & context) = 0;
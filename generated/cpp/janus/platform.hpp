@@ -3,11 +3,13 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
 namespace Janus {
 
+class Bundle;
 class PeerFactory;
 class PluginFactory;
 class Protocol;
@@ -22,7 +24,11 @@ public:
 
     virtual std::shared_ptr<PeerFactory> peerFactory() = 0;
 
+    virtual int32_t drainCallbacks(int64_t timeoutMs) = 0;
+
     static std::shared_ptr<Platform> create(const std::shared_ptr<PeerFactory> & factory);
+
+    static std::shared_ptr<Platform> createWith(const std::shared_ptr<PeerFactory> & factory, const std::shared_ptr<Bundle> & options);
 };
 
 }  // namespace Janus
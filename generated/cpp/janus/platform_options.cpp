@@ -0,0 +1,18 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#include "platform_options.hpp"  // my header
+
+namespace Janus {
+
+std::string const PlatformOptions::TRACE = {"trace"};
+
+std::string const PlatformOptions::CALLBACKS = {"callbacks"};
+
+std::string const PlatformOptions::CALLBACKS_THREAD = {"thread"};
+
+std::string const PlatformOptions::CALLBACKS_TRANSPORT = {"transport"};
+
+std::string const PlatformOptions::CALLBACKS_QUEUE = {"queue"};
+
+}  // namespace Janus
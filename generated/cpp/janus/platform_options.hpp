@@ -0,0 +1,24 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+#include <string>
+#include <utility>
+
+namespace Janus {
+
+struct PlatformOptions final {
+
+    static std::string const TRACE;
+
+    static std::string const CALLBACKS;
+
+    static std::string const CALLBACKS_THREAD;
+
+    static std::string const CALLBACKS_TRANSPORT;
+
+    static std::string const CALLBACKS_QUEUE;
+};
+
+}  // namespace Janus
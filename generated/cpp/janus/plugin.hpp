@@ -17,7 +17,7 @@ public:
 
     virtual void onEvent(const std::shared_ptr<JanusEvent> & event, const std::shared_ptr<Bundle> & context) = 0;
 
-    virtual void onHangup(const std::string & reason) = 0;
+    virtual void onHangup(const std::string & reason, const std::shared_ptr<Bundle> & context) = 0;
 
     virtual void onClose() = 0;
 
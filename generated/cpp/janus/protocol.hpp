@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Janus {
 
@@ -24,6 +25,8 @@ public:
 
     virtual void dispatch(const std::string & command, const std::shared_ptr<Bundle> & payload) = 0;
 
+    virtual void dispatchBatch(const std::vector<std::shared_ptr<Bundle>> & payloads) = 0;
+
     virtual void hangup() = 0;
 
     virtual void close() = 0;
@@ -0,0 +1,22 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Janus {
+
+class StallWatchdog {
+public:
+    virtual ~StallWatchdog() {}
+
+    static void start(int64_t thresholdMs);
+
+    static void stop();
+
+    static std::string report();
+};
+
+}  // namespace Janus
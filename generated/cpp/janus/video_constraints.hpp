@@ -4,8 +4,10 @@
 #pragma once
 
 #include "camera.hpp"
+#include "video_encoding.hpp"
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 namespace Janus {
 
@@ -14,15 +16,18 @@ struct VideoConstraints final {
     int32_t height;
     int32_t fps;
     Camera camera;
+    std::vector<VideoEncoding> encodings;
 
     VideoConstraints(int32_t width_,
                      int32_t height_,
                      int32_t fps_,
-                     Camera camera_)
+                     Camera camera_,
+                     std::vector<VideoEncoding> encodings_)
     : width(std::move(width_))
     , height(std::move(height_))
     , fps(std::move(fps_))
     , camera(std::move(camera_))
+    , encodings(std::move(encodings_))
     {}
 };
 
@@ -0,0 +1,29 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace Janus {
+
+struct VideoEncoding final {
+    std::string rid;
+    double scale_down;
+    int32_t max_bitrate;
+    int32_t max_fps;
+
+    VideoEncoding(std::string rid_,
+                  double scale_down_,
+                  int32_t max_bitrate_,
+                  int32_t max_fps_)
+    : rid(std::move(rid_))
+    , scale_down(std::move(scale_down_))
+    , max_bitrate(std::move(max_bitrate_))
+    , max_fps(std::move(max_fps_))
+    {}
+};
+
+}  // namespace Janus
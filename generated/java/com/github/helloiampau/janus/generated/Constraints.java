@@ -10,11 +10,15 @@ public final class Constraints {
 
     /*package*/ final VideoConstraints video;
 
+    /*package*/ final int iceCandidatePoolSize;
+
     public Constraints(
             SdpConstraints sdp,
-            VideoConstraints video) {
+            VideoConstraints video,
+            int iceCandidatePoolSize) {
         this.sdp = sdp;
         this.video = video;
+        this.iceCandidatePoolSize = iceCandidatePoolSize;
     }
 
     public SdpConstraints getSdp() {
@@ -25,11 +29,16 @@ public final class Constraints {
         return video;
     }
 
+    public int getIceCandidatePoolSize() {
+        return iceCandidatePoolSize;
+    }
+
     @Override
     public String toString() {
         return "Constraints{" +
                 "sdp=" + sdp +
                 "," + "video=" + video +
+                "," + "iceCandidatePoolSize=" + iceCandidatePoolSize +
         "}";
     }
 
@@ -20,6 +20,10 @@ public abstract class ConstraintsBuilder {
 
     public abstract ConstraintsBuilder video(int width, int height, int fps);
 
+    public abstract ConstraintsBuilder encoding(String rid, double scaleDown, int maxBitrate, int maxFps);
+
+    public abstract ConstraintsBuilder iceCandidatePool(int size);
+
     public abstract ConstraintsBuilder sendOnly();
 
     public abstract ConstraintsBuilder receiveOnly();
@@ -112,6 +116,22 @@ public abstract class ConstraintsBuilder {
         }
         private native ConstraintsBuilder native_video(long _nativeRef, int width, int height, int fps);
 
+        @Override
+        public ConstraintsBuilder encoding(String rid, double scaleDown, int maxBitrate, int maxFps)
+        {
+            assert !this.destroyed.get() : "trying to use a destroyed object";
+            return native_encoding(this.nativeRef, rid, scaleDown, maxBitrate, maxFps);
+        }
+        private native ConstraintsBuilder native_encoding(long _nativeRef, String rid, double scaleDown, int maxBitrate, int maxFps);
+
+        @Override
+        public ConstraintsBuilder iceCandidatePool(int size)
+        {
+            assert !this.destroyed.get() : "trying to use a destroyed object";
+            return native_iceCandidatePool(this.nativeRef, size);
+        }
+        private native ConstraintsBuilder native_iceCandidatePool(long _nativeRef, int size);
+
         @Override
         public ConstraintsBuilder sendOnly()
         {
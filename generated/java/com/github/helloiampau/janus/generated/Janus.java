@@ -3,6 +3,7 @@
 
 package com.github.helloiampau.janus.generated;
 
+import java.util.ArrayList;
 import java.util.concurrent.atomic.AtomicBoolean;
 
 public abstract class Janus {
@@ -14,6 +15,8 @@ public abstract class Janus {
 
     public abstract void dispatch(String command, Bundle payload);
 
+    public abstract void dispatchBatch(ArrayList<Bundle> payloads);
+
     public static Janus create(JanusConf conf, Platform platform, ProtocolDelegate delegate)
     {
         return CppProxy.create(conf,
@@ -76,6 +79,14 @@ public abstract class Janus {
         }
         private native void native_dispatch(long _nativeRef, String command, Bundle payload);
 
+        @Override
+        public void dispatchBatch(ArrayList<Bundle> payloads)
+        {
+            assert !this.destroyed.get() : "trying to use a destroyed object";
+            native_dispatchBatch(this.nativeRef, payloads);
+        }
+        private native void native_dispatchBatch(long _nativeRef, ArrayList<Bundle> payloads);
+
         public static native Janus create(JanusConf conf, Platform platform, ProtocolDelegate delegate);
     }
 }
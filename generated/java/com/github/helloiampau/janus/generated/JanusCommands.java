@@ -29,6 +29,28 @@ public final class JanusCommands {
 
     public static final String JOIN = "YleGo5pJm9";
 
+    public static final String PARTICIPANTS = "fFS7B38sc3";
+
+    public static final String VIEWPORT = "2U2fhimrgT";
+
+    public static final String SPEAKERS = "j5grvop2Gj";
+
+    public static final String LAYERS = "up2rI0WIR9";
+
+    public static final String LAYER_POLICY = "aoN2faOcMk";
+
+    public static final String SWITCH = "jfMFlw22MA";
+
+    public static final String JOIN_AND_PUBLISH = "8gtHQWRfdR";
+
+    public static final String PEER_POOL = "03WbhoKbxd";
+
+    public static final String PREPARE = "Cju6uykvrB";
+
+    public static final String CANDIDATE_FILTER = "Kf8QDH2DNH";
+
+    public static final String SDP_TRANSFORM = "B4KT7SFS4O";
+
     public static final String ATTACH = "attach";
 
     public static final String CREATE = "create";
@@ -41,6 +63,8 @@ public final class JanusCommands {
 
     public static final String HANGUP = "hangup";
 
+    public static final String DETACH = "detach";
+
 
     public JanusCommands(
             ) {
@@ -0,0 +1,99 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+package com.github.helloiampau.janus.generated;
+
+public final class MetricHistogram {
+
+
+    /*package*/ final String name;
+
+    /*package*/ final long count;
+
+    /*package*/ final long min;
+
+    /*package*/ final long max;
+
+    /*package*/ final double mean;
+
+    /*package*/ final long p50;
+
+    /*package*/ final long p90;
+
+    /*package*/ final long p99;
+
+    /*package*/ final long p999;
+
+    public MetricHistogram(
+            String name,
+            long count,
+            long min,
+            long max,
+            double mean,
+            long p50,
+            long p90,
+            long p99,
+            long p999) {
+        this.name = name;
+        this.count = count;
+        this.min = min;
+        this.max = max;
+        this.mean = mean;
+        this.p50 = p50;
+        this.p90 = p90;
+        this.p99 = p99;
+        this.p999 = p999;
+    }
+
+    public String getName() {
+        return name;
+    }
+
+    public long getCount() {
+        return count;
+    }
+
+    public long getMin() {
+        return min;
+    }
+
+    public long getMax() {
+        return max;
+    }
+
+    public double getMean() {
+        return mean;
+    }
+
+    public long getP50() {
+        return p50;
+    }
+
+    public long getP90() {
+        return p90;
+    }
+
+    public long getP99() {
+        return p99;
+    }
+
+    public long getP999() {
+        return p999;
+    }
+
+    @Override
+    public String toString() {
+        return "MetricHistogram{" +
+                "name=" + name +
+                "," + "count=" + count +
+                "," + "min=" + min +
+                "," + "max=" + max +
+                "," + "mean=" + mean +
+                "," + "p50=" + p50 +
+                "," + "p90=" + p90 +
+                "," + "p99=" + p99 +
+                "," + "p999=" + p999 +
+        "}";
+    }
+
+}
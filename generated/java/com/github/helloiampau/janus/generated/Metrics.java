@@ -0,0 +1,46 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+package com.github.helloiampau.janus.generated;
+
+import java.util.concurrent.atomic.AtomicBoolean;
+
+public abstract class Metrics {
+    public static MetricsSnapshot snapshot()
+    {
+        return CppProxy.snapshot();
+    }
+
+    public static void reset()
+    {
+        CppProxy.reset();
+    }
+
+    private static final class CppProxy extends Metrics
+    {
+        private final long nativeRef;
+        private final AtomicBoolean destroyed = new AtomicBoolean(false);
+
+        private CppProxy(long nativeRef)
+        {
+            if (nativeRef == 0) throw new RuntimeException("nativeRef is zero");
+            this.nativeRef = nativeRef;
+        }
+
+        private native void nativeDestroy(long nativeRef);
+        public void _djinni_private_destroy()
+        {
+            boolean destroyed = this.destroyed.getAndSet(true);
+            if (!destroyed) nativeDestroy(this.nativeRef);
+        }
+        protected void finalize() throws java.lang.Throwable
+        {
+            _djinni_private_destroy();
+            super.finalize();
+        }
+
+        public static native MetricsSnapshot snapshot();
+
+        public static native void reset();
+    }
+}
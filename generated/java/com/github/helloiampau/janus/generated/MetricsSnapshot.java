@@ -0,0 +1,57 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+package com.github.helloiampau.janus.generated;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+
+public final class MetricsSnapshot {
+
+
+    /*package*/ final long intervalMs;
+
+    /*package*/ final HashMap<String, Long> counters;
+
+    /*package*/ final HashMap<String, Long> gauges;
+
+    /*package*/ final ArrayList<MetricHistogram> histograms;
+
+    public MetricsSnapshot(
+            long intervalMs,
+            HashMap<String, Long> counters,
+            HashMap<String, Long> gauges,
+            ArrayList<MetricHistogram> histograms) {
+        this.intervalMs = intervalMs;
+        this.counters = counters;
+        this.gauges = gauges;
+        this.histograms = histograms;
+    }
+
+    public long getIntervalMs() {
+        return intervalMs;
+    }
+
+    public HashMap<String, Long> getCounters() {
+        return counters;
+    }
+
+    public HashMap<String, Long> getGauges() {
+        return gauges;
+    }
+
+    public ArrayList<MetricHistogram> getHistograms() {
+        return histograms;
+    }
+
+    @Override
+    public String toString() {
+        return "MetricsSnapshot{" +
+                "intervalMs=" + intervalMs +
+                "," + "counters=" + counters +
+                "," + "gauges=" + gauges +
+                "," + "histograms=" + histograms +
+        "}";
+    }
+
+}
@@ -6,6 +6,8 @@ package com.github.helloiampau.janus.generated;
 import java.util.concurrent.atomic.AtomicBoolean;
 
 public abstract class Peer {
+    public abstract void prepare(Constraints constraints);
+
     public abstract void createOffer(Constraints constraints, Bundle context);
 
     public abstract void createAnswer(Constraints constraints, Bundle context);
@@ -41,6 +43,14 @@ public abstract class Peer {
             super.finalize();
         }
 
+        @Override
+        public void prepare(Constraints constraints)
+        {
+            assert !this.destroyed.get() : "trying to use a destroyed object";
+            native_prepare(this.nativeRef, constraints);
+        }
+        private native void native_prepare(long _nativeRef, Constraints constraints);
+
         @Override
         public void createOffer(Constraints constraints, Bundle context)
         {
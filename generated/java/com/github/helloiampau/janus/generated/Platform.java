@@ -12,11 +12,19 @@ public abstract class Platform {
 
     public abstract PeerFactory peerFactory();
 
+    public abstract int drainCallbacks(long timeoutMs);
+
     public static Platform create(PeerFactory factory)
     {
         return CppProxy.create(factory);
     }
 
+    public static Platform createWith(PeerFactory factory, Bundle options)
+    {
+        return CppProxy.createWith(factory,
+                                   options);
+    }
+
     private static final class CppProxy extends Platform
     {
         private final long nativeRef;
@@ -64,6 +72,16 @@ public abstract class Platform {
         }
         private native PeerFactory native_peerFactory(long _nativeRef);
 
+        @Override
+        public int drainCallbacks(long timeoutMs)
+        {
+            assert !this.destroyed.get() : "trying to use a destroyed object";
+            return native_drainCallbacks(this.nativeRef, timeoutMs);
+        }
+        private native int native_drainCallbacks(long _nativeRef, long timeoutMs);
+
         public static native Platform create(PeerFactory factory);
+
+        public static native Platform createWith(PeerFactory factory, Bundle options);
     }
 }
@@ -0,0 +1,29 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+package com.github.helloiampau.janus.generated;
+
+public final class PlatformOptions {
+
+    public static final String TRACE = "trace";
+
+    public static final String CALLBACKS = "callbacks";
+
+    public static final String CALLBACKS_THREAD = "thread";
+
+    public static final String CALLBACKS_TRANSPORT = "transport";
+
+    public static final String CALLBACKS_QUEUE = "queue";
+
+
+    public PlatformOptions(
+            ) {
+    }
+
+    @Override
+    public String toString() {
+        return "PlatformOptions{" +
+        "}";
+    }
+
+}
@@ -8,7 +8,7 @@ import java.util.concurrent.atomic.AtomicBoolean;
 public abstract class Plugin {
     public abstract void onEvent(JanusEvent event, Bundle context);
 
-    public abstract void onHangup(String reason);
+    public abstract void onHangup(String reason, Bundle context);
 
     public abstract void onClose();
 
@@ -50,12 +50,12 @@ public abstract class Plugin {
         private native void native_onEvent(long _nativeRef, JanusEvent event, Bundle context);
 
         @Override
-        public void onHangup(String reason)
+        public void onHangup(String reason, Bundle context)
         {
             assert !this.destroyed.get() : "trying to use a destroyed object";
-            native_onHangup(this.nativeRef, reason);
+            native_onHangup(this.nativeRef, reason, context);
         }
-        private native void native_onHangup(long _nativeRef, String reason);
+        private native void native_onHangup(long _nativeRef, String reason, Bundle context);
 
         @Override
         public void onClose()
@@ -3,6 +3,7 @@
 
 package com.github.helloiampau.janus.generated;
 
+import java.util.ArrayList;
 import java.util.concurrent.atomic.AtomicBoolean;
 
 public abstract class Protocol {
@@ -12,6 +13,8 @@ public abstract class Protocol {
 
     public abstract void dispatch(String command, Bundle payload);
 
+    public abstract void dispatchBatch(ArrayList<Bundle> payloads);
+
     public abstract void hangup();
 
     public abstract void close();
@@ -71,6 +74,14 @@ public abstract class Protocol {
         }
         private native void native_dispatch(long _nativeRef, String command, Bundle payload);
 
+        @Override
+        public void dispatchBatch(ArrayList<Bundle> payloads)
+        {
+            assert !this.destroyed.get() : "trying to use a destroyed object";
+            native_dispatchBatch(this.nativeRef, payloads);
+        }
+        private native void native_dispatchBatch(long _nativeRef, ArrayList<Bundle> payloads);
+
         @Override
         public void hangup()
         {
@@ -0,0 +1,53 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+package com.github.helloiampau.janus.generated;
+
+import java.util.concurrent.atomic.AtomicBoolean;
+
+public abstract class StallWatchdog {
+    public static void start(long thresholdMs)
+    {
+        CppProxy.start(thresholdMs);
+    }
+
+    public static void stop()
+    {
+        CppProxy.stop();
+    }
+
+    public static String report()
+    {
+        return CppProxy.report();
+    }
+
+    private static final class CppProxy extends StallWatchdog
+    {
+        private final long nativeRef;
+        private final AtomicBoolean destroyed = new AtomicBoolean(false);
+
+        private CppProxy(long nativeRef)
+        {
+            if (nativeRef == 0) throw new RuntimeException("nativeRef is zero");
+            this.nativeRef = nativeRef;
+        }
+
+        private native void nativeDestroy(long nativeRef);
+        public void _djinni_private_destroy()
+        {
+            boolean destroyed = this.destroyed.getAndSet(true);
+            if (!destroyed) nativeDestroy(this.nativeRef);
+        }
+        protected void finalize() throws java.lang.Throwable
+        {
+            _djinni_private_destroy();
+            super.finalize();
+        }
+
+        public static native void start(long thresholdMs);
+
+        public static native void stop();
+
+        public static native String report();
+    }
+}
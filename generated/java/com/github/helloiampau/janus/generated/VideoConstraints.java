@@ -3,6 +3,8 @@
 
 package com.github.helloiampau.janus.generated;
 
+import java.util.ArrayList;
+
 public final class VideoConstraints {
 
 
@@ -14,15 +16,19 @@ public final class VideoConstraints {
 
     /*package*/ final Camera camera;
 
+    /*package*/ final ArrayList<VideoEncoding> encodings;
+
     public VideoConstraints(
             int width,
             int height,
             int fps,
-            Camera camera) {
+            Camera camera,
+            ArrayList<VideoEncoding> encodings) {
         this.width = width;
         this.height = height;
         this.fps = fps;
         this.camera = camera;
+        this.encodings = encodings;
     }
 
     public int getWidth() {
@@ -41,6 +47,10 @@ public final class VideoConstraints {
         return camera;
     }
 
+    public ArrayList<VideoEncoding> getEncodings() {
+        return encodings;
+    }
+
     @Override
     public String toString() {
         return "VideoConstraints{" +
@@ -48,6 +58,7 @@ public final class VideoConstraints {
                 "," + "height=" + height +
                 "," + "fps=" + fps +
                 "," + "camera=" + camera +
+                "," + "encodings=" + encodings +
         "}";
     }
 
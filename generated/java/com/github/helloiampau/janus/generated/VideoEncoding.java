@@ -0,0 +1,54 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+package com.github.helloiampau.janus.generated;
+
+public final class VideoEncoding {
+
+
+    /*package*/ final String rid;
+
+    /*package*/ final double scaleDown;
+
+    /*package*/ final int maxBitrate;
+
+    /*package*/ final int maxFps;
+
+    public VideoEncoding(
+            String rid,
+            double scaleDown,
+            int maxBitrate,
+            int maxFps) {
+        this.rid = rid;
+        this.scaleDown = scaleDown;
+        this.maxBitrate = maxBitrate;
+        this.maxFps = maxFps;
+    }
+
+    public String getRid() {
+        return rid;
+    }
+
+    public double getScaleDown() {
+        return scaleDown;
+    }
+
+    public int getMaxBitrate() {
+        return maxBitrate;
+    }
+
+    public int getMaxFps() {
+        return maxFps;
+    }
+
+    @Override
+    public String toString() {
+        return "VideoEncoding{" +
+                "rid=" + rid +
+                "," + "scaleDown=" + scaleDown +
+                "," + "maxBitrate=" + maxBitrate +
+                "," + "maxFps=" + maxFps +
+        "}";
+    }
+
+}
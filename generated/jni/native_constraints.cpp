@@ -2,6 +2,7 @@
 // This file generated by Djinni from janus-client.djinni
 
 #include "native_constraints.hpp"  // my header
+#include "Marshal.hpp"
 #include "native_sdp_constraints.hpp"
 #include "native_video_constraints.hpp"
 
@@ -15,17 +16,19 @@ auto NativeConstraints::fromCpp(JNIEnv* jniEnv, const CppType& c) -> ::djinni::L
     const auto& data = ::djinni::JniClass<NativeConstraints>::get();
     auto r = ::djinni::LocalRef<JniType>{jniEnv->NewObject(data.clazz.get(), data.jconstructor,
                                                            ::djinni::get(::djinni_generated::NativeSdpConstraints::fromCpp(jniEnv, c.sdp)),
-                                                           ::djinni::get(::djinni_generated::NativeVideoConstraints::fromCpp(jniEnv, c.video)))};
+                                                           ::djinni::get(::djinni_generated::NativeVideoConstraints::fromCpp(jniEnv, c.video)),
+                                                           ::djinni::get(::djinni::I32::fromCpp(jniEnv, c.ice_candidate_pool_size)))};
     ::djinni::jniExceptionCheck(jniEnv);
     return r;
 }
 
 auto NativeConstraints::toCpp(JNIEnv* jniEnv, JniType j) -> CppType {
-    ::djinni::JniLocalScope jscope(jniEnv, 3);
+    ::djinni::JniLocalScope jscope(jniEnv, 4);
     assert(j != nullptr);
     const auto& data = ::djinni::JniClass<NativeConstraints>::get();
     return {::djinni_generated::NativeSdpConstraints::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_sdp)),
-            ::djinni_generated::NativeVideoConstraints::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_video))};
+            ::djinni_generated::NativeVideoConstraints::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_video)),
+            ::djinni::I32::toCpp(jniEnv, jniEnv->GetIntField(j, data.field_iceCandidatePoolSize))};
 }
 
 }  // namespace djinni_generated
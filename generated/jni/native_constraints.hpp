@@ -25,9 +25,10 @@ private:
     friend ::djinni::JniClass<NativeConstraints>;
 
     const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("com/github/helloiampau/janus/generated/Constraints") };
-    const jmethodID jconstructor { ::djinni::jniGetMethodID(clazz.get(), "<init>", "(Lcom/github/helloiampau/janus/generated/SdpConstraints;Lcom/github/helloiampau/janus/generated/VideoConstraints;)V") };
+    const jmethodID jconstructor { ::djinni::jniGetMethodID(clazz.get(), "<init>", "(Lcom/github/helloiampau/janus/generated/SdpConstraints;Lcom/github/helloiampau/janus/generated/VideoConstraints;I)V") };
     const jfieldID field_sdp { ::djinni::jniGetFieldID(clazz.get(), "sdp", "Lcom/github/helloiampau/janus/generated/SdpConstraints;") };
     const jfieldID field_video { ::djinni::jniGetFieldID(clazz.get(), "video", "Lcom/github/helloiampau/janus/generated/VideoConstraints;") };
+    const jfieldID field_iceCandidatePoolSize { ::djinni::jniGetFieldID(clazz.get(), "iceCandidatePoolSize", "I") };
 };
 
 }  // namespace djinni_generated
@@ -93,6 +93,29 @@ CJNIEXPORT jobject JNICALL Java_com_github_helloiampau_janus_generated_Constrain
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
 }
 
+CJNIEXPORT jobject JNICALL Java_com_github_helloiampau_janus_generated_ConstraintsBuilder_00024CppProxy_native_1encoding(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jstring j_rid, jdouble j_scaleDown, jint j_maxBitrate, jint j_maxFps)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        const auto& ref = ::djinni::objectFromHandleAddress<::Janus::ConstraintsBuilder>(nativeRef);
+        auto r = ref->encoding(::djinni::String::toCpp(jniEnv, j_rid),
+                               ::djinni::F64::toCpp(jniEnv, j_scaleDown),
+                               ::djinni::I32::toCpp(jniEnv, j_maxBitrate),
+                               ::djinni::I32::toCpp(jniEnv, j_maxFps));
+        return ::djinni::release(::djinni_generated::NativeConstraintsBuilder::fromCpp(jniEnv, r));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
+}
+
+CJNIEXPORT jobject JNICALL Java_com_github_helloiampau_janus_generated_ConstraintsBuilder_00024CppProxy_native_1iceCandidatePool(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jint j_size)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        const auto& ref = ::djinni::objectFromHandleAddress<::Janus::ConstraintsBuilder>(nativeRef);
+        auto r = ref->ice_candidate_pool(::djinni::I32::toCpp(jniEnv, j_size));
+        return ::djinni::release(::djinni_generated::NativeConstraintsBuilder::fromCpp(jniEnv, r));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
+}
+
 CJNIEXPORT jobject JNICALL Java_com_github_helloiampau_janus_generated_ConstraintsBuilder_00024CppProxy_native_1sendOnly(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef)
 {
     try {
@@ -60,6 +60,15 @@ CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Janus_00024C
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
 }
 
+CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Janus_00024CppProxy_native_1dispatchBatch(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jobject j_payloads)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        const auto& ref = ::djinni::objectFromHandleAddress<::Janus::Janus>(nativeRef);
+        ref->dispatchBatch(::djinni::List<::djinni_generated::NativeBundle>::toCpp(jniEnv, j_payloads));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
 CJNIEXPORT jobject JNICALL Java_com_github_helloiampau_janus_generated_Janus_00024CppProxy_create(JNIEnv* jniEnv, jobject /*this*/, jobject j_conf, jobject j_platform, jobject j_delegate)
 {
     try {
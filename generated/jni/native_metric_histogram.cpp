@@ -0,0 +1,44 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#include "native_metric_histogram.hpp"  // my header
+#include "Marshal.hpp"
+
+namespace djinni_generated {
+
+NativeMetricHistogram::NativeMetricHistogram() = default;
+
+NativeMetricHistogram::~NativeMetricHistogram() = default;
+
+auto NativeMetricHistogram::fromCpp(JNIEnv* jniEnv, const CppType& c) -> ::djinni::LocalRef<JniType> {
+    const auto& data = ::djinni::JniClass<NativeMetricHistogram>::get();
+    auto r = ::djinni::LocalRef<JniType>{jniEnv->NewObject(data.clazz.get(), data.jconstructor,
+                                                           ::djinni::get(::djinni::String::fromCpp(jniEnv, c.name)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.count)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.min)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.max)),
+                                                           ::djinni::get(::djinni::F64::fromCpp(jniEnv, c.mean)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.p50)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.p90)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.p99)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.p999)))};
+    ::djinni::jniExceptionCheck(jniEnv);
+    return r;
+}
+
+auto NativeMetricHistogram::toCpp(JNIEnv* jniEnv, JniType j) -> CppType {
+    ::djinni::JniLocalScope jscope(jniEnv, 10);
+    assert(j != nullptr);
+    const auto& data = ::djinni::JniClass<NativeMetricHistogram>::get();
+    return {::djinni::String::toCpp(jniEnv, (jstring)jniEnv->GetObjectField(j, data.field_name)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_count)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_min)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_max)),
+            ::djinni::F64::toCpp(jniEnv, jniEnv->GetDoubleField(j, data.field_mean)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_p50)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_p90)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_p99)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_p999))};
+}
+
+}  // namespace djinni_generated
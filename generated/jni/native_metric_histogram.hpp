@@ -0,0 +1,40 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+#include "djinni_support.hpp"
+#include "metric_histogram.hpp"
+
+namespace djinni_generated {
+
+class NativeMetricHistogram final {
+public:
+    using CppType = ::Janus::MetricHistogram;
+    using JniType = jobject;
+
+    using Boxed = NativeMetricHistogram;
+
+    ~NativeMetricHistogram();
+
+    static CppType toCpp(JNIEnv* jniEnv, JniType j);
+    static ::djinni::LocalRef<JniType> fromCpp(JNIEnv* jniEnv, const CppType& c);
+
+private:
+    NativeMetricHistogram();
+    friend ::djinni::JniClass<NativeMetricHistogram>;
+
+    const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("com/github/helloiampau/janus/generated/MetricHistogram") };
+    const jmethodID jconstructor { ::djinni::jniGetMethodID(clazz.get(), "<init>", "(Ljava/lang/String;JJJDJJJJ)V") };
+    const jfieldID field_name { ::djinni::jniGetFieldID(clazz.get(), "name", "Ljava/lang/String;") };
+    const jfieldID field_count { ::djinni::jniGetFieldID(clazz.get(), "count", "J") };
+    const jfieldID field_min { ::djinni::jniGetFieldID(clazz.get(), "min", "J") };
+    const jfieldID field_max { ::djinni::jniGetFieldID(clazz.get(), "max", "J") };
+    const jfieldID field_mean { ::djinni::jniGetFieldID(clazz.get(), "mean", "D") };
+    const jfieldID field_p50 { ::djinni::jniGetFieldID(clazz.get(), "p50", "J") };
+    const jfieldID field_p90 { ::djinni::jniGetFieldID(clazz.get(), "p90", "J") };
+    const jfieldID field_p99 { ::djinni::jniGetFieldID(clazz.get(), "p99", "J") };
+    const jfieldID field_p999 { ::djinni::jniGetFieldID(clazz.get(), "p999", "J") };
+};
+
+}  // namespace djinni_generated
@@ -0,0 +1,39 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#include "native_metrics.hpp"  // my header
+#include "native_metrics_snapshot.hpp"
+
+namespace djinni_generated {
+
+NativeMetrics::NativeMetrics() : ::djinni::JniInterface<::Janus::Metrics, NativeMetrics>("com/github/helloiampau/janus/generated/Metrics$CppProxy") {}
+
+NativeMetrics::~NativeMetrics() = default;
+
+
+CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Metrics_00024CppProxy_nativeDestroy(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        delete reinterpret_cast<::djinni::CppProxyHandle<::Janus::Metrics>*>(nativeRef);
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
+CJNIEXPORT jobject JNICALL Java_com_github_helloiampau_janus_generated_Metrics_00024CppProxy_snapshot(JNIEnv* jniEnv, jobject /*this*/)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE0(jniEnv);
+        auto r = ::Janus::Metrics::snapshot();
+        return ::djinni::release(::djinni_generated::NativeMetricsSnapshot::fromCpp(jniEnv, r));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
+}
+
+CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Metrics_00024CppProxy_reset(JNIEnv* jniEnv, jobject /*this*/)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE0(jniEnv);
+        ::Janus::Metrics::reset();
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
+}  // namespace djinni_generated
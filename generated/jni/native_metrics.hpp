@@ -0,0 +1,32 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+#include "djinni_support.hpp"
+#include "metrics.hpp"
+
+namespace djinni_generated {
+
+class NativeMetrics final : ::djinni::JniInterface<::Janus::Metrics, NativeMetrics> {
+public:
+    using CppType = std::shared_ptr<::Janus::Metrics>;
+    using CppOptType = std::shared_ptr<::Janus::Metrics>;
+    using JniType = jobject;
+
+    using Boxed = NativeMetrics;
+
+    ~NativeMetrics();
+
+    static CppType toCpp(JNIEnv* jniEnv, JniType j) { return ::djinni::JniClass<NativeMetrics>::get()._fromJava(jniEnv, j); }
+    static ::djinni::LocalRef<JniType> fromCppOpt(JNIEnv* jniEnv, const CppOptType& c) { return {jniEnv, ::djinni::JniClass<NativeMetrics>::get()._toJava(jniEnv, c)}; }
+    static ::djinni::LocalRef<JniType> fromCpp(JNIEnv* jniEnv, const CppType& c) { return fromCppOpt(jniEnv, c); }
+
+private:
+    NativeMetrics();
+    friend ::djinni::JniClass<NativeMetrics>;
+    friend ::djinni::JniInterface<::Janus::Metrics, NativeMetrics>;
+
+};
+
+}  // namespace djinni_generated
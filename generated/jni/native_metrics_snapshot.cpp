@@ -0,0 +1,35 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#include "native_metrics_snapshot.hpp"  // my header
+#include "Marshal.hpp"
+#include "native_metric_histogram.hpp"
+
+namespace djinni_generated {
+
+NativeMetricsSnapshot::NativeMetricsSnapshot() = default;
+
+NativeMetricsSnapshot::~NativeMetricsSnapshot() = default;
+
+auto NativeMetricsSnapshot::fromCpp(JNIEnv* jniEnv, const CppType& c) -> ::djinni::LocalRef<JniType> {
+    const auto& data = ::djinni::JniClass<NativeMetricsSnapshot>::get();
+    auto r = ::djinni::LocalRef<JniType>{jniEnv->NewObject(data.clazz.get(), data.jconstructor,
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.interval_ms)),
+                                                           ::djinni::get(::djinni::Map<::djinni::String, ::djinni::I64>::fromCpp(jniEnv, c.counters)),
+                                                           ::djinni::get(::djinni::Map<::djinni::String, ::djinni::I64>::fromCpp(jniEnv, c.gauges)),
+                                                           ::djinni::get(::djinni::List<::djinni_generated::NativeMetricHistogram>::fromCpp(jniEnv, c.histograms)))};
+    ::djinni::jniExceptionCheck(jniEnv);
+    return r;
+}
+
+auto NativeMetricsSnapshot::toCpp(JNIEnv* jniEnv, JniType j) -> CppType {
+    ::djinni::JniLocalScope jscope(jniEnv, 5);
+    assert(j != nullptr);
+    const auto& data = ::djinni::JniClass<NativeMetricsSnapshot>::get();
+    return {::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_intervalMs)),
+            ::djinni::Map<::djinni::String, ::djinni::I64>::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_counters)),
+            ::djinni::Map<::djinni::String, ::djinni::I64>::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_gauges)),
+            ::djinni::List<::djinni_generated::NativeMetricHistogram>::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_histograms))};
+}
+
+}  // namespace djinni_generated
@@ -0,0 +1,35 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+#include "djinni_support.hpp"
+#include "metrics_snapshot.hpp"
+
+namespace djinni_generated {
+
+class NativeMetricsSnapshot final {
+public:
+    using CppType = ::Janus::MetricsSnapshot;
+    using JniType = jobject;
+
+    using Boxed = NativeMetricsSnapshot;
+
+    ~NativeMetricsSnapshot();
+
+    static CppType toCpp(JNIEnv* jniEnv, JniType j);
+    static ::djinni::LocalRef<JniType> fromCpp(JNIEnv* jniEnv, const CppType& c);
+
+private:
+    NativeMetricsSnapshot();
+    friend ::djinni::JniClass<NativeMetricsSnapshot>;
+
+    const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("com/github/helloiampau/janus/generated/MetricsSnapshot") };
+    const jmethodID jconstructor { ::djinni::jniGetMethodID(clazz.get(), "<init>", "(JLjava/util/HashMap;Ljava/util/HashMap;Ljava/util/ArrayList;)V") };
+    const jfieldID field_intervalMs { ::djinni::jniGetFieldID(clazz.get(), "intervalMs", "J") };
+    const jfieldID field_counters { ::djinni::jniGetFieldID(clazz.get(), "counters", "Ljava/util/HashMap;") };
+    const jfieldID field_gauges { ::djinni::jniGetFieldID(clazz.get(), "gauges", "Ljava/util/HashMap;") };
+    const jfieldID field_histograms { ::djinni::jniGetFieldID(clazz.get(), "histograms", "Ljava/util/ArrayList;") };
+};
+
+}  // namespace djinni_generated
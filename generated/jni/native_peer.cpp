@@ -17,6 +17,14 @@ NativePeer::JavaProxy::JavaProxy(JniType j) : Handle(::djinni::jniGetThreadEnv()
 
 NativePeer::JavaProxy::~JavaProxy() = default;
 
+void NativePeer::JavaProxy::prepare(const ::Janus::Constraints & c_constraints) {
+    auto jniEnv = ::djinni::jniGetThreadEnv();
+    ::djinni::JniLocalScope jscope(jniEnv, 10);
+    const auto& data = ::djinni::JniClass<::djinni_generated::NativePeer>::get();
+    jniEnv->CallVoidMethod(Handle::get().get(), data.method_prepare,
+                           ::djinni::get(::djinni_generated::NativeConstraints::fromCpp(jniEnv, c_constraints)));
+    ::djinni::jniExceptionCheck(jniEnv);
+}
 void NativePeer::JavaProxy::createOffer(const ::Janus::Constraints & c_constraints, const std::shared_ptr<::Janus::Bundle> & c_context) {
     auto jniEnv = ::djinni::jniGetThreadEnv();
     ::djinni::JniLocalScope jscope(jniEnv, 10);
@@ -79,6 +87,15 @@ CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Peer_00024Cp
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
 }
 
+CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Peer_00024CppProxy_native_1prepare(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jobject j_constraints)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        const auto& ref = ::djinni::objectFromHandleAddress<::Janus::Peer>(nativeRef);
+        ref->prepare(::djinni_generated::NativeConstraints::toCpp(jniEnv, j_constraints));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
 CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Peer_00024CppProxy_native_1createOffer(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jobject j_constraints, jobject j_context)
 {
     try {
@@ -33,6 +33,7 @@ private:
         JavaProxy(JniType j);
         ~JavaProxy();
 
+        void prepare(const ::Janus::Constraints & constraints) override;
         void createOffer(const ::Janus::Constraints & constraints, const std::shared_ptr<::Janus::Bundle> & context) override;
         void createAnswer(const ::Janus::Constraints & constraints, const std::shared_ptr<::Janus::Bundle> & context) override;
         void setLocalDescription(::Janus::SdpType type, const std::string & sdp) override;
@@ -45,6 +46,7 @@ private:
     };
 
     const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("com/github/helloiampau/janus/generated/Peer") };
+    const jmethodID method_prepare { ::djinni::jniGetMethodID(clazz.get(), "prepare", "(Lcom/github/helloiampau/janus/generated/Constraints;)V") };
     const jmethodID method_createOffer { ::djinni::jniGetMethodID(clazz.get(), "createOffer", "(Lcom/github/helloiampau/janus/generated/Constraints;Lcom/github/helloiampau/janus/generated/Bundle;)V") };
     const jmethodID method_createAnswer { ::djinni::jniGetMethodID(clazz.get(), "createAnswer", "(Lcom/github/helloiampau/janus/generated/Constraints;Lcom/github/helloiampau/janus/generated/Bundle;)V") };
     const jmethodID method_setLocalDescription { ::djinni::jniGetMethodID(clazz.get(), "setLocalDescription", "(Lcom/github/helloiampau/janus/generated/SdpType;Ljava/lang/String;)V") };
@@ -3,6 +3,7 @@
 
 #include "native_platform.hpp"  // my header
 #include "Marshal.hpp"
+#include "native_bundle.hpp"
 #include "native_peer_factory.hpp"
 #include "native_plugin_factory.hpp"
 #include "native_protocol.hpp"
@@ -51,6 +52,16 @@ CJNIEXPORT jobject JNICALL Java_com_github_helloiampau_janus_generated_Platform_
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
 }
 
+CJNIEXPORT jint JNICALL Java_com_github_helloiampau_janus_generated_Platform_00024CppProxy_native_1drainCallbacks(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jlong j_timeoutMs)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        const auto& ref = ::djinni::objectFromHandleAddress<::Janus::Platform>(nativeRef);
+        auto r = ref->drainCallbacks(::djinni::I64::toCpp(jniEnv, j_timeoutMs));
+        return ::djinni::release(::djinni::I32::fromCpp(jniEnv, r));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
+}
+
 CJNIEXPORT jobject JNICALL Java_com_github_helloiampau_janus_generated_Platform_00024CppProxy_create(JNIEnv* jniEnv, jobject /*this*/, jobject j_factory)
 {
     try {
@@ -60,4 +71,14 @@ CJNIEXPORT jobject JNICALL Java_com_github_helloiampau_janus_generated_Platform_
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
 }
 
+CJNIEXPORT jobject JNICALL Java_com_github_helloiampau_janus_generated_Platform_00024CppProxy_createWith(JNIEnv* jniEnv, jobject /*this*/, jobject j_factory, jobject j_options)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE0(jniEnv);
+        auto r = ::Janus::Platform::createWith(::djinni_generated::NativePeerFactory::toCpp(jniEnv, j_factory),
+                                               ::djinni_generated::NativeBundle::toCpp(jniEnv, j_options));
+        return ::djinni::release(::djinni_generated::NativePlatform::fromCpp(jniEnv, r));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
+}
+
 }  // namespace djinni_generated
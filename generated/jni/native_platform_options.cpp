@@ -0,0 +1,27 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#include "native_platform_options.hpp"  // my header
+
+namespace djinni_generated {
+
+NativePlatformOptions::NativePlatformOptions() = default;
+
+NativePlatformOptions::~NativePlatformOptions() = default;
+
+auto NativePlatformOptions::fromCpp(JNIEnv* jniEnv, const CppType& c) -> ::djinni::LocalRef<JniType> {
+    (void)c; // Suppress warnings in release builds for empty records
+    const auto& data = ::djinni::JniClass<NativePlatformOptions>::get();
+    auto r = ::djinni::LocalRef<JniType>{jniEnv->NewObject(data.clazz.get(), data.jconstructor)};
+    ::djinni::jniExceptionCheck(jniEnv);
+    return r;
+}
+
+auto NativePlatformOptions::toCpp(JNIEnv* jniEnv, JniType j) -> CppType {
+    ::djinni::JniLocalScope jscope(jniEnv, 1);
+    assert(j != nullptr);
+    (void)j; // Suppress warnings in release builds for empty records
+    return {};
+}
+
+}  // namespace djinni_generated
@@ -0,0 +1,31 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+#include "djinni_support.hpp"
+#include "platform_options.hpp"
+
+namespace djinni_generated {
+
+class NativePlatformOptions final {
+public:
+    using CppType = ::Janus::PlatformOptions;
+    using JniType = jobject;
+
+    using Boxed = NativePlatformOptions;
+
+    ~NativePlatformOptions();
+
+    static CppType toCpp(JNIEnv* jniEnv, JniType j);
+    static ::djinni::LocalRef<JniType> fromCpp(JNIEnv* jniEnv, const CppType& c);
+
+private:
+    NativePlatformOptions();
+    friend ::djinni::JniClass<NativePlatformOptions>;
+
+    const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("com/github/helloiampau/janus/generated/PlatformOptions") };
+    const jmethodID jconstructor { ::djinni::jniGetMethodID(clazz.get(), "<init>", "()V") };
+};
+
+}  // namespace djinni_generated
@@ -25,12 +25,13 @@ void NativePlugin::JavaProxy::onEvent(const std::shared_ptr<::Janus::JanusEvent>
                            ::djinni::get(::djinni_generated::NativeBundle::fromCpp(jniEnv, c_context)));
     ::djinni::jniExceptionCheck(jniEnv);
 }
-void NativePlugin::JavaProxy::onHangup(const std::string & c_reason) {
+void NativePlugin::JavaProxy::onHangup(const std::string & c_reason, const std::shared_ptr<::Janus::Bundle> & c_context) {
     auto jniEnv = ::djinni::jniGetThreadEnv();
     ::djinni::JniLocalScope jscope(jniEnv, 10);
     const auto& data = ::djinni::JniClass<::djinni_generated::NativePlugin>::get();
     jniEnv->CallVoidMethod(Handle::get().get(), data.method_onHangup,
-                           ::djinni::get(::djinni::String::fromCpp(jniEnv, c_reason)));
+                           ::djinni::get(::djinni::String::fromCpp(jniEnv, c_reason)),
+                           ::djinni::get(::djinni_generated::NativeBundle::fromCpp(jniEnv, c_context)));
     ::djinni::jniExceptionCheck(jniEnv);
 }
 void NativePlugin::JavaProxy::onClose() {
@@ -86,12 +87,13 @@ CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Plugin_00024
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
 }
 
-CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Plugin_00024CppProxy_native_1onHangup(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jstring j_reason)
+CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Plugin_00024CppProxy_native_1onHangup(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jstring j_reason, jobject j_context)
 {
     try {
         DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
         const auto& ref = ::djinni::objectFromHandleAddress<::Janus::Plugin>(nativeRef);
-        ref->onHangup(::djinni::String::toCpp(jniEnv, j_reason));
+        ref->onHangup(::djinni::String::toCpp(jniEnv, j_reason),
+                      ::djinni_generated::NativeBundle::toCpp(jniEnv, j_context));
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
 }
 
@@ -34,7 +34,7 @@ private:
         ~JavaProxy();
 
         void onEvent(const std::shared_ptr<::Janus::JanusEvent> & event, const std::shared_ptr<::Janus::Bundle> & context) override;
-        void onHangup(const std::string & reason) override;
+        void onHangup(const std::string & reason, const std::shared_ptr<::Janus::Bundle> & context) override;
         void onClose() override;
         void command(const std::string & command, const std::shared_ptr<::Janus::Bundle> & payload) override;
         void onOffer(const std::string & sdp, const std::shared_ptr<::Janus::Bundle> & context) override;
@@ -46,7 +46,7 @@ private:
 
     const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("com/github/helloiampau/janus/generated/Plugin") };
     const jmethodID method_onEvent { ::djinni::jniGetMethodID(clazz.get(), "onEvent", "(Lcom/github/helloiampau/janus/generated/JanusEvent;Lcom/github/helloiampau/janus/generated/Bundle;)V") };
-    const jmethodID method_onHangup { ::djinni::jniGetMethodID(clazz.get(), "onHangup", "(Ljava/lang/String;)V") };
+    const jmethodID method_onHangup { ::djinni::jniGetMethodID(clazz.get(), "onHangup", "(Ljava/lang/String;Lcom/github/helloiampau/janus/generated/Bundle;)V") };
     const jmethodID method_onClose { ::djinni::jniGetMethodID(clazz.get(), "onClose", "()V") };
     const jmethodID method_command { ::djinni::jniGetMethodID(clazz.get(), "command", "(Ljava/lang/String;Lcom/github/helloiampau/janus/generated/Bundle;)V") };
     const jmethodID method_onOffer { ::djinni::jniGetMethodID(clazz.get(), "onOffer", "(Ljava/lang/String;Lcom/github/helloiampau/janus/generated/Bundle;)V") };
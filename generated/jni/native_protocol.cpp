@@ -45,6 +45,14 @@ void NativeProtocol::JavaProxy::dispatch(const std::string & c_command, const st
                            ::djinni::get(::djinni_generated::NativeBundle::fromCpp(jniEnv, c_payload)));
     ::djinni::jniExceptionCheck(jniEnv);
 }
+void NativeProtocol::JavaProxy::dispatchBatch(const std::vector<std::shared_ptr<::Janus::Bundle>> & c_payloads) {
+    auto jniEnv = ::djinni::jniGetThreadEnv();
+    ::djinni::JniLocalScope jscope(jniEnv, 10);
+    const auto& data = ::djinni::JniClass<::djinni_generated::NativeProtocol>::get();
+    jniEnv->CallVoidMethod(Handle::get().get(), data.method_dispatchBatch,
+                           ::djinni::get(::djinni::List<::djinni_generated::NativeBundle>::fromCpp(jniEnv, c_payloads)));
+    ::djinni::jniExceptionCheck(jniEnv);
+}
 void NativeProtocol::JavaProxy::hangup() {
     auto jniEnv = ::djinni::jniGetThreadEnv();
     ::djinni::JniLocalScope jscope(jniEnv, 10);
@@ -136,6 +144,15 @@ CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Protocol_000
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
 }
 
+CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Protocol_00024CppProxy_native_1dispatchBatch(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jobject j_payloads)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        const auto& ref = ::djinni::objectFromHandleAddress<::Janus::Protocol>(nativeRef);
+        ref->dispatchBatch(::djinni::List<::djinni_generated::NativeBundle>::toCpp(jniEnv, j_payloads));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
 CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_Protocol_00024CppProxy_native_1hangup(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef)
 {
     try {
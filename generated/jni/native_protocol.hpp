@@ -36,6 +36,7 @@ private:
         std::string name() override;
         void init(const std::shared_ptr<::Janus::JanusConf> & conf, const std::shared_ptr<::Janus::Platform> & platform, const std::shared_ptr<::Janus::ProtocolDelegate> & delegate) override;
         void dispatch(const std::string & command, const std::shared_ptr<::Janus::Bundle> & payload) override;
+        void dispatchBatch(const std::vector<std::shared_ptr<::Janus::Bundle>> & payloads) override;
         void hangup() override;
         void close() override;
         void onOffer(const std::string & sdp, const std::shared_ptr<::Janus::Bundle> & context) override;
@@ -51,6 +52,7 @@ private:
     const jmethodID method_name { ::djinni::jniGetMethodID(clazz.get(), "name", "()Ljava/lang/String;") };
     const jmethodID method_init { ::djinni::jniGetMethodID(clazz.get(), "init", "(Lcom/github/helloiampau/janus/generated/JanusConf;Lcom/github/helloiampau/janus/generated/Platform;Lcom/github/helloiampau/janus/generated/ProtocolDelegate;)V") };
     const jmethodID method_dispatch { ::djinni::jniGetMethodID(clazz.get(), "dispatch", "(Ljava/lang/String;Lcom/github/helloiampau/janus/generated/Bundle;)V") };
+    const jmethodID method_dispatchBatch { ::djinni::jniGetMethodID(clazz.get(), "dispatchBatch", "(Ljava/util/ArrayList;)V") };
     const jmethodID method_hangup { ::djinni::jniGetMethodID(clazz.get(), "hangup", "()V") };
     const jmethodID method_close { ::djinni::jniGetMethodID(clazz.get(), "close", "()V") };
     const jmethodID method_onOffer { ::djinni::jniGetMethodID(clazz.get(), "onOffer", "(Ljava/lang/String;Lcom/github/helloiampau/janus/generated/Bundle;)V") };
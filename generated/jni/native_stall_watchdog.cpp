@@ -0,0 +1,47 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#include "native_stall_watchdog.hpp"  // my header
+#include "Marshal.hpp"
+
+namespace djinni_generated {
+
+NativeStallWatchdog::NativeStallWatchdog() : ::djinni::JniInterface<::Janus::StallWatchdog, NativeStallWatchdog>("com/github/helloiampau/janus/generated/StallWatchdog$CppProxy") {}
+
+NativeStallWatchdog::~NativeStallWatchdog() = default;
+
+
+CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_StallWatchdog_00024CppProxy_nativeDestroy(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        delete reinterpret_cast<::djinni::CppProxyHandle<::Janus::StallWatchdog>*>(nativeRef);
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
+CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_StallWatchdog_00024CppProxy_start(JNIEnv* jniEnv, jobject /*this*/, jlong j_thresholdMs)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE0(jniEnv);
+        ::Janus::StallWatchdog::start(::djinni::I64::toCpp(jniEnv, j_thresholdMs));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
+CJNIEXPORT void JNICALL Java_com_github_helloiampau_janus_generated_StallWatchdog_00024CppProxy_stop(JNIEnv* jniEnv, jobject /*this*/)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE0(jniEnv);
+        ::Janus::StallWatchdog::stop();
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
+CJNIEXPORT jstring JNICALL Java_com_github_helloiampau_janus_generated_StallWatchdog_00024CppProxy_report(JNIEnv* jniEnv, jobject /*this*/)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE0(jniEnv);
+        auto r = ::Janus::StallWatchdog::report();
+        return ::djinni::release(::djinni::String::fromCpp(jniEnv, r));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
+}
+
+}  // namespace djinni_generated
@@ -0,0 +1,32 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+#include "djinni_support.hpp"
+#include "stall_watchdog.hpp"
+
+namespace djinni_generated {
+
+class NativeStallWatchdog final : ::djinni::JniInterface<::Janus::StallWatchdog, NativeStallWatchdog> {
+public:
+    using CppType = std::shared_ptr<::Janus::StallWatchdog>;
+    using CppOptType = std::shared_ptr<::Janus::StallWatchdog>;
+    using JniType = jobject;
+
+    using Boxed = NativeStallWatchdog;
+
+    ~NativeStallWatchdog();
+
+    static CppType toCpp(JNIEnv* jniEnv, JniType j) { return ::djinni::JniClass<NativeStallWatchdog>::get()._fromJava(jniEnv, j); }
+    static ::djinni::LocalRef<JniType> fromCppOpt(JNIEnv* jniEnv, const CppOptType& c) { return {jniEnv, ::djinni::JniClass<NativeStallWatchdog>::get()._toJava(jniEnv, c)}; }
+    static ::djinni::LocalRef<JniType> fromCpp(JNIEnv* jniEnv, const CppType& c) { return fromCppOpt(jniEnv, c); }
+
+private:
+    NativeStallWatchdog();
+    friend ::djinni::JniClass<NativeStallWatchdog>;
+    friend ::djinni::JniInterface<::Janus::StallWatchdog, NativeStallWatchdog>;
+
+};
+
+}  // namespace djinni_generated
@@ -4,6 +4,7 @@
 #include "native_video_constraints.hpp"  // my header
 #include "Marshal.hpp"
 #include "native_camera.hpp"
+#include "native_video_encoding.hpp"
 
 namespace djinni_generated {
 
@@ -17,19 +18,21 @@ auto NativeVideoConstraints::fromCpp(JNIEnv* jniEnv, const CppType& c) -> ::djin
                                                            ::djinni::get(::djinni::I32::fromCpp(jniEnv, c.width)),
                                                            ::djinni::get(::djinni::I32::fromCpp(jniEnv, c.height)),
                                                            ::djinni::get(::djinni::I32::fromCpp(jniEnv, c.fps)),
-                                                           ::djinni::get(::djinni_generated::NativeCamera::fromCpp(jniEnv, c.camera)))};
+                                                           ::djinni::get(::djinni_generated::NativeCamera::fromCpp(jniEnv, c.camera)),
+                                                           ::djinni::get(::djinni::List<::djinni_generated::NativeVideoEncoding>::fromCpp(jniEnv, c.encodings)))};
     ::djinni::jniExceptionCheck(jniEnv);
     return r;
 }
 
 auto NativeVideoConstraints::toCpp(JNIEnv* jniEnv, JniType j) -> CppType {
-    ::djinni::JniLocalScope jscope(jniEnv, 5);
+    ::djinni::JniLocalScope jscope(jniEnv, 6);
     assert(j != nullptr);
     const auto& data = ::djinni::JniClass<NativeVideoConstraints>::get();
     return {::djinni::I32::toCpp(jniEnv, jniEnv->GetIntField(j, data.field_width)),
             ::djinni::I32::toCpp(jniEnv, jniEnv->GetIntField(j, data.field_height)),
             ::djinni::I32::toCpp(jniEnv, jniEnv->GetIntField(j, data.field_fps)),
-            ::djinni_generated::NativeCamera::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_camera))};
+            ::djinni_generated::NativeCamera::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_camera)),
+            ::djinni::List<::djinni_generated::NativeVideoEncoding>::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_encodings))};
 }
 
 }  // namespace djinni_generated
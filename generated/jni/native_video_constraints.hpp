@@ -25,11 +25,12 @@ private:
     friend ::djinni::JniClass<NativeVideoConstraints>;
 
     const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("com/github/helloiampau/janus/generated/VideoConstraints") };
-    const jmethodID jconstructor { ::djinni::jniGetMethodID(clazz.get(), "<init>", "(IIILcom/github/helloiampau/janus/generated/Camera;)V") };
+    const jmethodID jconstructor { ::djinni::jniGetMethodID(clazz.get(), "<init>", "(IIILcom/github/helloiampau/janus/generated/Camera;Ljava/util/ArrayList;)V") };
     const jfieldID field_width { ::djinni::jniGetFieldID(clazz.get(), "width", "I") };
     const jfieldID field_height { ::djinni::jniGetFieldID(clazz.get(), "height", "I") };
     const jfieldID field_fps { ::djinni::jniGetFieldID(clazz.get(), "fps", "I") };
     const jfieldID field_camera { ::djinni::jniGetFieldID(clazz.get(), "camera", "Lcom/github/helloiampau/janus/generated/Camera;") };
+    const jfieldID field_encodings { ::djinni::jniGetFieldID(clazz.get(), "encodings", "Ljava/util/ArrayList;") };
 };
 
 }  // namespace djinni_generated
@@ -0,0 +1,34 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#include "native_video_encoding.hpp"  // my header
+#include "Marshal.hpp"
+
+namespace djinni_generated {
+
+NativeVideoEncoding::NativeVideoEncoding() = default;
+
+NativeVideoEncoding::~NativeVideoEncoding() = default;
+
+auto NativeVideoEncoding::fromCpp(JNIEnv* jniEnv, const CppType& c) -> ::djinni::LocalRef<JniType> {
+    const auto& data = ::djinni::JniClass<NativeVideoEncoding>::get();
+    auto r = ::djinni::LocalRef<JniType>{jniEnv->NewObject(data.clazz.get(), data.jconstructor,
+                                                           ::djinni::get(::djinni::String::fromCpp(jniEnv, c.rid)),
+                                                           ::djinni::get(::djinni::F64::fromCpp(jniEnv, c.scale_down)),
+                                                           ::djinni::get(::djinni::I32::fromCpp(jniEnv, c.max_bitrate)),
+                                                           ::djinni::get(::djinni::I32::fromCpp(jniEnv, c.max_fps)))};
+    ::djinni::jniExceptionCheck(jniEnv);
+    return r;
+}
+
+auto NativeVideoEncoding::toCpp(JNIEnv* jniEnv, JniType j) -> CppType {
+    ::djinni::JniLocalScope jscope(jniEnv, 5);
+    assert(j != nullptr);
+    const auto& data = ::djinni::JniClass<NativeVideoEncoding>::get();
+    return {::djinni::String::toCpp(jniEnv, (jstring)jniEnv->GetObjectField(j, data.field_rid)),
+            ::djinni::F64::toCpp(jniEnv, jniEnv->GetDoubleField(j, data.field_scaleDown)),
+            ::djinni::I32::toCpp(jniEnv, jniEnv->GetIntField(j, data.field_maxBitrate)),
+            ::djinni::I32::toCpp(jniEnv, jniEnv->GetIntField(j, data.field_maxFps))};
+}
+
+}  // namespace djinni_generated
@@ -0,0 +1,35 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#pragma once
+
+#include "djinni_support.hpp"
+#include "video_encoding.hpp"
+
+namespace djinni_generated {
+
+class NativeVideoEncoding final {
+public:
+    using CppType = ::Janus::VideoEncoding;
+    using JniType = jobject;
+
+    using Boxed = NativeVideoEncoding;
+
+    ~NativeVideoEncoding();
+
+    static CppType toCpp(JNIEnv* jniEnv, JniType j);
+    static ::djinni::LocalRef<JniType> fromCpp(JNIEnv* jniEnv, const CppType& c);
+
+private:
+    NativeVideoEncoding();
+    friend ::djinni::JniClass<NativeVideoEncoding>;
+
+    const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("com/github/helloiampau/janus/generated/VideoEncoding") };
+    const jmethodID jconstructor { ::djinni::jniGetMethodID(clazz.get(), "<init>", "(Ljava/lang/String;DII)V") };
+    const jfieldID field_rid { ::djinni::jniGetFieldID(clazz.get(), "rid", "Ljava/lang/String;") };
+    const jfieldID field_scaleDown { ::djinni::jniGetFieldID(clazz.get(), "scaleDown", "D") };
+    const jfieldID field_maxBitrate { ::djinni::jniGetFieldID(clazz.get(), "maxBitrate", "I") };
+    const jfieldID field_maxFps { ::djinni::jniGetFieldID(clazz.get(), "maxFps", "I") };
+};
+
+}  // namespace djinni_generated
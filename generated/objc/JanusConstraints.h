@@ -7,12 +7,16 @@
 
 @interface JanusConstraints : NSObject
 - (nonnull instancetype)initWithSdp:(nonnull JanusSdpConstraints *)sdp
-                              video:(nonnull JanusVideoConstraints *)video;
+                              video:(nonnull JanusVideoConstraints *)video
+               iceCandidatePoolSize:(int32_t)iceCandidatePoolSize;
 + (nonnull instancetype)constraintsWithSdp:(nonnull JanusSdpConstraints *)sdp
-                                     video:(nonnull JanusVideoConstraints *)video;
+                                     video:(nonnull JanusVideoConstraints *)video
+                      iceCandidatePoolSize:(int32_t)iceCandidatePoolSize;
 
 @property (nonatomic, readonly, nonnull) JanusSdpConstraints * sdp;
 
 @property (nonatomic, readonly, nonnull) JanusVideoConstraints * video;
 
+@property (nonatomic, readonly) int32_t iceCandidatePoolSize;
+
 @end
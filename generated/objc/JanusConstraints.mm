@@ -8,24 +8,28 @@
 
 - (nonnull instancetype)initWithSdp:(nonnull JanusSdpConstraints *)sdp
                               video:(nonnull JanusVideoConstraints *)video
+               iceCandidatePoolSize:(int32_t)iceCandidatePoolSize
 {
     if (self = [super init]) {
         _sdp = sdp;
         _video = video;
+        _iceCandidatePoolSize = iceCandidatePoolSize;
     }
     return self;
 }
 
 + (nonnull instancetype)constraintsWithSdp:(nonnull JanusSdpConstraints *)sdp
                                      video:(nonnull JanusVideoConstraints *)video
+                      iceCandidatePoolSize:(int32_t)iceCandidatePoolSize
 {
     return [[self alloc] initWithSdp:sdp
-                               video:video];
+                               video:video
+                iceCandidatePoolSize:iceCandidatePoolSize];
 }
 
 - (NSString *)description
 {
-    return [NSString stringWithFormat:@"<%@ %p sdp:%@ video:%@>", self.class, (void *)self, self.sdp, self.video];
+    return [NSString stringWithFormat:@"<%@ %p sdp:%@ video:%@ iceCandidatePoolSize:%@>", self.class, (void *)self, self.sdp, self.video, @(self.iceCandidatePoolSize)];
 }
 
 @end
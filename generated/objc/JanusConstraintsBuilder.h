@@ -25,6 +25,13 @@
                                      height:(int32_t)height
                                         fps:(int32_t)fps;
 
+- (nullable JanusConstraintsBuilder *)encoding:(nonnull NSString *)rid
+                                     scaleDown:(double)scaleDown
+                                    maxBitrate:(int32_t)maxBitrate
+                                        maxFps:(int32_t)maxFps;
+
+- (nullable JanusConstraintsBuilder *)iceCandidatePool:(int32_t)size;
+
 - (nullable JanusConstraintsBuilder *)sendOnly;
 
 - (nullable JanusConstraintsBuilder *)receiveOnly;
@@ -20,6 +20,8 @@
 - (void)dispatch:(nonnull NSString *)command
          payload:(nullable JanusBundle *)payload;
 
+- (void)dispatchBatch:(nonnull NSArray<JanusBundle *> *)payloads;
+
 + (nullable JanusJanus *)create:(nullable id<JanusJanusConf>)conf
                        platform:(nullable JanusPlatform *)platform
                        delegate:(nullable id<JanusProtocolDelegate>)delegate;
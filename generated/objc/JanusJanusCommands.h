@@ -21,9 +21,21 @@ extern NSString * __nonnull const JanusJanusCommandsSTART;
 extern NSString * __nonnull const JanusJanusCommandsPAUSE;
 extern NSString * __nonnull const JanusJanusCommandsSTOP;
 extern NSString * __nonnull const JanusJanusCommandsJOIN;
+extern NSString * __nonnull const JanusJanusCommandsPARTICIPANTS;
+extern NSString * __nonnull const JanusJanusCommandsVIEWPORT;
+extern NSString * __nonnull const JanusJanusCommandsSPEAKERS;
+extern NSString * __nonnull const JanusJanusCommandsLAYERS;
+extern NSString * __nonnull const JanusJanusCommandsLAYERPOLICY;
+extern NSString * __nonnull const JanusJanusCommandsSWITCH;
+extern NSString * __nonnull const JanusJanusCommandsJOINANDPUBLISH;
+extern NSString * __nonnull const JanusJanusCommandsPEERPOOL;
+extern NSString * __nonnull const JanusJanusCommandsPREPARE;
+extern NSString * __nonnull const JanusJanusCommandsCANDIDATEFILTER;
+extern NSString * __nonnull const JanusJanusCommandsSDPTRANSFORM;
 extern NSString * __nonnull const JanusJanusCommandsATTACH;
 extern NSString * __nonnull const JanusJanusCommandsCREATE;
 extern NSString * __nonnull const JanusJanusCommandsDESTROY;
 extern NSString * __nonnull const JanusJanusCommandsTRICKLE;
 extern NSString * __nonnull const JanusJanusCommandsTRICKLECOMPLETED;
 extern NSString * __nonnull const JanusJanusCommandsHANGUP;
+extern NSString * __nonnull const JanusJanusCommandsDETACH;
@@ -28,6 +28,28 @@ NSString * __nonnull const JanusJanusCommandsSTOP = @"uSYwffonCO";
 
 NSString * __nonnull const JanusJanusCommandsJOIN = @"YleGo5pJm9";
 
+NSString * __nonnull const JanusJanusCommandsPARTICIPANTS = @"fFS7B38sc3";
+
+NSString * __nonnull const JanusJanusCommandsVIEWPORT = @"2U2fhimrgT";
+
+NSString * __nonnull const JanusJanusCommandsSPEAKERS = @"j5grvop2Gj";
+
+NSString * __nonnull const JanusJanusCommandsLAYERS = @"up2rI0WIR9";
+
+NSString * __nonnull const JanusJanusCommandsLAYERPOLICY = @"aoN2faOcMk";
+
+NSString * __nonnull const JanusJanusCommandsSWITCH = @"jfMFlw22MA";
+
+NSString * __nonnull const JanusJanusCommandsJOINANDPUBLISH = @"8gtHQWRfdR";
+
+NSString * __nonnull const JanusJanusCommandsPEERPOOL = @"03WbhoKbxd";
+
+NSString * __nonnull const JanusJanusCommandsPREPARE = @"Cju6uykvrB";
+
+NSString * __nonnull const JanusJanusCommandsCANDIDATEFILTER = @"Kf8QDH2DNH";
+
+NSString * __nonnull const JanusJanusCommandsSDPTRANSFORM = @"B4KT7SFS4O";
+
 NSString * __nonnull const JanusJanusCommandsATTACH = @"attach";
 
 NSString * __nonnull const JanusJanusCommandsCREATE = @"create";
@@ -40,6 +62,8 @@ NSString * __nonnull const JanusJanusCommandsTRICKLECOMPLETED = @"trickle_comple
 
 NSString * __nonnull const JanusJanusCommandsHANGUP = @"hangup";
 
+NSString * __nonnull const JanusJanusCommandsDETACH = @"detach";
+
 @implementation JanusJanusCommands
 
 - (nonnull instancetype)init
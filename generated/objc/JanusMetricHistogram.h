@@ -0,0 +1,44 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import <Foundation/Foundation.h>
+
+@interface JanusMetricHistogram : NSObject
+- (nonnull instancetype)initWithName:(nonnull NSString *)name
+                               count:(int64_t)count
+                                 min:(int64_t)min
+                                 max:(int64_t)max
+                                mean:(double)mean
+                                 p50:(int64_t)p50
+                                 p90:(int64_t)p90
+                                 p99:(int64_t)p99
+                                p999:(int64_t)p999;
++ (nonnull instancetype)metricHistogramWithName:(nonnull NSString *)name
+                                          count:(int64_t)count
+                                            min:(int64_t)min
+                                            max:(int64_t)max
+                                           mean:(double)mean
+                                            p50:(int64_t)p50
+                                            p90:(int64_t)p90
+                                            p99:(int64_t)p99
+                                           p999:(int64_t)p999;
+
+@property (nonatomic, readonly, nonnull) NSString * name;
+
+@property (nonatomic, readonly) int64_t count;
+
+@property (nonatomic, readonly) int64_t min;
+
+@property (nonatomic, readonly) int64_t max;
+
+@property (nonatomic, readonly) double mean;
+
+@property (nonatomic, readonly) int64_t p50;
+
+@property (nonatomic, readonly) int64_t p90;
+
+@property (nonatomic, readonly) int64_t p99;
+
+@property (nonatomic, readonly) int64_t p999;
+
+@end
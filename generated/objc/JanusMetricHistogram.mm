@@ -0,0 +1,59 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusMetricHistogram.h"
+
+
+@implementation JanusMetricHistogram
+
+- (nonnull instancetype)initWithName:(nonnull NSString *)name
+                               count:(int64_t)count
+                                 min:(int64_t)min
+                                 max:(int64_t)max
+                                mean:(double)mean
+                                 p50:(int64_t)p50
+                                 p90:(int64_t)p90
+                                 p99:(int64_t)p99
+                                p999:(int64_t)p999
+{
+    if (self = [super init]) {
+        _name = [name copy];
+        _count = count;
+        _min = min;
+        _max = max;
+        _mean = mean;
+        _p50 = p50;
+        _p90 = p90;
+        _p99 = p99;
+        _p999 = p999;
+    }
+    return self;
+}
+
++ (nonnull instancetype)metricHistogramWithName:(nonnull NSString *)name
+                                          count:(int64_t)count
+                                            min:(int64_t)min
+                                            max:(int64_t)max
+                                           mean:(double)mean
+                                            p50:(int64_t)p50
+                                            p90:(int64_t)p90
+                                            p99:(int64_t)p99
+                                           p999:(int64_t)p999
+{
+    return [[self alloc] initWithName:name
+                                count:count
+                                  min:min
+                                  max:max
+                                 mean:mean
+                                  p50:p50
+                                  p90:p90
+                                  p99:p99
+                                 p999:p999];
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@ %p name:%@ count:%@ min:%@ max:%@ mean:%@ p50:%@ p90:%@ p99:%@ p999:%@>", self.class, (void *)self, self.name, @(self.count), @(self.min), @(self.max), @(self.mean), @(self.p50), @(self.p90), @(self.p99), @(self.p999)];
+}
+
+@end
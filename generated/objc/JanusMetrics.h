@@ -0,0 +1,14 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import <Foundation/Foundation.h>
+@class JanusMetricsSnapshot;
+
+
+@interface JanusMetrics : NSObject
+
++ (nonnull JanusMetricsSnapshot *)snapshot;
+
++ (void)reset;
+
+@end
@@ -0,0 +1,25 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusMetricHistogram.h"
+#import <Foundation/Foundation.h>
+
+@interface JanusMetricsSnapshot : NSObject
+- (nonnull instancetype)initWithIntervalMs:(int64_t)intervalMs
+                                  counters:(nonnull NSDictionary<NSString *, NSNumber *> *)counters
+                                    gauges:(nonnull NSDictionary<NSString *, NSNumber *> *)gauges
+                                histograms:(nonnull NSArray<JanusMetricHistogram *> *)histograms;
++ (nonnull instancetype)metricsSnapshotWithIntervalMs:(int64_t)intervalMs
+                                             counters:(nonnull NSDictionary<NSString *, NSNumber *> *)counters
+                                               gauges:(nonnull NSDictionary<NSString *, NSNumber *> *)gauges
+                                           histograms:(nonnull NSArray<JanusMetricHistogram *> *)histograms;
+
+@property (nonatomic, readonly) int64_t intervalMs;
+
+@property (nonatomic, readonly, nonnull) NSDictionary<NSString *, NSNumber *> * counters;
+
+@property (nonatomic, readonly, nonnull) NSDictionary<NSString *, NSNumber *> * gauges;
+
+@property (nonatomic, readonly, nonnull) NSArray<JanusMetricHistogram *> * histograms;
+
+@end
@@ -0,0 +1,39 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusMetricsSnapshot.h"
+
+
+@implementation JanusMetricsSnapshot
+
+- (nonnull instancetype)initWithIntervalMs:(int64_t)intervalMs
+                                  counters:(nonnull NSDictionary<NSString *, NSNumber *> *)counters
+                                    gauges:(nonnull NSDictionary<NSString *, NSNumber *> *)gauges
+                                histograms:(nonnull NSArray<JanusMetricHistogram *> *)histograms
+{
+    if (self = [super init]) {
+        _intervalMs = intervalMs;
+        _counters = [counters copy];
+        _gauges = [gauges copy];
+        _histograms = [histograms copy];
+    }
+    return self;
+}
+
++ (nonnull instancetype)metricsSnapshotWithIntervalMs:(int64_t)intervalMs
+                                             counters:(nonnull NSDictionary<NSString *, NSNumber *> *)counters
+                                               gauges:(nonnull NSDictionary<NSString *, NSNumber *> *)gauges
+                                           histograms:(nonnull NSArray<JanusMetricHistogram *> *)histograms
+{
+    return [[self alloc] initWithIntervalMs:intervalMs
+                                   counters:counters
+                                     gauges:gauges
+                                 histograms:histograms];
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@ %p intervalMs:%@ counters:%@ gauges:%@ histograms:%@>", self.class, (void *)self, @(self.intervalMs), self.counters, self.gauges, self.histograms];
+}
+
+@end
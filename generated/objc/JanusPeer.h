@@ -9,6 +9,8 @@
 
 @protocol JanusPeer
 
+- (void)prepare:(nonnull JanusConstraints *)constraints;
+
 - (void)createOffer:(nonnull JanusConstraints *)constraints
             context:(nullable JanusBundle *)context;
 
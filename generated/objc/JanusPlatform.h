@@ -2,6 +2,7 @@
 // This file generated by Djinni from janus-client.djinni
 
 #import <Foundation/Foundation.h>
+@class JanusBundle;
 @class JanusPlatform;
 @protocol JanusPeerFactory;
 @protocol JanusPluginFactory;
@@ -17,6 +18,11 @@
 
 - (nullable id<JanusPeerFactory>)peerFactory;
 
+- (int32_t)drainCallbacks:(int64_t)timeoutMs;
+
 + (nullable JanusPlatform *)create:(nullable id<JanusPeerFactory>)factory;
 
++ (nullable JanusPlatform *)createWith:(nullable id<JanusPeerFactory>)factory
+                               options:(nullable JanusBundle *)options;
+
 @end
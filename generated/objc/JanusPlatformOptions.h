@@ -0,0 +1,16 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import <Foundation/Foundation.h>
+
+@interface JanusPlatformOptions : NSObject
+- (nonnull instancetype)init;
++ (nonnull instancetype)platformOptions;
+
+@end
+
+extern NSString * __nonnull const JanusPlatformOptionsTRACE;
+extern NSString * __nonnull const JanusPlatformOptionsCALLBACKS;
+extern NSString * __nonnull const JanusPlatformOptionsCALLBACKSTHREAD;
+extern NSString * __nonnull const JanusPlatformOptionsCALLBACKSTRANSPORT;
+extern NSString * __nonnull const JanusPlatformOptionsCALLBACKSQUEUE;
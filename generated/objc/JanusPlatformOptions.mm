@@ -0,0 +1,36 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusPlatformOptions.h"
+
+
+NSString * __nonnull const JanusPlatformOptionsTRACE = @"trace";
+
+NSString * __nonnull const JanusPlatformOptionsCALLBACKS = @"callbacks";
+
+NSString * __nonnull const JanusPlatformOptionsCALLBACKSTHREAD = @"thread";
+
+NSString * __nonnull const JanusPlatformOptionsCALLBACKSTRANSPORT = @"transport";
+
+NSString * __nonnull const JanusPlatformOptionsCALLBACKSQUEUE = @"queue";
+
+@implementation JanusPlatformOptions
+
+- (nonnull instancetype)init
+{
+    if (self = [super init]) {
+    }
+    return self;
+}
+
++ (nonnull instancetype)platformOptions
+{
+    return [[self alloc] init];
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@ %p>", self.class, (void *)self];
+}
+
+@end
@@ -11,7 +11,8 @@
 - (void)onEvent:(nullable JanusJanusEvent *)event
         context:(nullable JanusBundle *)context;
 
-- (void)onHangup:(nonnull NSString *)reason;
+- (void)onHangup:(nonnull NSString *)reason
+         context:(nullable JanusBundle *)context;
 
 - (void)onClose;
 
@@ -19,6 +19,8 @@
 - (void)dispatch:(nonnull NSString *)command
          payload:(nullable JanusBundle *)payload;
 
+- (void)dispatchBatch:(nonnull NSArray<JanusBundle *> *)payloads;
+
 - (void)hangup;
 
 - (void)close;
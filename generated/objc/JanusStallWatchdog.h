@@ -0,0 +1,15 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import <Foundation/Foundation.h>
+
+
+@interface JanusStallWatchdog : NSObject
+
++ (void)start:(int64_t)thresholdMs;
+
++ (void)stop;
+
++ (nonnull NSString *)report;
+
+@end
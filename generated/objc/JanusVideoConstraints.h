@@ -2,17 +2,20 @@
 // This file generated by Djinni from janus-client.djinni
 
 #import "JanusCamera.h"
+#import "JanusVideoEncoding.h"
 #import <Foundation/Foundation.h>
 
 @interface JanusVideoConstraints : NSObject
 - (nonnull instancetype)initWithWidth:(int32_t)width
                                height:(int32_t)height
                                   fps:(int32_t)fps
-                               camera:(JanusCamera)camera;
+                               camera:(JanusCamera)camera
+                            encodings:(nonnull NSArray<JanusVideoEncoding *> *)encodings;
 + (nonnull instancetype)videoConstraintsWithWidth:(int32_t)width
                                            height:(int32_t)height
                                               fps:(int32_t)fps
-                                           camera:(JanusCamera)camera;
+                                           camera:(JanusCamera)camera
+                                        encodings:(nonnull NSArray<JanusVideoEncoding *> *)encodings;
 
 @property (nonatomic, readonly) int32_t width;
 
@@ -22,4 +25,6 @@
 
 @property (nonatomic, readonly) JanusCamera camera;
 
+@property (nonatomic, readonly, nonnull) NSArray<JanusVideoEncoding *> * encodings;
+
 @end
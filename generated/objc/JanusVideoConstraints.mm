@@ -10,12 +10,14 @@
                                height:(int32_t)height
                                   fps:(int32_t)fps
                                camera:(JanusCamera)camera
+                            encodings:(nonnull NSArray<JanusVideoEncoding *> *)encodings
 {
     if (self = [super init]) {
         _width = width;
         _height = height;
         _fps = fps;
         _camera = camera;
+        _encodings = [encodings copy];
     }
     return self;
 }
@@ -24,16 +26,18 @@
                                            height:(int32_t)height
                                               fps:(int32_t)fps
                                            camera:(JanusCamera)camera
+                                        encodings:(nonnull NSArray<JanusVideoEncoding *> *)encodings
 {
     return [[self alloc] initWithWidth:width
                                 height:height
                                    fps:fps
-                                camera:camera];
+                                camera:camera
+                             encodings:encodings];
 }
 
 - (NSString *)description
 {
-    return [NSString stringWithFormat:@"<%@ %p width:%@ height:%@ fps:%@ camera:%@>", self.class, (void *)self, @(self.width), @(self.height), @(self.fps), @(self.camera)];
+    return [NSString stringWithFormat:@"<%@ %p width:%@ height:%@ fps:%@ camera:%@ encodings:%@>", self.class, (void *)self, @(self.width), @(self.height), @(self.fps), @(self.camera), self.encodings];
 }
 
 @end
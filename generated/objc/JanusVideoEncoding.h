@@ -0,0 +1,24 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import <Foundation/Foundation.h>
+
+@interface JanusVideoEncoding : NSObject
+- (nonnull instancetype)initWithRid:(nonnull NSString *)rid
+                          scaleDown:(double)scaleDown
+                         maxBitrate:(int32_t)maxBitrate
+                             maxFps:(int32_t)maxFps;
++ (nonnull instancetype)videoEncodingWithRid:(nonnull NSString *)rid
+                                   scaleDown:(double)scaleDown
+                                  maxBitrate:(int32_t)maxBitrate
+                                      maxFps:(int32_t)maxFps;
+
+@property (nonatomic, readonly, nonnull) NSString * rid;
+
+@property (nonatomic, readonly) double scaleDown;
+
+@property (nonatomic, readonly) int32_t maxBitrate;
+
+@property (nonatomic, readonly) int32_t maxFps;
+
+@end
@@ -0,0 +1,39 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusVideoEncoding.h"
+
+
+@implementation JanusVideoEncoding
+
+- (nonnull instancetype)initWithRid:(nonnull NSString *)rid
+                          scaleDown:(double)scaleDown
+                         maxBitrate:(int32_t)maxBitrate
+                             maxFps:(int32_t)maxFps
+{
+    if (self = [super init]) {
+        _rid = [rid copy];
+        _scaleDown = scaleDown;
+        _maxBitrate = maxBitrate;
+        _maxFps = maxFps;
+    }
+    return self;
+}
+
++ (nonnull instancetype)videoEncodingWithRid:(nonnull NSString *)rid
+                                   scaleDown:(double)scaleDown
+                                  maxBitrate:(int32_t)maxBitrate
+                                      maxFps:(int32_t)maxFps
+{
+    return [[self alloc] initWithRid:rid
+                           scaleDown:scaleDown
+                          maxBitrate:maxBitrate
+                              maxFps:maxFps];
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@ %p rid:%@ scaleDown:%@ maxBitrate:%@ maxFps:%@>", self.class, (void *)self, self.rid, @(self.scaleDown), @(self.maxBitrate), @(self.maxFps)];
+}
+
+@end
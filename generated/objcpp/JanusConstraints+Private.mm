@@ -2,6 +2,7 @@
 // This file generated by Djinni from janus-client.djinni
 
 #import "JanusConstraints+Private.h"
+#import "DJIMarshal+Private.h"
 #import "JanusSdpConstraints+Private.h"
 #import "JanusVideoConstraints+Private.h"
 #include <cassert>
@@ -12,13 +13,15 @@ auto Constraints::toCpp(ObjcType obj) -> CppType
 {
     assert(obj);
     return {::djinni_generated::SdpConstraints::toCpp(obj.sdp),
-            ::djinni_generated::VideoConstraints::toCpp(obj.video)};
+            ::djinni_generated::VideoConstraints::toCpp(obj.video),
+            ::djinni::I32::toCpp(obj.iceCandidatePoolSize)};
 }
 
 auto Constraints::fromCpp(const CppType& cpp) -> ObjcType
 {
     return [[JanusConstraints alloc] initWithSdp:(::djinni_generated::SdpConstraints::fromCpp(cpp.sdp))
-                                           video:(::djinni_generated::VideoConstraints::fromCpp(cpp.video))];
+                                           video:(::djinni_generated::VideoConstraints::fromCpp(cpp.video))
+                            iceCandidatePoolSize:(::djinni::I32::fromCpp(cpp.ice_candidate_pool_size))];
 }
 
 }  // namespace djinni_generated
@@ -85,6 +85,26 @@ static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for th
     } DJINNI_TRANSLATE_EXCEPTIONS()
 }
 
+- (nullable JanusConstraintsBuilder *)encoding:(nonnull NSString *)rid
+                                     scaleDown:(double)scaleDown
+                                    maxBitrate:(int32_t)maxBitrate
+                                        maxFps:(int32_t)maxFps {
+    try {
+        auto objcpp_result_ = _cppRefHandle.get()->encoding(::djinni::String::toCpp(rid),
+                                                            ::djinni::F64::toCpp(scaleDown),
+                                                            ::djinni::I32::toCpp(maxBitrate),
+                                                            ::djinni::I32::toCpp(maxFps));
+        return ::djinni_generated::ConstraintsBuilder::fromCpp(objcpp_result_);
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
+- (nullable JanusConstraintsBuilder *)iceCandidatePool:(int32_t)size {
+    try {
+        auto objcpp_result_ = _cppRefHandle.get()->ice_candidate_pool(::djinni::I32::toCpp(size));
+        return ::djinni_generated::ConstraintsBuilder::fromCpp(objcpp_result_);
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
 - (nullable JanusConstraintsBuilder *)sendOnly {
     try {
         auto objcpp_result_ = _cppRefHandle.get()->send_only();
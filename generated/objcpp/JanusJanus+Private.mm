@@ -60,6 +60,12 @@ static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for th
     } DJINNI_TRANSLATE_EXCEPTIONS()
 }
 
+- (void)dispatchBatch:(nonnull NSArray<JanusBundle *> *)payloads {
+    try {
+        _cppRefHandle.get()->dispatchBatch(::djinni::List<::djinni_generated::Bundle>::toCpp(payloads));
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
 + (nullable JanusJanus *)create:(nullable id<JanusJanusConf>)conf
                        platform:(nullable JanusPlatform *)platform
                        delegate:(nullable id<JanusProtocolDelegate>)delegate {
@@ -0,0 +1,24 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusMetricHistogram.h"
+#include "metric_histogram.hpp"
+
+static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for this file");
+
+@class JanusMetricHistogram;
+
+namespace djinni_generated {
+
+struct MetricHistogram
+{
+    using CppType = ::Janus::MetricHistogram;
+    using ObjcType = JanusMetricHistogram*;
+
+    using Boxed = MetricHistogram;
+
+    static CppType toCpp(ObjcType objc);
+    static ObjcType fromCpp(const CppType& cpp);
+};
+
+}  // namespace djinni_generated
@@ -0,0 +1,37 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusMetricHistogram+Private.h"
+#import "DJIMarshal+Private.h"
+#include <cassert>
+
+namespace djinni_generated {
+
+auto MetricHistogram::toCpp(ObjcType obj) -> CppType
+{
+    assert(obj);
+    return {::djinni::String::toCpp(obj.name),
+            ::djinni::I64::toCpp(obj.count),
+            ::djinni::I64::toCpp(obj.min),
+            ::djinni::I64::toCpp(obj.max),
+            ::djinni::F64::toCpp(obj.mean),
+            ::djinni::I64::toCpp(obj.p50),
+            ::djinni::I64::toCpp(obj.p90),
+            ::djinni::I64::toCpp(obj.p99),
+            ::djinni::I64::toCpp(obj.p999)};
+}
+
+auto MetricHistogram::fromCpp(const CppType& cpp) -> ObjcType
+{
+    return [[JanusMetricHistogram alloc] initWithName:(::djinni::String::fromCpp(cpp.name))
+                                                count:(::djinni::I64::fromCpp(cpp.count))
+                                                  min:(::djinni::I64::fromCpp(cpp.min))
+                                                  max:(::djinni::I64::fromCpp(cpp.max))
+                                                 mean:(::djinni::F64::fromCpp(cpp.mean))
+                                                  p50:(::djinni::I64::fromCpp(cpp.p50))
+                                                  p90:(::djinni::I64::fromCpp(cpp.p90))
+                                                  p99:(::djinni::I64::fromCpp(cpp.p99))
+                                                 p999:(::djinni::I64::fromCpp(cpp.p999))];
+}
+
+}  // namespace djinni_generated
@@ -0,0 +1,31 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#include "metrics.hpp"
+#include <memory>
+
+static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for this file");
+
+@class JanusMetrics;
+
+namespace djinni_generated {
+
+class Metrics
+{
+public:
+    using CppType = std::shared_ptr<::Janus::Metrics>;
+    using CppOptType = std::shared_ptr<::Janus::Metrics>;
+    using ObjcType = JanusMetrics*;
+
+    using Boxed = Metrics;
+
+    static CppType toCpp(ObjcType objc);
+    static ObjcType fromCppOpt(const CppOptType& cpp);
+    static ObjcType fromCpp(const CppType& cpp) { return fromCppOpt(cpp); }
+
+private:
+    class ObjcProxy;
+};
+
+}  // namespace djinni_generated
+
@@ -0,0 +1,66 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusMetrics+Private.h"
+#import "JanusMetrics.h"
+#import "DJICppWrapperCache+Private.h"
+#import "DJIError.h"
+#import "JanusMetricsSnapshot+Private.h"
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for this file");
+
+@interface JanusMetrics ()
+
+- (id)initWithCpp:(const std::shared_ptr<::Janus::Metrics>&)cppRef;
+
+@end
+
+@implementation JanusMetrics {
+    ::djinni::CppProxyCache::Handle<std::shared_ptr<::Janus::Metrics>> _cppRefHandle;
+}
+
+- (id)initWithCpp:(const std::shared_ptr<::Janus::Metrics>&)cppRef
+{
+    if (self = [super init]) {
+        _cppRefHandle.assign(cppRef);
+    }
+    return self;
+}
+
++ (nonnull JanusMetricsSnapshot *)snapshot {
+    try {
+        auto objcpp_result_ = ::Janus::Metrics::snapshot();
+        return ::djinni_generated::MetricsSnapshot::fromCpp(objcpp_result_);
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
++ (void)reset {
+    try {
+        ::Janus::Metrics::reset();
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
+namespace djinni_generated {
+
+auto Metrics::toCpp(ObjcType objc) -> CppType
+{
+    if (!objc) {
+        return nullptr;
+    }
+    return objc->_cppRefHandle.get();
+}
+
+auto Metrics::fromCppOpt(const CppOptType& cpp) -> ObjcType
+{
+    if (!cpp) {
+        return nil;
+    }
+    return ::djinni::get_cpp_proxy<JanusMetrics>(cpp);
+}
+
+}  // namespace djinni_generated
+
+@end
@@ -0,0 +1,24 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusMetricsSnapshot.h"
+#include "metrics_snapshot.hpp"
+
+static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for this file");
+
+@class JanusMetricsSnapshot;
+
+namespace djinni_generated {
+
+struct MetricsSnapshot
+{
+    using CppType = ::Janus::MetricsSnapshot;
+    using ObjcType = JanusMetricsSnapshot*;
+
+    using Boxed = MetricsSnapshot;
+
+    static CppType toCpp(ObjcType objc);
+    static ObjcType fromCpp(const CppType& cpp);
+};
+
+}  // namespace djinni_generated
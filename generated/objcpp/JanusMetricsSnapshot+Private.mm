@@ -0,0 +1,28 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusMetricsSnapshot+Private.h"
+#import "DJIMarshal+Private.h"
+#import "JanusMetricHistogram+Private.h"
+#include <cassert>
+
+namespace djinni_generated {
+
+auto MetricsSnapshot::toCpp(ObjcType obj) -> CppType
+{
+    assert(obj);
+    return {::djinni::I64::toCpp(obj.intervalMs),
+            ::djinni::Map<::djinni::String, ::djinni::I64>::toCpp(obj.counters),
+            ::djinni::Map<::djinni::String, ::djinni::I64>::toCpp(obj.gauges),
+            ::djinni::List<::djinni_generated::MetricHistogram>::toCpp(obj.histograms)};
+}
+
+auto MetricsSnapshot::fromCpp(const CppType& cpp) -> ObjcType
+{
+    return [[JanusMetricsSnapshot alloc] initWithIntervalMs:(::djinni::I64::fromCpp(cpp.interval_ms))
+                                                   counters:(::djinni::Map<::djinni::String, ::djinni::I64>::fromCpp(cpp.counters))
+                                                     gauges:(::djinni::Map<::djinni::String, ::djinni::I64>::fromCpp(cpp.gauges))
+                                                 histograms:(::djinni::List<::djinni_generated::MetricHistogram>::fromCpp(cpp.histograms))];
+}
+
+}  // namespace djinni_generated
@@ -34,6 +34,12 @@ static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for th
     return self;
 }
 
+- (void)prepare:(nonnull JanusConstraints *)constraints {
+    try {
+        _cppRefHandle.get()->prepare(::djinni_generated::Constraints::toCpp(constraints));
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
 - (void)createOffer:(nonnull JanusConstraints *)constraints
             context:(nullable JanusBundle *)context {
     try {
@@ -91,6 +97,12 @@ class Peer::ObjcProxy final
     friend class ::djinni_generated::Peer;
 public:
     using ObjcProxyBase::ObjcProxyBase;
+    void prepare(const ::Janus::Constraints & c_constraints) override
+    {
+        @autoreleasepool {
+            [djinni_private_get_proxied_objc_object() prepare:(::djinni_generated::Constraints::fromCpp(c_constraints))];
+        }
+    }
     void createOffer(const ::Janus::Constraints & c_constraints, const std::shared_ptr<::Janus::Bundle> & c_context) override
     {
         @autoreleasepool {
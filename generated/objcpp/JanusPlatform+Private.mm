@@ -6,6 +6,7 @@
 #import "DJICppWrapperCache+Private.h"
 #import "DJIError.h"
 #import "DJIMarshal+Private.h"
+#import "JanusBundle+Private.h"
 #import "JanusPeerFactory+Private.h"
 #import "JanusPluginFactory+Private.h"
 #import "JanusProtocol+Private.h"
@@ -54,6 +55,13 @@ static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for th
     } DJINNI_TRANSLATE_EXCEPTIONS()
 }
 
+- (int32_t)drainCallbacks:(int64_t)timeoutMs {
+    try {
+        auto objcpp_result_ = _cppRefHandle.get()->drainCallbacks(::djinni::I64::toCpp(timeoutMs));
+        return ::djinni::I32::fromCpp(objcpp_result_);
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
 + (nullable JanusPlatform *)create:(nullable id<JanusPeerFactory>)factory {
     try {
         auto objcpp_result_ = ::Janus::Platform::create(::djinni_generated::PeerFactory::toCpp(factory));
@@ -61,6 +69,15 @@ static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for th
     } DJINNI_TRANSLATE_EXCEPTIONS()
 }
 
++ (nullable JanusPlatform *)createWith:(nullable id<JanusPeerFactory>)factory
+                               options:(nullable JanusBundle *)options {
+    try {
+        auto objcpp_result_ = ::Janus::Platform::createWith(::djinni_generated::PeerFactory::toCpp(factory),
+                                                            ::djinni_generated::Bundle::toCpp(options));
+        return ::djinni_generated::Platform::fromCpp(objcpp_result_);
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
 namespace djinni_generated {
 
 auto Platform::toCpp(ObjcType objc) -> CppType
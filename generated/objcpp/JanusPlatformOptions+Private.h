@@ -0,0 +1,24 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusPlatformOptions.h"
+#include "platform_options.hpp"
+
+static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for this file");
+
+@class JanusPlatformOptions;
+
+namespace djinni_generated {
+
+struct PlatformOptions
+{
+    using CppType = ::Janus::PlatformOptions;
+    using ObjcType = JanusPlatformOptions*;
+
+    using Boxed = PlatformOptions;
+
+    static CppType toCpp(ObjcType objc);
+    static ObjcType fromCpp(const CppType& cpp);
+};
+
+}  // namespace djinni_generated
@@ -0,0 +1,23 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusPlatformOptions+Private.h"
+#import "DJIMarshal+Private.h"
+#include <cassert>
+
+namespace djinni_generated {
+
+auto PlatformOptions::toCpp(ObjcType obj) -> CppType
+{
+    assert(obj);
+    (void)obj; // Suppress warnings in relase builds for empty records
+    return {};
+}
+
+auto PlatformOptions::fromCpp(const CppType& cpp) -> ObjcType
+{
+    (void)cpp; // Suppress warnings in relase builds for empty records
+    return [[JanusPlatformOptions alloc] init];
+}
+
+}  // namespace djinni_generated
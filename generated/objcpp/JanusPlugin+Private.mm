@@ -41,9 +41,11 @@ static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for th
     } DJINNI_TRANSLATE_EXCEPTIONS()
 }
 
-- (void)onHangup:(nonnull NSString *)reason {
+- (void)onHangup:(nonnull NSString *)reason
+         context:(nullable JanusBundle *)context {
     try {
-        _cppRefHandle.get()->onHangup(::djinni::String::toCpp(reason));
+        _cppRefHandle.get()->onHangup(::djinni::String::toCpp(reason),
+                                      ::djinni_generated::Bundle::toCpp(context));
     } DJINNI_TRANSLATE_EXCEPTIONS()
 }
 
@@ -93,10 +95,11 @@ public:
                                                       context:(::djinni_generated::Bundle::fromCpp(c_context))];
         }
     }
-    void onHangup(const std::string & c_reason) override
+    void onHangup(const std::string & c_reason, const std::shared_ptr<::Janus::Bundle> & c_context) override
     {
         @autoreleasepool {
-            [djinni_private_get_proxied_objc_object() onHangup:(::djinni::String::fromCpp(c_reason))];
+            [djinni_private_get_proxied_objc_object() onHangup:(::djinni::String::fromCpp(c_reason))
+                                                       context:(::djinni_generated::Bundle::fromCpp(c_context))];
         }
     }
     void onClose() override
@@ -60,6 +60,12 @@ static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for th
     } DJINNI_TRANSLATE_EXCEPTIONS()
 }
 
+- (void)dispatchBatch:(nonnull NSArray<JanusBundle *> *)payloads {
+    try {
+        _cppRefHandle.get()->dispatchBatch(::djinni::List<::djinni_generated::Bundle>::toCpp(payloads));
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
 - (void)hangup {
     try {
         _cppRefHandle.get()->hangup();
@@ -137,6 +143,12 @@ public:
                                                        payload:(::djinni_generated::Bundle::fromCpp(c_payload))];
         }
     }
+    void dispatchBatch(const std::vector<std::shared_ptr<::Janus::Bundle>> & c_payloads) override
+    {
+        @autoreleasepool {
+            [djinni_private_get_proxied_objc_object() dispatchBatch:(::djinni::List<::djinni_generated::Bundle>::fromCpp(c_payloads))];
+        }
+    }
     void hangup() override
     {
         @autoreleasepool {
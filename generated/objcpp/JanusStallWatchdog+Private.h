@@ -0,0 +1,31 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#include "stall_watchdog.hpp"
+#include <memory>
+
+static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for this file");
+
+@class JanusStallWatchdog;
+
+namespace djinni_generated {
+
+class StallWatchdog
+{
+public:
+    using CppType = std::shared_ptr<::Janus::StallWatchdog>;
+    using CppOptType = std::shared_ptr<::Janus::StallWatchdog>;
+    using ObjcType = JanusStallWatchdog*;
+
+    using Boxed = StallWatchdog;
+
+    static CppType toCpp(ObjcType objc);
+    static ObjcType fromCppOpt(const CppOptType& cpp);
+    static ObjcType fromCpp(const CppType& cpp) { return fromCppOpt(cpp); }
+
+private:
+    class ObjcProxy;
+};
+
+}  // namespace djinni_generated
+
@@ -0,0 +1,72 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusStallWatchdog+Private.h"
+#import "JanusStallWatchdog.h"
+#import "DJICppWrapperCache+Private.h"
+#import "DJIError.h"
+#import "DJIMarshal+Private.h"
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for this file");
+
+@interface JanusStallWatchdog ()
+
+- (id)initWithCpp:(const std::shared_ptr<::Janus::StallWatchdog>&)cppRef;
+
+@end
+
+@implementation JanusStallWatchdog {
+    ::djinni::CppProxyCache::Handle<std::shared_ptr<::Janus::StallWatchdog>> _cppRefHandle;
+}
+
+- (id)initWithCpp:(const std::shared_ptr<::Janus::StallWatchdog>&)cppRef
+{
+    if (self = [super init]) {
+        _cppRefHandle.assign(cppRef);
+    }
+    return self;
+}
+
++ (void)start:(int64_t)thresholdMs {
+    try {
+        ::Janus::StallWatchdog::start(::djinni::I64::toCpp(thresholdMs));
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
++ (void)stop {
+    try {
+        ::Janus::StallWatchdog::stop();
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
++ (nonnull NSString *)report {
+    try {
+        auto objcpp_result_ = ::Janus::StallWatchdog::report();
+        return ::djinni::String::fromCpp(objcpp_result_);
+    } DJINNI_TRANSLATE_EXCEPTIONS()
+}
+
+namespace djinni_generated {
+
+auto StallWatchdog::toCpp(ObjcType objc) -> CppType
+{
+    if (!objc) {
+        return nullptr;
+    }
+    return objc->_cppRefHandle.get();
+}
+
+auto StallWatchdog::fromCppOpt(const CppOptType& cpp) -> ObjcType
+{
+    if (!cpp) {
+        return nil;
+    }
+    return ::djinni::get_cpp_proxy<JanusStallWatchdog>(cpp);
+}
+
+}  // namespace djinni_generated
+
+@end
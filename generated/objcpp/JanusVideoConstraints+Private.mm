@@ -4,6 +4,7 @@
 #import "JanusVideoConstraints+Private.h"
 #import "DJIMarshal+Private.h"
 #import "JanusCamera+Private.h"
+#import "JanusVideoEncoding+Private.h"
 #include <cassert>
 
 namespace djinni_generated {
@@ -14,7 +15,8 @@ auto VideoConstraints::toCpp(ObjcType obj) -> CppType
     return {::djinni::I32::toCpp(obj.width),
             ::djinni::I32::toCpp(obj.height),
             ::djinni::I32::toCpp(obj.fps),
-            ::djinni::Enum<::Janus::Camera, JanusCamera>::toCpp(obj.camera)};
+            ::djinni::Enum<::Janus::Camera, JanusCamera>::toCpp(obj.camera),
+            ::djinni::List<::djinni_generated::VideoEncoding>::toCpp(obj.encodings)};
 }
 
 auto VideoConstraints::fromCpp(const CppType& cpp) -> ObjcType
@@ -22,7 +24,8 @@ auto VideoConstraints::fromCpp(const CppType& cpp) -> ObjcType
     return [[JanusVideoConstraints alloc] initWithWidth:(::djinni::I32::fromCpp(cpp.width))
                                                  height:(::djinni::I32::fromCpp(cpp.height))
                                                     fps:(::djinni::I32::fromCpp(cpp.fps))
-                                                 camera:(::djinni::Enum<::Janus::Camera, JanusCamera>::fromCpp(cpp.camera))];
+                                                 camera:(::djinni::Enum<::Janus::Camera, JanusCamera>::fromCpp(cpp.camera))
+                                              encodings:(::djinni::List<::djinni_generated::VideoEncoding>::fromCpp(cpp.encodings))];
 }
 
 }  // namespace djinni_generated
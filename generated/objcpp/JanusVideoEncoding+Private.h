@@ -0,0 +1,24 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusVideoEncoding.h"
+#include "video_encoding.hpp"
+
+static_assert(__has_feature(objc_arc), "Djinni requires ARC to be enabled for this file");
+
+@class JanusVideoEncoding;
+
+namespace djinni_generated {
+
+struct VideoEncoding
+{
+    using CppType = ::Janus::VideoEncoding;
+    using ObjcType = JanusVideoEncoding*;
+
+    using Boxed = VideoEncoding;
+
+    static CppType toCpp(ObjcType objc);
+    static ObjcType fromCpp(const CppType& cpp);
+};
+
+}  // namespace djinni_generated
@@ -0,0 +1,27 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from janus-client.djinni
+
+#import "JanusVideoEncoding+Private.h"
+#import "DJIMarshal+Private.h"
+#include <cassert>
+
+namespace djinni_generated {
+
+auto VideoEncoding::toCpp(ObjcType obj) -> CppType
+{
+    assert(obj);
+    return {::djinni::String::toCpp(obj.rid),
+            ::djinni::F64::toCpp(obj.scaleDown),
+            ::djinni::I32::toCpp(obj.maxBitrate),
+            ::djinni::I32::toCpp(obj.maxFps)};
+}
+
+auto VideoEncoding::fromCpp(const CppType& cpp) -> ObjcType
+{
+    return [[JanusVideoEncoding alloc] initWithRid:(::djinni::String::fromCpp(cpp.rid))
+                                         scaleDown:(::djinni::F64::fromCpp(cpp.scale_down))
+                                        maxBitrate:(::djinni::I32::fromCpp(cpp.max_bitrate))
+                                            maxFps:(::djinni::I32::fromCpp(cpp.max_fps))];
+}
+
+}  // namespace djinni_generated
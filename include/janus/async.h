@@ -10,7 +10,10 @@
 
 #pragma once
 
+#include <chrono>
 #include <functional>
+#include <map>
+#include <memory>
 #include <queue>
 #include <mutex>
 #include <vector>
@@ -30,7 +33,7 @@ namespace Janus {
 
   class AsyncImpl : public Async {
     public:
-      AsyncImpl();
+      AsyncImpl(unsigned threads = THREAD_POOL_SIZE);
       ~AsyncImpl();
 
       void submit(Task task);
@@ -39,14 +42,65 @@ namespace Janus {
 
       static void* _loop(AsyncImpl* context);
 
-      std::queue<Task> _queue;
+      // every task with the microseconds it was queued at
+      std::queue<std::pair<Task, int64_t>> _queue;
       std::mutex _queueMutex;
       std::condition_variable _notEmpty;
 
       std::mutex _enabledMutex;
       bool _enabled = true;
 
-      std::thread _threads[THREAD_POOL_SIZE];
+      std::vector<std::thread> _threads;
+  };
+
+  // runs the task right away, on the thread that submits it
+  class InlineAsync : public Async {
+    public:
+      void submit(Task task) {
+        task();
+      }
+  };
+
+  // the tasks wait until the thread that owns the queue drains them, so they run on a thread the app picks
+  class CallbackQueue : public Async {
+    public:
+      void submit(Task task);
+
+      // runs every queued task, waiting up to timeout for the first one, and tells how many ran
+      int drain(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    private:
+      std::queue<Task> _queue;
+      std::mutex _queueMutex;
+      std::condition_variable _notEmpty;
+  };
+
+  // runs every task once its delay, in milliseconds, expired
+  class Scheduler {
+    public:
+      virtual void post(int64_t delay, const Task& task) = 0;
+  };
+
+  // a single thread sleeping until the next task is due
+  class SchedulerImpl : public Scheduler {
+    public:
+      SchedulerImpl();
+      ~SchedulerImpl();
+
+      void post(int64_t delay, const Task& task);
+
+    private:
+      // the thread owns it too, so it outlives a scheduler whose last owner went away from one of its tasks
+      struct State {
+        std::multimap<std::chrono::steady_clock::time_point, Task> pending;
+        std::mutex mutex;
+        std::condition_variable timer;
+        bool running = true;
+      };
+
+      static void _tick(std::shared_ptr<State> state);
+
+      std::shared_ptr<State> _state = std::make_shared<State>();
+      std::thread _thread;
   };
 
 }
@@ -0,0 +1,110 @@
+/*!
+ * janus-client SDK
+ *
+ * candidate_filter.h
+ * The ICE Candidate Filter
+ * This module decides which local candidates are worth a trickle, following a configurable policy.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "janus/sdp.h"
+
+#define CANDIDATE_UNLIMITED -1
+
+namespace Janus {
+
+  enum CandidateType {
+    HOST,
+    SRFLX,
+    PRFLX,
+    RELAY,
+    UNKNOWN_TYPE
+  };
+
+  enum CandidateTransport {
+    UDP,
+    TCP,
+    UNKNOWN_TRANSPORT
+  };
+
+  struct CandidateInfo {
+    int component = 0;
+    CandidateTransport transport = UNKNOWN_TRANSPORT;
+    CandidateType type = UNKNOWN_TYPE;
+    bool ipv6 = false;
+    bool linkLocal = false;
+  };
+
+  // the reasons a candidate is dropped for, in the order the pipeline checks them
+  enum CandidateDrop {
+    LINK_LOCAL,
+    NOT_RELAY,
+    TCP_TRANSPORT,
+    HOST_LIMIT,
+    RELAY_LIMIT,
+    CANDIDATE_DROPS
+  };
+
+  struct CandidatePolicy {
+    bool dropLinkLocal = false;
+    bool relayOnly = false;
+    bool dropTcp = false;
+    int maxHost = CANDIDATE_UNLIMITED;
+    int maxRelay = CANDIDATE_UNLIMITED;
+  };
+
+  struct CandidateStats {
+    int64_t accepted = 0;
+    int64_t dropped[CANDIDATE_DROPS] = {};
+
+    int64_t droppedTotal() const {
+      int64_t total = 0;
+      for(auto count : dropped) {
+        total += count;
+      }
+
+      return total;
+    }
+  };
+
+  // walks the candidate attribute in place, no token is ever copied
+  bool parseCandidate(const std::string& line, CandidateInfo& info);
+  bool parseCandidate(const char* data, size_t size, CandidateInfo& info);
+
+  class CandidateFilter {
+    public:
+      void configure(const CandidatePolicy& policy);
+
+      bool accept(int64_t handleId, const std::string& line);
+      bool accept(int64_t handleId, const SdpSlice& line);
+      // the candidates a peer put in its own description face the same policy, the description is returned as is when none is dropped
+      std::shared_ptr<SessionDescription> filter(int64_t handleId, const std::shared_ptr<SessionDescription>& description);
+      void reset(int64_t handleId);
+
+      CandidateStats stats();
+      CandidateStats stats(int64_t handleId);
+
+    private:
+      struct Gathered {
+        int host = 0;
+        int relay = 0;
+        CandidateStats stats;
+      };
+
+      bool _drop(Gathered& gathered, CandidateDrop reason);
+
+      CandidatePolicy _policy;
+      CandidateStats _stats;
+      std::unordered_map<int64_t, Gathered> _handles;
+      std::mutex _mutex;
+  };
+
+}
@@ -13,6 +13,9 @@
 #include "janus/constraints_builder.hpp"
 
 #include "janus/constraints.hpp"
+#include "janus/video_encoding.hpp"
+
+#define ICE_CANDIDATE_POOL_SIZE 0
 
 namespace Janus {
 
@@ -24,6 +27,8 @@ namespace Janus {
       std::shared_ptr<ConstraintsBuilder> receive_audio(bool enable);
       std::shared_ptr<ConstraintsBuilder> receive_video(bool enable);
       std::shared_ptr<ConstraintsBuilder> video(int32_t width, int32_t height, int32_t fps);
+      std::shared_ptr<ConstraintsBuilder> encoding(const std::string& rid, double scale_down, int32_t max_bitrate, int32_t max_fps);
+      std::shared_ptr<ConstraintsBuilder> ice_candidate_pool(int32_t size);
       std::shared_ptr<ConstraintsBuilder> camera(Camera camera);
       std::shared_ptr<ConstraintsBuilder> send_only();
       std::shared_ptr<ConstraintsBuilder> receive_only();
@@ -41,6 +46,8 @@ namespace Janus {
       int32_t _height = 720;
       int32_t _fps = 30;
       Camera _camera = Camera::FRONT;
+      std::vector<VideoEncoding> _encodings;
+      int32_t _ice_candidate_pool_size = ICE_CANDIDATE_POOL_SIZE;
   };
 
 }
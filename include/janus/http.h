@@ -45,6 +45,8 @@ namespace Janus {
       static size_t _writeFunction(void* ptr, size_t size, size_t nmemb, std::string* data);
 
       std::string _baseUrl;
+      // the curl easy handle is kept for the whole client lifetime so that keep-alive connections get reused across requests
+      void* _handle = nullptr;
   };
 
   class HttpFactory {
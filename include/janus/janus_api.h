@@ -10,15 +10,22 @@
 
 #pragma once
 
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
 #include "janus/protocol.hpp"
 
 #include "janus/transport.h"
 #include "janus/janus_conf.hpp"
 #include "janus/protocol_delegate.hpp"
+#include "janus/janus_error.hpp"
 #include "janus/random.h"
 #include "janus/platform_impl.h"
 #include "janus/plugin.hpp"
 #include "janus/janus_event_impl.h"
+#include "janus/query_cache.h"
+#include "janus/candidate_filter.h"
 
 #define JANUS_API "Janus API"
 
@@ -31,10 +38,55 @@ namespace Janus {
     CLOSING
   };
 
+  // the setup of a handle, in ms since Janus::init: every stage keeps the first time it happened. It is reported once, when the media flows
+  struct HandleTimeline {
+    std::chrono::steady_clock::time_point init = std::chrono::steady_clock::now();
+    std::unordered_map<std::string, int64_t> marks;
+    // the plugin requests, in order, the flow of the setup
+    std::vector<std::string> requests;
+    // a handle that only receives is set up on webrtcup, the others once janus gets their media
+    bool sends = true;
+    // the candidates of the first gathering, the filter starts over for the next one
+    bool gathered = false;
+    CandidateStats candidates;
+
+    void mark(const std::string& stage) {
+      marks.emplace(stage, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - init).count());
+    }
+
+    // -1 when the handle missed either stage
+    int64_t between(const std::string& from, const std::string& to) const {
+      auto start = marks.find(from);
+      auto end = marks.find(to);
+
+      return start != marks.end() && end != marks.end() ? end->second - start->second : -1;
+    }
+  };
+
+  /* Janus API message Factories */
+
+  namespace Messages {
+    nlohmann::json create(const std::string& transaction);
+    nlohmann::json attach(const std::string& transaction, const std::string& plugin);
+    nlohmann::json destroy(const std::string& transaction);
+    nlohmann::json trickle(const std::string& transaction, int64_t handleId, const std::string& sdpMid, int32_t sdpMLineIndex, const std::string& candidate);
+    nlohmann::json trickleCompleted(const std::string& transaction, int64_t handleId);
+    nlohmann::json message(const std::string& transaction, int64_t handleId, nlohmann::json body);
+    nlohmann::json hangup(const std::string& transaction, int64_t handleId);
+    nlohmann::json detach(const std::string& transaction, int64_t handleId);
+    nlohmann::json candidateFilter(const CandidateStats& stats);
+    nlohmann::json setupTiming(int64_t handleId, const HandleTimeline& timeline, const CandidateStats& candidates);
+  }
+
   class PluginCommandDelegate {
     public:
       virtual void onCommandResult(const nlohmann::json& body, const std::shared_ptr<Bundle>& context) = 0;
       virtual void onPluginEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context) = 0;
+      // a command the plugin could not carry out
+      virtual void onPluginError(const JanusError& error, const std::shared_ptr<Bundle>& context) = 0;
+      // the scope is what the reply depends on, invalidating it drops the replies cached for it
+      virtual void onQuery(const nlohmann::json& body, const std::shared_ptr<Bundle>& context, const std::string& scope) = 0;
+      virtual void invalidateQueries(const std::string& scope) = 0;
   };
 
   class JanusApi : public Protocol, public TransportDelegate, public PluginCommandDelegate, public std::enable_shared_from_this<JanusApi> {
@@ -50,6 +102,7 @@ namespace Janus {
       void close();
       void hangup();
       void dispatch(const std::string& command, const std::shared_ptr<Bundle>& payload);
+      void dispatchBatch(const std::vector<std::shared_ptr<Bundle>>& payloads);
 
       void onMessage(const nlohmann::json& message, const std::shared_ptr<Bundle>& context);
 
@@ -60,6 +113,9 @@ namespace Janus {
 
       void onCommandResult(const nlohmann::json& body, const std::shared_ptr<Bundle>& context);
       void onPluginEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context);
+      void onPluginError(const JanusError& error, const std::shared_ptr<Bundle>& context);
+      void onQuery(const nlohmann::json& body, const std::shared_ptr<Bundle>& context, const std::string& scope);
+      void invalidateQueries(const std::string& scope);
 
       int64_t handleId(const std::shared_ptr<Bundle>& context);
 
@@ -67,6 +123,14 @@ namespace Janus {
       ReadyState readyState();
       void readyState(ReadyState readyState);
 
+      void _send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context);
+      void _onQueryResult(const std::string& key, const nlohmann::json& message);
+      void _startTimeline(int64_t handleId);
+      void _mark(int64_t handleId, const std::string& stage);
+      void _described(int64_t handleId, const std::shared_ptr<SessionDescription>& description);
+      void _gathered(int64_t handleId, const CandidateStats& candidates);
+      void _reportSetup(int64_t handleId, const std::shared_ptr<Bundle>& context);
+
       int64_t _handleId = -1;
 
       std::shared_ptr<Plugin> _plugin = nullptr;
@@ -75,9 +139,16 @@ namespace Janus {
       std::shared_ptr<Transport> _transport;
       std::shared_ptr<Random> _random;
       std::shared_ptr<ProtocolDelegate> _delegate;
+      std::shared_ptr<QueryCache> _queries;
+      std::shared_ptr<CandidateFilter> _candidates;
 
       std::mutex _readyStateMutex;
       ReadyState _readyState = ReadyState::CLOSED;
+
+      // the session stages every handle timeline starts from
+      HandleTimeline _session;
+      std::mutex _timelinesMutex;
+      std::unordered_map<int64_t, HandleTimeline> _timelines;
   };
 
 }
@@ -16,6 +16,7 @@
 #include "janus/janus_data.hpp"
 #include "janus/jsep.hpp"
 #include "janus/sdp_type.hpp"
+#include "janus/sdp.h"
 
 namespace Janus {
 
@@ -26,11 +27,16 @@ namespace Janus {
       std::string sdp();
       SdpType type();
 
+      std::shared_ptr<SessionDescription> description();
+
     private:
       SdpType _type;
-      std::string _sdp;
+      std::shared_ptr<SessionDescription> _description;
   };
 
+  // the description behind a jsep, shared when janus sent it and wrapped otherwise
+  std::shared_ptr<SessionDescription> descriptionOf(const std::shared_ptr<Jsep>& jsep);
+
   class JanusDataImpl : public JanusData {
     public:
       JanusDataImpl(const nlohmann::json& body);
@@ -25,6 +25,7 @@ namespace Janus {
       void close();
       void hangup();
       void dispatch(const std::string& command, const std::shared_ptr<Bundle>& payload);
+      void dispatchBatch(const std::vector<std::shared_ptr<Bundle>>& payloads);
 
     private:
       std::shared_ptr<JanusConf> _conf;
@@ -0,0 +1,153 @@
+/*!
+ * janus-client SDK
+ *
+ * metrics_impl.h
+ * Metrics registry
+ * This module defines the counters, gauges and histograms the SDK keeps about itself and the registry behind the Metrics snapshots
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "janus/metrics.hpp"
+#include "janus/metrics_snapshot.hpp"
+
+// a histogram keeps 2^METRICS_HISTOGRAM_BITS buckets per power of two, so its percentiles are within 1/32 of the recorded values
+#define METRICS_HISTOGRAM_BITS 5
+#define METRICS_HISTOGRAM_BUCKETS ((64 - METRICS_HISTOGRAM_BITS) << METRICS_HISTOGRAM_BITS)
+
+#define METRIC_HTTP_REQUESTS "http.requests"
+#define METRIC_HTTP_LONG_POLLS "http.long_polls"
+#define METRIC_HTTP_BYTES_OUT "http.bytes_out"
+#define METRIC_HTTP_BYTES_IN "http.bytes_in"
+#define METRIC_HTTP_ERRORS "http.errors"
+#define METRIC_HTTP_POOL_WAITS "http.pool_waits"
+#define METRIC_HTTP_REQUEST_US "http.request_us"
+#define METRIC_HTTP_LONG_POLL_US "http.long_poll_us"
+#define METRIC_HTTP_POOL_WAIT_US "http.pool_wait_us"
+// how long a reply waited for the callback executor
+#define METRIC_HTTP_CALLBACK_QUEUE_US "http.callback_queue_us"
+
+#define METRIC_ASYNC_TASKS "async.tasks"
+#define METRIC_ASYNC_QUEUE_DEPTH "async.queue_depth"
+#define METRIC_ASYNC_QUEUE_US "async.queue_us"
+
+#define METRIC_API_DISPATCHES "api.dispatches"
+#define METRIC_API_MESSAGES "api.messages"
+#define METRIC_API_EVENTS "api.events"
+#define METRIC_API_ERRORS "api.errors"
+#define METRIC_API_HANGUPS "api.hangups"
+#define METRIC_API_QUERY_HITS "api.query_hits"
+#define METRIC_API_SESSIONS "api.sessions"
+
+#define METRIC_PLUGIN_EVENTS "plugin.events"
+#define METRIC_PLUGIN_COMMANDS "plugin.commands"
+#define METRIC_PLUGIN_PEERS "plugin.peers"
+#define METRIC_PLUGIN_PREPARED_PEERS "plugin.prepared_peers"
+#define METRIC_PLUGIN_DESCRIPTIONS "plugin.descriptions"
+
+#define METRIC_WATCHDOG_STALLS "watchdog.stalls"
+// the run time of the watched scopes goes to watchdog.<origin>_us
+#define METRIC_WATCHDOG_PREFIX "watchdog."
+
+namespace Janus {
+
+  class MetricCounter {
+    public:
+      void add(int64_t value = 1) {
+        this->_value.fetch_add(value, std::memory_order_relaxed);
+      }
+
+      int64_t value();
+      void reset();
+
+    private:
+      std::atomic<int64_t> _value { 0 };
+  };
+
+  // a gauge tells the current state, a reset leaves it alone
+  class MetricGauge {
+    public:
+      void add(int64_t value) {
+        this->_value.fetch_add(value, std::memory_order_relaxed);
+      }
+
+      void set(int64_t value);
+      int64_t value();
+
+    private:
+      std::atomic<int64_t> _value { 0 };
+  };
+
+  // HDR style: log-linear buckets, so recording is a couple of relaxed atomic adds whatever the value
+  class MetricHistogramImpl {
+    public:
+      MetricHistogramImpl();
+
+      // negative values are recorded as zero
+      void record(int64_t value);
+
+      int64_t count();
+      // the highest value of the bucket the quantile falls in, capped to the max recorded
+      int64_t percentile(double quantile);
+
+      MetricHistogram snapshot(const std::string& name);
+      void reset();
+
+      static int bucketOf(int64_t value);
+      static int64_t highestOf(int bucket);
+
+    private:
+      std::atomic<int64_t> _buckets[METRICS_HISTOGRAM_BUCKETS];
+      std::atomic<int64_t> _count { 0 };
+      std::atomic<int64_t> _sum { 0 };
+      std::atomic<int64_t> _min { INT64_MAX };
+      std::atomic<int64_t> _max { 0 };
+  };
+
+  // the microseconds of a scope
+  class MetricTimer {
+    public:
+      MetricTimer(MetricHistogramImpl& histogram);
+      ~MetricTimer();
+
+    private:
+      MetricHistogramImpl& _histogram;
+      int64_t _start;
+  };
+
+  // process wide, like the spans: the metrics are created on first use and live as long as the process
+  class MetricsRegistry {
+    public:
+      static MetricsRegistry& instance();
+
+      // microseconds on the monotonic clock
+      static int64_t now();
+
+      // the references stay valid forever, hot paths keep them in a static
+      MetricCounter& counter(const std::string& name);
+      MetricGauge& gauge(const std::string& name);
+      MetricHistogramImpl& histogram(const std::string& name);
+
+      MetricsSnapshot snapshot();
+      void reset();
+
+    private:
+      MetricsRegistry();
+
+      std::map<std::string, std::unique_ptr<MetricCounter>> _counters;
+      std::map<std::string, std::unique_ptr<MetricGauge>> _gauges;
+      std::map<std::string, std::unique_ptr<MetricHistogramImpl>> _histograms;
+      std::mutex _metricsMutex;
+
+      std::atomic<int64_t> _resetAt { 0 };
+  };
+
+}
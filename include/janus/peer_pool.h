@@ -0,0 +1,98 @@
+/*!
+ * janus-client SDK
+ *
+ * peer_pool.h
+ * The Peer Pool
+ * This module keeps some peers already created and binds them to a handle id when a plugin asks for one.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+#include "janus/peer.hpp"
+#include "janus/peer_factory.hpp"
+#include "janus/protocol.hpp"
+#include "janus/async.h"
+
+#define PEER_POOL_SIZE 2
+
+namespace Janus {
+
+  struct PeerPoolStats {
+    size_t size;
+    size_t idle;
+    int64_t hits;
+    int64_t misses;
+
+    double hitRate() const {
+      auto total = hits + misses;
+
+      return total == 0 ? 0 : (double) hits / total;
+    }
+  };
+
+  // the owner of a pooled peer: it forwards everything to the real owner, with the handle id the peer is bound to
+  class PeerBinding : public Protocol {
+    public:
+      PeerBinding(const std::shared_ptr<Protocol>& owner);
+
+      void bind(int64_t id);
+      int64_t id();
+
+      std::string name();
+      void init(const std::shared_ptr<JanusConf>& conf, const std::shared_ptr<Platform>& platform, const std::shared_ptr<ProtocolDelegate>& delegate);
+      void dispatch(const std::string& command, const std::shared_ptr<Bundle>& payload);
+      void dispatchBatch(const std::vector<std::shared_ptr<Bundle>>& payloads);
+      void hangup();
+      void close();
+      void onOffer(const std::string& sdp, const std::shared_ptr<Bundle>& context);
+      void onAnswer(const std::string& sdp, const std::shared_ptr<Bundle>& context);
+      void onIceCandidate(const std::string& mid, int32_t index, const std::string& sdp, int64_t id);
+      void onIceCompleted(int64_t id);
+
+    private:
+      std::shared_ptr<Protocol> _owner;
+      std::atomic<int64_t> _id;
+  };
+
+  class PeerPool : public PeerFactory {
+    public:
+      PeerPool(const std::shared_ptr<PeerFactory>& factory, const std::shared_ptr<Protocol>& owner, const std::shared_ptr<Async>& async, size_t size = PEER_POOL_SIZE);
+      ~PeerPool();
+
+      std::shared_ptr<Peer> create(int64_t id, const std::shared_ptr<Protocol>& owner);
+
+      void resize(size_t size);
+      void drain();
+      PeerPoolStats stats();
+
+    private:
+      struct Warm {
+        std::shared_ptr<Peer> peer;
+        std::shared_ptr<PeerBinding> binding;
+      };
+
+      // shared with the refill tasks, so a task outliving the pool never touches it
+      struct Shelf {
+        std::deque<Warm> idle;
+        size_t size = 0;
+        size_t pending = 0;
+        int64_t hits = 0;
+        int64_t misses = 0;
+        std::mutex mutex;
+      };
+
+      void _refill();
+
+      std::shared_ptr<PeerFactory> _factory;
+      std::shared_ptr<Protocol> _owner;
+      std::shared_ptr<Async> _async;
+      std::shared_ptr<Shelf> _shelf = std::make_shared<Shelf>();
+  };
+
+}
@@ -12,9 +12,11 @@
 
 #include <unordered_map>
 
+#include "janus/bundle.hpp"
 #include "janus/platform.hpp"
 #include "janus/plugin.hpp"
 #include "janus/plugin_factory.hpp"
+#include "janus/async.h"
 
 namespace Janus {
 
@@ -26,7 +28,8 @@ namespace Janus {
 
   class PlatformImplImpl : public PlatformImpl {
     public:
-      PlatformImplImpl(const std::shared_ptr<PeerFactory>& factory);
+      // the options are the PlatformOptions keys, callbacks is where the protocol and the plugins hear from janus and wins over the CALLBACKS option
+      PlatformImplImpl(const std::shared_ptr<PeerFactory>& factory, const std::shared_ptr<Bundle>& options = nullptr, const std::shared_ptr<Async>& callbacks = nullptr);
 
       void protocol(const std::shared_ptr<Protocol>& protocol);
       std::shared_ptr<Protocol> protocol();
@@ -36,10 +39,14 @@ namespace Janus {
 
       std::shared_ptr<PeerFactory> peerFactory();
 
+      // runs the callbacks queued meanwhile when CALLBACKS is CALLBACKS_QUEUE, 0 otherwise
+      int32_t drainCallbacks(int64_t timeoutMs);
+
     private:
       std::shared_ptr<Protocol> _protocol;
       std::unordered_map<std::string, std::shared_ptr<PluginFactory>> _factories;
       std::shared_ptr<PeerFactory> _peerFactory;
+      std::shared_ptr<CallbackQueue> _queue;
   };
 
 }
@@ -15,17 +15,31 @@
 #include "janus/peer.hpp"
 #include "janus/peer_factory.hpp"
 #include "janus/janus_api.h"
+#include "janus/sdp.h"
 
 namespace Janus {
 
   class JanusPlugin : public Plugin {
     public:
       JanusPlugin(int64_t handleId, const std::shared_ptr<PluginCommandDelegate>& delegate, const std::shared_ptr<PeerFactory>& peerFactory, const std::shared_ptr<Protocol>& owner);
-      void onHangup(const std::string& reason);
+      // only the hangup of the plugin own handle closes its peer
+      void onHangup(const std::string& reason, const std::shared_ptr<Bundle>& context);
       void onClose();
 
+      // every local description goes through it before reaching the peer and janus
+      std::shared_ptr<SdpPipeline> sdpPipeline();
+
     protected:
+      void _prepare(const std::shared_ptr<Bundle>& payload);
+      void _transform(const std::shared_ptr<Bundle>& payload);
+      std::string _rewrite(SdpType type, const std::string& sdp);
+      std::shared_ptr<Peer> _createPeer(int64_t handleId);
+
       std::shared_ptr<Peer> _peer;
+      // created by PREPARE, so ICE is already gathering when the plugin needs its first peer
+      std::shared_ptr<Peer> _prepared;
+
+      std::shared_ptr<SdpPipeline> _sdpPipeline = std::make_shared<SdpPipeline>();
 
       int64_t _handleId = -1;
 
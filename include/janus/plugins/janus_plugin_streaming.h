@@ -10,6 +10,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+
 #include "janus/plugins/janus_plugin.h"
 
 #include "janus/janus_plugins.hpp"
@@ -17,6 +20,13 @@
 
 namespace Janus {
 
+  struct Watch {
+    std::shared_ptr<Peer> peer;
+    std::shared_ptr<Bundle> session;
+
+    Watch(std::shared_ptr<Bundle> session_) : peer(nullptr), session(std::move(session_)) {}
+  };
+
   class JanusPluginStreaming : public JanusPlugin {
     public:
       JanusPluginStreaming(int64_t handleId, const std::shared_ptr<PluginCommandDelegate>& delegate, const std::shared_ptr<PeerFactory>& peerFactory, const std::shared_ptr<Protocol>& owner) : JanusPlugin(handleId, delegate, peerFactory, owner) {}
@@ -24,13 +34,22 @@ namespace Janus {
       void onEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context);
       void onOffer(const std::string& sdp, const std::shared_ptr<Bundle>& context) {}
       void onAnswer(const std::string& sdp, const std::shared_ptr<Bundle>& context);
+      void onHangup(const std::string& reason, const std::shared_ptr<Bundle>& context);
+      void onClose();
 
       std::string name() {
         return JanusPlugins::STREAMING;
       }
 
     private:
-      std::shared_ptr<Bundle> _session = nullptr;
+      // nullptr when nothing is watched on the handle, the caller holds the lock
+      std::shared_ptr<Watch> _watch(int64_t handleId);
+      void _noWatch(int64_t handleId, const std::shared_ptr<Bundle>& context);
+
+      // every concurrent watch runs on its own handle, the plugin handle included
+      std::unordered_map<int64_t, std::shared_ptr<Watch>> _watches;
+      // the commands, the janus events and the peer change the watches on three threads, the peers and the delegate are called unlocked
+      std::mutex _watchesMutex;
   };
 
   class JanusPluginStreamingFactory : public PluginFactory {
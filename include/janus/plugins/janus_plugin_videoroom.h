@@ -10,45 +10,114 @@
 
 #pragma once
 
+#include <chrono>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "janus/plugins/janus_plugin.h"
+#include "janus/plugins/layer_policy.h"
+#include "janus/plugins/room_state.h"
+#include "janus/plugins/speaker_tracker.h"
+#include "janus/plugins/subscription_manager.h"
 #include "janus/janus_plugins.hpp"
+#include "janus/peer_pool.h"
+#include "janus/async.h"
 
 namespace Janus {
 
   struct Subscriber {
     std::shared_ptr<Peer> peer;
     std::shared_ptr<Bundle> context;
+    // the start went out, before it a pause would be undone
+    bool started = false;
 
     Subscriber(std::shared_ptr<Peer> peer_, std::shared_ptr<Bundle> context_) : peer(std::move(peer_)), context(std::move(context_)) {}
   };
 
   class JanusPluginVideoroom : public JanusPlugin {
     public:
-      JanusPluginVideoroom(int64_t handleId, const std::shared_ptr<PluginCommandDelegate>& delegate, const std::shared_ptr<PeerFactory>& peerFactory, const std::shared_ptr<Protocol>& owner) : JanusPlugin(handleId, delegate, peerFactory, owner) {}
+      // the scheduler wakes the subscriptions up when a hysteresis expires, the async creates the pooled peers, each a thread of its own when there is none
+      JanusPluginVideoroom(int64_t handleId, const std::shared_ptr<PluginCommandDelegate>& delegate, const std::shared_ptr<PeerFactory>& peerFactory, const std::shared_ptr<Protocol>& owner, const std::shared_ptr<Scheduler>& scheduler = nullptr, const std::shared_ptr<Async>& async = nullptr);
       void command(const std::string& command, const std::shared_ptr<Bundle>& payload);
       void onEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context);
       void onOffer(const std::string& sdp, const std::shared_ptr<Bundle>& context);
       void onAnswer(const std::string& sdp, const std::shared_ptr<Bundle>& context);
+      void onClose();
 
       std::string name() {
         return JanusPlugins::VIDEOROOM;
       }
 
+      std::shared_ptr<RoomState> roomState();
+      std::shared_ptr<SubscriptionManager> subscriptions();
+      std::shared_ptr<SpeakerTracker> speakers();
+      std::shared_ptr<LayerPolicy> layers();
+      std::shared_ptr<PeerPool> pool();
+
     private:
+      // the bodies of command and onEvent, run with the state locked
+      void _command(const std::string& command, const std::shared_ptr<Bundle>& payload);
+      void _onEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context);
+      // closes the peers detached meanwhile, once the state is unlocked
+      void _closeDetached();
+      void _follow(const SubscriptionPlan& plan, const std::shared_ptr<Bundle>& payload);
+      void _switch(int64_t from, int64_t feed, const std::shared_ptr<Bundle>& context);
+      void _request(int64_t feed, const nlohmann::json& body);
+      void _flush(int64_t feed);
+      void _switchLayers();
+      // posts the tick of the command unless an earlier one is pending already
+      void _schedule(const std::string& command, std::chrono::steady_clock::time_point now, int64_t due, std::chrono::steady_clock::time_point& tickAt);
+      void _detach(int64_t feed);
+      void _speakersChanged(const std::shared_ptr<Bundle>& context);
+
+      // guards the state below against the command, callback and scheduler threads, a command may come back on the thread holding it
+      std::recursive_mutex _stateMutex;
+      // the peers of the detached subscribers, closing one may wait on the thread an answer comes from
+      std::vector<std::shared_ptr<Peer>> _detached;
+
       std::unordered_map<int64_t, std::shared_ptr<Subscriber>> _subscribers;
+      // feed id -> subscriber handle id, filled as soon as the subscriber handle is attached
+      std::unordered_map<int64_t, int64_t> _feeds;
+      // the requests for a feed whose subscriber has not started yet
+      std::unordered_map<int64_t, std::vector<nlohmann::json>> _queued;
+      std::shared_ptr<RoomState> _roomState = std::make_shared<RoomState>();
+      std::shared_ptr<SubscriptionManager> _subscriptions = std::make_shared<SubscriptionManager>();
+      std::shared_ptr<SpeakerTracker> _speakers = std::make_shared<SpeakerTracker>();
+      std::shared_ptr<LayerPolicy> _layers = std::make_shared<LayerPolicy>();
+      // warm subscriber peers, nullptr until PEER_POOL enables it
+      std::shared_ptr<PeerPool> _pool;
+      // PEER_POOL sets the pool on the command thread, the attach replies read it on the transport one
+      std::mutex _poolMutex;
+      std::shared_ptr<Async> _async;
+      // the SPEAKERS payload while the ranking drives the subscriptions, nullptr otherwise
+      std::shared_ptr<Bundle> _speakersFollow;
+      // the last VIEWPORT payload, the ticks attach with it
+      std::shared_ptr<Bundle> _viewport;
+
+      // the last LAYER_POLICY asked for svc layers
+      bool _layersSvc = false;
+
+      std::shared_ptr<Scheduler> _scheduler;
+      // when the pending ticks fire, the epoch while none is
+      std::chrono::steady_clock::time_point _viewportTickAt;
+      std::chrono::steady_clock::time_point _layersTickAt;
+      std::mutex _tickMutex;
   };
 
   class JanusPluginVideoroomFactory : public PluginFactory {
     public:
-      JanusPluginVideoroomFactory(const std::shared_ptr<PluginCommandDelegate>& delegate, const std::shared_ptr<PeerFactory>& peerFactory);
+      // every plugin it creates shares the scheduler and the async of the peer pools, created with the first plugin when missing
+      JanusPluginVideoroomFactory(const std::shared_ptr<PluginCommandDelegate>& delegate, const std::shared_ptr<PeerFactory>& peerFactory, const std::shared_ptr<Scheduler>& scheduler = nullptr, const std::shared_ptr<Async>& async = nullptr);
 
       std::shared_ptr<Plugin> create(int64_t handleId, const std::shared_ptr<Protocol>& owner);
 
     private:
       std::shared_ptr<PeerFactory> _peerFactory;
       std::shared_ptr<PluginCommandDelegate> _delegate;
+      std::shared_ptr<Scheduler> _scheduler;
+      std::shared_ptr<Async> _async;
+      std::mutex _mutex;
   };
 
 }
@@ -0,0 +1,69 @@
+/*!
+ * janus-client SDK
+ *
+ * layer_policy.h
+ * The Videoroom Layer Policy
+ * This module picks the simulcast/SVC layer of every subscribed feed from its rendered tile size and a bandwidth budget.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <vector>
+
+// kbps
+#define LAYER_BUDGET 2500
+#define LAYER_SWITCH_INTERVAL 2000
+
+namespace Janus {
+
+  struct Layer {
+    int32_t substream;
+    int32_t temporal;
+    int64_t bitrate;
+    int32_t height;
+  };
+
+  struct LayerSwitch {
+    int64_t feed;
+    int32_t substream;
+    int32_t temporal;
+
+    LayerSwitch(int64_t feed_, int32_t substream_, int32_t temporal_) : feed(feed_), substream(substream_), temporal(temporal_) {}
+  };
+
+  class LayerPolicy {
+    public:
+      LayerPolicy(int64_t budget = LAYER_BUDGET, int64_t interval = LAYER_SWITCH_INTERVAL);
+
+      void configure(int64_t budget, int64_t interval);
+      void tile(int64_t feed, int32_t width, int32_t height);
+      void forget(int64_t feed);
+
+      std::vector<LayerSwitch> plan();
+      std::vector<LayerSwitch> plan(std::chrono::steady_clock::time_point now);
+      // milliseconds until a switch the interval held back can go out, -1 when none is waiting
+      int64_t due(std::chrono::steady_clock::time_point now);
+
+    private:
+      struct Feed {
+        int32_t height;
+        // index in the layer ladder, -1 until the first switch since janus starts from the top layer
+        int32_t current;
+        std::chrono::steady_clock::time_point switchedAt;
+        // the last plan wanted another layer before the interval expired
+        bool held;
+      };
+
+      int64_t _budget;
+      std::chrono::milliseconds _interval;
+
+      std::map<int64_t, Feed> _feeds;
+      std::mutex _mutex;
+  };
+
+}
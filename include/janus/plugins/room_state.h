@@ -0,0 +1,65 @@
+/*!
+ * janus-client SDK
+ *
+ * room_state.h
+ * The Videoroom Room State
+ * This module keeps an indexed participant table updated by applying the videoroom events as deltas.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "janus/janus_data.hpp"
+
+namespace Janus {
+
+  struct Participant {
+    int64_t id;
+    std::string display;
+    bool publisher;
+    std::string audioCodec;
+    std::string videoCodec;
+
+    Participant(int64_t id_, std::string display_, bool publisher_, std::string audioCodec_, std::string videoCodec_) : id(id_), display(std::move(display_)), publisher(publisher_), audioCodec(std::move(audioCodec_)), videoCodec(std::move(videoCodec_)) {}
+  };
+
+  struct RoomStateDelta {
+    std::vector<Participant> joined;
+    std::vector<Participant> updated;
+    std::vector<int64_t> left;
+
+    bool empty() const {
+      return joined.empty() && updated.empty() && left.empty();
+    }
+  };
+
+  class RoomState {
+    public:
+      RoomStateDelta apply(const std::shared_ptr<JanusData>& data);
+
+      std::vector<Participant> snapshot();
+      bool find(int64_t id, Participant& participant);
+      int64_t room();
+      size_t size();
+
+    private:
+      void _upsert(const Participant& participant, RoomStateDelta& delta);
+      void _unpublish(int64_t id, RoomStateDelta& delta);
+      void _remove(int64_t id, RoomStateDelta& delta);
+      void _clear(RoomStateDelta& delta);
+
+      int64_t _room = -1;
+
+      // the list keeps the join order stable while the index makes every delta O(1)
+      std::list<Participant> _participants;
+      std::unordered_map<int64_t, std::list<Participant>::iterator> _index;
+      std::mutex _mutex;
+  };
+
+}
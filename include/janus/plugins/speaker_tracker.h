@@ -0,0 +1,50 @@
+/*!
+ * janus-client SDK
+ *
+ * speaker_tracker.h
+ * The Videoroom Active Speaker Tracker
+ * This module ranks the room participants by their talking and stopped-talking events.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "janus/janus_data.hpp"
+
+#define ACTIVE_SPEAKERS 4
+
+namespace Janus {
+
+  class SpeakerTracker {
+    public:
+      SpeakerTracker(size_t size = ACTIVE_SPEAKERS);
+
+      bool resize(size_t size);
+      bool apply(const std::shared_ptr<JanusData>& data);
+      bool remove(int64_t id);
+
+      std::vector<int64_t> ranking();
+
+    private:
+      struct Speaker {
+        std::list<int64_t>::iterator position;
+        bool talking;
+      };
+
+      std::vector<int64_t> _ranking();
+
+      size_t _size;
+
+      // most recent activity first: talking speakers rank above the silent ones, recency breaks the ties
+      std::list<int64_t> _recency;
+      std::unordered_map<int64_t, Speaker> _speakers;
+      std::mutex _mutex;
+  };
+
+}
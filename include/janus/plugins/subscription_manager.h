@@ -0,0 +1,81 @@
+/*!
+ * janus-client SDK
+ *
+ * subscription_manager.h
+ * The Videoroom Subscription Manager
+ * This module turns the set of visible feeds into the attach, pause, resume and detach steps needed to follow it.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#define SUBSCRIPTION_MAX_ACTIVE 9
+#define SUBSCRIPTION_MAX_WARM 3
+#define SUBSCRIPTION_HYSTERESIS 1500
+
+namespace Janus {
+
+  struct SubscriptionPlan {
+    std::vector<int64_t> detach;
+    std::vector<int64_t> pause;
+    std::vector<int64_t> resume;
+    std::vector<int64_t> attach;
+
+    bool empty() const {
+      return detach.empty() && pause.empty() && resume.empty() && attach.empty();
+    }
+  };
+
+  class SubscriptionManager {
+    public:
+      SubscriptionManager(int64_t maxActive = SUBSCRIPTION_MAX_ACTIVE, int64_t maxWarm = SUBSCRIPTION_MAX_WARM, int64_t hysteresis = SUBSCRIPTION_HYSTERESIS);
+
+      // negative values count as zero
+      void configure(int64_t maxActive, int64_t maxWarm, int64_t hysteresis);
+
+      SubscriptionPlan update(const std::vector<int64_t>& visible);
+      SubscriptionPlan update(const std::vector<int64_t>& visible, std::chrono::steady_clock::time_point now);
+      SubscriptionPlan remove(int64_t feed);
+      // the subscriber of from switched to feed, which takes over its state
+      void replace(int64_t from, int64_t feed);
+
+      // pauses the hidden feeds whose hysteresis expired since the last update
+      SubscriptionPlan tick();
+      SubscriptionPlan tick(std::chrono::steady_clock::time_point now);
+      // milliseconds until the next hysteresis expires, -1 when no hidden feed is still flowing
+      int64_t due(std::chrono::steady_clock::time_point now);
+
+      bool tracks(int64_t feed);
+      size_t active();
+      size_t warm();
+
+    private:
+      enum State {
+        ACTIVE,
+        WARM
+      };
+
+      struct Entry {
+        State state;
+        bool visible;
+        std::chrono::steady_clock::time_point hiddenSince;
+      };
+
+      size_t _count(State state);
+      void _evict(SubscriptionPlan& plan, std::chrono::steady_clock::time_point now);
+
+      size_t _maxActive;
+      size_t _maxWarm;
+      std::chrono::milliseconds _hysteresis;
+
+      std::unordered_map<int64_t, Entry> _entries;
+      std::mutex _mutex;
+  };
+
+}
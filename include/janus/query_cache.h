@@ -0,0 +1,69 @@
+/*!
+ * janus-client SDK
+ *
+ * query_cache.h
+ * Read-only query cache
+ * This module merges identical in-flight plugin queries and keeps their replies for a short time
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "janus/bundle.hpp"
+
+#define QUERY_CACHE_TTL 2000
+// a query still without a reply by then is sent again, the reply may never come
+#define QUERY_CACHE_FLIGHT_TIMEOUT 10000
+
+namespace Janus {
+
+  enum QueryStatus {
+    HIT,
+    PENDING,
+    MISS
+  };
+
+  class QueryCache {
+    public:
+      QueryCache(int64_t ttl = QUERY_CACHE_TTL, int64_t timeout = QUERY_CACHE_FLIGHT_TIMEOUT);
+
+      // the scope tells what the reply depends on, a room for instance, so it can be invalidated alone
+      QueryStatus acquire(const std::string& key, const std::string& scope, const std::shared_ptr<Bundle>& context, nlohmann::json& reply);
+      std::vector<std::shared_ptr<Bundle>> complete(const std::string& key, const nlohmann::json& reply, bool cacheable);
+      void invalidate(const std::string& scope);
+      void invalidate();
+      // drops the queries in flight, their replies will never come, and tells who was waiting
+      std::vector<std::shared_ptr<Bundle>> abandon();
+
+    private:
+      struct Entry {
+        std::string scope;
+        nlohmann::json reply;
+        std::chrono::steady_clock::time_point expiresAt;
+      };
+
+      struct Flight {
+        std::string scope;
+        uint64_t generation;
+        std::chrono::steady_clock::time_point deadline;
+        std::vector<std::shared_ptr<Bundle>> waiters;
+      };
+
+      std::chrono::milliseconds _ttl;
+      std::chrono::milliseconds _timeout;
+      std::unordered_map<std::string, uint64_t> _generations;
+
+      std::unordered_map<std::string, Entry> _entries;
+      std::unordered_map<std::string, Flight> _flights;
+      std::mutex _mutex;
+  };
+
+}
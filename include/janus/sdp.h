@@ -0,0 +1,168 @@
+/*!
+ * janus-client SDK
+ *
+ * sdp.h
+ * The SDP Rewriting Pipeline
+ * This module indexes the session descriptions janus sends, and runs the transforms the plugins apply to their local descriptions.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "janus/sdp_type.hpp"
+
+namespace Janus {
+
+  // a read-only window on the buffer of a SessionDescription, valid as long as the description lives
+  struct SdpSlice {
+    const char* data = nullptr;
+    size_t size = 0;
+
+    bool startsWith(const char* prefix) const;
+    bool equals(const char* literal) const;
+    std::string str() const;
+  };
+
+  // an immutable description indexed in place: sections, lines and attributes are offsets into the one buffer, built on first access
+  class SessionDescription {
+    public:
+      SessionDescription(std::string sdp);
+
+      const std::string& str() const;
+
+      size_t mediaCount() const;
+      SdpSlice mline(size_t media) const;
+      SdpSlice kind(size_t media) const;
+
+      // the value after "a=<name>:", empty for a flag attribute, false when the attribute is not there
+      bool attribute(const char* name, SdpSlice& value) const;
+      bool attribute(size_t media, const char* name, SdpSlice& value) const;
+      std::vector<SdpSlice> attributes(size_t media, const char* name) const;
+      // "candidate:..." without the "a=", ready for parseCandidate
+      std::vector<SdpSlice> candidates(size_t media) const;
+
+      // a copy without the lines the slices point into
+      std::string without(const std::vector<SdpSlice>& slices) const;
+
+    private:
+      friend class Sdp;
+
+      struct Line {
+        size_t offset;
+        size_t size;
+      };
+
+      struct Section {
+        size_t first;
+        size_t count;
+      };
+
+      void _index() const;
+      SdpSlice _line(size_t line) const;
+      bool _find(const Section& section, const char* name, SdpSlice& value) const;
+
+      const std::string _buffer;
+
+      mutable std::once_flag _indexed;
+      mutable std::vector<Line> _lines;
+      // the session section first, then one per m= line
+      mutable std::vector<Section> _sections;
+  };
+
+  struct SdpMedia {
+    // the m= line first, then every line up to the next media section
+    std::vector<std::string> lines;
+
+    std::string kind() const;
+    std::vector<std::string> payloads() const;
+    void payloads(const std::vector<std::string>& formats);
+    std::string codec(const std::string& payload) const;
+
+    void removePayload(const std::string& payload);
+    // inserts a line where RFC 4566 wants it: the b= lines go after the c= line, everything else at the end
+    void insert(const std::string& line);
+  };
+
+  class Sdp {
+    public:
+      Sdp(const std::string& sdp);
+      Sdp(const SessionDescription& description);
+
+      std::string str() const;
+
+      std::vector<std::string> session;
+      std::vector<SdpMedia> media;
+  };
+
+  class SdpTransform {
+    public:
+      virtual ~SdpTransform() {}
+      virtual void apply(Sdp& sdp, SdpType type) = 0;
+  };
+
+  // moves the given codecs, in order, ahead of the others of the same media kind
+  class SdpCodecPreference : public SdpTransform {
+    public:
+      SdpCodecPreference(const std::string& kind, const std::vector<std::string>& codecs);
+      void apply(Sdp& sdp, SdpType type);
+
+    private:
+      std::string _kind;
+      std::vector<std::string> _codecs;
+  };
+
+  // removes the given codecs and their retransmission payloads, a media section never loses all of them
+  class SdpCodecFilter : public SdpTransform {
+    public:
+      SdpCodecFilter(const std::string& kind, const std::vector<std::string>& codecs);
+      void apply(Sdp& sdp, SdpType type);
+
+    private:
+      std::string _kind;
+      std::vector<std::string> _codecs;
+  };
+
+  class SdpExtensionFilter : public SdpTransform {
+    public:
+      SdpExtensionFilter(const std::vector<std::string>& uris);
+      void apply(Sdp& sdp, SdpType type);
+
+    private:
+      std::vector<std::string> _uris;
+  };
+
+  // caps every media section of the given kind with both b=AS (kbps) and b=TIAS (bps)
+  class SdpBandwidth : public SdpTransform {
+    public:
+      SdpBandwidth(const std::string& kind, int64_t kbps);
+      void apply(Sdp& sdp, SdpType type);
+
+    private:
+      std::string _kind;
+      int64_t _kbps;
+  };
+
+  class SdpPipeline {
+    public:
+      void add(const std::shared_ptr<SdpTransform>& transform);
+      void clear();
+      bool empty();
+
+      // the description is returned untouched, and never parsed, when there is nothing to run
+      std::shared_ptr<SessionDescription> run(const std::shared_ptr<SessionDescription>& description, SdpType type);
+      std::string run(const std::string& sdp, SdpType type);
+
+    private:
+      std::vector<std::shared_ptr<SdpTransform>> _transforms;
+      std::mutex _mutex;
+  };
+
+}
@@ -0,0 +1,93 @@
+/*!
+ * janus-client SDK
+ *
+ * spans.h
+ * Transaction spans
+ * This module times the stages of every janus transaction into a lock-free ring you can export as Chrome trace events
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <nlohmann/json.hpp>
+
+#include "janus/bundle.hpp"
+
+// the oldest spans are overwritten past this, it must be a power of two
+#define SPAN_RING_SIZE 16384
+// random transactions are 16 chars, longer ones are cut
+#define SPAN_TRANSACTION_WORDS 3
+#define SPAN_TIMELINE_STAGES 8
+// when JanusApi::dispatch started, so the send can tell how long the command took to become a message
+#define SPAN_DISPATCH_KEY "span_dispatch"
+
+namespace Janus {
+
+  // the spans are process wide: the recording is off until enable(true), then every record is a few relaxed atomic stores
+  class Spans {
+    public:
+      static void enable(bool enabled);
+
+      static bool enabled() {
+        return Spans::_enabled.load(std::memory_order_relaxed);
+      }
+
+      // microseconds on the monotonic clock
+      static int64_t now();
+
+      // a span on the current thread, async ones may start on another thread and overlap their neighbours
+      static void record(const char* name, const std::string& transaction, int64_t start, int64_t end, bool async = false);
+
+      static void clear();
+
+      // { "traceEvents": [...] } as chrome://tracing and Perfetto load it
+      static nlohmann::json chromeTrace();
+
+    private:
+      static std::atomic<bool> _enabled;
+  };
+
+  // the transaction of a janus message, empty when it has none
+  std::string transactionOf(const nlohmann::json& message);
+
+  // the span of a scope, nothing happens when the recording is off
+  class SpanScope {
+    public:
+      SpanScope(const char* name, const std::string& transaction);
+      // keyed by the transaction of the message
+      SpanScope(const char* name, const nlohmann::json& message);
+      ~SpanScope();
+
+    private:
+      const char* _name;
+      std::string _transaction;
+      int64_t _start = -1;
+  };
+
+  // consecutive stages of a transaction: every mark closes the stage opened by the previous one
+  class SpanTimeline {
+    public:
+      // a negative start means the recording was off when the transaction began
+      SpanTimeline(int64_t start);
+
+      void mark(const char* stage, bool async = false);
+
+      // the stages are recorded once the transaction is known, a whole transaction span wraps them when flow is set
+      void record(const std::string& transaction, const char* flow = nullptr);
+
+    private:
+      struct Stage {
+        const char* name;
+        int64_t end;
+        bool async;
+      };
+
+      int64_t _start;
+      Stage _stages[SPAN_TIMELINE_STAGES];
+      int _count = 0;
+  };
+
+}
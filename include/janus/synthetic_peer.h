@@ -0,0 +1,94 @@
+/*!
+ * janus-client SDK
+ *
+ * synthetic_peer.h
+ * The Synthetic Peer
+ * This module fakes a WebRTC peer without any media stack: it answers with browser-like descriptions and candidate bursts, on a timing you can configure, so the plugin flows run headless.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "janus/peer.hpp"
+#include "janus/peer_factory.hpp"
+#include "janus/protocol.hpp"
+#include "janus/constraints.hpp"
+#include "janus/async.h"
+
+#define SYNTHETIC_HOST_CANDIDATES 2
+#define SYNTHETIC_SRFLX_CANDIDATES 1
+
+namespace Janus {
+
+  // every delay is in milliseconds
+  struct SyntheticPeerConf {
+    int64_t offerDelay = 0;
+    int64_t answerDelay = 0;
+    // from setLocalDescription to the first candidate
+    int64_t gatheringDelay = 0;
+    // between two candidates of the same burst
+    int64_t candidateInterval = 0;
+
+    int32_t hostCandidates = SYNTHETIC_HOST_CANDIDATES;
+    bool tcpCandidates = true;
+    int32_t srflxCandidates = SYNTHETIC_SRFLX_CANDIDATES;
+    int32_t relayCandidates = 0;
+
+    // a bundled peer gathers on the first m-line only
+    bool bundle = true;
+  };
+
+  // one thread runs the callbacks of every peer at their deadline, in order, like the signaling thread of a real stack
+  class SyntheticPeer : public Peer {
+    public:
+      SyntheticPeer(int64_t id, const std::shared_ptr<Protocol>& owner, const SyntheticPeerConf& conf, const std::shared_ptr<Scheduler>& scheduler);
+
+      void prepare(const Constraints& constraints);
+      void createOffer(const Constraints& constraints, const std::shared_ptr<Bundle>& context);
+      void createAnswer(const Constraints& constraints, const std::shared_ptr<Bundle>& context);
+      void setLocalDescription(SdpType type, const std::string& sdp);
+      void setRemoteDescription(SdpType type, const std::string& sdp);
+      void addIceCandidate(const std::string& mid, int32_t index, const std::string& sdp);
+      void close();
+
+      int64_t remoteCandidates();
+
+    private:
+      // shared with the scheduled callbacks, so that a closed peer stops talking to its owner
+      struct State {
+        std::atomic<bool> closed { false };
+      };
+
+      std::string _describe(const Constraints& constraints, SdpType type);
+
+      int64_t _id;
+      std::shared_ptr<Protocol> _owner;
+      SyntheticPeerConf _conf;
+      std::shared_ptr<Scheduler> _scheduler;
+      std::shared_ptr<State> _state = std::make_shared<State>();
+
+      std::string _remote;
+      int64_t _version = 0;
+      int64_t _remoteCandidates = 0;
+      std::mutex _mutex;
+  };
+
+  class SyntheticPeerFactory : public PeerFactory {
+    public:
+      SyntheticPeerFactory(const SyntheticPeerConf& conf = SyntheticPeerConf());
+
+      std::shared_ptr<Peer> create(int64_t id, const std::shared_ptr<Protocol>& owner);
+
+    private:
+      SyntheticPeerConf _conf;
+      std::shared_ptr<Scheduler> _scheduler;
+  };
+
+}
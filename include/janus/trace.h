@@ -0,0 +1,179 @@
+/*!
+ * janus-client SDK
+ *
+ * trace.h
+ * Signaling traces
+ * This module records the messages a transport exchanges with janus and replays them through the protocol, at their recorded pace or as fast as possible
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "janus/bundle.hpp"
+#include "janus/transport.h"
+
+// the send a reply belongs to travels in its context
+#define TRACE_SEQUENCE_KEY "trace_sequence"
+// the asynchronous events do not answer any send
+#define TRACE_NO_REQUEST -1
+// how long a replay waits for the protocol to send what the recording expects
+#define REPLAY_STEP_TIMEOUT 5000
+
+namespace Janus {
+
+  enum TraceDirection {
+    OUTGOING,
+    INCOMING
+  };
+
+  enum ReplaySpeed {
+    REAL_TIME,
+    MAX_SPEED
+  };
+
+  struct TraceEntry {
+    // microseconds since the recording started
+    int64_t at = 0;
+    TraceDirection direction = TraceDirection::OUTGOING;
+    // the number of a send, or the send an incoming message replies to
+    int64_t sequence = TRACE_NO_REQUEST;
+    nlohmann::json message;
+  };
+
+  // one JSON object per line, flushed as the messages go: a crash loses nothing but the line it was writing. An existing file is truncated, a trace holds one session
+  class TraceRecorder {
+    public:
+      TraceRecorder(const std::string& path);
+
+      bool good();
+
+      int64_t sent(const nlohmann::json& message);
+      void received(const nlohmann::json& message, int64_t sequence);
+
+    private:
+      void _write(TraceDirection direction, int64_t sequence, const nlohmann::json& message);
+
+      std::ofstream _file;
+      std::chrono::steady_clock::time_point _start = std::chrono::steady_clock::now();
+      int64_t _sequence = 0;
+      std::mutex _mutex;
+  };
+
+  // the lines that do not parse, like the last one of a crashed session, are skipped
+  std::vector<TraceEntry> readTrace(const std::string& path);
+
+  class TracingTransport : public Transport {
+    public:
+      TracingTransport(const std::shared_ptr<Transport>& transport, const std::shared_ptr<TraceRecorder>& recorder);
+
+      void sessionId(const std::string& id);
+      void close();
+
+      TransportType type();
+      void send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context);
+      void sendBatch(const std::vector<TransportMessage>& messages);
+
+    private:
+      std::shared_ptr<Transport> _transport;
+      std::shared_ptr<TraceRecorder> _recorder;
+  };
+
+  class TracingDelegate : public TransportDelegate {
+    public:
+      TracingDelegate(const std::shared_ptr<TransportDelegate>& delegate, const std::shared_ptr<TraceRecorder>& recorder);
+
+      void onMessage(const nlohmann::json& message, const std::shared_ptr<Bundle>& context);
+
+    private:
+      std::shared_ptr<TransportDelegate> _delegate;
+      std::shared_ptr<TraceRecorder> _recorder;
+  };
+
+  // records every transport it creates, the protocol does not know
+  class TracingTransportFactory : public TransportFactory {
+    public:
+      TracingTransportFactory(const std::shared_ptr<TransportFactory>& factory, const std::shared_ptr<TraceRecorder>& recorder);
+
+      std::shared_ptr<Transport> create(const std::string& url, const std::shared_ptr<TransportDelegate>& delegate);
+
+    private:
+      std::shared_ptr<TransportFactory> _factory;
+      std::shared_ptr<TraceRecorder> _recorder;
+  };
+
+  struct ReplayStats {
+    int64_t delivered = 0;
+    int64_t sent = 0;
+    // sends whose command differs from the recorded one
+    int64_t mismatched = 0;
+    // the protocol never sent what a recorded reply answers
+    bool stalled = false;
+    bool done = false;
+    // microseconds from the first send to the last delivery
+    int64_t elapsed = 0;
+  };
+
+  // the n-th send of the protocol stands for the n-th recorded send, and gets its recorded replies in order
+  class ReplayTransport : public Transport {
+    public:
+      ReplayTransport(const std::vector<TraceEntry>& entries, ReplaySpeed speed, const std::shared_ptr<TransportDelegate>& delegate);
+      ~ReplayTransport();
+
+      void sessionId(const std::string& id) {}
+      void close();
+
+      TransportType type() {
+        return TransportType::HTTP;
+      }
+
+      void send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context);
+      void sendBatch(const std::vector<TransportMessage>& messages);
+
+      ReplayStats wait(int64_t timeout);
+
+    private:
+      void _run();
+
+      std::vector<TraceEntry> _incoming;
+      std::vector<nlohmann::json> _outgoing;
+      ReplaySpeed _speed;
+      std::shared_ptr<TransportDelegate> _delegate;
+      // when the recording started, in its own clock
+      int64_t _origin = 0;
+
+      std::vector<std::shared_ptr<Bundle>> _contexts;
+      std::chrono::steady_clock::time_point _start;
+      ReplayStats _stats;
+      bool _running = true;
+      std::mutex _mutex;
+      std::condition_variable _changed;
+      std::thread _thread;
+  };
+
+  class ReplayTransportFactory : public TransportFactory {
+    public:
+      ReplayTransportFactory(const std::vector<TraceEntry>& entries, ReplaySpeed speed = ReplaySpeed::MAX_SPEED);
+
+      std::shared_ptr<Transport> create(const std::string& url, const std::shared_ptr<TransportDelegate>& delegate);
+
+      // the last transport this factory created
+      std::shared_ptr<ReplayTransport> transport();
+
+    private:
+      std::vector<TraceEntry> _entries;
+      ReplaySpeed _speed;
+      std::shared_ptr<ReplayTransport> _transport;
+      std::mutex _mutex;
+  };
+
+}
@@ -14,10 +14,12 @@
 
 #include <memory>
 #include <queue>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 #include "janus/http.h"
 #include "janus/async.h"
+#include "janus/spans.h"
 #include "janus/bundle.hpp"
 
 namespace Janus {
@@ -31,6 +33,13 @@ namespace Janus {
       virtual void onMessage(const nlohmann::json& message, const std::shared_ptr<Bundle>& context) = 0;
   };
 
+  struct TransportMessage {
+    nlohmann::json message;
+    std::shared_ptr<Bundle> context;
+
+    TransportMessage(nlohmann::json message_, std::shared_ptr<Bundle> context_) : message(std::move(message_)), context(std::move(context_)) {}
+  };
+
   enum TransportType { HTTP, WS };
   enum TransportStatus { ON, OFF };
 
@@ -41,6 +50,7 @@ namespace Janus {
 
       virtual TransportType type() = 0;
       virtual void send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context) = 0;
+      virtual void sendBatch(const std::vector<TransportMessage>& messages) = 0;
   };
 
   class TransportImpl : public Transport {
@@ -62,22 +72,32 @@ namespace Janus {
 
   class HttpTransport : public TransportImpl, public std::enable_shared_from_this<HttpTransport> {
     public:
-      HttpTransport(const std::string& url, const std::shared_ptr<TransportDelegate>& delegate, const std::shared_ptr<HttpFactory>& factory, const std::shared_ptr<Async>& async);
+      // the replies reach the delegate through callbacks, right on the worker when there is none
+      HttpTransport(const std::string& url, const std::shared_ptr<TransportDelegate>& delegate, const std::shared_ptr<HttpFactory>& factory, const std::shared_ptr<Async>& async, const std::shared_ptr<Async>& callbacks = nullptr);
 
       TransportType type() {
         return TransportType::HTTP;
       }
 
       void send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context);
+      void sendBatch(const std::vector<TransportMessage>& messages);
       void sessionId(const std::string& id);
     private:
-      void _sendAsync(const HttpTask& kernel, const std::shared_ptr<Bundle>& context);
+      void _sendAsync(const HttpTask& kernel, const std::shared_ptr<Bundle>& context, const std::string& transaction = "");
+      // hands a reply to the delegate once its client is back in the pool
+      void _deliver(const nlohmann::json& content, const std::shared_ptr<Bundle>& context, SpanTimeline spans, const std::string& transaction);
+
+      std::shared_ptr<Http> _acquire();
+      void _release(const std::shared_ptr<Http>& client);
+      std::string _path();
 
       static std::shared_ptr<HttpResponse> _loop(const std::string& path, const std::shared_ptr<Http>& client, const std::shared_ptr<HttpTransport>& main);
 
       std::queue<std::shared_ptr<Http>> _clients;
       std::mutex _clientsMutex;
       std::condition_variable _notEmpty;
+
+      std::shared_ptr<Async> _callbacks;
   };
 
   class WebSocketTransport : public TransportImpl {
@@ -88,6 +108,7 @@ namespace Janus {
       }
 
       void send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context);
+      void sendBatch(const std::vector<TransportMessage>& messages);
       void close();
   };
 
@@ -98,7 +119,12 @@ namespace Janus {
 
   class TransportFactoryImpl : public TransportFactory {
     public:
+      // every transport gets a callback thread of its own, unless the app gives an executor to share
+      TransportFactoryImpl(const std::shared_ptr<Async>& callbacks = nullptr);
+
       std::shared_ptr<Transport> create(const std::string& url, const std::shared_ptr<TransportDelegate>& delegate);
+    private:
+      std::shared_ptr<Async> _callbacks;
   };
 
 }
@@ -0,0 +1,81 @@
+/*!
+ * janus-client SDK
+ *
+ * watchdog.h
+ * Stall watchdog
+ * This module times the commands, the transport tasks, the callbacks and the plugin events, and flags the ones that run past a threshold
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// where the time went: JanusApi::dispatch, a request on a transport worker, a reply handed to the delegate, a plugin handling its event
+#define WATCHDOG_COMMAND "command"
+#define WATCHDOG_TRANSPORT "transport"
+#define WATCHDOG_CALLBACK "callback"
+#define WATCHDOG_PLUGIN "plugin"
+
+// the oldest stalls are dropped past this
+#define WATCHDOG_STALLS_SIZE 64
+// the scopes a thread nests before the inner ones go unwatched, and the name bytes each keeps
+#define WATCHDOG_DEPTH 8
+#define WATCHDOG_NAME_WORDS 4
+
+namespace Janus {
+
+  struct WatchdogStall {
+    int64_t id;
+    std::string origin;
+    std::string name;
+    // microseconds on the monotonic clock
+    int64_t startedAt;
+    int64_t runningUs;
+    // false while the task is still blocked
+    bool finished;
+  };
+
+  using WatchdogHandler = std::function<void(const WatchdogStall&)>;
+
+  // process wide like the spans: nothing is watched until start, then every scope costs two clock reads and a write to a slot of its thread
+  class Watchdog {
+    public:
+      // a monitor thread flags the scopes still running past thresholdMs, the handler hears of each stall once, on the monitor or on the thread that ran late
+      static void start(int64_t thresholdMs, const WatchdogHandler& handler = nullptr);
+      static void stop();
+
+      static bool enabled() {
+        return Watchdog::_enabled.load(std::memory_order_relaxed);
+      }
+
+      // -1 when the watchdog is off, a thread ends its scopes in the opposite order it began them
+      static int64_t begin(const char* origin, const std::string& name);
+      static void end(int64_t id);
+
+      // the latest stalls, oldest first
+      static std::vector<WatchdogStall> stalls();
+      static void clear();
+
+      // the stalls, what is running right now and the percentiles of the queue ages
+      static nlohmann::json report();
+
+    private:
+      static std::atomic<bool> _enabled;
+  };
+
+  class WatchdogScope {
+    public:
+      WatchdogScope(const char* origin, const std::string& name);
+      ~WatchdogScope();
+
+    private:
+      int64_t _id;
+  };
+
+}
@@ -12,6 +12,7 @@ import com.github.helloiampau.janus.generated.Protocol;
 import com.github.helloiampau.janus.generated.SdpConstraints;
 import com.github.helloiampau.janus.generated.SdpType;
 import com.github.helloiampau.janus.generated.VideoConstraints;
+import com.github.helloiampau.janus.generated.VideoEncoding;
 import com.github.helloiampau.janusclientsdk.JanusDelegate;
 
 import org.webrtc.AudioSource;
@@ -25,6 +26,7 @@ import org.webrtc.MediaStream;
 import org.webrtc.MediaStreamTrack;
 import org.webrtc.PeerConnection;
 import org.webrtc.PeerConnectionFactory;
+import org.webrtc.RtpParameters;
 import org.webrtc.RtpReceiver;
 import org.webrtc.RtpTransceiver;
 import org.webrtc.SdpObserver;
@@ -38,6 +40,7 @@ import java.nio.ByteBuffer;
 import java.nio.charset.Charset;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.Collections;
 import java.util.List;
 import java.util.function.Consumer;
 
@@ -58,6 +61,7 @@ public class PeerImpl extends Peer implements PeerConnection.Observer, DataChann
   private PeerConnectionFactory _pcFactory;
   private EglBase _rootEglBase;
 
+  private PeerConnection.RTCConfiguration _rtcConf;
   private PeerConnection _peerConnection;
   private MutableMediaBundle _mediaBundle;
 
@@ -80,11 +84,11 @@ public class PeerImpl extends Peer implements PeerConnection.Observer, DataChann
       iceServers.add(iceServer);
     }
 
-    PeerConnection.RTCConfiguration rtcConf = new PeerConnection.RTCConfiguration(iceServers);
-    rtcConf.sdpSemantics = PeerConnection.SdpSemantics.UNIFIED_PLAN;
-    rtcConf.bundlePolicy = PeerConnection.BundlePolicy.MAXBUNDLE;
+    this._rtcConf = new PeerConnection.RTCConfiguration(iceServers);
+    this._rtcConf.sdpSemantics = PeerConnection.SdpSemantics.UNIFIED_PLAN;
+    this._rtcConf.bundlePolicy = PeerConnection.BundlePolicy.MAXBUNDLE;
 
-    this._peerConnection = pcFactory.createPeerConnection(rtcConf, this);
+    this._peerConnection = pcFactory.createPeerConnection(this._rtcConf, this);
 
     this._mediaBundle = new MutableMediaBundle();
   }
@@ -124,8 +128,27 @@ public class PeerImpl extends Peer implements PeerConnection.Observer, DataChann
       VideoTrack videoTrack = this._pcFactory.createVideoTrack("janus-client-video", videoSource);
       videoTrack.setEnabled(true);
 
-      // register local track
-      this._peerConnection.addTrack(videoTrack);
+      // register local track, one send encoding per simulcast layer
+      ArrayList<VideoEncoding> encodings = videoConstraints.getEncodings();
+      if(encodings == null || encodings.isEmpty() == true) {
+        this._peerConnection.addTrack(videoTrack);
+      } else {
+        List<RtpParameters.Encoding> sendEncodings = new ArrayList<>();
+        for(VideoEncoding encoding : encodings) {
+          RtpParameters.Encoding sendEncoding = new RtpParameters.Encoding(encoding.getRid(), true, encoding.getScaleDown());
+          // an unset cap stays null, 0 would mute the layer
+          if(encoding.getMaxBitrate() > 0) {
+            sendEncoding.maxBitrateBps = encoding.getMaxBitrate() * 1000;
+          }
+          if(encoding.getMaxFps() > 0) {
+            sendEncoding.maxFramerate = encoding.getMaxFps();
+          }
+          sendEncodings.add(sendEncoding);
+        }
+
+        RtpTransceiver.RtpTransceiverInit init = new RtpTransceiver.RtpTransceiverInit(RtpTransceiver.RtpTransceiverDirection.SEND_ONLY, Collections.emptyList(), sendEncodings);
+        this._peerConnection.addTransceiver(videoTrack, init);
+      }
       this._mediaBundle.localVideoTrack(videoTrack);
     }
 
@@ -147,6 +170,13 @@ public class PeerImpl extends Peer implements PeerConnection.Observer, DataChann
     return this._mediaBundle;
   }
 
+  @Override
+  public void prepare(Constraints constraints) {
+    // a candidate pool makes the peer connection gather before any local description exists
+    this._rtcConf.iceCandidatePoolSize = constraints.getIceCandidatePoolSize();
+    this._peerConnection.setConfiguration(this._rtcConf);
+  }
+
   @Override
   public void createOffer(Constraints constraints, Bundle context) {
     this.getUserMedia(constraints);
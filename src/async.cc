@@ -1,10 +1,12 @@
 #include "janus/async.h"
 
+#include "janus/metrics_impl.h"
+
 namespace Janus {
 
-  AsyncImpl::AsyncImpl() {
-    for(unsigned index = 0; index < THREAD_POOL_SIZE; index++) {
-      this->_threads[index] = std::thread(this->_loop, this);
+  AsyncImpl::AsyncImpl(unsigned threads) {
+    for(unsigned index = 0; index < threads; index++) {
+      this->_threads.emplace_back(this->_loop, this);
     }
   }
 
@@ -16,14 +18,23 @@ namespace Janus {
 
     this->_notEmpty.notify_all();
 
-    for(unsigned index = 0; index < THREAD_POOL_SIZE; index++) {
-      this->_threads[index].join();
+    for(auto& thread : this->_threads) {
+      thread.join();
     }
+
+    // the tasks left behind never run
+    MetricsRegistry::instance().gauge(METRIC_ASYNC_QUEUE_DEPTH).add(-(int64_t) this->_queue.size());
   }
 
   void AsyncImpl::submit(Task task) {
+    static auto& tasks = MetricsRegistry::instance().counter(METRIC_ASYNC_TASKS);
+    static auto& depth = MetricsRegistry::instance().gauge(METRIC_ASYNC_QUEUE_DEPTH);
+
+    tasks.add();
+    depth.add(1);
+
     std::lock_guard<std::mutex> lock(this->_queueMutex);
-    this->_queue.push(task);
+    this->_queue.emplace(task, MetricsRegistry::now());
 
     this->_notEmpty.notify_one();
   }
@@ -34,6 +45,9 @@ namespace Janus {
   }
 
   void* AsyncImpl::_loop(AsyncImpl* context) {
+    static auto& depth = MetricsRegistry::instance().gauge(METRIC_ASYNC_QUEUE_DEPTH);
+    static auto& queueUs = MetricsRegistry::instance().histogram(METRIC_ASYNC_QUEUE_US);
+
     while(context->_isEnabled() == true) {
       std::unique_lock<std::mutex> lock(context->_queueMutex);
       context->_notEmpty.wait(lock, [context] {
@@ -44,9 +58,13 @@ namespace Janus {
         return nullptr;
       }
 
-      Task task = context->_queue.front();
+      Task task = context->_queue.front().first;
+      auto queued = context->_queue.front().second;
       context->_queue.pop();
 
+      depth.add(-1);
+      queueUs.record(MetricsRegistry::now() - queued);
+
       lock.unlock();
       context->_notEmpty.notify_one();
 
@@ -56,4 +74,97 @@ namespace Janus {
     return nullptr;
   }
 
+  /* Callback Queue */
+
+  void CallbackQueue::submit(Task task) {
+    {
+      std::lock_guard<std::mutex> lock(this->_queueMutex);
+      this->_queue.push(task);
+    }
+
+    this->_notEmpty.notify_one();
+  }
+
+  int CallbackQueue::drain(std::chrono::milliseconds timeout) {
+    std::queue<Task> tasks;
+
+    {
+      std::unique_lock<std::mutex> lock(this->_queueMutex);
+      this->_notEmpty.wait_for(lock, timeout, [this] {
+        return this->_queue.empty() == false;
+      });
+
+      // the tasks run unlocked, they may well submit more
+      std::swap(tasks, this->_queue);
+    }
+
+    int ran = 0;
+    while(tasks.empty() == false) {
+      tasks.front()();
+      tasks.pop();
+      ran++;
+    }
+
+    return ran;
+  }
+
+  /* Scheduler */
+
+  SchedulerImpl::SchedulerImpl() {
+    this->_thread = std::thread(&SchedulerImpl::_tick, this->_state);
+  }
+
+  SchedulerImpl::~SchedulerImpl() {
+    {
+      std::lock_guard<std::mutex> lock(this->_state->mutex);
+      this->_state->running = false;
+    }
+
+    this->_state->timer.notify_all();
+
+    // the last owner can go away from one of its own tasks, the loop then ends on the state it holds
+    if(this->_thread.get_id() == std::this_thread::get_id()) {
+      this->_thread.detach();
+
+      return;
+    }
+
+    this->_thread.join();
+  }
+
+  void SchedulerImpl::post(int64_t delay, const Task& task) {
+    {
+      std::lock_guard<std::mutex> lock(this->_state->mutex);
+      this->_state->pending.emplace(std::chrono::steady_clock::now() + std::chrono::milliseconds(delay), task);
+    }
+
+    this->_state->timer.notify_one();
+  }
+
+  void SchedulerImpl::_tick(std::shared_ptr<State> state) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+
+    while(state->running == true) {
+      if(state->pending.empty() == true) {
+        state->timer.wait(lock);
+        continue;
+      }
+
+      auto next = state->pending.begin();
+      if(next->first > std::chrono::steady_clock::now()) {
+        state->timer.wait_until(lock, next->first);
+        continue;
+      }
+
+      auto task = next->second;
+      state->pending.erase(next);
+
+      lock.unlock();
+      task();
+      // the task may hold the last owner of the scheduler, it goes before the lock is taken again
+      task = nullptr;
+      lock.lock();
+    }
+  }
+
 }
@@ -0,0 +1,226 @@
+#include "janus/candidate_filter.h"
+
+#include <cctype>
+#include <cstring>
+
+namespace Janus {
+
+  namespace {
+
+    bool nextToken(const char*& cursor, const char* end, const char*& token, size_t& size) {
+      while(cursor < end && *cursor == ' ') {
+        cursor++;
+      }
+
+      if(cursor == end) {
+        return false;
+      }
+
+      token = cursor;
+      while(cursor < end && *cursor != ' ') {
+        cursor++;
+      }
+      size = cursor - token;
+
+      return true;
+    }
+
+    bool startsWith(const char* token, size_t size, const char* prefix) {
+      auto length = std::strlen(prefix);
+      if(size < length) {
+        return false;
+      }
+
+      for(size_t i = 0; i < length; i++) {
+        if(std::tolower((unsigned char) token[i]) != prefix[i]) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    bool equals(const char* token, size_t size, const char* literal) {
+      return size == std::strlen(literal) && startsWith(token, size, literal);
+    }
+
+  }
+
+  bool parseCandidate(const std::string& line, CandidateInfo& info) {
+    return parseCandidate(line.data(), line.size(), info);
+  }
+
+  bool parseCandidate(const char* data, size_t size, CandidateInfo& info) {
+    const char* cursor = data;
+    const char* end = cursor + size;
+    const char* token = nullptr;
+    size_t length = 0;
+
+    // candidate:foundation component transport priority address port typ type ...
+    if(nextToken(cursor, end, token, length) == false) {
+      return false;
+    }
+
+    if(startsWith(token, length, "a=") == true) {
+      token += 2;
+      length -= 2;
+    }
+
+    if(startsWith(token, length, "candidate:") == false) {
+      return false;
+    }
+
+    if(nextToken(cursor, end, token, length) == false) {
+      return false;
+    }
+    info.component = 0;
+    for(size_t i = 0; i < length && std::isdigit((unsigned char) token[i]); i++) {
+      info.component = info.component * 10 + (token[i] - '0');
+    }
+
+    if(nextToken(cursor, end, token, length) == false) {
+      return false;
+    }
+    info.transport = equals(token, length, "udp") ? UDP : equals(token, length, "tcp") ? TCP : UNKNOWN_TRANSPORT;
+
+    // the priority is not needed
+    if(nextToken(cursor, end, token, length) == false || nextToken(cursor, end, token, length) == false) {
+      return false;
+    }
+
+    info.ipv6 = std::memchr(token, ':', length) != nullptr;
+    info.linkLocal = info.ipv6 == true ? startsWith(token, length, "fe8") || startsWith(token, length, "fe9") || startsWith(token, length, "fea") || startsWith(token, length, "feb") : startsWith(token, length, "169.254.");
+
+    if(nextToken(cursor, end, token, length) == false || nextToken(cursor, end, token, length) == false || equals(token, length, "typ") == false) {
+      return false;
+    }
+
+    if(nextToken(cursor, end, token, length) == false) {
+      return false;
+    }
+
+    info.type = UNKNOWN_TYPE;
+    if(equals(token, length, "host") == true) {
+      info.type = HOST;
+    } else if(equals(token, length, "srflx") == true) {
+      info.type = SRFLX;
+    } else if(equals(token, length, "prflx") == true) {
+      info.type = PRFLX;
+    } else if(equals(token, length, "relay") == true) {
+      info.type = RELAY;
+    }
+
+    return true;
+  }
+
+  void CandidateFilter::configure(const CandidatePolicy& policy) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_policy = policy;
+  }
+
+  bool CandidateFilter::accept(int64_t handleId, const std::string& line) {
+    SdpSlice slice;
+    slice.data = line.data();
+    slice.size = line.size();
+
+    return this->accept(handleId, slice);
+  }
+
+  bool CandidateFilter::accept(int64_t handleId, const SdpSlice& line) {
+    CandidateInfo info;
+    auto parsed = parseCandidate(line.data, line.size, info);
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto& gathered = this->_handles[handleId];
+
+    // a line that cannot be read here is left to janus to judge
+    if(parsed == false) {
+      gathered.stats.accepted++;
+      this->_stats.accepted++;
+
+      return true;
+    }
+
+    if(this->_policy.dropLinkLocal == true && info.linkLocal == true) {
+      return this->_drop(gathered, CandidateDrop::LINK_LOCAL);
+    }
+
+    if(this->_policy.relayOnly == true && info.type != RELAY) {
+      return this->_drop(gathered, CandidateDrop::NOT_RELAY);
+    }
+
+    if(this->_policy.dropTcp == true && info.transport == TCP) {
+      return this->_drop(gathered, CandidateDrop::TCP_TRANSPORT);
+    }
+
+    if(info.type == HOST) {
+      if(this->_policy.maxHost != CANDIDATE_UNLIMITED && gathered.host >= this->_policy.maxHost) {
+        return this->_drop(gathered, CandidateDrop::HOST_LIMIT);
+      }
+
+      gathered.host++;
+    }
+
+    if(info.type == RELAY) {
+      if(this->_policy.maxRelay != CANDIDATE_UNLIMITED && gathered.relay >= this->_policy.maxRelay) {
+        return this->_drop(gathered, CandidateDrop::RELAY_LIMIT);
+      }
+
+      gathered.relay++;
+    }
+
+    gathered.stats.accepted++;
+    this->_stats.accepted++;
+
+    return true;
+  }
+
+  std::shared_ptr<SessionDescription> CandidateFilter::filter(int64_t handleId, const std::shared_ptr<SessionDescription>& description) {
+    std::vector<SdpSlice> dropped;
+    for(size_t media = 0; media < description->mediaCount(); media++) {
+      for(auto& candidate : description->candidates(media)) {
+        if(this->accept(handleId, candidate) == false) {
+          dropped.push_back(candidate);
+        }
+      }
+    }
+
+    if(dropped.empty() == true) {
+      return description;
+    }
+
+    return std::make_shared<SessionDescription>(description->without(dropped));
+  }
+
+  void CandidateFilter::reset(int64_t handleId) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_handles.erase(handleId);
+  }
+
+  CandidateStats CandidateFilter::stats() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_stats;
+  }
+
+  CandidateStats CandidateFilter::stats(int64_t handleId) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto entry = this->_handles.find(handleId);
+    if(entry == this->_handles.end()) {
+      return CandidateStats();
+    }
+
+    return entry->second.stats;
+  }
+
+  bool CandidateFilter::_drop(Gathered& gathered, CandidateDrop reason) {
+    gathered.stats.dropped[reason]++;
+    this->_stats.dropped[reason]++;
+
+    return false;
+  }
+
+}
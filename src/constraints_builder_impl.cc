@@ -10,9 +10,9 @@ namespace Janus {
   Constraints ConstraintsBuilderImpl::build() {
     auto sdp = SdpConstraints(this->_send_audio, this->_send_video, this->_receive_audio, this->_receive_video, this->_datachannel);
 
-    auto video = VideoConstraints(this->_width, this->_height, this->_fps, this->_camera);
+    auto video = VideoConstraints(this->_width, this->_height, this->_fps, this->_camera, this->_encodings);
 
-    return Constraints(sdp, video);
+    return Constraints(sdp, video, this->_ice_candidate_pool_size);
   }
 
   std::shared_ptr<ConstraintsBuilder> ConstraintsBuilderImpl::datachannel(bool enable) {
@@ -53,6 +53,18 @@ namespace Janus {
     return this->shared_from_this();
   }
 
+  std::shared_ptr<ConstraintsBuilder> ConstraintsBuilderImpl::encoding(const std::string& rid, double scale_down, int32_t max_bitrate, int32_t max_fps) {
+    this->_encodings.push_back(VideoEncoding(rid, scale_down, max_bitrate, max_fps));
+
+    return this->shared_from_this();
+  }
+
+  std::shared_ptr<ConstraintsBuilder> ConstraintsBuilderImpl::ice_candidate_pool(int32_t size) {
+    this->_ice_candidate_pool_size = size;
+
+    return this->shared_from_this();
+  }
+
   std::shared_ptr<ConstraintsBuilder> ConstraintsBuilderImpl::camera(Camera camera) {
     this->_camera = camera;
 
@@ -25,9 +25,11 @@ namespace Janus {
   HttpImpl::HttpImpl(const std::string& baseUrl) {
     curl_global_init(CURL_GLOBAL_ALL);
     this->_baseUrl = baseUrl;
+    this->_handle = curl_easy_init();
   }
 
   HttpImpl::~HttpImpl() {
+    curl_easy_cleanup(this->_handle);
     curl_global_cleanup();
   }
 
@@ -40,7 +42,8 @@ namespace Janus {
   }
 
   std::shared_ptr<HttpResponse> HttpImpl::_request(const std::string& path, const std::string& method, const std::string& body) {
-    auto handle = curl_easy_init();
+    auto handle = this->_handle;
+    curl_easy_reset(handle);
 
     curl_easy_setopt(handle, CURLOPT_USERAGENT, "Janus Native HTTP Client");
 
@@ -65,7 +68,6 @@ namespace Janus {
     }
 
     curl_slist_free_all(headers);
-    curl_easy_cleanup(handle);
 
     return std::make_shared<HttpResponse>(status, bodyString);
   }
@@ -3,9 +3,40 @@
 #include "janus/bundle_impl.h"
 #include "janus/janus_error.hpp"
 #include "janus/janus_commands.hpp"
+#include "janus/metrics_impl.h"
+#include "janus/spans.h"
+#include "janus/watchdog.h"
 
 namespace Janus {
 
+  namespace {
+
+    // the batches open on this thread, outermost first: each api with where its messages go
+    thread_local std::vector<std::pair<JanusApi*, std::vector<TransportMessage>*>> openBatches;
+
+    std::vector<TransportMessage>* openBatchOf(JanusApi* api) {
+      for(auto& entry : openBatches) {
+        if(entry.first == api) {
+          return entry.second;
+        }
+      }
+
+      return nullptr;
+    }
+
+    // closes the batch even when a dispatch throws
+    struct BatchScope {
+      BatchScope(JanusApi* api, std::vector<TransportMessage>* batch) {
+        openBatches.emplace_back(api, batch);
+      }
+
+      ~BatchScope() {
+        openBatches.pop_back();
+      }
+    };
+
+  }
+
   /* Janus API message Factories */
   
   namespace Messages {
@@ -66,6 +97,55 @@ namespace Janus {
       };
     }
 
+    nlohmann::json detach(const std::string& transaction, int64_t handleId) {
+      return {
+        { "janus", JanusCommands::DETACH },
+        { "transaction", transaction },
+        { "handle_id", handleId }
+      };
+    }
+
+    nlohmann::json candidateFilter(const CandidateStats& stats) {
+      return {
+        { "janus", "candidate-filter" },
+        { "accepted", stats.accepted },
+        { "dropped", stats.droppedTotal() },
+        { "dropped_link_local", stats.dropped[CandidateDrop::LINK_LOCAL] },
+        { "dropped_not_relay", stats.dropped[CandidateDrop::NOT_RELAY] },
+        { "dropped_tcp", stats.dropped[CandidateDrop::TCP_TRANSPORT] },
+        { "dropped_host_limit", stats.dropped[CandidateDrop::HOST_LIMIT] },
+        { "dropped_relay_limit", stats.dropped[CandidateDrop::RELAY_LIMIT] }
+      };
+    }
+
+    nlohmann::json setupTiming(int64_t handleId, const HandleTimeline& timeline, const CandidateStats& candidates) {
+      std::string flow = "";
+      for(auto& request : timeline.requests) {
+        flow += (flow.empty() == true ? "" : "+") + request;
+      }
+
+      nlohmann::json msg = {
+        { "janus", "setup-timing" },
+        { "sender", handleId },
+        { "flow", flow },
+        { "sends", timeline.sends },
+        // the gathering counts from the attach, a handle still gathering has not completed
+        { "ice", {
+          { "candidates", candidates.accepted },
+          { "candidates_dropped", candidates.droppedTotal() },
+          { "first_candidate", timeline.between("attach", "first_candidate") },
+          { "completed", timeline.between("attach", "trickle_complete") }
+        } }
+      };
+
+      for(auto& stage : { "create", "attach", "prepare", "request", "join", "offer", "answer_applied", "first_candidate", "trickle_complete", "webrtcup", "media" }) {
+        auto mark = timeline.marks.find(stage);
+        msg[stage] = mark != timeline.marks.end() ? mark->second : -1;
+      }
+
+      return msg;
+    }
+
   }
 
   /* Janus API */
@@ -73,6 +153,8 @@ namespace Janus {
   JanusApi::JanusApi(const std::shared_ptr<Random>& random, const std::shared_ptr<TransportFactory>& transportFactory) {
     this->_transportFactory = transportFactory;
     this->_random = random;
+    this->_queries = std::make_shared<QueryCache>();
+    this->_candidates = std::make_shared<CandidateFilter>();
   }
 
   JanusApi::~JanusApi() {
@@ -82,6 +164,12 @@ namespace Janus {
   void JanusApi::init(const std::shared_ptr<JanusConf>& conf, const std::shared_ptr<Platform>& platform, const std::shared_ptr<ProtocolDelegate>& delegate) {
     this->readyState(ReadyState::INIT);
 
+    {
+      std::lock_guard<std::mutex> lock(this->_timelinesMutex);
+      this->_session = HandleTimeline();
+    }
+    this->_queries->invalidate();
+
     this->_transport = this->_transportFactory->create(conf->url(), this->shared_from_this());
     this->_delegate = delegate;
     this->_platform = std::static_pointer_cast<PlatformImpl>(platform);
@@ -92,32 +180,53 @@ namespace Janus {
   }
 
   void JanusApi::dispatch(const std::string& command, const std::shared_ptr<Bundle>& payload) {
+    static auto& dispatches = MetricsRegistry::instance().counter(METRIC_API_DISPATCHES);
+    static auto& pluginCommands = MetricsRegistry::instance().counter(METRIC_PLUGIN_COMMANDS);
+
+    dispatches.add();
+    WatchdogScope watch(WATCHDOG_COMMAND, command);
+
+    if(Spans::enabled() == true) {
+      payload->setInt(SPAN_DISPATCH_KEY, Spans::now());
+    }
+
     payload->setString("command", command);
     auto transaction = this->_random->generate();
     auto handleId = this->handleId(payload);
 
     if(command == JanusCommands::CREATE) {
       auto msg = Messages::create(transaction);
-      this->_transport->send(msg, payload);
+      this->_send(msg, payload);
 
       return;
     }
 
     if(command == JanusCommands::ATTACH) {
       auto plugin = payload->getString("plugin", "");
-      this->_transport->send(Messages::attach(transaction, plugin), payload);
+      this->_send(Messages::attach(transaction, plugin), payload);
 
       return;
     }
 
     if(command == JanusCommands::DESTROY) {
-      this->_transport->send(Messages::destroy(transaction), payload);
+      this->_send(Messages::destroy(transaction), payload);
 
       return;
     }
 
     if(command == JanusCommands::HANGUP) {
-      this->_transport->send(Messages::hangup(transaction, handleId), payload);
+      this->_send(Messages::hangup(transaction, handleId), payload);
+
+      return;
+    }
+
+    if(command == JanusCommands::DETACH) {
+      {
+        std::lock_guard<std::mutex> lock(this->_timelinesMutex);
+        this->_timelines.erase(handleId);
+      }
+
+      this->_send(Messages::detach(transaction, handleId), payload);
 
       return;
     }
@@ -128,23 +237,68 @@ namespace Janus {
       auto candidate = payload->getString("candidate", "");
 
       auto msg = Messages::trickle(transaction, handleId, sdpMid, sdpMLineIndex, candidate);
-      this->_transport->send(msg, payload);
+      this->_send(msg, payload);
 
       return;
     }
 
     if(command == JanusCommands::TRICKLE_COMPLETED) {
       auto msg = Messages::trickleCompleted(transaction, handleId);
-      this->_transport->send(msg, payload);
+      this->_send(msg, payload);
+
+      return;
+    }
+
+    if(command == JanusCommands::CANDIDATE_FILTER) {
+      CandidatePolicy policy;
+      policy.dropLinkLocal = payload->getBool("drop_link_local", false);
+      policy.relayOnly = payload->getBool("relay_only", false);
+      policy.dropTcp = payload->getBool("drop_tcp", false);
+      policy.maxHost = payload->getInt("max_host", CANDIDATE_UNLIMITED);
+      policy.maxRelay = payload->getInt("max_relay", CANDIDATE_UNLIMITED);
+      this->_candidates->configure(policy);
+
+      auto evt = std::make_shared<JanusEventImpl>(handleId, Messages::candidateFilter(this->_candidates->stats()));
+      this->_delegate->onEvent(evt, payload);
 
       return;
     }
 
+    if(command == JanusCommands::PREPARE) {
+      this->_mark(handleId, "prepare");
+    }
+
     if(this->_plugin != nullptr) {
+      pluginCommands.add();
       this->_plugin->command(command, payload);
     }
   }
 
+  void JanusApi::dispatchBatch(const std::vector<std::shared_ptr<Bundle>>& payloads) {
+    // a batch dispatched from within another one of this api, a plugin command for instance, joins it
+    if(openBatchOf(this) != nullptr) {
+      for(auto& payload : payloads) {
+        this->dispatch(payload->getString("command", ""), payload);
+      }
+
+      return;
+    }
+
+    std::vector<TransportMessage> batch;
+    {
+      BatchScope scope(this, &batch);
+
+      for(auto& payload : payloads) {
+        auto command = payload->getString("command", "");
+        this->dispatch(command, payload);
+      }
+    }
+
+    if(batch.empty() == false) {
+      this->_transport->sendBatch(batch);
+    }
+  }
+
   void JanusApi::hangup() {
     auto bundle = Bundle::create();
     this->dispatch(JanusCommands::HANGUP, bundle);
@@ -162,10 +316,29 @@ namespace Janus {
   }
 
   void JanusApi::onMessage(const nlohmann::json& message, const std::shared_ptr<Bundle>& context) {
+    static auto& messages = MetricsRegistry::instance().counter(METRIC_API_MESSAGES);
+    static auto& errors = MetricsRegistry::instance().counter(METRIC_API_ERRORS);
+    static auto& events = MetricsRegistry::instance().counter(METRIC_API_EVENTS);
+    static auto& hangups = MetricsRegistry::instance().counter(METRIC_API_HANGUPS);
+    static auto& sessions = MetricsRegistry::instance().gauge(METRIC_API_SESSIONS);
+    static auto& pluginEvents = MetricsRegistry::instance().counter(METRIC_PLUGIN_EVENTS);
+
+    messages.add();
+
     auto header = message.value("janus", "");
     auto str = message.dump();
 
+    auto query = context->getString("query", "");
+    if(query.empty() == false && (header == "success" || header == "error")) {
+      context->setString("query", "");
+      this->_onQueryResult(query, message);
+
+      return;
+    }
+
     if(header == "error") {
+      errors.add();
+
       auto errorContent = message.value("error", nlohmann::json::object());
       auto code = errorContent.value("code", -1);
       auto reason = errorContent.value("reason", "");
@@ -179,6 +352,12 @@ namespace Janus {
     if(header == "success" && context->getString("command", "") == JanusCommands::CREATE) {
       auto id = message.value("data", nlohmann::json::object()).value("id", (int64_t) 0);
       auto idAsString = std::to_string(id);
+
+      {
+        std::lock_guard<std::mutex> lock(this->_timelinesMutex);
+        this->_session.mark("create");
+      }
+
       this->_transport->sessionId(idAsString);
       this->dispatch(JanusCommands::ATTACH, context);
 
@@ -191,7 +370,10 @@ namespace Janus {
       auto pluginId = context->getString("plugin", "");
       this->_plugin = this->_platform->plugin(pluginId, this->_handleId, this->shared_from_this());
 
+      this->_startTimeline(this->_handleId);
+
       this->readyState(ReadyState::READY);
+      sessions.add(1);
       this->_delegate->onReady();
 
       return;
@@ -200,15 +382,35 @@ namespace Janus {
     if(header == "success" && context->getString("command", "") == JanusCommands::DESTROY) {
       this->_transport->close();
       this->readyState(ReadyState::CLOSED);
+      sessions.add(-1);
+
+      // the transport is off, the queries still in flight will never hear back and the cached replies belong to the old session
+      this->_queries->invalidate();
+      JanusError abandoned(-1, "the session closed before the query got a reply");
+      for(auto& waiter : this->_queries->abandon()) {
+        this->_delegate->onError(abandoned, waiter);
+      }
+
       this->_delegate->onClose();
 
       return;
     }
 
     if(header == "hangup") {
+      hangups.add();
+
+      auto sender = message.value("sender", this->_handleId);
+      {
+        std::lock_guard<std::mutex> lock(this->_timelinesMutex);
+        this->_timelines.erase(sender);
+      }
+
       auto reason = message.value("reason", "");
 
-      this->_plugin->onHangup(reason);
+      // the plugin closes the peer of the handle that hung up, not every one it has
+      auto hangupContext = Bundle::create();
+      hangupContext->setInt("handleId", sender);
+      this->_plugin->onHangup(reason, hangupContext);
       this->_delegate->onHangup(reason);
 
       return;
@@ -217,9 +419,21 @@ namespace Janus {
     auto sender = message.value("sender", this->_handleId);
 
     if(header == "event") {
+      SpanScope span("plugin", message);
+      WatchdogScope watch(WATCHDOG_PLUGIN, Watchdog::enabled() == true ? message.value("plugindata", nlohmann::json::object()).value("plugin", "") : "");
+      events.add();
+      pluginEvents.add();
+
       auto data = message.value("plugindata", nlohmann::json::object()).value("data", nlohmann::json::object());
       auto jsep = message.value("jsep", nlohmann::json::object());
 
+      // the first answer of the plugin, then the offer janus brings
+      this->_mark(sender, "join");
+      auto type = jsep.value("type", "");
+      if(type == "offer") {
+        this->_mark(sender, type);
+      }
+
       std::shared_ptr<JanusEventImpl> evt;
       if(jsep.empty()) {
         evt = std::make_shared<JanusEventImpl>(sender, data);
@@ -228,12 +442,33 @@ namespace Janus {
       }
       this->_plugin->onEvent(evt, context);
 
+      // the plugin handed the answer of janus to its peer
+      if(type == "answer") {
+        this->_mark(sender, "answer_applied");
+      }
+
       return;
     }
 
     auto evt = std::make_shared<JanusEventImpl>(sender, message);
 
+    // the media state belongs to the plugin handles, plugins forward it like any other event
+    if((header == "webrtcup" || header == "media") && this->_plugin != nullptr) {
+      WatchdogScope watch(WATCHDOG_PLUGIN, header);
+      pluginEvents.add();
+      this->_mark(sender, header);
+      this->_plugin->onEvent(evt, context);
+
+      if(header == "webrtcup" || message.value("receiving", true) == true) {
+        this->_reportSetup(sender, context);
+      }
+
+      return;
+    }
+
     if(header == "success" && context->getString("command", "") == JanusCommands::ATTACH && this->_plugin != nullptr) {
+      this->_startTimeline(message.value("data", nlohmann::json::object()).value("id", (int64_t) 0));
+
       this->_plugin->onEvent(evt, context);
 
       return;
@@ -243,11 +478,25 @@ namespace Janus {
   }
 
   void JanusApi::onOffer(const std::string& sdp, const std::shared_ptr<Bundle>& context) {
-    this->_plugin->onOffer(sdp, context);
+    auto handleId = this->handleId(context);
+
+    // a peer that does not trickle lists its candidates in the description
+    auto description = this->_candidates->filter(handleId, std::make_shared<SessionDescription>(sdp));
+    this->_described(handleId, description);
+    this->_mark(handleId, "offer");
+    this->_plugin->onOffer(description->str(), context);
   }
 
   void JanusApi::onAnswer(const std::string& sdp, const std::shared_ptr<Bundle>& context) {
-    this->_plugin->onAnswer(sdp, context);
+    auto handleId = this->handleId(context);
+
+    // a peer that does not trickle lists its candidates in the description
+    auto description = this->_candidates->filter(handleId, std::make_shared<SessionDescription>(sdp));
+    this->_described(handleId, description);
+    this->_plugin->onAnswer(description->str(), context);
+
+    // the plugin set the answer on its peer and sent it to janus
+    this->_mark(handleId, "answer_applied");
   }
 
   void JanusApi::onIceCandidate(const std::string& mid, int32_t index, const std::string& sdp, int64_t id) {
@@ -257,6 +506,13 @@ namespace Janus {
     bundle->setString("candidate", sdp);
     bundle->setInt("handleId", id);
 
+    if(this->_candidates->accept(id, sdp) == false) {
+      return;
+    }
+
+    // a candidate the filter drops never reaches janus, so it starts nothing
+    this->_mark(id, "first_candidate");
+
     this->dispatch(JanusCommands::TRICKLE, bundle);
   }
 
@@ -265,6 +521,101 @@ namespace Janus {
     bundle->setInt("handleId", id);
 
     this->dispatch(JanusCommands::TRICKLE_COMPLETED, bundle);
+    this->_mark(id, "trickle_complete");
+
+    // a restart gathers from scratch, so do the candidate limits
+    auto candidates = this->_candidates->stats(id);
+    this->_candidates->reset(id);
+
+    this->_gathered(id, candidates);
+  }
+
+  void JanusApi::_startTimeline(int64_t handleId) {
+    std::lock_guard<std::mutex> lock(this->_timelinesMutex);
+
+    auto timeline = this->_session;
+    timeline.mark("attach");
+    this->_timelines[handleId] = timeline;
+  }
+
+  void JanusApi::_mark(int64_t handleId, const std::string& stage) {
+    std::lock_guard<std::mutex> lock(this->_timelinesMutex);
+
+    auto entry = this->_timelines.find(handleId);
+    if(entry != this->_timelines.end()) {
+      entry->second.mark(stage);
+    }
+  }
+
+  // a description without a section that sends, the data channel aside, belongs to a handle that only receives
+  void JanusApi::_described(int64_t handleId, const std::shared_ptr<SessionDescription>& description) {
+    auto sends = description->mediaCount() == 0;
+    for(size_t media = 0; media < description->mediaCount() && sends == false; media++) {
+      SdpSlice direction;
+      auto receives = description->attribute(media, "recvonly", direction) == true || description->attribute(media, "inactive", direction) == true;
+      sends = receives == false && description->kind(media).equals("application") == false;
+    }
+
+    std::lock_guard<std::mutex> lock(this->_timelinesMutex);
+
+    auto entry = this->_timelines.find(handleId);
+    if(entry != this->_timelines.end()) {
+      entry->second.sends = sends;
+    }
+  }
+
+  void JanusApi::_gathered(int64_t handleId, const CandidateStats& candidates) {
+    std::lock_guard<std::mutex> lock(this->_timelinesMutex);
+
+    auto entry = this->_timelines.find(handleId);
+    if(entry != this->_timelines.end() && entry->second.gathered == false) {
+      entry->second.gathered = true;
+      entry->second.candidates = candidates;
+    }
+  }
+
+  // one report per handle, the timeline goes with it
+  void JanusApi::_reportSetup(int64_t handleId, const std::shared_ptr<Bundle>& context) {
+    std::unique_lock<std::mutex> lock(this->_timelinesMutex);
+    auto entry = this->_timelines.find(handleId);
+    if(entry == this->_timelines.end()) {
+      return;
+    }
+
+    // a handle that sends is set up once janus gets its media, webrtcup is not enough
+    if(entry->second.sends == true && entry->second.marks.count("media") == 0) {
+      return;
+    }
+
+    // a handle still gathering reports the candidates so far
+    auto candidates = entry->second.gathered == true ? entry->second.candidates : this->_candidates->stats(handleId);
+    auto msg = Messages::setupTiming(handleId, entry->second, candidates);
+    this->_timelines.erase(entry);
+    lock.unlock();
+
+    auto evt = std::make_shared<JanusEventImpl>(handleId, msg);
+    this->_delegate->onEvent(evt, context);
+  }
+
+  void JanusApi::_send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context) {
+    // from the dispatch to the message, once: later sends of the same context did not come from it
+    if(Spans::enabled() == true && context != nullptr) {
+      auto dispatched = context->getInt(SPAN_DISPATCH_KEY, -1);
+      if(dispatched >= 0) {
+        context->setInt(SPAN_DISPATCH_KEY, -1);
+        Spans::record("dispatch", transactionOf(message), dispatched, Spans::now());
+      }
+    }
+
+    // the batch belongs to the thread that opened it, the other threads keep sending right away
+    auto batch = openBatchOf(this);
+    if(batch != nullptr) {
+      batch->emplace_back(message, context);
+
+      return;
+    }
+
+    this->_transport->send(message, context);
   }
 
   ReadyState JanusApi::readyState() {
@@ -286,12 +637,88 @@ namespace Janus {
     auto transaction = this->_random->generate();
     auto handleId = this->handleId(context);
 
+    // what the plugin asked for until the setup ended is its flow
+    auto request = body.value("body", nlohmann::json::object()).value("request", "");
+    if(request.empty() == false) {
+      std::lock_guard<std::mutex> lock(this->_timelinesMutex);
+
+      auto entry = this->_timelines.find(handleId);
+      if(entry != this->_timelines.end()) {
+        entry->second.mark("request");
+        entry->second.requests.push_back(request);
+      }
+    }
+
     auto message = Messages::message(transaction, handleId, body);
-    this->_transport->send(message, context);
+    this->_send(message, context);
   }
 
   void JanusApi::onPluginEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context) {
     this->_delegate->onEvent(event, context);
   }
 
+  void JanusApi::onPluginError(const JanusError& error, const std::shared_ptr<Bundle>& context) {
+    this->_delegate->onError(error, context);
+  }
+
+  void JanusApi::onQuery(const nlohmann::json& body, const std::shared_ptr<Bundle>& context, const std::string& scope) {
+    if(context->getBool("cache", true) == false) {
+      this->onCommandResult(body, context);
+
+      return;
+    }
+
+    auto key = body.dump();
+    nlohmann::json reply;
+
+    auto status = this->_queries->acquire(key, scope, context, reply);
+    if(status == QueryStatus::HIT) {
+      static auto& hits = MetricsRegistry::instance().counter(METRIC_API_QUERY_HITS);
+      hits.add();
+
+      auto sender = reply.value("sender", this->handleId(context));
+      auto evt = std::make_shared<JanusEventImpl>(sender, reply);
+      this->_delegate->onEvent(evt, context);
+
+      return;
+    }
+
+    if(status == QueryStatus::PENDING) {
+      return;
+    }
+
+    context->setString("query", key);
+    this->onCommandResult(body, context);
+  }
+
+  void JanusApi::invalidateQueries(const std::string& scope) {
+    this->_queries->invalidate(scope);
+  }
+
+  void JanusApi::_onQueryResult(const std::string& key, const nlohmann::json& message) {
+    auto header = message.value("janus", "");
+    auto waiters = this->_queries->complete(key, message, header == "success");
+
+    if(header == "error") {
+      static auto& errors = MetricsRegistry::instance().counter(METRIC_API_ERRORS);
+      errors.add();
+
+      auto errorContent = message.value("error", nlohmann::json::object());
+      JanusError error(errorContent.value("code", -1), errorContent.value("reason", ""));
+
+      for(auto& waiter : waiters) {
+        this->_delegate->onError(error, waiter);
+      }
+
+      return;
+    }
+
+    auto sender = message.value("sender", this->_handleId);
+    auto evt = std::make_shared<JanusEventImpl>(sender, message);
+
+    for(auto& waiter : waiters) {
+      this->_delegate->onEvent(evt, waiter);
+    }
+  }
+
 }
@@ -33,31 +33,54 @@ namespace Janus {
     this->_content = body;
   }
 
+  // janus reuses some keys with different types (e.g. "leaving" is either a feed id or "ok"), so a type mismatch falls back too
+
   std::string JanusDataImpl::getString(const std::string& key, const std::string& fallback) {
-    return this->_content.value(key, fallback);
+    auto item = this->_content.find(key);
+    if(item == this->_content.end() || item->is_string() == false) {
+      return fallback;
+    }
+
+    return item->get<std::string>();
   }
 
   int64_t JanusDataImpl::getInt(const std::string& key, int64_t fallback) {
-    return this->_content.value(key, fallback);
+    auto item = this->_content.find(key);
+    if(item == this->_content.end() || item->is_number_integer() == false) {
+      return fallback;
+    }
+
+    return item->get<int64_t>();
   }
 
   bool JanusDataImpl::getBool(const std::string& key, bool fallback) {
-    return this->_content.value(key, fallback);
+    auto item = this->_content.find(key);
+    if(item == this->_content.end() || item->is_boolean() == false) {
+      return fallback;
+    }
+
+    return item->get<bool>();
   }
 
   std::shared_ptr<JanusData> JanusDataImpl::getObject(const std::string& key) {
-    auto child = this->_content.value(key, nlohmann::json::object());
+    auto item = this->_content.find(key);
+    if(item == this->_content.end() || item->is_object() == false) {
+      return std::make_shared<JanusDataImpl>(nlohmann::json::object());
+    }
 
-    return std::make_shared<JanusDataImpl>(child);
+    return std::make_shared<JanusDataImpl>(*item);
   }
 
   std::vector<std::shared_ptr<JanusData>> JanusDataImpl::getList(const std::string & key) {
     std::vector<std::shared_ptr<JanusData>> parsed({});
 
-    std::vector<nlohmann::json> items = this->_content.value(key, std::vector<nlohmann::json>({}));
-    for(unsigned index = 0; index < items.size(); index++) {
-      auto child = std::make_shared<JanusDataImpl>(items[index]);
-      parsed.push_back(child);
+    auto item = this->_content.find(key);
+    if(item == this->_content.end() || item->is_array() == false) {
+      return parsed;
+    }
+
+    for(auto& child : *item) {
+      parsed.push_back(std::make_shared<JanusDataImpl>(child));
     }
 
     return parsed;
@@ -66,16 +89,29 @@ namespace Janus {
   /* Jsepimpl */
 
   JsepImpl::JsepImpl(const nlohmann::json& jsep) {
-    this->_sdp = jsep.value("sdp", "");
+    this->_description = std::make_shared<SessionDescription>(jsep.value("sdp", ""));
     this->_type = jsep.value("type", "") == "offer" ? SdpType::OFFER : SdpType::ANSWER;
   }
 
   std::string JsepImpl::sdp() {
-    return this->_sdp;
+    return this->_description->str();
+  }
+
+  std::shared_ptr<SessionDescription> JsepImpl::description() {
+    return this->_description;
   }
 
   SdpType JsepImpl::type() {
     return this->_type;
   }
 
+  std::shared_ptr<SessionDescription> descriptionOf(const std::shared_ptr<Jsep>& jsep) {
+    auto impl = std::dynamic_pointer_cast<JsepImpl>(jsep);
+    if(impl != nullptr) {
+      return impl->description();
+    }
+
+    return std::make_shared<SessionDescription>(jsep->sdp());
+  }
+
 }
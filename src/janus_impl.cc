@@ -43,6 +43,11 @@ namespace Janus {
     protocol->dispatch(command, payload);
   }
 
+  void JanusImpl::dispatchBatch(const std::vector<std::shared_ptr<Bundle>>& payloads) {
+    auto protocol = this->_platform->protocol();
+    protocol->dispatchBatch(payloads);
+  }
+
   /* Janus */
 
   std::shared_ptr<Janus> Janus::create(const std::shared_ptr<JanusConf>& conf, const std::shared_ptr<Platform>& platform, const std::shared_ptr<ProtocolDelegate>& delegate) {
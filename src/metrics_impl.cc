@@ -0,0 +1,245 @@
+#include "janus/metrics_impl.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Janus {
+
+  namespace {
+
+    int64_t nowMs() {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    int highestBit(uint64_t value) {
+      int bit = 0;
+      while(value >>= 1) {
+        bit++;
+      }
+
+      return bit;
+    }
+
+  }
+
+  /* Counter */
+
+  int64_t MetricCounter::value() {
+    return this->_value.load(std::memory_order_relaxed);
+  }
+
+  void MetricCounter::reset() {
+    this->_value.store(0, std::memory_order_relaxed);
+  }
+
+  /* Gauge */
+
+  void MetricGauge::set(int64_t value) {
+    this->_value.store(value, std::memory_order_relaxed);
+  }
+
+  int64_t MetricGauge::value() {
+    return this->_value.load(std::memory_order_relaxed);
+  }
+
+  /* Histogram */
+
+  MetricHistogramImpl::MetricHistogramImpl() {
+    this->reset();
+  }
+
+  int MetricHistogramImpl::bucketOf(int64_t value) {
+    const int64_t linear = 1 << (METRICS_HISTOGRAM_BITS + 1);
+    if(value < linear) {
+      return (int) value;
+    }
+
+    // the top bits of the value pick the bucket, the lower ones are the error
+    auto shift = highestBit(value) - METRICS_HISTOGRAM_BITS;
+    return (shift << METRICS_HISTOGRAM_BITS) + (int) (value >> shift);
+  }
+
+  int64_t MetricHistogramImpl::highestOf(int bucket) {
+    const int linear = 1 << (METRICS_HISTOGRAM_BITS + 1);
+    if(bucket < linear) {
+      return bucket;
+    }
+
+    auto shift = (bucket >> METRICS_HISTOGRAM_BITS) - 1;
+    uint64_t mantissa = (bucket & ((1 << METRICS_HISTOGRAM_BITS) - 1)) + (1 << METRICS_HISTOGRAM_BITS);
+
+    return (int64_t) (((mantissa + 1) << shift) - 1);
+  }
+
+  void MetricHistogramImpl::record(int64_t value) {
+    if(value < 0) {
+      value = 0;
+    }
+
+    this->_buckets[MetricHistogramImpl::bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    this->_count.fetch_add(1, std::memory_order_relaxed);
+    this->_sum.fetch_add(value, std::memory_order_relaxed);
+
+    auto min = this->_min.load(std::memory_order_relaxed);
+    while(value < min && this->_min.compare_exchange_weak(min, value, std::memory_order_relaxed) == false);
+
+    auto max = this->_max.load(std::memory_order_relaxed);
+    while(value > max && this->_max.compare_exchange_weak(max, value, std::memory_order_relaxed) == false);
+  }
+
+  int64_t MetricHistogramImpl::count() {
+    return this->_count.load(std::memory_order_relaxed);
+  }
+
+  int64_t MetricHistogramImpl::percentile(double quantile) {
+    // the buckets are summed rather than trusting the count, a concurrent record may have bumped only one of them
+    int64_t total = 0;
+    for(auto& bucket : this->_buckets) {
+      total += bucket.load(std::memory_order_relaxed);
+    }
+
+    if(total == 0) {
+      return 0;
+    }
+
+    auto target = std::max((int64_t) 1, (int64_t) std::ceil(quantile * total));
+    auto max = this->_max.load(std::memory_order_relaxed);
+
+    int64_t seen = 0;
+    for(int index = 0; index < METRICS_HISTOGRAM_BUCKETS; index++) {
+      seen += this->_buckets[index].load(std::memory_order_relaxed);
+      if(seen >= target) {
+        return std::min(MetricHistogramImpl::highestOf(index), max);
+      }
+    }
+
+    return max;
+  }
+
+  MetricHistogram MetricHistogramImpl::snapshot(const std::string& name) {
+    auto count = this->count();
+    auto sum = this->_sum.load(std::memory_order_relaxed);
+    auto min = count > 0 ? this->_min.load(std::memory_order_relaxed) : 0;
+    auto max = this->_max.load(std::memory_order_relaxed);
+    double mean = count > 0 ? (double) sum / count : 0;
+
+    return MetricHistogram(name, count, min, max, mean, this->percentile(0.5), this->percentile(0.9), this->percentile(0.99), this->percentile(0.999));
+  }
+
+  void MetricHistogramImpl::reset() {
+    for(auto& bucket : this->_buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+
+    this->_count.store(0, std::memory_order_relaxed);
+    this->_sum.store(0, std::memory_order_relaxed);
+    this->_min.store(INT64_MAX, std::memory_order_relaxed);
+    this->_max.store(0, std::memory_order_relaxed);
+  }
+
+  /* Timer */
+
+  MetricTimer::MetricTimer(MetricHistogramImpl& histogram) : _histogram(histogram) {
+    this->_start = MetricsRegistry::now();
+  }
+
+  MetricTimer::~MetricTimer() {
+    this->_histogram.record(MetricsRegistry::now() - this->_start);
+  }
+
+  /* Registry */
+
+  MetricsRegistry::MetricsRegistry() {
+    this->_resetAt = nowMs();
+  }
+
+  MetricsRegistry& MetricsRegistry::instance() {
+    // never destroyed, the queues and transports that outlive main still update it
+    static auto registry = new MetricsRegistry();
+
+    return *registry;
+  }
+
+  int64_t MetricsRegistry::now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  MetricCounter& MetricsRegistry::counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(this->_metricsMutex);
+
+    auto& metric = this->_counters[name];
+    if(metric == nullptr) {
+      metric.reset(new MetricCounter());
+    }
+
+    return *metric;
+  }
+
+  MetricGauge& MetricsRegistry::gauge(const std::string& name) {
+    std::lock_guard<std::mutex> lock(this->_metricsMutex);
+
+    auto& metric = this->_gauges[name];
+    if(metric == nullptr) {
+      metric.reset(new MetricGauge());
+    }
+
+    return *metric;
+  }
+
+  MetricHistogramImpl& MetricsRegistry::histogram(const std::string& name) {
+    std::lock_guard<std::mutex> lock(this->_metricsMutex);
+
+    auto& metric = this->_histograms[name];
+    if(metric == nullptr) {
+      metric.reset(new MetricHistogramImpl());
+    }
+
+    return *metric;
+  }
+
+  MetricsSnapshot MetricsRegistry::snapshot() {
+    std::unordered_map<std::string, int64_t> counters;
+    std::unordered_map<std::string, int64_t> gauges;
+    std::vector<MetricHistogram> histograms;
+
+    std::lock_guard<std::mutex> lock(this->_metricsMutex);
+    for(auto& entry : this->_counters) {
+      counters[entry.first] = entry.second->value();
+    }
+
+    for(auto& entry : this->_gauges) {
+      gauges[entry.first] = entry.second->value();
+    }
+
+    for(auto& entry : this->_histograms) {
+      histograms.push_back(entry.second->snapshot(entry.first));
+    }
+
+    return MetricsSnapshot(nowMs() - this->_resetAt, counters, gauges, histograms);
+  }
+
+  void MetricsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(this->_metricsMutex);
+    for(auto& entry : this->_counters) {
+      entry.second->reset();
+    }
+
+    for(auto& entry : this->_histograms) {
+      entry.second->reset();
+    }
+
+    this->_resetAt = nowMs();
+  }
+
+  /* Metrics */
+
+  MetricsSnapshot Metrics::snapshot() {
+    return MetricsRegistry::instance().snapshot();
+  }
+
+  void Metrics::reset() {
+    MetricsRegistry::instance().reset();
+  }
+
+}
@@ -0,0 +1,168 @@
+#include "janus/peer_pool.h"
+
+namespace Janus {
+
+  PeerBinding::PeerBinding(const std::shared_ptr<Protocol>& owner) : _id(-1) {
+    this->_owner = owner;
+  }
+
+  void PeerBinding::bind(int64_t id) {
+    this->_id = id;
+  }
+
+  int64_t PeerBinding::id() {
+    return this->_id;
+  }
+
+  std::string PeerBinding::name() {
+    return this->_owner->name();
+  }
+
+  void PeerBinding::init(const std::shared_ptr<JanusConf>& conf, const std::shared_ptr<Platform>& platform, const std::shared_ptr<ProtocolDelegate>& delegate) {
+    this->_owner->init(conf, platform, delegate);
+  }
+
+  void PeerBinding::dispatch(const std::string& command, const std::shared_ptr<Bundle>& payload) {
+    this->_owner->dispatch(command, payload);
+  }
+
+  void PeerBinding::dispatchBatch(const std::vector<std::shared_ptr<Bundle>>& payloads) {
+    this->_owner->dispatchBatch(payloads);
+  }
+
+  void PeerBinding::hangup() {
+    this->_owner->hangup();
+  }
+
+  void PeerBinding::close() {
+    this->_owner->close();
+  }
+
+  void PeerBinding::onOffer(const std::string& sdp, const std::shared_ptr<Bundle>& context) {
+    this->_owner->onOffer(sdp, context);
+  }
+
+  void PeerBinding::onAnswer(const std::string& sdp, const std::shared_ptr<Bundle>& context) {
+    this->_owner->onAnswer(sdp, context);
+  }
+
+  void PeerBinding::onIceCandidate(const std::string& mid, int32_t index, const std::string& sdp, int64_t id) {
+    this->_owner->onIceCandidate(mid, index, sdp, this->_id);
+  }
+
+  void PeerBinding::onIceCompleted(int64_t id) {
+    this->_owner->onIceCompleted(this->_id);
+  }
+
+  PeerPool::PeerPool(const std::shared_ptr<PeerFactory>& factory, const std::shared_ptr<Protocol>& owner, const std::shared_ptr<Async>& async, size_t size) {
+    this->_factory = factory;
+    this->_owner = owner;
+    this->_async = async;
+
+    this->resize(size);
+  }
+
+  PeerPool::~PeerPool() {
+    this->resize(0);
+  }
+
+  std::shared_ptr<Peer> PeerPool::create(int64_t id, const std::shared_ptr<Protocol>& owner) {
+    std::unique_lock<std::mutex> lock(this->_shelf->mutex);
+
+    // warm peers report to the pool owner, anybody else gets a brand new peer
+    if(this->_shelf->idle.empty() == true || owner != this->_owner) {
+      this->_shelf->misses++;
+      lock.unlock();
+
+      this->_refill();
+
+      return this->_factory->create(id, owner);
+    }
+
+    auto warm = this->_shelf->idle.front();
+    this->_shelf->idle.pop_front();
+    this->_shelf->hits++;
+    lock.unlock();
+
+    warm.binding->bind(id);
+    this->_refill();
+
+    return warm.peer;
+  }
+
+  void PeerPool::resize(size_t size) {
+    std::vector<Warm> extra;
+    {
+      std::lock_guard<std::mutex> lock(this->_shelf->mutex);
+      this->_shelf->size = size;
+
+      while(this->_shelf->idle.size() > size) {
+        extra.push_back(this->_shelf->idle.back());
+        this->_shelf->idle.pop_back();
+      }
+    }
+
+    for(auto& warm : extra) {
+      warm.peer->close();
+    }
+
+    this->_refill();
+  }
+
+  void PeerPool::drain() {
+    std::deque<Warm> idle;
+    {
+      std::lock_guard<std::mutex> lock(this->_shelf->mutex);
+      idle.swap(this->_shelf->idle);
+    }
+
+    for(auto& warm : idle) {
+      warm.peer->close();
+    }
+  }
+
+  PeerPoolStats PeerPool::stats() {
+    std::lock_guard<std::mutex> lock(this->_shelf->mutex);
+
+    return { this->_shelf->size, this->_shelf->idle.size(), this->_shelf->hits, this->_shelf->misses };
+  }
+
+  void PeerPool::_refill() {
+    size_t missing = 0;
+    {
+      std::lock_guard<std::mutex> lock(this->_shelf->mutex);
+      auto available = this->_shelf->idle.size() + this->_shelf->pending;
+      if(available < this->_shelf->size) {
+        missing = this->_shelf->size - available;
+        this->_shelf->pending += missing;
+      }
+    }
+
+    auto shelf = this->_shelf;
+    auto factory = this->_factory;
+    auto owner = this->_owner;
+    for(size_t i = 0; i < missing; i++) {
+      this->_async->submit([shelf, factory, owner]() {
+        auto binding = std::make_shared<PeerBinding>(owner);
+        auto peer = factory->create(-1, binding);
+
+        std::unique_lock<std::mutex> lock(shelf->mutex);
+        shelf->pending--;
+
+        // the pool could have shrunk while the peer was being created
+        if(peer == nullptr || shelf->idle.size() >= shelf->size) {
+          lock.unlock();
+
+          if(peer != nullptr) {
+            peer->close();
+          }
+
+          return;
+        }
+
+        shelf->idle.push_back({ peer, binding });
+      });
+    }
+  }
+
+}
@@ -2,8 +2,10 @@
 
 #include "janus/janus_api.h"
 #include "janus/random.h"
+#include "janus/trace.h"
 
 #include "janus/janus_plugins.hpp"
+#include "janus/platform_options.hpp"
 #include "janus/plugins/janus_plugin_echotest.h"
 #include "janus/plugins/janus_plugin_streaming.h"
 #include "janus/plugins/janus_plugin_videoroom.h"
@@ -12,8 +14,25 @@ namespace Janus {
 
   /* PlatformImplImpl */
 
-  PlatformImplImpl::PlatformImplImpl(const std::shared_ptr<PeerFactory>& factory) {
-    auto transportFactory = std::make_shared<TransportFactoryImpl>();
+  PlatformImplImpl::PlatformImplImpl(const std::shared_ptr<PeerFactory>& factory, const std::shared_ptr<Bundle>& options, const std::shared_ptr<Async>& callbacks) {
+    // a thread for each Janus instance unless the app picks another executor
+    auto executor = callbacks;
+    auto choice = options != nullptr ? options->getString(PlatformOptions::CALLBACKS, PlatformOptions::CALLBACKS_THREAD) : PlatformOptions::CALLBACKS_THREAD;
+    if(executor == nullptr && choice == PlatformOptions::CALLBACKS_TRANSPORT) {
+      executor = std::make_shared<InlineAsync>();
+    } else if(executor == nullptr && choice == PlatformOptions::CALLBACKS_QUEUE) {
+      this->_queue = std::make_shared<CallbackQueue>();
+      executor = this->_queue;
+    }
+
+    std::shared_ptr<TransportFactory> transportFactory = std::make_shared<TransportFactoryImpl>(executor);
+
+    // every transport the protocol creates gets recorded, a new trace for each platform
+    auto trace = options != nullptr ? options->getString(PlatformOptions::TRACE, "") : "";
+    if(trace.empty() == false) {
+      transportFactory = std::make_shared<TracingTransportFactory>(transportFactory, std::make_shared<TraceRecorder>(trace));
+    }
+
     auto random = std::make_shared<RandomImpl>();
 
     auto protocol = std::make_shared<JanusApi>(random, transportFactory);
@@ -53,6 +72,14 @@ namespace Janus {
     return this->_peerFactory;
   }
 
+  int32_t PlatformImplImpl::drainCallbacks(int64_t timeoutMs) {
+    if(this->_queue == nullptr) {
+      return 0;
+    }
+
+    return this->_queue->drain(std::chrono::milliseconds(timeoutMs));
+  }
+
   /* Platform */
 
   std::shared_ptr<Platform> Platform::create(const std::shared_ptr<PeerFactory>& factory) {
@@ -61,4 +88,10 @@ namespace Janus {
     return instance;
   }
 
+  std::shared_ptr<Platform> Platform::createWith(const std::shared_ptr<PeerFactory>& factory, const std::shared_ptr<Bundle>& options) {
+    auto instance = std::make_shared<PlatformImplImpl>(factory, options);
+
+    return instance;
+  }
+
 }
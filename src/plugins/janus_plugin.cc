@@ -1,7 +1,29 @@
 #include "janus/plugins/janus_plugin.h"
 
+#include "janus/constraints.hpp"
+#include "janus/metrics_impl.h"
+
+#include <sstream>
+
 namespace Janus {
 
+  namespace {
+
+    std::vector<std::string> splitList(const std::string& list) {
+      std::vector<std::string> items;
+      std::istringstream stream(list);
+      std::string item;
+      while(std::getline(stream, item, ',')) {
+        if(item.empty() == false) {
+          items.push_back(item);
+        }
+      }
+
+      return items;
+    }
+
+  }
+
   JanusPlugin::JanusPlugin(int64_t handleId, const std::shared_ptr<PluginCommandDelegate>& delegate, const std::shared_ptr<PeerFactory>& peerFactory, const std::shared_ptr<Protocol>& owner) {
     this->_delegate = delegate;
     this->_peerFactory = peerFactory;
@@ -10,16 +32,92 @@ namespace Janus {
   }
 
   void JanusPlugin::onClose() {
-    if(this->_peer == nullptr) {
-      return;
+    if(this->_prepared != nullptr) {
+      this->_prepared->close();
+      this->_prepared = nullptr;
     }
 
-    this->onHangup("");
+    auto context = Bundle::create();
+    context->setInt("handleId", this->_handleId);
+    this->onHangup("", context);
   }
 
-  void JanusPlugin::onHangup(const std::string& reason) {
+  void JanusPlugin::onHangup(const std::string& reason, const std::shared_ptr<Bundle>& context) {
+    if(this->_peer == nullptr || context->getInt("handleId", this->_handleId) != this->_handleId) {
+      return;
+    }
+
     this->_peer->close();
     this->_peer = nullptr;
   }
 
+  void JanusPlugin::_prepare(const std::shared_ptr<Bundle>& payload) {
+    static auto& peers = MetricsRegistry::instance().counter(METRIC_PLUGIN_PEERS);
+
+    if(this->_prepared != nullptr) {
+      return;
+    }
+
+    auto constraints = payload->getConstraints();
+
+    peers.add();
+    this->_prepared = this->_peerFactory->create(this->_handleId, this->_owner);
+    this->_prepared->prepare(constraints);
+  }
+
+  std::shared_ptr<Peer> JanusPlugin::_createPeer(int64_t handleId) {
+    static auto& peers = MetricsRegistry::instance().counter(METRIC_PLUGIN_PEERS);
+    static auto& prepared = MetricsRegistry::instance().counter(METRIC_PLUGIN_PREPARED_PEERS);
+
+    if(handleId != this->_handleId || this->_prepared == nullptr) {
+      peers.add();
+      return this->_peerFactory->create(handleId, this->_owner);
+    }
+
+    prepared.add();
+    auto peer = this->_prepared;
+    this->_prepared = nullptr;
+
+    return peer;
+  }
+
+  std::shared_ptr<SdpPipeline> JanusPlugin::sdpPipeline() {
+    return this->_sdpPipeline;
+  }
+
+  void JanusPlugin::_transform(const std::shared_ptr<Bundle>& payload) {
+    this->_sdpPipeline->clear();
+
+    for(auto kind : { "audio", "video" }) {
+      auto prefix = std::string(kind);
+
+      auto strip = splitList(payload->getString("strip_" + prefix + "_codecs", ""));
+      if(strip.empty() == false) {
+        this->_sdpPipeline->add(std::make_shared<SdpCodecFilter>(prefix, strip));
+      }
+
+      auto prefer = splitList(payload->getString(prefix + "_codecs", ""));
+      if(prefer.empty() == false) {
+        this->_sdpPipeline->add(std::make_shared<SdpCodecPreference>(prefix, prefer));
+      }
+
+      auto bandwidth = payload->getInt(prefix + "_bandwidth", 0);
+      if(bandwidth > 0) {
+        this->_sdpPipeline->add(std::make_shared<SdpBandwidth>(prefix, bandwidth));
+      }
+    }
+
+    auto extensions = splitList(payload->getString("strip_extensions", ""));
+    if(extensions.empty() == false) {
+      this->_sdpPipeline->add(std::make_shared<SdpExtensionFilter>(extensions));
+    }
+  }
+
+  std::string JanusPlugin::_rewrite(SdpType type, const std::string& sdp) {
+    static auto& descriptions = MetricsRegistry::instance().counter(METRIC_PLUGIN_DESCRIPTIONS);
+    descriptions.add();
+
+    return this->_sdpPipeline->run(sdp, type);
+  }
+
 }
@@ -25,8 +25,20 @@ namespace Janus {
   }
 
   void JanusPluginEchotest::command(const std::string& command, const std::shared_ptr<Bundle>& payload) {
+    if(command == JanusCommands::PREPARE) {
+      this->_prepare(payload);
+
+      return;
+    }
+
+    if(command == JanusCommands::SDP_TRANSFORM) {
+      this->_transform(payload);
+
+      return;
+    }
+
     if(command == JanusCommands::CALL) {
-      this->_peer = this->_peerFactory->create(this->_handleId, this->_owner);
+      this->_peer = this->_createPeer(this->_handleId);
       auto constraints = payload->getConstraints();
 
       constraints.sdp.send_audio = constraints.sdp.receive_audio = payload->getBool("audio", true);
@@ -50,7 +62,7 @@ namespace Janus {
     auto jsep = event->jsep();
 
     if(jsep != nullptr) {
-      this->_peer->setRemoteDescription(jsep->type(), jsep->sdp());
+      this->_peer->setRemoteDescription(jsep->type(), descriptionOf(jsep)->str());
 
       return;
     }
@@ -58,7 +70,8 @@ namespace Janus {
     this->_delegate->onPluginEvent(event, context);
   }
 
-  void JanusPluginEchotest::onOffer(const std::string& sdp, const std::shared_ptr<Bundle>& context) {
+  void JanusPluginEchotest::onOffer(const std::string& generated, const std::shared_ptr<Bundle>& context) {
+    auto sdp = this->_rewrite(SdpType::OFFER, generated);
     this->_peer->setLocalDescription(SdpType::OFFER, sdp);
 
     auto msg = Messages::call(sdp, context->getBool("audio", true), context->getBool("video", true));
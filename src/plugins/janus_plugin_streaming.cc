@@ -3,6 +3,9 @@
 #include "janus/janus_commands.hpp"
 #include "janus/constraints.hpp"
 
+// the code janus itself answers with for a request out of place
+#define STREAMING_ERROR_INVALID_STATE 460
+
 namespace Janus {
 
   namespace Messages {
@@ -19,6 +22,24 @@ namespace Janus {
       return msg;
     }
 
+    nlohmann::json info(int64_t id) {
+      return {
+        { "body", {
+          { "request", "info" },
+          { "id", id }
+        } }
+      };
+    }
+
+    nlohmann::json switchMountpoint(int64_t id) {
+      return {
+        { "body", {
+          { "request", "switch" },
+          { "id", id }
+        } }
+      };
+    }
+
     nlohmann::json watch(int64_t id, bool offerAudio, bool offerVideo, bool offerData) {
       return {
         { "body", {
@@ -36,13 +57,50 @@ namespace Janus {
   void JanusPluginStreaming::command(const std::string& command, const std::shared_ptr<Bundle>& payload) {
     if(command == JanusCommands::LIST) {
       auto msg = Messages::request("list");
-      this->_delegate->onCommandResult(msg, payload);
+      this->_delegate->onQuery(msg, payload, "streaming");
+
+      return;
+    }
+
+    if(command == JanusCommands::INFO) {
+      auto id = payload->getInt("id", -1);
+      auto msg = Messages::info(id);
+      this->_delegate->onQuery(msg, payload, "streaming/" + std::to_string(id));
+
+      return;
+    }
+
+    if(command == JanusCommands::PREPARE) {
+      this->_prepare(payload);
+
+      return;
+    }
+
+    if(command == JanusCommands::SDP_TRANSFORM) {
+      this->_transform(payload);
 
       return;
     }
 
     if(command == JanusCommands::WATCH) {
-      this->_session = payload;
+      // a concurrent watch needs a handle of its own, it is watched as soon as it is attached
+      if(payload->getBool("concurrent", false) == true && payload->getInt("handleId", -1) == -1) {
+        payload->setString("plugin", JanusPlugins::STREAMING);
+        this->_owner->dispatch(JanusCommands::ATTACH, payload);
+
+        return;
+      }
+
+      auto handleId = payload->getInt("handleId", this->_handleId);
+      {
+        std::lock_guard<std::mutex> lock(this->_watchesMutex);
+        auto& watch = this->_watches[handleId];
+        if(watch == nullptr) {
+          watch = std::make_shared<Watch>(payload);
+        } else {
+          watch->session = payload;
+        }
+      }
 
       auto id = payload->getInt("id", -1);
       auto offerAudio = payload->getBool("offer_audio", true);
@@ -62,10 +120,60 @@ namespace Janus {
       return;
     }
 
+    if(command == JanusCommands::SWITCH) {
+      auto handleId = payload->getInt("handleId", this->_handleId);
+      auto id = payload->getInt("id", -1);
+      std::shared_ptr<Bundle> session;
+      {
+        std::lock_guard<std::mutex> lock(this->_watchesMutex);
+        auto watch = this->_watch(handleId);
+        session = watch != nullptr ? watch->session : nullptr;
+      }
+
+      if(session == nullptr) {
+        this->_noWatch(handleId, payload);
+
+        return;
+      }
+
+      session->setInt("id", id);
+
+      auto msg = Messages::switchMountpoint(id);
+      this->_delegate->onCommandResult(msg, payload);
+
+      return;
+    }
+
     if(command == JanusCommands::STOP) {
       auto msg = Messages::request("stop");
       this->_delegate->onCommandResult(msg, payload);
 
+      auto handleId = payload->getInt("handleId", this->_handleId);
+      std::shared_ptr<Peer> peer;
+      {
+        std::lock_guard<std::mutex> lock(this->_watchesMutex);
+        auto watch = this->_watches.find(handleId);
+        if(watch == this->_watches.end()) {
+          return;
+        }
+
+        std::swap(peer, watch->second->peer);
+        // concurrent watches give their handle back, the plugin handle stays for the next watch
+        if(handleId != this->_handleId) {
+          this->_watches.erase(watch);
+        }
+      }
+
+      if(peer != nullptr) {
+        peer->close();
+      }
+
+      if(handleId != this->_handleId) {
+        auto context = Bundle::create();
+        context->setInt("handleId", handleId);
+        this->_owner->dispatch(JanusCommands::DETACH, context);
+      }
+
       return;
     }
 
@@ -78,20 +186,53 @@ namespace Janus {
   }
 
   void JanusPluginStreaming::onEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context) {
+    auto data = event->data();
     auto jsep = event->jsep();
 
+    if(data->getString("janus", "") == "success" && context->getString("command", "") == JanusCommands::ATTACH) {
+      auto handleId = data->getObject("data")->getInt("id", -1);
+      context->setInt("handleId", handleId);
+
+      this->command(JanusCommands::WATCH, context);
+
+      return;
+    }
+
     if(jsep != nullptr) {
-      this->_peer = this->_peerFactory->create(this->_handleId, this->_owner);
-      this->_peer->setRemoteDescription(jsep->type(), jsep->sdp());
+      auto handleId = event->sender();
+      std::shared_ptr<Peer> peer;
+      std::shared_ptr<Bundle> session;
+      {
+        std::lock_guard<std::mutex> lock(this->_watchesMutex);
+        auto watch = this->_watch(handleId);
+        if(watch != nullptr) {
+          // an offer on a live watch is a renegotiation, the peer connection is kept
+          if(watch->peer == nullptr) {
+            watch->peer = this->_createPeer(handleId);
+          }
+
+          peer = watch->peer;
+          session = watch->session;
+        }
+      }
+
+      if(peer == nullptr) {
+        this->_noWatch(handleId, context);
+
+        return;
+      }
 
-      auto constraints = this->_session->getConstraints();
+      peer->setRemoteDescription(jsep->type(), descriptionOf(jsep)->str());
+
+      auto constraints = session->getConstraints();
       constraints.sdp.send_audio = false;
       constraints.sdp.send_video = false;
-      constraints.sdp.receive_audio = this->_session->getBool("offer_audio", true);
-      constraints.sdp.receive_video = this->_session->getBool("offer_video", true);
-      constraints.sdp.datachannel = this->_session->getBool("offer_data", true);
+      constraints.sdp.receive_audio = session->getBool("offer_audio", true);
+      constraints.sdp.receive_video = session->getBool("offer_video", true);
+      constraints.sdp.datachannel = session->getBool("offer_data", true);
 
-      this->_peer->createAnswer(constraints, context);
+      context->setInt("handleId", handleId);
+      peer->createAnswer(constraints, context);
 
       return;
     }
@@ -99,11 +240,73 @@ namespace Janus {
     this->_delegate->onPluginEvent(event, context);
   }
 
-  void JanusPluginStreaming::onAnswer(const std::string& sdp, const std::shared_ptr<Bundle>& context) {
-    this->_peer->setLocalDescription(SdpType::ANSWER, sdp);
+  void JanusPluginStreaming::onAnswer(const std::string& generated, const std::shared_ptr<Bundle>& context) {
+    auto sdp = this->_rewrite(SdpType::ANSWER, generated);
+    std::shared_ptr<Peer> peer;
+    std::shared_ptr<Bundle> session;
+    {
+      std::lock_guard<std::mutex> lock(this->_watchesMutex);
+      auto watch = this->_watch(context->getInt("handleId", this->_handleId));
+      if(watch != nullptr) {
+        peer = watch->peer;
+        session = watch->session;
+      }
+    }
+
+    // stopped while the peer was answering
+    if(peer == nullptr) {
+      return;
+    }
+
+    peer->setLocalDescription(SdpType::ANSWER, sdp);
 
     auto msg = Messages::request("start", sdp);
-    this->_delegate->onCommandResult(msg, this->_session);
+    this->_delegate->onCommandResult(msg, session);
+  }
+
+  void JanusPluginStreaming::onHangup(const std::string& reason, const std::shared_ptr<Bundle>& context) {
+    std::shared_ptr<Peer> peer;
+    {
+      std::lock_guard<std::mutex> lock(this->_watchesMutex);
+      auto watch = this->_watches.find(context->getInt("handleId", this->_handleId));
+      if(watch != this->_watches.end()) {
+        std::swap(peer, watch->second->peer);
+      }
+    }
+
+    if(peer != nullptr) {
+      peer->close();
+    }
+  }
+
+  void JanusPluginStreaming::onClose() {
+    std::unordered_map<int64_t, std::shared_ptr<Watch>> watches;
+    {
+      std::lock_guard<std::mutex> lock(this->_watchesMutex);
+      std::swap(watches, this->_watches);
+    }
+
+    for(auto& watch : watches) {
+      if(watch.second->peer != nullptr) {
+        watch.second->peer->close();
+      }
+    }
+
+    JanusPlugin::onClose();
+  }
+
+  std::shared_ptr<Watch> JanusPluginStreaming::_watch(int64_t handleId) {
+    auto watch = this->_watches.find(handleId);
+    if(watch == this->_watches.end()) {
+      return nullptr;
+    }
+
+    return watch->second;
+  }
+
+  void JanusPluginStreaming::_noWatch(int64_t handleId, const std::shared_ptr<Bundle>& context) {
+    JanusError error(STREAMING_ERROR_INVALID_STATE, "nothing is watched on handle " + std::to_string(handleId));
+    this->_delegate->onPluginError(error, context);
   }
 
   JanusPluginStreamingFactory::JanusPluginStreamingFactory(const std::shared_ptr<PluginCommandDelegate>& delegate, const std::shared_ptr<PeerFactory>& peerFactory) {
@@ -4,8 +4,25 @@
 #include "janus/constraints_builder_impl.h"
 #include "janus/janus_p_types.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+// the cached list of rooms, the queries about a single room go to videoroom/<room>
+#define VIDEOROOM_ROOMS_SCOPE "videoroom"
+// the code janus itself answers with for an unknown feed
+#define VIDEOROOM_ERROR_NO_SUCH_FEED 428
+
 namespace Janus {
 
+  namespace {
+
+    std::string roomScope(int64_t room) {
+      return std::string(VIDEOROOM_ROOMS_SCOPE) + "/" + std::to_string(room);
+    }
+
+  }
+
   namespace Messages {
 
     nlohmann::json start(const std::string& sdp) {
@@ -20,14 +37,55 @@ namespace Janus {
       };
     }
 
+    nlohmann::json pause() {
+      return {
+        { "body", { { "request", "pause" } } }
+      };
+    }
+
+    nlohmann::json resume() {
+      return {
+        { "body", { { "request", "start" } } }
+      };
+    }
+
+    nlohmann::json simulcastLayers(int64_t substream, int64_t temporal) {
+      return {
+        { "body", {
+          { "request", "configure" },
+          { "substream", substream },
+          { "temporal", temporal }
+        } }
+      };
+    }
+
+    nlohmann::json svcLayers(int64_t spatial, int64_t temporal) {
+      return {
+        { "body", {
+          { "request", "configure" },
+          { "spatial_layer", spatial },
+          { "temporal_layer", temporal }
+        } }
+      };
+    }
+
+    nlohmann::json switchFeed(int64_t feed) {
+      return {
+        { "body", {
+          { "request", "switch" },
+          { "feed", feed }
+        } }
+      };
+    }
+
     nlohmann::json list() {
       return {
         { "body", { { "request", "list" } } }
       };
     }
 
-    nlohmann::json publish(const std::string& sdp, bool audio, bool video, bool data) {
-      return {
+    nlohmann::json publish(const std::string& sdp, bool audio, bool video, bool data, bool simulcast) {
+      nlohmann::json msg = {
         { "body", {
           { "request", "publish" },
           { "audio", audio },
@@ -39,6 +97,12 @@ namespace Janus {
           { "sdp", sdp }
         } }
       };
+
+      if(simulcast == true) {
+        msg["body"]["simulcast"] = true;
+      }
+
+      return msg;
     }
 
     nlohmann::json listParticipants(int64_t room) {
@@ -65,6 +129,58 @@ namespace Janus {
     }
 
 
+    nlohmann::json participant(const Participant& participant) {
+      return {
+        { "id", participant.id },
+        { "display", participant.display },
+        { "publisher", participant.publisher },
+        { "audio_codec", participant.audioCodec },
+        { "video_codec", participant.videoCodec }
+      };
+    }
+
+    nlohmann::json roomState(int64_t room, const std::vector<Participant>& participants) {
+      nlohmann::json msg = {
+        { "videoroom", "room-state" },
+        { "room", room },
+        { "participants", nlohmann::json::array() }
+      };
+
+      for(auto& item : participants) {
+        msg["participants"].push_back(participant(item));
+      }
+
+      return msg;
+    }
+
+    nlohmann::json roomChanged(int64_t room, const RoomStateDelta& delta) {
+      nlohmann::json msg = {
+        { "videoroom", "room-changed" },
+        { "room", room },
+        { "joined", nlohmann::json::array() },
+        { "updated", nlohmann::json::array() },
+        { "left", delta.left }
+      };
+
+      for(auto& item : delta.joined) {
+        msg["joined"].push_back(participant(item));
+      }
+
+      for(auto& item : delta.updated) {
+        msg["updated"].push_back(participant(item));
+      }
+
+      return msg;
+    }
+
+    nlohmann::json speakers(int64_t room, const std::vector<int64_t>& ranking) {
+      return {
+        { "videoroom", "speakers" },
+        { "room", room },
+        { "speakers", ranking }
+      };
+    }
+
     nlohmann::json join(const std::string& ptype, int64_t room, const std::string& display, int64_t id, const std::string& token) {
       nlohmann::json msg = {
         { "body", {
@@ -89,13 +205,78 @@ namespace Janus {
       return msg;
     }
 
+    nlohmann::json joinAndConfigure(int64_t room, const std::string& display, int64_t id, const std::string& token, const std::string& sdp, bool audio, bool video, bool data, bool simulcast) {
+      auto msg = join(JanusPTypes::PUBLISHER, room, display, id, token);
+      msg["body"]["request"] = "joinandconfigure";
+      msg["body"]["audio"] = audio;
+      msg["body"]["video"] = video;
+      msg["body"]["data"] = data;
+
+      if(simulcast == true) {
+        msg["body"]["simulcast"] = true;
+      }
+
+      msg["jsep"] = {
+        { "type", "offer" },
+        { "sdp", sdp }
+      };
+
+      return msg;
+    }
+
+    nlohmann::json peerPool(const PeerPoolStats& stats) {
+      return {
+        { "videoroom", "peer-pool" },
+        { "size", stats.size },
+        { "idle", stats.idle },
+        { "hits", stats.hits },
+        { "misses", stats.misses },
+        { "hit_rate", stats.hitRate() }
+      };
+    }
+
+  }
+
+  JanusPluginVideoroom::JanusPluginVideoroom(int64_t handleId, const std::shared_ptr<PluginCommandDelegate>& delegate, const std::shared_ptr<PeerFactory>& peerFactory, const std::shared_ptr<Protocol>& owner, const std::shared_ptr<Scheduler>& scheduler, const std::shared_ptr<Async>& async) : JanusPlugin(handleId, delegate, peerFactory, owner) {
+    this->_scheduler = scheduler;
+    this->_async = async;
   }
 
   void JanusPluginVideoroom::command(const std::string& command, const std::shared_ptr<Bundle>& payload) {
+    {
+      std::lock_guard<std::recursive_mutex> lock(this->_stateMutex);
+      this->_command(command, payload);
+    }
+
+    this->_closeDetached();
+  }
+
+  void JanusPluginVideoroom::onEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context) {
+    {
+      std::lock_guard<std::recursive_mutex> lock(this->_stateMutex);
+      this->_onEvent(event, context);
+    }
+
+    this->_closeDetached();
+  }
+
+  void JanusPluginVideoroom::_closeDetached() {
+    std::vector<std::shared_ptr<Peer>> detached;
+    {
+      std::lock_guard<std::recursive_mutex> lock(this->_stateMutex);
+      std::swap(detached, this->_detached);
+    }
+
+    for(auto& peer : detached) {
+      peer->close();
+    }
+  }
+
+  void JanusPluginVideoroom::_command(const std::string& command, const std::shared_ptr<Bundle>& payload) {
 
     if(command == JanusCommands::LIST) {
       auto msg = Messages::list();
-      this->_delegate->onCommandResult(msg, payload);
+      this->_delegate->onQuery(msg, payload, VIDEOROOM_ROOMS_SCOPE);
 
       return;
     }
@@ -103,7 +284,7 @@ namespace Janus {
     if(command == JanusCommands::LISTPARTICIPANTS) {
       auto room = payload->getInt("room", -1);
       auto msg = Messages::listParticipants(room);
-      this->_delegate->onCommandResult(msg, payload);
+      this->_delegate->onQuery(msg, payload, roomScope(room));
 
       return;
     }
@@ -121,8 +302,20 @@ namespace Janus {
       return;
     }
 
-    if(command == JanusCommands::PUBLISH) {
-      this->_peer = this->_peerFactory->create(this->_handleId, this->_owner);
+    if(command == JanusCommands::PREPARE) {
+      this->_prepare(payload);
+
+      return;
+    }
+
+    if(command == JanusCommands::SDP_TRANSFORM) {
+      this->_transform(payload);
+
+      return;
+    }
+
+    if(command == JanusCommands::PUBLISH || command == JanusCommands::JOIN_AND_PUBLISH) {
+      this->_peer = this->_createPeer(this->_handleId);
 
       auto constraints = payload->getConstraints();
 
@@ -137,6 +330,14 @@ namespace Janus {
       return;
     }
 
+    if(command == JanusCommands::PARTICIPANTS) {
+      auto msg = Messages::roomState(this->_roomState->room(), this->_roomState->snapshot());
+      auto evt = std::make_shared<JanusEventImpl>(this->_handleId, msg);
+      this->_delegate->onPluginEvent(evt, payload);
+
+      return;
+    }
+
     if(command == JanusCommands::SUBSCRIBE) {
       payload->setString("plugin", JanusPlugins::VIDEOROOM);
       this->_owner->dispatch(JanusCommands::ATTACH, payload);
@@ -144,22 +345,215 @@ namespace Janus {
       return;
     }
 
+    if(command == JanusCommands::SWITCH) {
+      auto from = payload->getInt("from", -1);
+      auto feed = payload->getInt("feed", -1);
+      this->_switch(from, feed, payload);
+
+      return;
+    }
+
+    // scheduled by the plugin itself, once the hysteresis of a hidden feed expired
+    if(command == JanusCommands::VIEWPORT && payload->getBool("tick", false) == true) {
+      {
+        std::lock_guard<std::mutex> lock(this->_tickMutex);
+        this->_viewportTickAt = std::chrono::steady_clock::time_point();
+      }
+
+      auto followed = this->_speakersFollow != nullptr ? this->_speakersFollow : this->_viewport;
+      auto plan = this->_subscriptions->tick();
+      this->_follow(plan, followed != nullptr ? followed : payload);
+
+      return;
+    }
+
+    if(command == JanusCommands::VIEWPORT) {
+      this->_speakersFollow = nullptr;
+      this->_viewport = payload;
+
+      auto maxActive = payload->getInt("max_active", SUBSCRIPTION_MAX_ACTIVE);
+      auto maxWarm = payload->getInt("max_warm", SUBSCRIPTION_MAX_WARM);
+      auto hysteresis = payload->getInt("hysteresis", SUBSCRIPTION_HYSTERESIS);
+      this->_subscriptions->configure(maxActive, maxWarm, hysteresis);
+
+      // feeds are given as a comma separated list, most important first
+      std::vector<int64_t> visible;
+      std::stringstream feeds(payload->getString("feeds", ""));
+      std::string feed;
+      while(std::getline(feeds, feed, ',')) {
+        char* end = nullptr;
+        auto id = std::strtoll(feed.c_str(), &end, 10);
+        if(end != feed.c_str()) {
+          visible.push_back(id);
+        }
+      }
+
+      auto plan = this->_subscriptions->update(visible);
+      this->_follow(plan, payload);
+
+      return;
+    }
+
+    if(command == JanusCommands::LAYERS) {
+      auto feed = payload->getInt("feed", -1);
+
+      if(payload->getBool("svc", false) == true) {
+        auto msg = Messages::svcLayers(payload->getInt("spatial_layer", 2), payload->getInt("temporal_layer", 2));
+        this->_request(feed, msg);
+      } else {
+        auto msg = Messages::simulcastLayers(payload->getInt("substream", 2), payload->getInt("temporal", 2));
+        this->_request(feed, msg);
+      }
+
+      return;
+    }
+
+    // scheduled by the plugin itself, once the interval held a switch back
+    if(command == JanusCommands::LAYER_POLICY && payload->getBool("tick", false) == true) {
+      {
+        std::lock_guard<std::mutex> lock(this->_tickMutex);
+        this->_layersTickAt = std::chrono::steady_clock::time_point();
+      }
+
+      this->_switchLayers();
+
+      return;
+    }
+
+    if(command == JanusCommands::LAYER_POLICY) {
+      auto budget = payload->getInt("budget", LAYER_BUDGET);
+      auto interval = payload->getInt("interval", LAYER_SWITCH_INTERVAL);
+      this->_layers->configure(budget, interval);
+      this->_layersSvc = payload->getBool("svc", false);
+
+      // tiles are given as a comma separated list of feed:WIDTHxHEIGHT
+      std::stringstream tiles(payload->getString("tiles", ""));
+      std::string tile;
+      while(std::getline(tiles, tile, ',')) {
+        long long feed = 0;
+        int width = 0;
+        int height = 0;
+        if(std::sscanf(tile.c_str(), "%lld:%dx%d", &feed, &width, &height) == 3 && this->_feeds.count(feed) > 0) {
+          this->_layers->tile(feed, width, height);
+        }
+      }
+
+      this->_switchLayers();
+
+      return;
+    }
+
+    if(command == JanusCommands::SPEAKERS) {
+      auto size = payload->getInt("size", ACTIVE_SPEAKERS);
+      this->_speakers->resize(size);
+      this->_speakersFollow = nullptr;
+
+      if(payload->getBool("follow", false) == true) {
+        auto maxActive = payload->getInt("max_active", size);
+        auto maxWarm = payload->getInt("max_warm", SUBSCRIPTION_MAX_WARM);
+        auto hysteresis = payload->getInt("hysteresis", SUBSCRIPTION_HYSTERESIS);
+        this->_subscriptions->configure(maxActive, maxWarm, hysteresis);
+
+        this->_speakersFollow = payload;
+      }
+
+      this->_speakersChanged(payload);
+
+      return;
+    }
+
+    if(command == JanusCommands::PEER_POOL) {
+      // without a size the command only reports the pool stats
+      auto size = payload->getInt("size", -1);
+      auto pool = this->pool();
+      if(size >= 0 && pool != nullptr) {
+        pool->resize(size);
+      }
+
+      if(size >= 0 && pool == nullptr) {
+        // peers are created on the async, away from the signaling and the platform threads
+        auto async = this->_async != nullptr ? this->_async : std::make_shared<AsyncImpl>(1);
+        pool = std::make_shared<PeerPool>(this->_peerFactory, this->_owner, async, size);
+
+        std::lock_guard<std::mutex> lock(this->_poolMutex);
+        this->_pool = pool;
+      }
+
+      auto stats = pool != nullptr ? pool->stats() : PeerPoolStats{ 0, 0, 0, 0 };
+      auto evt = std::make_shared<JanusEventImpl>(this->_handleId, Messages::peerPool(stats));
+      this->_delegate->onPluginEvent(evt, payload);
+
+      return;
+    }
+
   }
 
-  void JanusPluginVideoroom::onEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context) {
+  void JanusPluginVideoroom::_onEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context) {
     auto data = event->data();
     auto jsep = event->jsep();
 
+    auto type = data->getString("videoroom", "");
+    // the list of rooms counts the participants, so it goes along with the room that changed
+    if(type == "joined" || type == "event" || type == "destroyed") {
+      this->_delegate->invalidateQueries(VIDEOROOM_ROOMS_SCOPE);
+      this->_delegate->invalidateQueries(roomScope(data->getInt("room", this->_roomState->room())));
+    }
+
+    auto delta = this->_roomState->apply(data);
+    if(delta.empty() == false) {
+      auto msg = Messages::roomChanged(this->_roomState->room(), delta);
+      auto evt = std::make_shared<JanusEventImpl>(event->sender(), msg);
+      this->_delegate->onPluginEvent(evt, context);
+    }
+
+    for(auto id : delta.left) {
+      auto plan = this->_subscriptions->remove(id);
+      this->_follow(plan, context);
+
+      if(this->_speakers->remove(id) == true) {
+        this->_speakersChanged(context);
+      }
+    }
+
+    if(this->_speakers->apply(data) == true) {
+      this->_speakersChanged(context);
+    }
+
+    for(auto& participant : delta.updated) {
+      if(participant.publisher == false) {
+        auto plan = this->_subscriptions->remove(participant.id);
+        this->_follow(plan, context);
+      }
+    }
+
     if(data->getString("configured", "") == "ok" && jsep != nullptr) {
-      this->_peer->setRemoteDescription(jsep->type(), jsep->sdp());
+      this->_peer->setRemoteDescription(jsep->type(), descriptionOf(jsep)->str());
 
       return;
     }
 
+    // joinandconfigure answers with the joined event, which the app still needs
+    if(type == "joined" && jsep != nullptr) {
+      this->_peer->setRemoteDescription(jsep->type(), descriptionOf(jsep)->str());
+    }
+
     if(data->getString("janus", "") == "success" && context->getString("command", "") == "attach") {
       auto subscriberId = data->getObject("data")->getInt("id", -1);
+      auto feed = context->getInt("feed", -1);
+      if(feed != -1) {
+        this->_feeds[feed] = subscriberId;
+      }
 
-      auto peer = this->_peerFactory->create(subscriberId, this->_owner);
+      // the viewport could have moved away while the handle was being attached
+      if(context->getBool("viewport", false) == true && this->_subscriptions->tracks(feed) == false) {
+        this->_detach(feed);
+
+        return;
+      }
+
+      auto pool = this->pool();
+      auto factory = pool != nullptr ? pool : this->_peerFactory;
+      auto peer = factory->create(subscriberId, this->_owner);
       auto subscriber = std::make_shared<Subscriber>(peer, context);
       this->_subscribers[subscriberId] = subscriber;
 
@@ -168,7 +562,6 @@ namespace Janus {
       auto offer_audio = context->getBool("offer_audio", true);
       auto offer_video = context->getBool("offer_video", true);
       auto offer_data = context->getBool("offer_data", true);
-      auto feed = context->getInt("feed", -1);
       auto room = context->getInt("room", -1);
 
       auto msg = Messages::subscribe(room, feed, offer_audio, offer_video, offer_data);
@@ -177,15 +570,20 @@ namespace Janus {
       return;
     }
 
-    if(data->getString("videoroom", "") == "attached" && jsep != nullptr) {
-      auto subscriberId = event->sender();
-      auto subscriber = this->_subscribers[subscriberId];
+    // a switch renegotiates only when the new publisher offers different media
+    auto subscriber = this->_subscribers.find(event->sender());
+    auto switched = data->getString("switched", "") == "ok" && subscriber != this->_subscribers.end();
+    if((data->getString("videoroom", "") == "attached" || switched == true) && jsep != nullptr) {
+      // the feed left the viewport while janus was offering, the handle is gone with it
+      if(subscriber == this->_subscribers.end()) {
+        return;
+      }
 
-      auto peer = subscriber->peer;
+      auto peer = subscriber->second->peer;
 
-      peer->setRemoteDescription(jsep->type(), jsep->sdp());
+      peer->setRemoteDescription(jsep->type(), descriptionOf(jsep)->str());
 
-      auto subscriberContext = subscriber->context;
+      auto subscriberContext = subscriber->second->context;
 
       auto constraints = subscriberContext->getConstraints();
       constraints.sdp.send_audio = false;
@@ -202,35 +600,335 @@ namespace Janus {
     this->_delegate->onPluginEvent(event, context);
   }
 
-  void JanusPluginVideoroom::onOffer(const std::string& sdp, const std::shared_ptr<Bundle>& context) {
+  void JanusPluginVideoroom::onOffer(const std::string& generated, const std::shared_ptr<Bundle>& context) {
+    auto sdp = this->_rewrite(SdpType::OFFER, generated);
     this->_peer->setLocalDescription(SdpType::OFFER, sdp);
 
     auto audio = context->getBool("audio", true);
     auto video = context->getBool("video", true);
     auto data = context->getBool("data", true);
+    // the peer publishes one layer per encoding, so more than one means simulcast
+    auto simulcast = context->getConstraints().video.encodings.size() > 1;
+
+    if(context->getString("command", "") == JanusCommands::JOIN_AND_PUBLISH) {
+      auto room = context->getInt("room", -1);
+      auto display = context->getString("display", "");
+      auto id = context->getInt("id", -1);
+      auto token = context->getString("token", "");
 
-    auto msg = Messages::publish(sdp, audio, video, data);
+      auto msg = Messages::joinAndConfigure(room, display, id, token, sdp, audio, video, data, simulcast);
+      this->_delegate->onCommandResult(msg, context);
+
+      return;
+    }
+
+    auto msg = Messages::publish(sdp, audio, video, data, simulcast);
     this->_delegate->onCommandResult(msg, context);
   }
 
-  void JanusPluginVideoroom::onAnswer(const std::string& sdp, const std::shared_ptr<Bundle>& context) {
+  void JanusPluginVideoroom::onAnswer(const std::string& generated, const std::shared_ptr<Bundle>& context) {
+    auto sdp = this->_rewrite(SdpType::ANSWER, generated);
     auto subscriberId = context->getInt("handleId", -1);
-    auto subscriber = this->_subscribers[subscriberId];
 
-    auto peer = subscriber->peer;
-    peer->setLocalDescription(SdpType::ANSWER, sdp);
+    std::lock_guard<std::recursive_mutex> lock(this->_stateMutex);
+    auto entry = this->_subscribers.find(subscriberId);
+    // detached while the peer was answering
+    if(entry == this->_subscribers.end()) {
+      return;
+    }
+
+    auto subscriber = entry->second;
+    subscriber->peer->setLocalDescription(SdpType::ANSWER, sdp);
 
     auto msg = Messages::start(sdp);
     this->_delegate->onCommandResult(msg, context);
+
+    // a pause sent before the start would be undone by it
+    subscriber->started = true;
+    this->_flush(subscriber->context->getInt("feed", -1));
   }
 
-  JanusPluginVideoroomFactory::JanusPluginVideoroomFactory(const std::shared_ptr<PluginCommandDelegate>& delegate, const std::shared_ptr<PeerFactory>& peerFactory) {
+  std::shared_ptr<RoomState> JanusPluginVideoroom::roomState() {
+    return this->_roomState;
+  }
+
+  std::shared_ptr<SubscriptionManager> JanusPluginVideoroom::subscriptions() {
+    return this->_subscriptions;
+  }
+
+  std::shared_ptr<SpeakerTracker> JanusPluginVideoroom::speakers() {
+    return this->_speakers;
+  }
+
+  std::shared_ptr<LayerPolicy> JanusPluginVideoroom::layers() {
+    return this->_layers;
+  }
+
+  std::shared_ptr<PeerPool> JanusPluginVideoroom::pool() {
+    std::lock_guard<std::mutex> lock(this->_poolMutex);
+
+    return this->_pool;
+  }
+
+  void JanusPluginVideoroom::onClose() {
+    auto pool = this->pool();
+    if(pool != nullptr) {
+      pool->resize(0);
+    }
+
+    JanusPlugin::onClose();
+  }
+
+  void JanusPluginVideoroom::_speakersChanged(const std::shared_ptr<Bundle>& context) {
+    auto ranking = this->_speakers->ranking();
+
+    auto msg = Messages::speakers(this->_roomState->room(), ranking);
+    auto evt = std::make_shared<JanusEventImpl>(this->_handleId, msg);
+    this->_delegate->onPluginEvent(evt, context);
+
+    if(this->_speakersFollow != nullptr) {
+      auto plan = this->_subscriptions->update(ranking);
+      this->_follow(plan, this->_speakersFollow);
+    }
+  }
+
+  void JanusPluginVideoroom::_switchLayers() {
+    auto svc = this->_layersSvc;
+    std::vector<std::shared_ptr<Bundle>> switches;
+    for(auto& layer : this->_layers->plan()) {
+      auto bundle = Bundle::create();
+      bundle->setString("command", JanusCommands::LAYERS);
+      bundle->setInt("feed", layer.feed);
+      bundle->setBool("svc", svc);
+      bundle->setInt(svc == true ? "spatial_layer" : "substream", layer.substream);
+      bundle->setInt(svc == true ? "temporal_layer" : "temporal", layer.temporal);
+
+      switches.push_back(bundle);
+    }
+
+    // one batch, so every subscriber switches within the same round trip
+    if(switches.empty() == false) {
+      this->_owner->dispatchBatch(switches);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    this->_schedule(JanusCommands::LAYER_POLICY, now, this->_layers->due(now), this->_layersTickAt);
+  }
+
+  void JanusPluginVideoroom::_follow(const SubscriptionPlan& plan, const std::shared_ptr<Bundle>& payload) {
+    // evicted handles are switched to the new feeds instead of paying a new attach and negotiation
+    std::vector<int64_t> spare;
+    for(auto feed : plan.detach) {
+      if(spare.size() < plan.attach.size() && this->_feeds.count(feed) > 0) {
+        spare.push_back(feed);
+
+        continue;
+      }
+
+      // release first, so the new subscribers never overlap with the ones they replace
+      this->_detach(feed);
+    }
+
+    for(auto feed : plan.pause) {
+      if(std::find(spare.begin(), spare.end(), feed) == spare.end()) {
+        this->_request(feed, Messages::pause());
+      }
+    }
+
+    for(auto feed : plan.resume) {
+      this->_request(feed, Messages::resume());
+    }
+
+    for(auto feed : plan.attach) {
+      if(spare.empty() == false) {
+        auto from = spare.back();
+        spare.pop_back();
+
+        auto context = Bundle::create();
+        this->_switch(from, feed, context);
+        // the evicted handle was paused while warm
+        this->_request(feed, Messages::resume());
+
+        continue;
+      }
+
+      auto context = Bundle::create();
+      context->setString("plugin", JanusPlugins::VIDEOROOM);
+      context->setBool("viewport", true);
+      context->setInt("feed", feed);
+      context->setInt("room", payload->getInt("room", this->_roomState->room()));
+      context->setBool("offer_audio", payload->getBool("offer_audio", true));
+      context->setBool("offer_video", payload->getBool("offer_video", true));
+      context->setBool("offer_data", payload->getBool("offer_data", true));
+      context->setConstraints(payload->getConstraints());
+
+      this->_owner->dispatch(JanusCommands::ATTACH, context);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    this->_schedule(JanusCommands::VIEWPORT, now, this->_subscriptions->due(now), this->_viewportTickAt);
+  }
+
+  void JanusPluginVideoroom::_switch(int64_t from, int64_t feed, const std::shared_ptr<Bundle>& context) {
+    auto entry = this->_feeds.find(from);
+    if(entry == this->_feeds.end()) {
+      JanusError error(VIDEOROOM_ERROR_NO_SUCH_FEED, "no subscriber for feed " + std::to_string(from));
+      this->_delegate->onPluginError(error, context);
+
+      return;
+    }
+
+    // two subscribers of the same feed could not be told apart anymore
+    if(feed != from && this->_feeds.count(feed) > 0) {
+      JanusError error(VIDEOROOM_ERROR_NO_SUCH_FEED, "feed " + std::to_string(feed) + " has a subscriber already");
+      this->_delegate->onPluginError(error, context);
+
+      return;
+    }
+
+    auto subscriberId = entry->second;
+    this->_feeds.erase(entry);
+    this->_feeds[feed] = subscriberId;
+    this->_queued.erase(from);
+    this->_layers->forget(from);
+    // a manual switch moves what the subscriptions know about the handle, the planned ones find it moved already
+    this->_subscriptions->replace(from, feed);
+
+    auto subscriber = this->_subscribers.find(subscriberId);
+    if(subscriber != this->_subscribers.end()) {
+      subscriber->second->context->setInt("feed", feed);
+    }
+
+    context->setInt("handleId", subscriberId);
+    context->setInt("feed", feed);
+
+    auto msg = Messages::switchFeed(feed);
+    this->_delegate->onCommandResult(msg, context);
+  }
+
+  void JanusPluginVideoroom::_request(int64_t feed, const nlohmann::json& body) {
+    auto entry = this->_feeds.find(feed);
+    // the attach is still in flight, the request waits for the subscriber to start
+    if(entry == this->_feeds.end()) {
+      if(this->_subscriptions->tracks(feed) == true) {
+        this->_queued[feed].push_back(body);
+      }
+
+      return;
+    }
+
+    auto subscriber = this->_subscribers.find(entry->second);
+    if(subscriber != this->_subscribers.end() && subscriber->second->started == false) {
+      this->_queued[feed].push_back(body);
+
+      return;
+    }
+
+    auto context = Bundle::create();
+    context->setInt("handleId", entry->second);
+    context->setInt("feed", feed);
+
+    this->_delegate->onCommandResult(body, context);
+  }
+
+  void JanusPluginVideoroom::_flush(int64_t feed) {
+    auto queued = this->_queued.find(feed);
+    if(queued == this->_queued.end()) {
+      return;
+    }
+
+    auto bodies = std::move(queued->second);
+    this->_queued.erase(queued);
+
+    for(auto& body : bodies) {
+      this->_request(feed, body);
+    }
+  }
+
+  void JanusPluginVideoroom::_schedule(const std::string& command, std::chrono::steady_clock::time_point now, int64_t due, std::chrono::steady_clock::time_point& tickAt) {
+    if(due < 0) {
+      return;
+    }
+
+    auto at = now + std::chrono::milliseconds(due);
+
+    std::lock_guard<std::mutex> lock(this->_tickMutex);
+    // the tick pending before then schedules the next one
+    if(tickAt != std::chrono::steady_clock::time_point() && tickAt <= at) {
+      return;
+    }
+
+    tickAt = at;
+    if(this->_scheduler == nullptr) {
+      this->_scheduler = std::make_shared<SchedulerImpl>();
+    }
+
+    // through the owner, like any command, and only while it is alive
+    std::weak_ptr<Protocol> owner = this->_owner;
+    this->_scheduler->post(due, [owner, command] {
+      auto protocol = owner.lock();
+      if(protocol == nullptr) {
+        return;
+      }
+
+      auto context = Bundle::create();
+      context->setBool("tick", true);
+      protocol->dispatch(command, context);
+    });
+  }
+
+  void JanusPluginVideoroom::_detach(int64_t feed) {
+    auto entry = this->_feeds.find(feed);
+    if(entry == this->_feeds.end()) {
+      this->_queued.erase(feed);
+
+      return;
+    }
+
+    auto subscriberId = entry->second;
+    this->_feeds.erase(entry);
+    this->_queued.erase(feed);
+    this->_layers->forget(feed);
+
+    auto subscriber = this->_subscribers.find(subscriberId);
+    if(subscriber != this->_subscribers.end()) {
+      this->_detached.push_back(subscriber->second->peer);
+      this->_subscribers.erase(subscriber);
+    }
+
+    auto context = Bundle::create();
+    context->setInt("handleId", subscriberId);
+    context->setInt("feed", feed);
+
+    this->_owner->dispatch(JanusCommands::DETACH, context);
+  }
+
+  JanusPluginVideoroomFactory::JanusPluginVideoroomFactory(const std::shared_ptr<PluginCommandDelegate>& delegate, const std::shared_ptr<PeerFactory>& peerFactory, const std::shared_ptr<Scheduler>& scheduler, const std::shared_ptr<Async>& async) {
     this->_peerFactory = peerFactory;
     this->_delegate = delegate;
+    this->_scheduler = scheduler;
+    this->_async = async;
   }
 
   std::shared_ptr<Plugin> JanusPluginVideoroomFactory::create(int64_t handleId, const std::shared_ptr<Protocol>& owner) {
-    auto plugin = std::make_shared<JanusPluginVideoroom>(handleId, this->_delegate, this->_peerFactory, owner);
+    std::shared_ptr<Scheduler> scheduler;
+    std::shared_ptr<Async> async;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      if(this->_scheduler == nullptr) {
+        this->_scheduler = std::make_shared<SchedulerImpl>();
+      }
+
+      // one thread warms the peers of every videoroom handle
+      if(this->_async == nullptr) {
+        this->_async = std::make_shared<AsyncImpl>(1);
+      }
+
+      scheduler = this->_scheduler;
+      async = this->_async;
+    }
+
+    auto plugin = std::make_shared<JanusPluginVideoroom>(handleId, this->_delegate, this->_peerFactory, owner, scheduler, async);
 
     return plugin;
   }
@@ -0,0 +1,136 @@
+#include "janus/plugins/layer_policy.h"
+
+#include <algorithm>
+
+namespace Janus {
+
+  // from the cheapest to the richest layer, the heights match the usual 1/4, 1/2, full simulcast encodings of a 720p source
+  static const Layer LAYERS[] = {
+    { 0, 0, 50, 0 },
+    { 0, 2, 150, 180 },
+    { 1, 2, 500, 360 },
+    { 2, 2, 1500, 720 }
+  };
+
+  static const int32_t TOP_LAYER = sizeof(LAYERS) / sizeof(Layer) - 1;
+
+  LayerPolicy::LayerPolicy(int64_t budget, int64_t interval) {
+    this->configure(budget, interval);
+  }
+
+  void LayerPolicy::configure(int64_t budget, int64_t interval) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_budget = budget;
+    this->_interval = std::chrono::milliseconds(interval);
+  }
+
+  void LayerPolicy::tile(int64_t feed, int32_t width, int32_t height) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    // the source height a 16:9 stream needs to fill the tile on both axes
+    auto required = std::max(height, width * 9 / 16);
+
+    auto entry = this->_feeds.find(feed);
+    if(entry == this->_feeds.end()) {
+      this->_feeds[feed] = { required, -1, std::chrono::steady_clock::time_point(), false };
+
+      return;
+    }
+
+    entry->second.height = required;
+  }
+
+  void LayerPolicy::forget(int64_t feed) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_feeds.erase(feed);
+  }
+
+  std::vector<LayerSwitch> LayerPolicy::plan() {
+    return this->plan(std::chrono::steady_clock::now());
+  }
+
+  std::vector<LayerSwitch> LayerPolicy::plan(std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    std::map<int64_t, int32_t> wanted;
+    int64_t total = 0;
+
+    for(auto& feed : this->_feeds) {
+      int32_t layer = 0;
+      if(feed.second.height > 0) {
+        layer = 1;
+        while(layer < TOP_LAYER && LAYERS[layer].height < feed.second.height) {
+          layer++;
+        }
+      }
+
+      wanted[feed.first] = layer;
+      total += LAYERS[layer].bitrate;
+    }
+
+    // over budget the richest layer steps down first, the smallest tile loses the ties
+    while(total > this->_budget) {
+      auto victim = wanted.end();
+      for(auto item = wanted.begin(); item != wanted.end(); item++) {
+        if(item->second == 0) {
+          continue;
+        }
+
+        if(victim == wanted.end() || item->second > victim->second || (item->second == victim->second && this->_feeds[item->first].height < this->_feeds[victim->first].height)) {
+          victim = item;
+        }
+      }
+
+      if(victim == wanted.end()) {
+        break;
+      }
+
+      total -= LAYERS[victim->second].bitrate - LAYERS[victim->second - 1].bitrate;
+      victim->second--;
+    }
+
+    std::vector<LayerSwitch> switches;
+    for(auto& item : wanted) {
+      auto& feed = this->_feeds[item.first];
+      feed.held = false;
+      if(feed.current == item.second) {
+        continue;
+      }
+
+      if(feed.current != -1 && now - feed.switchedAt < this->_interval) {
+        feed.held = true;
+
+        continue;
+      }
+
+      feed.current = item.second;
+      feed.switchedAt = now;
+      switches.emplace_back(item.first, LAYERS[item.second].substream, LAYERS[item.second].temporal);
+    }
+
+    return switches;
+  }
+
+  int64_t LayerPolicy::due(std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    int64_t due = -1;
+    for(auto& feed : this->_feeds) {
+      if(feed.second.held == false) {
+        continue;
+      }
+
+      // rounded up, so the plan never runs before the interval expired
+      auto left = std::chrono::duration_cast<std::chrono::microseconds>(feed.second.switchedAt + this->_interval - now).count();
+      auto ms = std::max((left + 999) / 1000, (int64_t) 0);
+      if(due == -1 || ms < due) {
+        due = ms;
+      }
+    }
+
+    return due;
+  }
+
+}
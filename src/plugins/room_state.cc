@@ -0,0 +1,167 @@
+#include "janus/plugins/room_state.h"
+
+namespace Janus {
+
+  RoomStateDelta RoomState::apply(const std::shared_ptr<JanusData>& data) {
+    RoomStateDelta delta;
+
+    auto type = data->getString("videoroom", "");
+    if(type != "joined" && type != "event" && type != "destroyed") {
+      return delta;
+    }
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if(type == "destroyed") {
+      this->_clear(delta);
+
+      return delta;
+    }
+
+    if(type == "joined") {
+      auto room = data->getInt("room", -1);
+      if(room != this->_room) {
+        this->_clear(delta);
+        this->_room = room;
+      }
+    }
+
+    for(auto& publisher : data->getList("publishers")) {
+      auto id = publisher->getInt("id", -1);
+      if(id == -1) {
+        continue;
+      }
+
+      Participant participant(id, publisher->getString("display", ""), true, publisher->getString("audio_codec", ""), publisher->getString("video_codec", ""));
+      this->_upsert(participant, delta);
+    }
+
+    for(auto& attendee : data->getList("attendees")) {
+      auto id = attendee->getInt("id", -1);
+      if(id == -1) {
+        continue;
+      }
+
+      Participant participant(id, attendee->getString("display", ""), false, "", "");
+      this->_upsert(participant, delta);
+    }
+
+    auto joining = data->getObject("joining");
+    auto joiningId = joining->getInt("id", -1);
+    if(joiningId != -1) {
+      Participant participant(joiningId, joining->getString("display", ""), false, "", "");
+      this->_upsert(participant, delta);
+    }
+
+    auto unpublished = data->getInt("unpublished", -1);
+    if(unpublished != -1) {
+      this->_unpublish(unpublished, delta);
+    }
+
+    auto leaving = data->getInt("leaving", -1);
+    if(leaving != -1) {
+      this->_remove(leaving, delta);
+    }
+
+    auto kicked = data->getInt("kicked", -1);
+    if(kicked != -1) {
+      this->_remove(kicked, delta);
+    }
+
+    return delta;
+  }
+
+  std::vector<Participant> RoomState::snapshot() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return std::vector<Participant>(this->_participants.begin(), this->_participants.end());
+  }
+
+  bool RoomState::find(int64_t id, Participant& participant) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto entry = this->_index.find(id);
+    if(entry == this->_index.end()) {
+      return false;
+    }
+
+    participant = *entry->second;
+
+    return true;
+  }
+
+  int64_t RoomState::room() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_room;
+  }
+
+  size_t RoomState::size() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_participants.size();
+  }
+
+  void RoomState::_upsert(const Participant& participant, RoomStateDelta& delta) {
+    auto entry = this->_index.find(participant.id);
+    if(entry == this->_index.end()) {
+      auto position = this->_participants.insert(this->_participants.end(), participant);
+      this->_index[participant.id] = position;
+      delta.joined.push_back(participant);
+
+      return;
+    }
+
+    auto& current = *entry->second;
+    // attendees lists never carry the publisher state, so they must not demote a publisher
+    auto publisher = current.publisher || participant.publisher;
+    auto display = participant.display.empty() ? current.display : participant.display;
+    auto audioCodec = participant.publisher ? participant.audioCodec : current.audioCodec;
+    auto videoCodec = participant.publisher ? participant.videoCodec : current.videoCodec;
+
+    if(current.publisher == publisher && current.display == display && current.audioCodec == audioCodec && current.videoCodec == videoCodec) {
+      return;
+    }
+
+    current.publisher = publisher;
+    current.display = display;
+    current.audioCodec = audioCodec;
+    current.videoCodec = videoCodec;
+    delta.updated.push_back(current);
+  }
+
+  void RoomState::_unpublish(int64_t id, RoomStateDelta& delta) {
+    auto entry = this->_index.find(id);
+    if(entry == this->_index.end() || entry->second->publisher == false) {
+      return;
+    }
+
+    auto& current = *entry->second;
+    current.publisher = false;
+    current.audioCodec = "";
+    current.videoCodec = "";
+    delta.updated.push_back(current);
+  }
+
+  void RoomState::_remove(int64_t id, RoomStateDelta& delta) {
+    auto entry = this->_index.find(id);
+    if(entry == this->_index.end()) {
+      return;
+    }
+
+    this->_participants.erase(entry->second);
+    this->_index.erase(entry);
+    delta.left.push_back(id);
+  }
+
+  void RoomState::_clear(RoomStateDelta& delta) {
+    for(auto& participant : this->_participants) {
+      delta.left.push_back(participant.id);
+    }
+
+    this->_participants.clear();
+    this->_index.clear();
+    this->_room = -1;
+  }
+
+}
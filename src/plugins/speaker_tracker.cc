@@ -0,0 +1,91 @@
+#include "janus/plugins/speaker_tracker.h"
+
+namespace Janus {
+
+  SpeakerTracker::SpeakerTracker(size_t size) : _size(size) {}
+
+  bool SpeakerTracker::resize(size_t size) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto before = this->_ranking();
+    this->_size = size;
+
+    return before != this->_ranking();
+  }
+
+  bool SpeakerTracker::apply(const std::shared_ptr<JanusData>& data) {
+    auto type = data->getString("videoroom", "");
+    if(type != "talking" && type != "stopped-talking") {
+      return false;
+    }
+
+    auto id = data->getInt("id", -1);
+    if(id == -1) {
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto before = this->_ranking();
+
+    auto speaker = this->_speakers.find(id);
+    if(speaker == this->_speakers.end()) {
+      this->_recency.push_front(id);
+      this->_speakers[id] = { this->_recency.begin(), type == "talking" };
+    } else {
+      this->_recency.splice(this->_recency.begin(), this->_recency, speaker->second.position);
+      speaker->second.talking = type == "talking";
+    }
+
+    return before != this->_ranking();
+  }
+
+  bool SpeakerTracker::remove(int64_t id) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto speaker = this->_speakers.find(id);
+    if(speaker == this->_speakers.end()) {
+      return false;
+    }
+
+    auto before = this->_ranking();
+
+    this->_recency.erase(speaker->second.position);
+    this->_speakers.erase(speaker);
+
+    return before != this->_ranking();
+  }
+
+  std::vector<int64_t> SpeakerTracker::ranking() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_ranking();
+  }
+
+  std::vector<int64_t> SpeakerTracker::_ranking() {
+    std::vector<int64_t> ranking;
+
+    for(auto id : this->_recency) {
+      if(ranking.size() == this->_size) {
+        return ranking;
+      }
+
+      if(this->_speakers[id].talking == true) {
+        ranking.push_back(id);
+      }
+    }
+
+    for(auto id : this->_recency) {
+      if(ranking.size() == this->_size) {
+        return ranking;
+      }
+
+      if(this->_speakers[id].talking == false) {
+        ranking.push_back(id);
+      }
+    }
+
+    return ranking;
+  }
+
+}
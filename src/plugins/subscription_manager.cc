@@ -0,0 +1,192 @@
+#include "janus/plugins/subscription_manager.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace Janus {
+
+  SubscriptionManager::SubscriptionManager(int64_t maxActive, int64_t maxWarm, int64_t hysteresis) {
+    this->configure(maxActive, maxWarm, hysteresis);
+  }
+
+  void SubscriptionManager::configure(int64_t maxActive, int64_t maxWarm, int64_t hysteresis) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_maxActive = (size_t) std::max(maxActive, (int64_t) 0);
+    this->_maxWarm = (size_t) std::max(maxWarm, (int64_t) 0);
+    this->_hysteresis = std::chrono::milliseconds(std::max(hysteresis, (int64_t) 0));
+  }
+
+  SubscriptionPlan SubscriptionManager::update(const std::vector<int64_t>& visible) {
+    return this->update(visible, std::chrono::steady_clock::now());
+  }
+
+  SubscriptionPlan SubscriptionManager::update(const std::vector<int64_t>& visible, std::chrono::steady_clock::time_point now) {
+    SubscriptionPlan plan;
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    // the visible feeds come in priority order, so only the first ones fitting the budget are wanted
+    std::vector<int64_t> wanted;
+    std::unordered_set<int64_t> wantedSet;
+    for(auto feed : visible) {
+      if(wanted.size() == this->_maxActive) {
+        break;
+      }
+
+      if(wantedSet.insert(feed).second == true) {
+        wanted.push_back(feed);
+      }
+    }
+
+    for(auto& entry : this->_entries) {
+      if(entry.second.visible == true && wantedSet.count(entry.first) == 0) {
+        entry.second.visible = false;
+        entry.second.hiddenSince = now;
+      }
+    }
+
+    for(auto feed : wanted) {
+      auto entry = this->_entries.find(feed);
+      if(entry == this->_entries.end()) {
+        this->_entries[feed] = { State::ACTIVE, true, now };
+        plan.attach.push_back(feed);
+
+        continue;
+      }
+
+      entry->second.visible = true;
+      if(entry->second.state == State::WARM) {
+        entry->second.state = State::ACTIVE;
+        plan.resume.push_back(feed);
+      }
+    }
+
+    this->_evict(plan, now);
+
+    return plan;
+  }
+
+  SubscriptionPlan SubscriptionManager::remove(int64_t feed) {
+    SubscriptionPlan plan;
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if(this->_entries.erase(feed) > 0) {
+      plan.detach.push_back(feed);
+    }
+
+    return plan;
+  }
+
+  void SubscriptionManager::replace(int64_t from, int64_t feed) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto entry = this->_entries.find(from);
+    if(entry == this->_entries.end()) {
+      return;
+    }
+
+    auto moved = entry->second;
+    this->_entries.erase(entry);
+    this->_entries.emplace(feed, moved);
+  }
+
+  SubscriptionPlan SubscriptionManager::tick() {
+    return this->tick(std::chrono::steady_clock::now());
+  }
+
+  SubscriptionPlan SubscriptionManager::tick(std::chrono::steady_clock::time_point now) {
+    SubscriptionPlan plan;
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_evict(plan, now);
+
+    return plan;
+  }
+
+  int64_t SubscriptionManager::due(std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    int64_t due = -1;
+    for(auto& entry : this->_entries) {
+      if(entry.second.state == State::WARM || entry.second.visible == true) {
+        continue;
+      }
+
+      // rounded up, so the tick never lands before the expiry
+      auto left = std::chrono::duration_cast<std::chrono::microseconds>(entry.second.hiddenSince + this->_hysteresis - now).count();
+      auto ms = std::max((left + 999) / 1000, (int64_t) 0);
+      if(due == -1 || ms < due) {
+        due = ms;
+      }
+    }
+
+    return due;
+  }
+
+  bool SubscriptionManager::tracks(int64_t feed) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_entries.count(feed) > 0;
+  }
+
+  size_t SubscriptionManager::active() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_count(State::ACTIVE);
+  }
+
+  size_t SubscriptionManager::warm() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_count(State::WARM);
+  }
+
+  void SubscriptionManager::_evict(SubscriptionPlan& plan, std::chrono::steady_clock::time_point now) {
+    std::vector<std::pair<std::chrono::steady_clock::time_point, int64_t>> hidden;
+    for(auto& entry : this->_entries) {
+      if(entry.second.state == State::ACTIVE && entry.second.visible == false) {
+        hidden.emplace_back(entry.second.hiddenSince, entry.first);
+      }
+    }
+    std::sort(hidden.begin(), hidden.end());
+
+    // a hidden feed keeps flowing until the hysteresis expires, unless its slot is needed right now
+    auto active = this->_count(State::ACTIVE);
+    for(auto& item : hidden) {
+      if(active <= this->_maxActive && now - item.first < this->_hysteresis) {
+        continue;
+      }
+
+      this->_entries[item.second].state = State::WARM;
+      plan.pause.push_back(item.second);
+      active--;
+    }
+
+    std::vector<std::pair<std::chrono::steady_clock::time_point, int64_t>> warm;
+    for(auto& entry : this->_entries) {
+      if(entry.second.state == State::WARM) {
+        warm.emplace_back(entry.second.hiddenSince, entry.first);
+      }
+    }
+    std::sort(warm.begin(), warm.end());
+
+    for(size_t i = 0; warm.size() - i > this->_maxWarm; i++) {
+      this->_entries.erase(warm[i].second);
+      plan.detach.push_back(warm[i].second);
+    }
+  }
+
+  size_t SubscriptionManager::_count(State state) {
+    size_t count = 0;
+    for(auto& entry : this->_entries) {
+      if(entry.second.state == state) {
+        count++;
+      }
+    }
+
+    return count;
+  }
+
+}
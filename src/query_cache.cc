@@ -0,0 +1,99 @@
+#include "janus/query_cache.h"
+
+namespace Janus {
+
+  QueryCache::QueryCache(int64_t ttl, int64_t timeout) : _ttl(ttl), _timeout(timeout) {}
+
+  QueryStatus QueryCache::acquire(const std::string& key, const std::string& scope, const std::shared_ptr<Bundle>& context, nlohmann::json& reply) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto now = std::chrono::steady_clock::now();
+
+    auto entry = this->_entries.find(key);
+    if(entry != this->_entries.end()) {
+      if(now < entry->second.expiresAt) {
+        reply = entry->second.reply;
+
+        return QueryStatus::HIT;
+      }
+
+      this->_entries.erase(entry);
+    }
+
+    std::vector<std::shared_ptr<Bundle>> waiters;
+    auto flight = this->_flights.find(key);
+    if(flight != this->_flights.end()) {
+      if(now < flight->second.deadline) {
+        flight->second.waiters.push_back(context);
+
+        return QueryStatus::PENDING;
+      }
+
+      // the reply got lost, whoever waited for it gets the one of the new request
+      waiters = std::move(flight->second.waiters);
+      this->_flights.erase(flight);
+    }
+
+    waiters.push_back(context);
+    this->_flights[key] = { scope, this->_generations[scope], now + this->_timeout, waiters };
+
+    return QueryStatus::MISS;
+  }
+
+  std::vector<std::shared_ptr<Bundle>> QueryCache::complete(const std::string& key, const nlohmann::json& reply, bool cacheable) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto flight = this->_flights.find(key);
+    if(flight == this->_flights.end()) {
+      return {};
+    }
+
+    auto waiters = std::move(flight->second.waiters);
+    auto scope = flight->second.scope;
+    // a reply requested before the last invalidation of its scope could already be stale
+    auto fresh = flight->second.generation == this->_generations[scope];
+    this->_flights.erase(flight);
+
+    if(cacheable == true && fresh == true && this->_ttl.count() > 0) {
+      this->_entries[key] = { scope, reply, std::chrono::steady_clock::now() + this->_ttl };
+    }
+
+    return waiters;
+  }
+
+  void QueryCache::invalidate(const std::string& scope) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    for(auto entry = this->_entries.begin(); entry != this->_entries.end();) {
+      if(entry->second.scope == scope) {
+        entry = this->_entries.erase(entry);
+      } else {
+        entry++;
+      }
+    }
+
+    this->_generations[scope]++;
+  }
+
+  void QueryCache::invalidate() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_entries.clear();
+    for(auto& flight : this->_flights) {
+      this->_generations[flight.second.scope]++;
+    }
+  }
+
+  std::vector<std::shared_ptr<Bundle>> QueryCache::abandon() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    std::vector<std::shared_ptr<Bundle>> waiters;
+    for(auto& flight : this->_flights) {
+      waiters.insert(waiters.end(), flight.second.waiters.begin(), flight.second.waiters.end());
+    }
+
+    this->_flights.clear();
+
+    return waiters;
+  }
+
+}
@@ -0,0 +1,531 @@
+#include "janus/sdp.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace Janus {
+
+  namespace {
+
+    bool startsWith(const std::string& line, const std::string& prefix) {
+      return line.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    bool sameCodec(const std::string& a, const std::string& b) {
+      return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower((unsigned char) x) == std::tolower((unsigned char) y);
+      });
+    }
+
+    bool contains(const std::vector<std::string>& codecs, const std::string& codec) {
+      return std::any_of(codecs.begin(), codecs.end(), [&codec](const std::string& current) {
+        return sameCodec(current, codec);
+      });
+    }
+
+    // calls back with the offset and the size of every non empty line, with or without the \r
+    template <typename Callback> void forEachLine(const std::string& text, Callback callback) {
+      size_t start = 0;
+      while(start < text.size()) {
+        auto end = text.find('\n', start);
+        if(end == std::string::npos) {
+          end = text.size();
+        }
+
+        auto size = end - start;
+        if(size > 0 && text[start + size - 1] == '\r') {
+          size--;
+        }
+
+        if(size > 0) {
+          callback(start, size);
+        }
+
+        start = end + 1;
+      }
+    }
+
+    // the payload type an a=rtpmap, a=fmtp or a=rtcp-fb line refers to, empty for any other line
+    std::string payloadOf(const std::string& line) {
+      for(auto prefix : { "a=rtpmap:", "a=fmtp:", "a=rtcp-fb:" }) {
+        std::string attribute(prefix);
+        if(startsWith(line, attribute) == true) {
+          auto end = line.find(' ', attribute.size());
+          return line.substr(attribute.size(), end == std::string::npos ? std::string::npos : end - attribute.size());
+        }
+      }
+
+      return "";
+    }
+
+  }
+
+  /* SdpSlice */
+
+  bool SdpSlice::startsWith(const char* prefix) const {
+    auto length = std::strlen(prefix);
+
+    return this->size >= length && std::memcmp(this->data, prefix, length) == 0;
+  }
+
+  bool SdpSlice::equals(const char* literal) const {
+    return this->size == std::strlen(literal) && this->startsWith(literal) == true;
+  }
+
+  std::string SdpSlice::str() const {
+    return std::string(this->data, this->size);
+  }
+
+  /* SessionDescription */
+
+  SessionDescription::SessionDescription(std::string sdp) : _buffer(std::move(sdp)) {
+  }
+
+  const std::string& SessionDescription::str() const {
+    return this->_buffer;
+  }
+
+  size_t SessionDescription::mediaCount() const {
+    this->_index();
+
+    return this->_sections.size() - 1;
+  }
+
+  SdpSlice SessionDescription::mline(size_t media) const {
+    this->_index();
+
+    return this->_line(this->_sections.at(media + 1).first);
+  }
+
+  SdpSlice SessionDescription::kind(size_t media) const {
+    auto line = this->mline(media);
+
+    SdpSlice kind;
+    kind.data = line.data + 2;
+    while(kind.size < line.size - 2 && kind.data[kind.size] != ' ') {
+      kind.size++;
+    }
+
+    return kind;
+  }
+
+  bool SessionDescription::attribute(const char* name, SdpSlice& value) const {
+    this->_index();
+
+    return this->_find(this->_sections.front(), name, value);
+  }
+
+  bool SessionDescription::attribute(size_t media, const char* name, SdpSlice& value) const {
+    this->_index();
+
+    return this->_find(this->_sections.at(media + 1), name, value);
+  }
+
+  std::vector<SdpSlice> SessionDescription::attributes(size_t media, const char* name) const {
+    this->_index();
+
+    std::vector<SdpSlice> values;
+    auto& section = this->_sections.at(media + 1);
+    auto prefix = std::string("a=") + name + ":";
+    for(auto line = section.first; line < section.first + section.count; line++) {
+      auto slice = this->_line(line);
+      if(slice.startsWith(prefix.c_str()) == true) {
+        slice.data += prefix.size();
+        slice.size -= prefix.size();
+        values.push_back(slice);
+      }
+    }
+
+    return values;
+  }
+
+  std::vector<SdpSlice> SessionDescription::candidates(size_t media) const {
+    auto values = this->attributes(media, "candidate");
+    for(auto& value : values) {
+      value.data -= std::strlen("candidate:");
+      value.size += std::strlen("candidate:");
+    }
+
+    return values;
+  }
+
+  std::string SessionDescription::without(const std::vector<SdpSlice>& slices) const {
+    this->_index();
+
+    std::string sdp;
+    sdp.reserve(this->_buffer.size());
+    for(size_t line = 0; line < this->_lines.size(); line++) {
+      auto slice = this->_line(line);
+      auto dropped = std::any_of(slices.begin(), slices.end(), [&slice](const SdpSlice& current) {
+        return current.data >= slice.data && current.data < slice.data + slice.size;
+      });
+
+      if(dropped == false) {
+        sdp.append(slice.data, slice.size);
+        sdp += "\r\n";
+      }
+    }
+
+    return sdp;
+  }
+
+  void SessionDescription::_index() const {
+    std::call_once(this->_indexed, [this]() {
+      this->_sections.push_back({ 0, 0 });
+
+      forEachLine(this->_buffer, [this](size_t offset, size_t size) {
+        if(this->_buffer.compare(offset, 2, "m=") == 0) {
+          this->_sections.push_back({ this->_lines.size(), 0 });
+        }
+
+        this->_lines.push_back({ offset, size });
+        this->_sections.back().count++;
+      });
+    });
+  }
+
+  SdpSlice SessionDescription::_line(size_t line) const {
+    SdpSlice slice;
+    slice.data = this->_buffer.data() + this->_lines[line].offset;
+    slice.size = this->_lines[line].size;
+
+    return slice;
+  }
+
+  bool SessionDescription::_find(const Section& section, const char* name, SdpSlice& value) const {
+    auto length = std::strlen(name);
+    for(auto line = section.first; line < section.first + section.count; line++) {
+      auto slice = this->_line(line);
+      if(slice.size < length + 2 || slice.startsWith("a=") == false || std::memcmp(slice.data + 2, name, length) != 0) {
+        continue;
+      }
+
+      if(slice.size == length + 2) {
+        value.data = slice.data + slice.size;
+        value.size = 0;
+
+        return true;
+      }
+
+      if(slice.data[length + 2] == ':') {
+        value.data = slice.data + length + 3;
+        value.size = slice.size - length - 3;
+
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /* SdpMedia */
+
+  std::string SdpMedia::kind() const {
+    auto& line = this->lines.front();
+    auto end = line.find(' ');
+
+    return line.substr(2, end == std::string::npos ? std::string::npos : end - 2);
+  }
+
+  std::vector<std::string> SdpMedia::payloads() const {
+    // m=<kind> <port> <proto> <fmt> ...
+    std::vector<std::string> formats;
+    auto& line = this->lines.front();
+
+    size_t index = 0;
+    size_t start = 0;
+    while(start < line.size()) {
+      auto end = line.find(' ', start);
+      if(end == std::string::npos) {
+        end = line.size();
+      }
+
+      if(index >= 3 && end > start) {
+        formats.emplace_back(line, start, end - start);
+      }
+
+      index++;
+      start = end + 1;
+    }
+
+    return formats;
+  }
+
+  void SdpMedia::payloads(const std::vector<std::string>& formats) {
+    auto& line = this->lines.front();
+
+    // keeps "m=<kind> <port> <proto>"
+    size_t end = 0;
+    for(int index = 0; index < 3 && end != std::string::npos; index++) {
+      end = line.find(' ', end == 0 ? 0 : end + 1);
+    }
+
+    auto rewritten = line.substr(0, end);
+    for(auto& format : formats) {
+      rewritten += " " + format;
+    }
+
+    line = rewritten;
+  }
+
+  std::string SdpMedia::codec(const std::string& payload) const {
+    auto prefix = "a=rtpmap:" + payload + " ";
+    for(auto& line : this->lines) {
+      if(startsWith(line, prefix) == true) {
+        auto end = line.find('/', prefix.size());
+        return line.substr(prefix.size(), end == std::string::npos ? std::string::npos : end - prefix.size());
+      }
+    }
+
+    return "";
+  }
+
+  void SdpMedia::removePayload(const std::string& payload) {
+    auto formats = this->payloads();
+    formats.erase(std::remove(formats.begin(), formats.end(), payload), formats.end());
+    this->payloads(formats);
+
+    this->lines.erase(std::remove_if(this->lines.begin() + 1, this->lines.end(), [&payload](const std::string& line) {
+      return payloadOf(line) == payload;
+    }), this->lines.end());
+  }
+
+  void SdpMedia::insert(const std::string& line) {
+    if(startsWith(line, "b=") == false) {
+      this->lines.push_back(line);
+
+      return;
+    }
+
+    // m= then i= then c= then the b= lines
+    auto position = this->lines.begin() + 1;
+    while(position != this->lines.end() && (startsWith(*position, "i=") || startsWith(*position, "c=") || startsWith(*position, "b="))) {
+      position++;
+    }
+
+    this->lines.insert(position, line);
+  }
+
+  /* Sdp */
+
+  Sdp::Sdp(const std::string& sdp) {
+    forEachLine(sdp, [this, &sdp](size_t offset, size_t size) {
+      if(sdp.compare(offset, 2, "m=") == 0) {
+        this->media.emplace_back();
+      }
+
+      auto& lines = this->media.empty() == true ? this->session : this->media.back().lines;
+      lines.emplace_back(sdp, offset, size);
+    });
+  }
+
+  Sdp::Sdp(const SessionDescription& description) {
+    description._index();
+
+    auto& header = description._sections.front();
+    for(auto line = header.first; line < header.first + header.count; line++) {
+      this->session.push_back(description._line(line).str());
+    }
+
+    for(size_t index = 1; index < description._sections.size(); index++) {
+      auto& section = description._sections[index];
+
+      this->media.emplace_back();
+      for(auto line = section.first; line < section.first + section.count; line++) {
+        this->media.back().lines.push_back(description._line(line).str());
+      }
+    }
+  }
+
+  std::string Sdp::str() const {
+    std::string sdp;
+    for(auto& line : this->session) {
+      sdp += line + "\r\n";
+    }
+
+    for(auto& section : this->media) {
+      for(auto& line : section.lines) {
+        sdp += line + "\r\n";
+      }
+    }
+
+    return sdp;
+  }
+
+  /* Transforms */
+
+  SdpCodecPreference::SdpCodecPreference(const std::string& kind, const std::vector<std::string>& codecs) {
+    this->_kind = kind;
+    this->_codecs = codecs;
+  }
+
+  void SdpCodecPreference::apply(Sdp& sdp, SdpType type) {
+    for(auto& section : sdp.media) {
+      if(section.kind() != this->_kind) {
+        continue;
+      }
+
+      auto formats = section.payloads();
+      std::vector<std::string> preferred;
+      for(auto& codec : this->_codecs) {
+        for(auto& format : formats) {
+          if(sameCodec(section.codec(format), codec) == true) {
+            preferred.push_back(format);
+          }
+        }
+      }
+
+      for(auto& format : formats) {
+        if(std::find(preferred.begin(), preferred.end(), format) == preferred.end()) {
+          preferred.push_back(format);
+        }
+      }
+
+      section.payloads(preferred);
+    }
+  }
+
+  SdpCodecFilter::SdpCodecFilter(const std::string& kind, const std::vector<std::string>& codecs) {
+    this->_kind = kind;
+    this->_codecs = codecs;
+  }
+
+  void SdpCodecFilter::apply(Sdp& sdp, SdpType type) {
+    for(auto& section : sdp.media) {
+      if(section.kind() != this->_kind) {
+        continue;
+      }
+
+      std::vector<std::string> removed;
+      size_t kept = 0;
+      for(auto& format : section.payloads()) {
+        auto codec = section.codec(format);
+        if(contains(this->_codecs, codec) == true) {
+          removed.push_back(format);
+        } else if(sameCodec(codec, "rtx") == false) {
+          kept++;
+        }
+      }
+
+      if(removed.empty() == true || kept == 0) {
+        continue;
+      }
+
+      // a retransmission payload goes away with the payload it is associated to
+      std::vector<std::string> retransmissions;
+      for(auto& line : section.lines) {
+        if(startsWith(line, "a=fmtp:") == false) {
+          continue;
+        }
+
+        auto apt = line.find("apt=");
+        if(apt != std::string::npos && std::find(removed.begin(), removed.end(), line.substr(apt + 4, line.find_first_of(";", apt) - apt - 4)) != removed.end()) {
+          retransmissions.push_back(payloadOf(line));
+        }
+      }
+
+      removed.insert(removed.end(), retransmissions.begin(), retransmissions.end());
+      for(auto& payload : removed) {
+        section.removePayload(payload);
+      }
+    }
+  }
+
+  SdpExtensionFilter::SdpExtensionFilter(const std::vector<std::string>& uris) {
+    this->_uris = uris;
+  }
+
+  void SdpExtensionFilter::apply(Sdp& sdp, SdpType type) {
+    auto strip = [this](const std::string& line) {
+      if(startsWith(line, "a=extmap:") == false) {
+        return false;
+      }
+
+      // a=extmap:<id>[/<direction>] <uri> [<attributes>]
+      auto start = line.find(' ');
+      if(start == std::string::npos) {
+        return false;
+      }
+
+      auto end = line.find(' ', start + 1);
+      auto uri = line.substr(start + 1, end == std::string::npos ? std::string::npos : end - start - 1);
+
+      return std::find(this->_uris.begin(), this->_uris.end(), uri) != this->_uris.end();
+    };
+
+    sdp.session.erase(std::remove_if(sdp.session.begin(), sdp.session.end(), strip), sdp.session.end());
+    for(auto& section : sdp.media) {
+      section.lines.erase(std::remove_if(section.lines.begin() + 1, section.lines.end(), strip), section.lines.end());
+    }
+  }
+
+  SdpBandwidth::SdpBandwidth(const std::string& kind, int64_t kbps) {
+    this->_kind = kind;
+    this->_kbps = kbps;
+  }
+
+  void SdpBandwidth::apply(Sdp& sdp, SdpType type) {
+    for(auto& section : sdp.media) {
+      if(section.kind() != this->_kind) {
+        continue;
+      }
+
+      section.lines.erase(std::remove_if(section.lines.begin() + 1, section.lines.end(), [](const std::string& line) {
+        return startsWith(line, "b=AS:") || startsWith(line, "b=TIAS:");
+      }), section.lines.end());
+
+      section.insert("b=AS:" + std::to_string(this->_kbps));
+      section.insert("b=TIAS:" + std::to_string(this->_kbps * 1000));
+    }
+  }
+
+  /* SdpPipeline */
+
+  void SdpPipeline::add(const std::shared_ptr<SdpTransform>& transform) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_transforms.push_back(transform);
+  }
+
+  void SdpPipeline::clear() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_transforms.clear();
+  }
+
+  bool SdpPipeline::empty() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_transforms.empty();
+  }
+
+  std::shared_ptr<SessionDescription> SdpPipeline::run(const std::shared_ptr<SessionDescription>& description, SdpType type) {
+    std::vector<std::shared_ptr<SdpTransform>> transforms;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      transforms = this->_transforms;
+    }
+
+    if(transforms.empty() == true) {
+      return description;
+    }
+
+    // the lines are cut on the index the description already has
+    Sdp parsed(*description);
+    for(auto& transform : transforms) {
+      transform->apply(parsed, type);
+    }
+
+    return std::make_shared<SessionDescription>(parsed.str());
+  }
+
+  std::string SdpPipeline::run(const std::string& sdp, SdpType type) {
+    if(this->empty() == true) {
+      return sdp;
+    }
+
+    return this->run(std::make_shared<SessionDescription>(sdp), type)->str();
+  }
+
+}
@@ -0,0 +1,233 @@
+#include "janus/spans.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+namespace Janus {
+
+  namespace {
+
+    // a seqlock per slot: odd while its writer fills it, then twice the index it holds plus two
+    struct SpanSlot {
+      std::atomic<uint64_t> sequence { 0 };
+      std::atomic<const char*> name { nullptr };
+      std::atomic<uint64_t> transaction[SPAN_TRANSACTION_WORDS];
+      std::atomic<int64_t> start { 0 };
+      std::atomic<int64_t> duration { 0 };
+      std::atomic<int32_t> thread { 0 };
+      std::atomic<bool> async { false };
+    };
+
+    std::atomic<SpanSlot*> ring { nullptr };
+    std::atomic<uint64_t> head { 0 };
+    std::atomic<uint64_t> floor { 0 };
+    std::once_flag allocated;
+
+    std::atomic<int32_t> threads { 0 };
+
+    int32_t threadId() {
+      thread_local int32_t id = ++threads;
+
+      return id;
+    }
+
+  }
+
+  /* Spans */
+
+  std::atomic<bool> Spans::_enabled { false };
+
+  void Spans::enable(bool enabled) {
+    // the ring costs nothing until somebody wants spans, then it stays for the export
+    if(enabled == true) {
+      std::call_once(allocated, [] {
+        auto slots = new SpanSlot[SPAN_RING_SIZE];
+        for(int index = 0; index < SPAN_RING_SIZE; index++) {
+          for(auto& word : slots[index].transaction) {
+            word.store(0, std::memory_order_relaxed);
+          }
+        }
+
+        ring.store(slots, std::memory_order_release);
+      });
+    }
+
+    Spans::_enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  int64_t Spans::now() {
+    static const auto epoch = std::chrono::steady_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch).count();
+  }
+
+  void Spans::record(const char* name, const std::string& transaction, int64_t start, int64_t end, bool async) {
+    auto slots = ring.load(std::memory_order_acquire);
+    if(slots == nullptr || Spans::enabled() == false) {
+      return;
+    }
+
+    auto index = head.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = slots[index & (SPAN_RING_SIZE - 1)];
+    auto sequence = (index + 1) * 2;
+
+    slot.sequence.store(sequence - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t words[SPAN_TRANSACTION_WORDS] = { 0 };
+    std::memcpy(words, transaction.data(), std::min(transaction.size(), sizeof(words)));
+    for(int word = 0; word < SPAN_TRANSACTION_WORDS; word++) {
+      slot.transaction[word].store(words[word], std::memory_order_relaxed);
+    }
+
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.duration.store(end - start, std::memory_order_relaxed);
+    slot.thread.store(threadId(), std::memory_order_relaxed);
+    slot.async.store(async, std::memory_order_relaxed);
+
+    slot.sequence.store(sequence, std::memory_order_release);
+  }
+
+  void Spans::clear() {
+    floor.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+  nlohmann::json Spans::chromeTrace() {
+    auto events = nlohmann::json::array();
+
+    auto slots = ring.load(std::memory_order_acquire);
+    auto last = head.load(std::memory_order_relaxed);
+    auto first = std::max(floor.load(std::memory_order_relaxed), last > SPAN_RING_SIZE ? last - SPAN_RING_SIZE : (uint64_t) 0);
+
+    for(auto index = first; slots != nullptr && index < last; index++) {
+      auto& slot = slots[index & (SPAN_RING_SIZE - 1)];
+
+      auto sequence = slot.sequence.load(std::memory_order_acquire);
+      if(sequence != (index + 1) * 2) {
+        continue;
+      }
+
+      uint64_t words[SPAN_TRANSACTION_WORDS + 1] = { 0 };
+      for(int word = 0; word < SPAN_TRANSACTION_WORDS; word++) {
+        words[word] = slot.transaction[word].load(std::memory_order_relaxed);
+      }
+
+      auto name = slot.name.load(std::memory_order_relaxed);
+      auto start = slot.start.load(std::memory_order_relaxed);
+      auto duration = slot.duration.load(std::memory_order_relaxed);
+      auto thread = slot.thread.load(std::memory_order_relaxed);
+      auto async = slot.async.load(std::memory_order_relaxed);
+
+      // a writer lapped the ring while this slot was read
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(slot.sequence.load(std::memory_order_relaxed) != sequence) {
+        continue;
+      }
+
+      std::string transaction(reinterpret_cast<const char*>(words));
+      nlohmann::json event = {
+        { "name", name },
+        { "cat", "janus" },
+        { "ts", start },
+        { "pid", 1 },
+        { "tid", thread },
+        { "args", { { "transaction", transaction } } }
+      };
+
+      if(async == false) {
+        event["ph"] = "X";
+        event["dur"] = duration;
+        events.push_back(event);
+
+        continue;
+      }
+
+      event["ph"] = "b";
+      event["id"] = transaction.empty() == false ? transaction : "span " + std::to_string(index);
+      events.push_back(event);
+
+      event["ph"] = "e";
+      event["ts"] = start + duration;
+      events.push_back(event);
+    }
+
+    return {
+      { "traceEvents", events },
+      { "displayTimeUnit", "ms" }
+    };
+  }
+
+  std::string transactionOf(const nlohmann::json& message) {
+    if(message.is_object() == false) {
+      return "";
+    }
+
+    auto transaction = message.find("transaction");
+    if(transaction == message.end() || transaction->is_string() == false) {
+      return "";
+    }
+
+    return transaction->get<std::string>();
+  }
+
+  /* Span Scope */
+
+  SpanScope::SpanScope(const char* name, const std::string& transaction) {
+    this->_name = name;
+
+    if(Spans::enabled() == true) {
+      this->_transaction = transaction;
+      this->_start = Spans::now();
+    }
+  }
+
+  SpanScope::SpanScope(const char* name, const nlohmann::json& message) {
+    this->_name = name;
+
+    if(Spans::enabled() == true) {
+      this->_transaction = transactionOf(message);
+      this->_start = Spans::now();
+    }
+  }
+
+  SpanScope::~SpanScope() {
+    if(this->_start >= 0) {
+      Spans::record(this->_name, this->_transaction, this->_start, Spans::now());
+    }
+  }
+
+  /* Span Timeline */
+
+  SpanTimeline::SpanTimeline(int64_t start) {
+    this->_start = start;
+  }
+
+  void SpanTimeline::mark(const char* stage, bool async) {
+    if(this->_start < 0 || this->_count == SPAN_TIMELINE_STAGES) {
+      return;
+    }
+
+    this->_stages[this->_count++] = { stage, Spans::now(), async };
+  }
+
+  void SpanTimeline::record(const std::string& transaction, const char* flow) {
+    if(this->_start < 0) {
+      return;
+    }
+
+    auto previous = this->_start;
+    for(int index = 0; index < this->_count; index++) {
+      auto& stage = this->_stages[index];
+      Spans::record(stage.name, transaction, previous, stage.end, stage.async);
+      previous = stage.end;
+    }
+
+    if(flow != nullptr) {
+      Spans::record(flow, transaction, this->_start, previous, true);
+    }
+  }
+
+}
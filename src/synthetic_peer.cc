@@ -0,0 +1,470 @@
+#include "janus/synthetic_peer.h"
+
+#include <sstream>
+
+#include "janus/sdp.h"
+
+namespace Janus {
+
+  namespace {
+
+    const char* FINGERPRINT = "sha-256 6B:8B:5D:EA:59:04:20:23:29:C8:87:1C:CC:87:32:BE:DD:8C:66:A5:8E:50:55:EA:8C:D3:B6:5C:09:5E:D6:BC";
+
+    struct Codec {
+      const char* payload;
+      const char* rtpmap;
+      const char* fmtp;
+      bool feedback;
+    };
+
+    const Codec AUDIO_CODECS[] = {
+      { "111", "opus/48000/2", "minptime=10;useinbandfec=1", false },
+      { "63", "red/48000/2", "111/111", false },
+      { "9", "G722/8000", nullptr, false },
+      { "0", "PCMU/8000", nullptr, false },
+      { "8", "PCMA/8000", nullptr, false },
+      { "13", "CN/8000", nullptr, false },
+      { "110", "telephone-event/48000", nullptr, false }
+    };
+
+    const Codec VIDEO_CODECS[] = {
+      { "96", "VP8/90000", nullptr, true },
+      { "97", "rtx/90000", "apt=96", false },
+      { "98", "VP9/90000", "profile-id=0", true },
+      { "99", "rtx/90000", "apt=98", false },
+      { "102", "H264/90000", "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42e01f", true },
+      { "103", "rtx/90000", "apt=102", false }
+    };
+
+    const char* AUDIO_EXTENSIONS[] = {
+      "urn:ietf:params:rtp-hdrext:ssrc-audio-level",
+      "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time",
+      "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01",
+      "urn:ietf:params:rtp-hdrext:sdes:mid"
+    };
+
+    const char* VIDEO_EXTENSIONS[] = {
+      "urn:ietf:params:rtp-hdrext:toffset",
+      "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time",
+      "urn:3gpp:video-orientation",
+      "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01",
+      "urn:ietf:params:rtp-hdrext:sdes:mid",
+      "urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id",
+      "urn:ietf:params:rtp-hdrext:sdes:repaired-rtp-stream-id"
+    };
+
+    // deterministic, so that a run can be replayed
+    std::string token(int64_t seed, size_t size) {
+      const char* alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789+/";
+      auto state = (uint64_t) seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+      std::string value;
+      for(size_t index = 0; index < size; index++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        value += alphabet[(state >> 33) % 64];
+      }
+
+      return value;
+    }
+
+    std::string direction(bool send, bool receive) {
+      if(send == true && receive == true) {
+        return "sendrecv";
+      }
+
+      return send == true ? "sendonly" : receive == true ? "recvonly" : "inactive";
+    }
+
+    struct Section {
+      std::string kind;
+      std::string mid;
+      bool send = false;
+      bool receive = false;
+      // the answer keeps the first format the offer proposes, an empty list rejects the section
+      std::vector<const Codec*> codecs;
+      std::string application;
+    };
+
+    class Writer {
+      public:
+        Writer(int64_t id, int64_t version, const std::string& setup) : _id(id), _setup(setup) {
+          this->_session << "v=0\r\n";
+          this->_session << "o=- " << (4611686018427387904LL + id) << " " << version << " IN IP4 127.0.0.1\r\n";
+          this->_session << "s=-\r\nt=0 0\r\n";
+        }
+
+        void add(const Section& section, const std::vector<std::string>& rids) {
+          auto rejected = section.codecs.empty() == true && section.application.empty() == true;
+          auto port = rejected == true ? "0" : "9";
+
+          if(section.kind == "application") {
+            this->_media << "m=application " << port << " UDP/DTLS/SCTP " << (section.application.empty() ? "webrtc-datachannel" : section.application) << "\r\n";
+          } else {
+            this->_media << "m=" << section.kind << " " << port << " UDP/TLS/RTP/SAVPF";
+            for(auto codec : section.codecs) {
+              this->_media << " " << codec->payload;
+            }
+            this->_media << "\r\n";
+          }
+
+          this->_media << "c=IN IP4 0.0.0.0\r\n";
+          if(section.kind != "application") {
+            this->_media << "a=rtcp:9 IN IP4 0.0.0.0\r\n";
+          }
+
+          this->_media << "a=ice-ufrag:" << token(this->_id, 4) << "\r\n";
+          this->_media << "a=ice-pwd:" << token(this->_id + 1, 24) << "\r\n";
+          this->_media << "a=ice-options:trickle\r\n";
+          this->_media << "a=fingerprint:" << FINGERPRINT << "\r\n";
+          this->_media << "a=setup:" << this->_setup << "\r\n";
+          this->_media << "a=mid:" << section.mid << "\r\n";
+
+          if(rejected == false) {
+            this->_mids += " " + section.mid;
+          }
+
+          if(section.kind == "application") {
+            this->_media << "a=sctp-port:5000\r\na=max-message-size:262144\r\n";
+
+            return;
+          }
+
+          auto extensions = section.kind == "audio" ? std::vector<const char*>(std::begin(AUDIO_EXTENSIONS), std::end(AUDIO_EXTENSIONS)) : std::vector<const char*>(std::begin(VIDEO_EXTENSIONS), std::end(VIDEO_EXTENSIONS));
+          for(size_t index = 0; index < extensions.size(); index++) {
+            this->_media << "a=extmap:" << index + 1 << " " << extensions[index] << "\r\n";
+          }
+
+          this->_media << "a=" << direction(section.send, section.receive) << "\r\n";
+
+          auto stream = token(this->_id + 2, 36);
+          if(section.send == true) {
+            this->_media << "a=msid:" << stream << " " << token(this->_id + 3 + section.kind.size(), 36) << "\r\n";
+          }
+
+          this->_media << "a=rtcp-mux\r\n";
+          if(section.kind == "video") {
+            this->_media << "a=rtcp-rsize\r\n";
+          }
+
+          for(auto codec : section.codecs) {
+            this->_media << "a=rtpmap:" << codec->payload << " " << codec->rtpmap << "\r\n";
+            if(codec->feedback == true) {
+              for(auto feedback : { "goog-remb", "transport-cc", "ccm fir", "nack", "nack pli" }) {
+                this->_media << "a=rtcp-fb:" << codec->payload << " " << feedback << "\r\n";
+              }
+            }
+            if(codec->fmtp != nullptr) {
+              this->_media << "a=fmtp:" << codec->payload << " " << codec->fmtp << "\r\n";
+            }
+          }
+
+          if(section.send == false) {
+            return;
+          }
+
+          auto ssrc = 1000000000LL + (this->_id * 7919 + section.kind.size() * 104729) % 1000000000LL;
+          if(rids.size() > 1) {
+            std::string layers;
+            for(auto& rid : rids) {
+              this->_media << "a=rid:" << rid << " send\r\n";
+              layers += (layers.empty() ? "" : ";") + rid;
+            }
+            this->_media << "a=simulcast:send " << layers << "\r\n";
+
+            return;
+          }
+
+          auto cname = token(this->_id + 4, 16);
+          if(section.kind == "video") {
+            this->_media << "a=ssrc-group:FID " << ssrc << " " << ssrc + 1 << "\r\n";
+          }
+          this->_media << "a=ssrc:" << ssrc << " cname:" << cname << "\r\n";
+          if(section.kind == "video") {
+            this->_media << "a=ssrc:" << ssrc + 1 << " cname:" << cname << "\r\n";
+          }
+        }
+
+        std::string str() {
+          auto session = this->_session.str();
+          session += "a=group:BUNDLE" + this->_mids + "\r\n";
+          session += "a=extmap-allow-mixed\r\na=msid-semantic: WMS\r\n";
+
+          return session + this->_media.str();
+        }
+
+      private:
+        int64_t _id;
+        std::string _setup;
+        std::string _mids;
+        std::ostringstream _session;
+        std::ostringstream _media;
+    };
+
+    std::vector<const Codec*> codecs(const std::string& kind) {
+      std::vector<const Codec*> all;
+      if(kind == "audio") {
+        for(auto& codec : AUDIO_CODECS) {
+          all.push_back(&codec);
+        }
+      } else {
+        for(auto& codec : VIDEO_CODECS) {
+          all.push_back(&codec);
+        }
+      }
+
+      return all;
+    }
+
+    // the offered format we support, with its retransmission payload
+    std::vector<const Codec*> negotiate(const std::string& kind, const std::vector<std::string>& offered) {
+      auto supported = codecs(kind);
+
+      for(auto& format : offered) {
+        for(auto codec : supported) {
+          if(format != codec->payload || std::string(codec->rtpmap).compare(0, 4, "rtx/") == 0) {
+            continue;
+          }
+
+          std::vector<const Codec*> chosen = { codec };
+          for(auto rtx : supported) {
+            if(rtx->fmtp != nullptr && std::string(rtx->fmtp) == std::string("apt=") + codec->payload) {
+              chosen.push_back(rtx);
+            }
+          }
+
+          return chosen;
+        }
+      }
+
+      return {};
+    }
+
+    std::vector<std::string> candidates(const SyntheticPeerConf& conf, int64_t id) {
+      std::vector<std::string> burst;
+      auto port = 50000 + (id * 37) % 10000;
+      int64_t foundation = 1000000000 + (id * 7) % 1000000000;
+
+      auto line = [&burst, &foundation](const std::string& transport, int64_t priority, const std::string& address, int64_t candidatePort, const std::string& tail) {
+        burst.push_back("candidate:" + std::to_string(foundation++) + " 1 " + transport + " " + std::to_string(priority) + " " + address + " " + std::to_string(candidatePort) + " typ " + tail + " generation 0");
+      };
+
+      for(int32_t index = 0; index < conf.hostCandidates; index++) {
+        line("udp", 2122260223 - index * 256, "192.168." + std::to_string(1 + index) + ".10", port, "host");
+      }
+
+      if(conf.tcpCandidates == true && conf.hostCandidates > 0) {
+        line("tcp", 1518280447, "192.168.1.10", 9, "host tcptype active");
+      }
+
+      for(int32_t index = 0; index < conf.srflxCandidates; index++) {
+        line("udp", 1686052607 - index * 256, "203.0.113." + std::to_string(7 + index), port + index, "srflx raddr 192.168.1.10 rport " + std::to_string(port));
+      }
+
+      for(int32_t index = 0; index < conf.relayCandidates; index++) {
+        line("udp", 41885439 - index * 256, "198.51.100." + std::to_string(20 + index), 3478 + index, "relay raddr 203.0.113.7 rport " + std::to_string(port));
+      }
+
+      return burst;
+    }
+
+  }
+
+  /* SyntheticPeer */
+
+  SyntheticPeer::SyntheticPeer(int64_t id, const std::shared_ptr<Protocol>& owner, const SyntheticPeerConf& conf, const std::shared_ptr<Scheduler>& scheduler) {
+    this->_id = id;
+    this->_owner = owner;
+    this->_conf = conf;
+    this->_scheduler = scheduler;
+  }
+
+  void SyntheticPeer::prepare(const Constraints& constraints) {}
+
+  void SyntheticPeer::createOffer(const Constraints& constraints, const std::shared_ptr<Bundle>& context) {
+    auto owner = this->_owner;
+    auto state = this->_state;
+    auto sdp = this->_describe(constraints, SdpType::OFFER);
+
+    this->_scheduler->post(this->_conf.offerDelay, [owner, state, sdp, context] {
+      if(state->closed == false) {
+        owner->onOffer(sdp, context);
+      }
+    });
+  }
+
+  void SyntheticPeer::createAnswer(const Constraints& constraints, const std::shared_ptr<Bundle>& context) {
+    auto owner = this->_owner;
+    auto state = this->_state;
+    auto sdp = this->_describe(constraints, SdpType::ANSWER);
+
+    this->_scheduler->post(this->_conf.answerDelay, [owner, state, sdp, context] {
+      if(state->closed == false) {
+        owner->onAnswer(sdp, context);
+      }
+    });
+  }
+
+  void SyntheticPeer::setLocalDescription(SdpType type, const std::string& sdp) {
+    SessionDescription description(sdp);
+
+    std::vector<std::pair<std::string, int32_t>> targets;
+    for(size_t media = 0; media < description.mediaCount(); media++) {
+      SdpSlice mid;
+      targets.emplace_back(description.attribute(media, "mid", mid) == true ? mid.str() : std::to_string(media), (int32_t) media);
+
+      if(this->_conf.bundle == true) {
+        break;
+      }
+    }
+
+    auto owner = this->_owner;
+    auto state = this->_state;
+    auto id = this->_id;
+    auto burst = candidates(this->_conf, id);
+    auto delay = this->_conf.gatheringDelay;
+
+    for(auto& target : targets) {
+      for(auto& candidate : burst) {
+        this->_scheduler->post(delay, [owner, state, target, candidate, id] {
+          if(state->closed == false) {
+            owner->onIceCandidate(target.first, target.second, candidate, id);
+          }
+        });
+
+        delay += this->_conf.candidateInterval;
+      }
+    }
+
+    this->_scheduler->post(delay, [owner, state, id] {
+      if(state->closed == false) {
+        owner->onIceCompleted(id);
+      }
+    });
+  }
+
+  void SyntheticPeer::setRemoteDescription(SdpType type, const std::string& sdp) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_remote = sdp;
+  }
+
+  void SyntheticPeer::addIceCandidate(const std::string& mid, int32_t index, const std::string& sdp) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_remoteCandidates++;
+  }
+
+  void SyntheticPeer::close() {
+    this->_state->closed = true;
+  }
+
+  int64_t SyntheticPeer::remoteCandidates() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_remoteCandidates;
+  }
+
+  std::string SyntheticPeer::_describe(const Constraints& constraints, SdpType type) {
+    std::string remote;
+    int64_t version;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      remote = this->_remote;
+      version = ++this->_version;
+    }
+
+    auto& sdp = constraints.sdp;
+    auto send = [&sdp](const std::string& kind) {
+      return kind == "audio" ? sdp.send_audio : sdp.send_video;
+    };
+    auto receive = [&sdp](const std::string& kind) {
+      return kind == "audio" ? sdp.receive_audio : sdp.receive_video;
+    };
+
+    std::vector<std::string> rids;
+    if(constraints.video.encodings.size() > 1) {
+      for(auto& encoding : constraints.video.encodings) {
+        rids.push_back(encoding.rid);
+      }
+    }
+
+    // an answer mirrors the sections of the offer, in order, and only sends what the offer receives
+    if(type == SdpType::ANSWER && remote.empty() == false) {
+      Writer writer(this->_id, version, "active");
+      Sdp offer(remote);
+
+      for(size_t media = 0; media < offer.media.size(); media++) {
+        auto& entry = offer.media[media];
+
+        Section section;
+        section.kind = entry.kind();
+        section.mid = std::to_string(media);
+
+        std::string offered = "sendrecv";
+        for(auto& line : entry.lines) {
+          if(line.compare(0, 6, "a=mid:") == 0) {
+            section.mid = line.substr(6);
+          }
+          for(auto value : { "sendrecv", "sendonly", "recvonly", "inactive" }) {
+            if(line == std::string("a=") + value) {
+              offered = value;
+            }
+          }
+        }
+
+        if(section.kind == "application") {
+          section.application = sdp.datachannel == true ? "webrtc-datachannel" : "";
+        } else if(section.kind == "audio" || section.kind == "video") {
+          section.send = send(section.kind) == true && (offered == "sendrecv" || offered == "recvonly");
+          section.receive = receive(section.kind) == true && (offered == "sendrecv" || offered == "sendonly");
+          if(section.send == true || section.receive == true) {
+            section.codecs = negotiate(section.kind, entry.payloads());
+          }
+        }
+
+        writer.add(section, {});
+      }
+
+      return writer.str();
+    }
+
+    Writer writer(this->_id, version, type == SdpType::OFFER ? "actpass" : "active");
+    int media = 0;
+
+    for(auto kind : { "audio", "video" }) {
+      if(send(kind) == false && receive(kind) == false) {
+        continue;
+      }
+
+      Section section;
+      section.kind = kind;
+      section.mid = std::to_string(media++);
+      section.send = send(kind);
+      section.receive = receive(kind);
+      section.codecs = codecs(kind);
+
+      writer.add(section, section.kind == "video" ? rids : std::vector<std::string>());
+    }
+
+    if(sdp.datachannel == true) {
+      Section section;
+      section.kind = "application";
+      section.mid = std::to_string(media++);
+      section.application = "webrtc-datachannel";
+
+      writer.add(section, {});
+    }
+
+    return writer.str();
+  }
+
+  /* SyntheticPeerFactory */
+
+  SyntheticPeerFactory::SyntheticPeerFactory(const SyntheticPeerConf& conf) {
+    this->_conf = conf;
+    this->_scheduler = std::make_shared<SchedulerImpl>();
+  }
+
+  std::shared_ptr<Peer> SyntheticPeerFactory::create(int64_t id, const std::shared_ptr<Protocol>& owner) {
+    return std::make_shared<SyntheticPeer>(id, owner, this->_conf, this->_scheduler);
+  }
+
+}
@@ -0,0 +1,322 @@
+#include "janus/trace.h"
+
+namespace Janus {
+
+  namespace {
+
+    // what a send asks janus for, the transactions and the ids change between runs
+    std::string commandOf(const nlohmann::json& message) {
+      std::string command = "";
+      if(message.is_object() == false) {
+        return command;
+      }
+
+      auto janus = message.find("janus");
+      if(janus != message.end() && janus->is_string() == true) {
+        command = janus->get<std::string>();
+      }
+
+      auto body = message.find("body");
+      if(body != message.end() && body->is_object() == true) {
+        auto request = body->find("request");
+        if(request != body->end() && request->is_string() == true) {
+          command = command + " " + request->get<std::string>();
+        }
+      }
+
+      return command;
+    }
+
+  }
+
+  /* Trace Recorder */
+
+  TraceRecorder::TraceRecorder(const std::string& path) {
+    this->_file.open(path, std::ios::out | std::ios::trunc);
+  }
+
+  bool TraceRecorder::good() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_file.good();
+  }
+
+  int64_t TraceRecorder::sent(const nlohmann::json& message) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto sequence = this->_sequence++;
+    this->_write(TraceDirection::OUTGOING, sequence, message);
+
+    return sequence;
+  }
+
+  void TraceRecorder::received(const nlohmann::json& message, int64_t sequence) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_write(TraceDirection::INCOMING, sequence, message);
+  }
+
+  void TraceRecorder::_write(TraceDirection direction, int64_t sequence, const nlohmann::json& message) {
+    if(this->_file.good() == false) {
+      return;
+    }
+
+    auto at = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - this->_start).count();
+    nlohmann::json line = {
+      { "t", at },
+      { "d", direction == TraceDirection::OUTGOING ? "out" : "in" },
+      { "s", sequence },
+      { "m", message }
+    };
+
+    this->_file << line.dump() << "\n";
+    this->_file.flush();
+  }
+
+  std::vector<TraceEntry> readTrace(const std::string& path) {
+    std::vector<TraceEntry> entries;
+
+    std::ifstream file(path);
+    std::string line;
+    while(std::getline(file, line)) {
+      auto parsed = nlohmann::json::parse(line, nullptr, false);
+      if(parsed.is_object() == false || parsed.count("m") == 0) {
+        continue;
+      }
+
+      TraceEntry entry;
+      entry.at = parsed.value("t", (int64_t) 0);
+      entry.direction = parsed.value("d", "") == "out" ? TraceDirection::OUTGOING : TraceDirection::INCOMING;
+      entry.sequence = parsed.value("s", (int64_t) TRACE_NO_REQUEST);
+      entry.message = parsed["m"];
+
+      entries.push_back(entry);
+    }
+
+    return entries;
+  }
+
+  /* Tracing Transport */
+
+  TracingTransport::TracingTransport(const std::shared_ptr<Transport>& transport, const std::shared_ptr<TraceRecorder>& recorder) {
+    this->_transport = transport;
+    this->_recorder = recorder;
+  }
+
+  void TracingTransport::sessionId(const std::string& id) {
+    this->_transport->sessionId(id);
+  }
+
+  void TracingTransport::close() {
+    this->_transport->close();
+  }
+
+  TransportType TracingTransport::type() {
+    return this->_transport->type();
+  }
+
+  void TracingTransport::send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context) {
+    auto sequence = this->_recorder->sent(message);
+    if(context != nullptr) {
+      context->setInt(TRACE_SEQUENCE_KEY, sequence);
+    }
+
+    this->_transport->send(message, context);
+  }
+
+  void TracingTransport::sendBatch(const std::vector<TransportMessage>& messages) {
+    for(auto& entry : messages) {
+      auto sequence = this->_recorder->sent(entry.message);
+      if(entry.context != nullptr) {
+        entry.context->setInt(TRACE_SEQUENCE_KEY, sequence);
+      }
+    }
+
+    this->_transport->sendBatch(messages);
+  }
+
+  /* Tracing Delegate */
+
+  TracingDelegate::TracingDelegate(const std::shared_ptr<TransportDelegate>& delegate, const std::shared_ptr<TraceRecorder>& recorder) {
+    this->_delegate = delegate;
+    this->_recorder = recorder;
+  }
+
+  void TracingDelegate::onMessage(const nlohmann::json& message, const std::shared_ptr<Bundle>& context) {
+    auto sequence = context != nullptr ? context->getInt(TRACE_SEQUENCE_KEY, TRACE_NO_REQUEST) : TRACE_NO_REQUEST;
+    this->_recorder->received(message, sequence);
+
+    this->_delegate->onMessage(message, context);
+  }
+
+  /* Tracing Transport Factory */
+
+  TracingTransportFactory::TracingTransportFactory(const std::shared_ptr<TransportFactory>& factory, const std::shared_ptr<TraceRecorder>& recorder) {
+    this->_factory = factory;
+    this->_recorder = recorder;
+  }
+
+  std::shared_ptr<Transport> TracingTransportFactory::create(const std::string& url, const std::shared_ptr<TransportDelegate>& delegate) {
+    auto tracingDelegate = std::make_shared<TracingDelegate>(delegate, this->_recorder);
+    auto transport = this->_factory->create(url, tracingDelegate);
+    if(transport == nullptr) {
+      return nullptr;
+    }
+
+    return std::make_shared<TracingTransport>(transport, this->_recorder);
+  }
+
+  /* Replay Transport */
+
+  ReplayTransport::ReplayTransport(const std::vector<TraceEntry>& entries, ReplaySpeed speed, const std::shared_ptr<TransportDelegate>& delegate) {
+    for(auto& entry : entries) {
+      if(entry.direction == TraceDirection::OUTGOING) {
+        this->_outgoing.push_back(entry.message);
+      } else {
+        this->_incoming.push_back(entry);
+      }
+    }
+
+    this->_origin = entries.empty() == false ? entries.front().at : 0;
+    this->_speed = speed;
+    this->_delegate = delegate;
+  }
+
+  ReplayTransport::~ReplayTransport() {
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      this->_running = false;
+    }
+    this->_changed.notify_all();
+
+    if(this->_thread.joinable() == false) {
+      return;
+    }
+
+    // the protocol may drop the last reference from one of the replayed callbacks
+    if(this->_thread.get_id() == std::this_thread::get_id()) {
+      this->_thread.detach();
+    } else {
+      this->_thread.join();
+    }
+  }
+
+  void ReplayTransport::close() {
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      this->_running = false;
+    }
+
+    this->_changed.notify_all();
+  }
+
+  void ReplayTransport::send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context) {
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+
+      auto sequence = this->_contexts.size();
+      if(sequence >= this->_outgoing.size() || commandOf(this->_outgoing[sequence]) != commandOf(message)) {
+        this->_stats.mismatched++;
+      }
+
+      this->_contexts.push_back(context);
+      this->_stats.sent++;
+
+      // the replay starts with the first send, like the recording did
+      if(sequence == 0 && this->_running == true) {
+        this->_start = std::chrono::steady_clock::now();
+        this->_thread = std::thread(&ReplayTransport::_run, this);
+      }
+    }
+
+    this->_changed.notify_all();
+  }
+
+  void ReplayTransport::sendBatch(const std::vector<TransportMessage>& messages) {
+    for(auto& entry : messages) {
+      this->send(entry.message, entry.context);
+    }
+  }
+
+  ReplayStats ReplayTransport::wait(int64_t timeout) {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_changed.wait_for(lock, std::chrono::milliseconds(timeout), [this] {
+      return this->_stats.done == true;
+    });
+
+    return this->_stats;
+  }
+
+  void ReplayTransport::_run() {
+    for(auto& entry : this->_incoming) {
+      std::shared_ptr<Bundle> context;
+
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+
+        if(this->_speed == ReplaySpeed::REAL_TIME) {
+          auto deadline = this->_start + std::chrono::microseconds(entry.at - this->_origin);
+          this->_changed.wait_until(lock, deadline, [this] {
+            return this->_running == false;
+          });
+        }
+
+        if(entry.sequence != TRACE_NO_REQUEST) {
+          auto sequence = (size_t) entry.sequence;
+          auto ready = this->_changed.wait_for(lock, std::chrono::milliseconds(REPLAY_STEP_TIMEOUT), [this, sequence] {
+            return this->_running == false || this->_contexts.size() > sequence;
+          });
+
+          if(ready == false) {
+            this->_stats.stalled = true;
+            break;
+          }
+        }
+
+        if(this->_running == false) {
+          break;
+        }
+
+        context = entry.sequence != TRACE_NO_REQUEST ? this->_contexts[entry.sequence] : Bundle::create();
+      }
+
+      this->_delegate->onMessage(entry.message, context);
+
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      this->_stats.delivered++;
+    }
+
+    // the protocol owns this transport, holding it past the replay would leak both
+    std::shared_ptr<TransportDelegate> delegate;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      this->_stats.done = true;
+      this->_stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - this->_start).count();
+      delegate.swap(this->_delegate);
+    }
+
+    this->_changed.notify_all();
+  }
+
+  /* Replay Transport Factory */
+
+  ReplayTransportFactory::ReplayTransportFactory(const std::vector<TraceEntry>& entries, ReplaySpeed speed) {
+    this->_entries = entries;
+    this->_speed = speed;
+  }
+
+  std::shared_ptr<Transport> ReplayTransportFactory::create(const std::string& url, const std::shared_ptr<TransportDelegate>& delegate) {
+    auto transport = std::make_shared<ReplayTransport>(this->_entries, this->_speed, delegate);
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_transport = transport;
+
+    return transport;
+  }
+
+  std::shared_ptr<ReplayTransport> ReplayTransportFactory::transport() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_transport;
+  }
+
+}
@@ -2,8 +2,27 @@
 
 #include <regex>
 
+#include "janus/metrics_impl.h"
+#include "janus/spans.h"
+#include "janus/watchdog.h"
+
 namespace Janus {
 
+  namespace {
+
+    // what came back from janus, whatever the request was
+    void countReply(const std::shared_ptr<HttpResponse>& reply) {
+      static auto& bytesIn = MetricsRegistry::instance().counter(METRIC_HTTP_BYTES_IN);
+      static auto& errors = MetricsRegistry::instance().counter(METRIC_HTTP_ERRORS);
+
+      bytesIn.add(reply->body().size());
+      if(reply->status() < 200 || reply->status() >= 300) {
+        errors.add();
+      }
+    }
+
+  }
+
   /* TransportImpl */
 
   TransportImpl::TransportImpl(const std::shared_ptr<TransportDelegate>& delegate, const std::shared_ptr<Async>& async) {
@@ -24,20 +43,95 @@ namespace Janus {
 
   /* HTTP Transport */
 
-  HttpTransport::HttpTransport(const std::string& url, const std::shared_ptr<TransportDelegate>& delegate, const std::shared_ptr<HttpFactory>& factory, const std::shared_ptr<Async>& async) : TransportImpl(delegate, async) {
+  HttpTransport::HttpTransport(const std::string& url, const std::shared_ptr<TransportDelegate>& delegate, const std::shared_ptr<HttpFactory>& factory, const std::shared_ptr<Async>& async, const std::shared_ptr<Async>& callbacks) : TransportImpl(delegate, async) {
     for(int index = 0; index < HTTP_CLIENT_POOL_SIZE; index++) {
       auto client = factory->create(url);
       this->_clients.push(client);
     }
+
+    this->_callbacks = callbacks != nullptr ? callbacks : std::make_shared<InlineAsync>();
   }
 
   void HttpTransport::send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context) {
+    static auto& bytesOut = MetricsRegistry::instance().counter(METRIC_HTTP_BYTES_OUT);
+    static auto& requestUs = MetricsRegistry::instance().histogram(METRIC_HTTP_REQUEST_US);
+
     auto body = message.dump();
+    bytesOut.add(body.size());
+    auto verb = Watchdog::enabled() == true ? message.value("janus", "") : "";
+
     HttpTask task = [=] (const std::string& path, const std::shared_ptr<Http>& client, const std::shared_ptr<HttpTransport>& main) {
+      WatchdogScope watch(WATCHDOG_TRANSPORT, verb);
+      MetricTimer timer(requestUs);
       return client->post(path, body);
     };
 
-    this->_sendAsync(task, context);
+    this->_sendAsync(task, context, Spans::enabled() == true ? transactionOf(message) : "");
+  }
+
+  void HttpTransport::sendBatch(const std::vector<TransportMessage>& messages) {
+    static auto& requests = MetricsRegistry::instance().counter(METRIC_HTTP_REQUESTS);
+    static auto& bytesOut = MetricsRegistry::instance().counter(METRIC_HTTP_BYTES_OUT);
+    static auto& requestUs = MetricsRegistry::instance().histogram(METRIC_HTTP_REQUEST_US);
+
+    if(messages.empty() == true) {
+      return;
+    }
+
+    std::vector<std::string> bodies;
+    std::vector<std::shared_ptr<Bundle>> contexts;
+    std::vector<std::string> transactions;
+    std::vector<std::string> verbs;
+    for(auto& entry : messages) {
+      bodies.push_back(entry.message.dump());
+      bytesOut.add(bodies.back().size());
+      contexts.push_back(entry.context);
+      transactions.push_back(Spans::enabled() == true ? transactionOf(entry.message) : "");
+      verbs.push_back(Watchdog::enabled() == true ? entry.message.value("janus", "") : "");
+    }
+
+    auto submitted = Spans::enabled() == true ? Spans::now() : -1;
+    auto task = [=] {
+      // the whole batch waits once, the first message carries those stages
+      SpanTimeline spans(submitted);
+      spans.mark("queue", true);
+
+      auto client = this->_acquire();
+      auto path = this->_path();
+      spans.mark("pool");
+
+      if(this->_status == TransportStatus::OFF) {
+        return;
+      }
+
+      std::vector<nlohmann::json> contents;
+      std::vector<SpanTimeline> timelines;
+      for(unsigned index = 0; index < bodies.size(); index++) {
+        requests.add();
+        auto started = MetricsRegistry::now();
+        std::shared_ptr<HttpResponse> reply;
+        {
+          WatchdogScope watch(WATCHDOG_TRANSPORT, verbs[index]);
+          reply = client->post(path, bodies[index]);
+        }
+        requestUs.record(MetricsRegistry::now() - started);
+        countReply(reply);
+        spans.mark("network");
+        contents.push_back(nlohmann::json::parse(reply->body()));
+        spans.mark("parse");
+
+        timelines.push_back(spans);
+        spans = SpanTimeline(submitted >= 0 ? Spans::now() : -1);
+      }
+
+      this->_release(client);
+
+      for(unsigned index = 0; index < contents.size(); index++) {
+        this->_deliver(contents[index], contexts[index], timelines[index], transactions[index]);
+      }
+    };
+
+    this->_async->submit(task);
   }
 
   void HttpTransport::sessionId(const std::string& id) {
@@ -48,7 +142,14 @@ namespace Janus {
   }
 
   std::shared_ptr<HttpResponse> HttpTransport::_loop(const std::string& path, const std::shared_ptr<Http>& client, const std::shared_ptr<HttpTransport>& main) {
+    static auto& longPolls = MetricsRegistry::instance().counter(METRIC_HTTP_LONG_POLLS);
+    static auto& longPollUs = MetricsRegistry::instance().histogram(METRIC_HTTP_LONG_POLL_US);
+
+    // the long poll blocks on purpose, the watchdog leaves it alone
+    longPolls.add();
+    auto started = MetricsRegistry::now();
     auto reply = client->get(path);
+    longPollUs.record(MetricsRegistry::now() - started);
 
     auto context = Bundle::create();
     main->_sendAsync(HttpTransport::_loop, context);
@@ -56,60 +157,136 @@ namespace Janus {
     return reply;
   }
 
-  void HttpTransport::_sendAsync(const HttpTask& kernel, const std::shared_ptr<Bundle>& context) {
-    auto task = [=] {
-      std::unique_lock<std::mutex> notEmptyLock(this->_clientsMutex);
-      this->_notEmpty.wait(notEmptyLock, [this] {
-        return this->_clients.size() != 0;
-      });
-
-      auto client = this->_clients.front();
-      this->_clients.pop();
+  void HttpTransport::_sendAsync(const HttpTask& kernel, const std::shared_ptr<Bundle>& context, const std::string& transaction) {
+    static auto& requests = MetricsRegistry::instance().counter(METRIC_HTTP_REQUESTS);
 
-      notEmptyLock.unlock();
-      this->_notEmpty.notify_one();
+    auto submitted = Spans::enabled() == true ? Spans::now() : -1;
+    auto task = [=] {
+      SpanTimeline spans(submitted);
+      spans.mark("queue", true);
 
-      std::string path = "/";
-      {
-        std::lock_guard<std::mutex> sessionIdLock(this->_sessionIdMutex);
-        if(this->_sessionId.empty() == false) {
-          path = path + this->_sessionId;
-        }
-      }
+      auto client = this->_acquire();
+      auto path = this->_path();
+      spans.mark("pool");
 
       if(this->_status == TransportStatus::OFF) {
         return;
       }
 
+      requests.add();
       auto reply = kernel(path, client, this->shared_from_this());
+      countReply(reply);
+      spans.mark("network");
       auto content = nlohmann::json::parse(reply->body());
-      this->_delegate->onMessage(content, context);
+      spans.mark("parse");
 
-      notEmptyLock.lock();
-      this->_clients.push(client);
-      notEmptyLock.unlock();
-      this->_notEmpty.notify_one();
+      // the app code may take its time, the client must not wait for it
+      this->_release(client);
+
+      this->_deliver(content, context, spans, transaction);
     };
 
     this->_async->submit(task);
   }
 
+  void HttpTransport::_deliver(const nlohmann::json& content, const std::shared_ptr<Bundle>& context, SpanTimeline spans, const std::string& transaction) {
+    static auto& callbackQueueUs = MetricsRegistry::instance().histogram(METRIC_HTTP_CALLBACK_QUEUE_US);
+
+    std::weak_ptr<HttpTransport> weak = this->shared_from_this();
+    auto queued = MetricsRegistry::now();
+
+    this->_callbacks->submit([=]() mutable {
+      callbackQueueUs.record(MetricsRegistry::now() - queued);
+
+      auto main = weak.lock();
+      if(main == nullptr) {
+        return;
+      }
+
+      spans.mark("callback", true);
+      {
+        WatchdogScope watch(WATCHDOG_CALLBACK, Watchdog::enabled() == true ? content.value("janus", "") : "");
+        main->_delegate->onMessage(content, context);
+      }
+      spans.mark("handle");
+
+      // a long poll only learns its transaction from the event it brings back
+      spans.record(transaction.empty() == false ? transaction : transactionOf(content), "transaction");
+    });
+  }
+
+  std::shared_ptr<Http> HttpTransport::_acquire() {
+    static auto& poolWaits = MetricsRegistry::instance().counter(METRIC_HTTP_POOL_WAITS);
+    static auto& poolWaitUs = MetricsRegistry::instance().histogram(METRIC_HTTP_POOL_WAIT_US);
+
+    std::unique_lock<std::mutex> notEmptyLock(this->_clientsMutex);
+    if(this->_clients.empty() == true) {
+      // every client is busy, usually with the long poll
+      poolWaits.add();
+      MetricTimer timer(poolWaitUs);
+
+      this->_notEmpty.wait(notEmptyLock, [this] {
+        return this->_clients.size() != 0;
+      });
+    }
+
+    auto client = this->_clients.front();
+    this->_clients.pop();
+
+    notEmptyLock.unlock();
+    this->_notEmpty.notify_one();
+
+    return client;
+  }
+
+  void HttpTransport::_release(const std::shared_ptr<Http>& client) {
+    {
+      std::lock_guard<std::mutex> lock(this->_clientsMutex);
+      this->_clients.push(client);
+    }
+
+    this->_notEmpty.notify_one();
+  }
+
+  std::string HttpTransport::_path() {
+    std::string path = "/";
+
+    std::lock_guard<std::mutex> sessionIdLock(this->_sessionIdMutex);
+    if(this->_sessionId.empty() == false) {
+      path = path + this->_sessionId;
+    }
+
+    return path;
+  }
+
   /* WS Transport */
 
   void WebSocketTransport::send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context) {
   }
 
+  void WebSocketTransport::sendBatch(const std::vector<TransportMessage>& messages) {
+    for(auto& entry : messages) {
+      this->send(entry.message, entry.context);
+    }
+  }
+
   void WebSocketTransport::close() {}
 
   /* Transport Factory */
 
+  TransportFactoryImpl::TransportFactoryImpl(const std::shared_ptr<Async>& callbacks) {
+    this->_callbacks = callbacks;
+  }
+
   std::shared_ptr<Transport> TransportFactoryImpl::create(const std::string& url, const std::shared_ptr<TransportDelegate>& delegate) {
     std::regex HTTP_RXP("^https?:\\/\\/");
     if(std::regex_search(url, HTTP_RXP) == true) {
       auto async = std::make_shared<AsyncImpl>();
       auto factory = std::make_shared<HttpFactoryImpl>();
+      // a single thread, so the app sees the messages in the order they came back
+      auto callbacks = this->_callbacks != nullptr ? this->_callbacks : std::make_shared<AsyncImpl>(1);
 
-      return std::make_shared<HttpTransport>(url, delegate, factory, async);
+      return std::make_shared<HttpTransport>(url, delegate, factory, async, callbacks);
     }
 
     std::regex WS_RXP("^wss?:\\/\\/");
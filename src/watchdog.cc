@@ -0,0 +1,421 @@
+#include "janus/watchdog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "janus/metrics_impl.h"
+#include "janus/stall_watchdog.hpp"
+
+namespace Janus {
+
+  namespace {
+
+    // a seqlock per scope like the span slots: odd while its thread fills it. The state is the id of the scope, negated once flagged, 0 when idle
+    struct Running {
+      std::atomic<uint64_t> sequence { 0 };
+      std::atomic<int64_t> state { 0 };
+      std::atomic<const char*> origin { nullptr };
+      std::atomic<uint64_t> name[WATCHDOG_NAME_WORDS];
+      std::atomic<int64_t> start { 0 };
+      // only the owning thread reads it
+      MetricHistogramImpl* histogram = nullptr;
+    };
+
+    // the scopes of a thread, a stack only that thread pushes and pops; the monitor reads them
+    struct ThreadSlot {
+      Running running[WATCHDOG_DEPTH];
+      int depth = 0;
+      int64_t serial = 0;
+      int64_t index = 0;
+      std::atomic<bool> free { false };
+      // the origins are literals, their run histograms are looked up once per thread
+      std::unordered_map<const char*, MetricHistogramImpl*> histograms;
+    };
+
+    struct WatchdogState {
+      std::mutex mutex;
+      std::condition_variable wakeUp;
+      bool stopping = false;
+      std::thread monitor;
+
+      std::atomic<int64_t> thresholdUs { 0 };
+      WatchdogHandler handler;
+
+      // never freed, a thread that exits leaves its slot to the next one
+      std::vector<ThreadSlot*> slots;
+      std::deque<WatchdogStall> stalls;
+    };
+
+    // never destroyed, like the metrics registry: a scope may end after main returned
+    WatchdogState& state() {
+      static auto watchdog = new WatchdogState();
+
+      return *watchdog;
+    }
+
+    struct SlotOwner {
+      ThreadSlot* slot = nullptr;
+
+      ~SlotOwner() {
+        if(this->slot != nullptr) {
+          this->slot->free.store(true, std::memory_order_release);
+        }
+      }
+    };
+
+    // the lock is taken once per thread, the first time it begins a scope
+    ThreadSlot& threadSlot() {
+      thread_local SlotOwner owner;
+      if(owner.slot != nullptr) {
+        return *owner.slot;
+      }
+
+      auto& watchdog = state();
+      std::lock_guard<std::mutex> lock(watchdog.mutex);
+      for(auto slot : watchdog.slots) {
+        auto free = true;
+        if(slot->free.compare_exchange_strong(free, false, std::memory_order_acquire) == true) {
+          owner.slot = slot;
+
+          return *slot;
+        }
+      }
+
+      owner.slot = new ThreadSlot();
+      owner.slot->index = watchdog.slots.size() + 1;
+      for(auto& running : owner.slot->running) {
+        for(auto& word : running.name) {
+          word.store(0, std::memory_order_relaxed);
+        }
+      }
+      watchdog.slots.push_back(owner.slot);
+
+      return *owner.slot;
+    }
+
+    std::string nameOf(const Running& running) {
+      uint64_t words[WATCHDOG_NAME_WORDS + 1] = { 0 };
+      for(int word = 0; word < WATCHDOG_NAME_WORDS; word++) {
+        words[word] = running.name[word].load(std::memory_order_relaxed);
+      }
+
+      return std::string(reinterpret_cast<const char*>(words));
+    }
+
+    // what a scope of another thread is up to, false when it is idle or changed while read
+    bool snapshot(const Running& running, int64_t& id, WatchdogStall& stall) {
+      auto sequence = running.sequence.load(std::memory_order_acquire);
+      if((sequence & 1) == 1) {
+        return false;
+      }
+
+      id = running.state.load(std::memory_order_relaxed);
+      if(id == 0) {
+        return false;
+      }
+
+      auto origin = running.origin.load(std::memory_order_relaxed);
+      auto name = nameOf(running);
+      auto start = running.start.load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(running.sequence.load(std::memory_order_relaxed) != sequence || origin == nullptr) {
+        return false;
+      }
+
+      stall.origin = origin;
+      stall.name = name;
+      stall.startedAt = start;
+
+      return true;
+    }
+
+    // the caller holds the lock
+    void flag(WatchdogState& watchdog, const WatchdogStall& stall) {
+      static auto& stalls = MetricsRegistry::instance().counter(METRIC_WATCHDOG_STALLS);
+      stalls.add();
+
+      watchdog.stalls.push_back(stall);
+      if(watchdog.stalls.size() > WATCHDOG_STALLS_SIZE) {
+        watchdog.stalls.pop_front();
+      }
+    }
+
+    void monitor() {
+      auto& watchdog = state();
+
+      std::unique_lock<std::mutex> lock(watchdog.mutex);
+      while(watchdog.stopping == false) {
+        // a stall is caught at most half a threshold late
+        auto thresholdUs = watchdog.thresholdUs.load(std::memory_order_relaxed);
+        auto period = std::max(thresholdUs / 2, (int64_t) 1000);
+        watchdog.wakeUp.wait_for(lock, std::chrono::microseconds(period));
+        if(watchdog.stopping == true) {
+          break;
+        }
+
+        auto now = MetricsRegistry::now();
+        std::vector<WatchdogStall> flagged;
+        for(auto slot : watchdog.slots) {
+          for(auto& running : slot->running) {
+            int64_t id = 0;
+            WatchdogStall stall;
+            if(snapshot(running, id, stall) == false || id < 0 || now - stall.startedAt < thresholdUs) {
+              continue;
+            }
+
+            // the scope may have ended meanwhile, then its id is gone and the exchange fails
+            if(running.state.compare_exchange_strong(id, -id, std::memory_order_acq_rel) == false) {
+              continue;
+            }
+
+            stall.id = id;
+            stall.runningUs = now - stall.startedAt;
+            stall.finished = false;
+            flag(watchdog, stall);
+            flagged.push_back(stall);
+          }
+        }
+
+        auto handler = watchdog.handler;
+        if(flagged.empty() == true || handler == nullptr) {
+          continue;
+        }
+
+        lock.unlock();
+        for(auto& stall : flagged) {
+          handler(stall);
+        }
+        lock.lock();
+      }
+    }
+
+    nlohmann::json percentiles(const char* name) {
+      auto& histogram = MetricsRegistry::instance().histogram(name);
+
+      return {
+        { "count", histogram.count() },
+        { "p50", histogram.percentile(0.5) },
+        { "p90", histogram.percentile(0.9) },
+        { "p99", histogram.percentile(0.99) },
+        { "p999", histogram.percentile(0.999) }
+      };
+    }
+
+  }
+
+  /* Watchdog */
+
+  std::atomic<bool> Watchdog::_enabled { false };
+
+  void Watchdog::start(int64_t thresholdMs, const WatchdogHandler& handler) {
+    Watchdog::stop();
+
+    auto& watchdog = state();
+    {
+      std::lock_guard<std::mutex> lock(watchdog.mutex);
+      watchdog.thresholdUs.store(thresholdMs * 1000, std::memory_order_relaxed);
+      watchdog.handler = handler;
+      watchdog.stopping = false;
+      watchdog.monitor = std::thread(monitor);
+    }
+
+    Watchdog::_enabled.store(true, std::memory_order_relaxed);
+  }
+
+  void Watchdog::stop() {
+    Watchdog::_enabled.store(false, std::memory_order_relaxed);
+
+    auto& watchdog = state();
+    std::thread monitor;
+    {
+      std::lock_guard<std::mutex> lock(watchdog.mutex);
+      watchdog.stopping = true;
+      std::swap(monitor, watchdog.monitor);
+    }
+
+    watchdog.wakeUp.notify_all();
+    if(monitor.joinable() == true) {
+      monitor.join();
+    }
+  }
+
+  int64_t Watchdog::begin(const char* origin, const std::string& name) {
+    if(Watchdog::enabled() == false) {
+      return -1;
+    }
+
+    auto& slot = threadSlot();
+    if(slot.depth == WATCHDOG_DEPTH) {
+      return -1;
+    }
+
+    auto& histogram = slot.histograms[origin];
+    if(histogram == nullptr) {
+      histogram = &MetricsRegistry::instance().histogram(std::string(METRIC_WATCHDOG_PREFIX) + origin + "_us");
+    }
+
+    auto& running = slot.running[slot.depth++];
+    auto id = (slot.index << 32) | (++slot.serial & 0xffffffff);
+    auto sequence = running.sequence.load(std::memory_order_relaxed) + 1;
+
+    running.sequence.store(sequence, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t words[WATCHDOG_NAME_WORDS] = { 0 };
+    std::memcpy(words, name.data(), std::min(name.size(), sizeof(words)));
+    for(int word = 0; word < WATCHDOG_NAME_WORDS; word++) {
+      running.name[word].store(words[word], std::memory_order_relaxed);
+    }
+
+    running.origin.store(origin, std::memory_order_relaxed);
+    running.histogram = histogram;
+    running.start.store(MetricsRegistry::now(), std::memory_order_relaxed);
+    running.state.store(id, std::memory_order_relaxed);
+
+    running.sequence.store(sequence + 1, std::memory_order_release);
+
+    return id;
+  }
+
+  void Watchdog::end(int64_t id) {
+    if(id < 0) {
+      return;
+    }
+
+    auto& slot = threadSlot();
+    if(slot.depth == 0) {
+      return;
+    }
+
+    auto& running = slot.running[--slot.depth];
+    auto now = MetricsRegistry::now();
+    auto runningUs = now - running.start.load(std::memory_order_relaxed);
+    auto histogram = running.histogram;
+
+    // the monitor flags a scope by negating its id, whoever gets there first owns the stall
+    auto flagged = running.state.exchange(0, std::memory_order_acq_rel) < 0;
+    histogram->record(runningUs);
+
+    auto& watchdog = state();
+    if(flagged == false && (Watchdog::enabled() == false || runningUs < watchdog.thresholdUs.load(std::memory_order_relaxed))) {
+      return;
+    }
+
+    WatchdogStall stall;
+    WatchdogHandler handler;
+    {
+      std::lock_guard<std::mutex> lock(watchdog.mutex);
+      if(flagged == true) {
+        // the monitor caught it already, the record gets the whole time
+        for(auto& caught : watchdog.stalls) {
+          if(caught.id == id) {
+            caught.runningUs = runningUs;
+            caught.finished = true;
+          }
+        }
+
+        return;
+      }
+
+      stall = { id, running.origin.load(std::memory_order_relaxed), nameOf(running), now - runningUs, runningUs, true };
+      flag(watchdog, stall);
+      handler = watchdog.handler;
+    }
+
+    if(handler != nullptr) {
+      handler(stall);
+    }
+  }
+
+  std::vector<WatchdogStall> Watchdog::stalls() {
+    auto& watchdog = state();
+
+    std::lock_guard<std::mutex> lock(watchdog.mutex);
+    return std::vector<WatchdogStall>(watchdog.stalls.begin(), watchdog.stalls.end());
+  }
+
+  void Watchdog::clear() {
+    auto& watchdog = state();
+
+    std::lock_guard<std::mutex> lock(watchdog.mutex);
+    watchdog.stalls.clear();
+  }
+
+  nlohmann::json Watchdog::report() {
+    auto& watchdog = state();
+    auto now = MetricsRegistry::now();
+
+    nlohmann::json stalls = nlohmann::json::array();
+    nlohmann::json running = nlohmann::json::array();
+    int64_t thresholdMs = watchdog.thresholdUs.load(std::memory_order_relaxed) / 1000;
+    {
+      std::lock_guard<std::mutex> lock(watchdog.mutex);
+      for(auto& stall : watchdog.stalls) {
+        stalls.push_back({
+          { "origin", stall.origin },
+          { "name", stall.name },
+          { "running_us", stall.runningUs },
+          { "finished", stall.finished }
+        });
+      }
+
+      for(auto slot : watchdog.slots) {
+        for(auto& scope : slot->running) {
+          int64_t id = 0;
+          WatchdogStall current;
+          if(snapshot(scope, id, current) == false) {
+            continue;
+          }
+
+          running.push_back({
+            { "origin", current.origin },
+            { "name", current.name },
+            { "running_us", now - current.startedAt }
+          });
+        }
+      }
+    }
+
+    return {
+      { "threshold_ms", thresholdMs },
+      { "stalls", stalls },
+      { "running", running },
+      { "queues", {
+        { "async_us", percentiles(METRIC_ASYNC_QUEUE_US) },
+        { "callback_us", percentiles(METRIC_HTTP_CALLBACK_QUEUE_US) }
+      } }
+    };
+  }
+
+  /* WatchdogScope */
+
+  WatchdogScope::WatchdogScope(const char* origin, const std::string& name) {
+    this->_id = Watchdog::begin(origin, name);
+  }
+
+  WatchdogScope::~WatchdogScope() {
+    Watchdog::end(this->_id);
+  }
+
+  /* StallWatchdog */
+
+  void StallWatchdog::start(int64_t thresholdMs) {
+    Watchdog::start(thresholdMs);
+  }
+
+  void StallWatchdog::stop() {
+    Watchdog::stop();
+  }
+
+  std::string StallWatchdog::report() {
+    return Watchdog::report().dump();
+  }
+
+}
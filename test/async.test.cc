@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <future>
+
 #include "janus/async.h"
 
 using testing::ElementsAre;
@@ -32,4 +34,67 @@ namespace Janus {
     EXPECT_THAT(results, ElementsAre(200, 201));
   }
 
+  TEST_F(AsyncTest, shouldKeepTheOrderOnASingleThread) {
+    std::vector<int> results;
+    std::promise<void> done;
+
+    {
+      AsyncImpl async(1);
+      for(int index = 0; index < 100; index++) {
+        async.submit([&results, index] {
+          results.push_back(index);
+        });
+      }
+
+      async.submit([&done] {
+        done.set_value();
+      });
+      done.get_future().wait();
+    }
+
+    ASSERT_EQ(results.size(), 100u);
+    for(int index = 0; index < 100; index++) {
+      EXPECT_EQ(results[index], index);
+    }
+  }
+
+  TEST_F(AsyncTest, shouldRunTheQueuedCallbacksOnTheDrainingThread) {
+    CallbackQueue callbacks;
+    std::thread::id ranOn;
+
+    std::thread([&callbacks, &ranOn] {
+      callbacks.submit([&ranOn] {
+        ranOn = std::this_thread::get_id();
+      });
+    }).join();
+
+    EXPECT_EQ(callbacks.drain(), 1);
+    EXPECT_EQ(ranOn, std::this_thread::get_id());
+    EXPECT_EQ(callbacks.drain(std::chrono::milliseconds(1)), 0);
+  }
+
+  TEST_F(AsyncTest, shouldOutliveASchedulerReleasedByItsOwnTask) {
+    std::promise<void> dropped;
+    std::promise<void> released;
+    auto ready = dropped.get_future().share();
+    auto owner = std::make_shared<std::shared_ptr<SchedulerImpl>>(std::make_shared<SchedulerImpl>());
+
+    // the task holds the last owner once the test let go of it
+    auto scheduler = *owner;
+    scheduler->post(0, [owner, ready, &released] {
+      ready.wait();
+      owner->reset();
+      released.set_value();
+    });
+    scheduler.reset();
+    owner.reset();
+    dropped.set_value();
+
+    auto future = released.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    // the detached loop must end on its own state, not on the freed scheduler
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
 }
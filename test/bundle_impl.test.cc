@@ -72,7 +72,7 @@ namespace Janus {
   }
 
   TEST_F(BundleImplTest, shouldStoreAnConstraintObject) {
-    auto constraints = ConstraintsBuilder::create()->build();
+    auto constraints = ConstraintsBuilder::create()->encoding("h", 2.0, 500, 30)->build();
 
     auto bundle = std::make_shared<BundleImpl>();
     bundle->setConstraints(constraints);
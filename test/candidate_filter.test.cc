@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "janus/candidate_filter.h"
+
+#define HOST_CANDIDATE "candidate:1 1 udp 2122260223 192.168.1.2 50000 typ host generation 0"
+#define HOST_CANDIDATE_2 "candidate:2 1 udp 2122260223 10.0.0.2 50001 typ host generation 0"
+#define TCP_CANDIDATE "candidate:3 1 tcp 1518280447 192.168.1.2 9 typ host tcptype active generation 0"
+#define LINK_LOCAL_CANDIDATE "candidate:4 1 UDP 2122197247 fe80::1c2b:3ff:fe4d:5e6f 50002 typ host generation 0"
+#define SRFLX_CANDIDATE "candidate:5 1 udp 1686052607 1.2.3.4 50003 typ srflx raddr 192.168.1.2 rport 50000 generation 0"
+#define RELAY_CANDIDATE "candidate:6 1 udp 41885439 5.6.7.8 3478 typ relay raddr 1.2.3.4 rport 50003 generation 0"
+#define RELAY_CANDIDATE_2 "candidate:7 1 udp 41885439 5.6.7.9 3478 typ relay raddr 1.2.3.4 rport 50003 generation 0"
+
+namespace Janus {
+
+  TEST(CandidateFilterTest, shouldParseACandidateLine) {
+    CandidateInfo info;
+
+    ASSERT_EQ(parseCandidate("a=" TCP_CANDIDATE, info), true);
+    EXPECT_EQ(info.component, 1);
+    EXPECT_EQ(info.transport, TCP);
+    EXPECT_EQ(info.type, HOST);
+    EXPECT_EQ(info.ipv6, false);
+    EXPECT_EQ(info.linkLocal, false);
+
+    ASSERT_EQ(parseCandidate(LINK_LOCAL_CANDIDATE, info), true);
+    EXPECT_EQ(info.transport, UDP);
+    EXPECT_EQ(info.ipv6, true);
+    EXPECT_EQ(info.linkLocal, true);
+
+    ASSERT_EQ(parseCandidate(RELAY_CANDIDATE, info), true);
+    EXPECT_EQ(info.type, RELAY);
+
+    EXPECT_EQ(parseCandidate("candidate:1 1 udp", info), false);
+    EXPECT_EQ(parseCandidate("yolo", info), false);
+  }
+
+  TEST(CandidateFilterTest, shouldAcceptEverythingByDefault) {
+    auto filter = std::make_shared<CandidateFilter>();
+
+    EXPECT_EQ(filter->accept(1, HOST_CANDIDATE), true);
+    EXPECT_EQ(filter->accept(1, TCP_CANDIDATE), true);
+    EXPECT_EQ(filter->accept(1, LINK_LOCAL_CANDIDATE), true);
+    EXPECT_EQ(filter->accept(1, "not a candidate"), true);
+
+    EXPECT_EQ(filter->stats().accepted, 4);
+    EXPECT_EQ(filter->stats().droppedTotal(), 0);
+  }
+
+  TEST(CandidateFilterTest, shouldKeepOnlyTheRelayCandidates) {
+    auto filter = std::make_shared<CandidateFilter>();
+    CandidatePolicy policy;
+    policy.relayOnly = true;
+    filter->configure(policy);
+
+    EXPECT_EQ(filter->accept(1, HOST_CANDIDATE), false);
+    EXPECT_EQ(filter->accept(1, SRFLX_CANDIDATE), false);
+    EXPECT_EQ(filter->accept(1, RELAY_CANDIDATE), true);
+
+    EXPECT_EQ(filter->stats().dropped[CandidateDrop::NOT_RELAY], 2);
+  }
+
+  TEST(CandidateFilterTest, shouldDropTcpAndLinkLocalCandidates) {
+    auto filter = std::make_shared<CandidateFilter>();
+    CandidatePolicy policy;
+    policy.dropTcp = true;
+    policy.dropLinkLocal = true;
+    filter->configure(policy);
+
+    EXPECT_EQ(filter->accept(1, TCP_CANDIDATE), false);
+    EXPECT_EQ(filter->accept(1, LINK_LOCAL_CANDIDATE), false);
+    EXPECT_EQ(filter->accept(1, HOST_CANDIDATE), true);
+
+    auto stats = filter->stats(1);
+    EXPECT_EQ(stats.dropped[CandidateDrop::TCP_TRANSPORT], 1);
+    EXPECT_EQ(stats.dropped[CandidateDrop::LINK_LOCAL], 1);
+    EXPECT_EQ(stats.accepted, 1);
+  }
+
+  TEST(CandidateFilterTest, shouldLimitTheCandidatesOfEachHandle) {
+    auto filter = std::make_shared<CandidateFilter>();
+    CandidatePolicy policy;
+    policy.maxHost = 1;
+    policy.maxRelay = 1;
+    filter->configure(policy);
+
+    EXPECT_EQ(filter->accept(1, HOST_CANDIDATE), true);
+    EXPECT_EQ(filter->accept(1, HOST_CANDIDATE_2), false);
+    EXPECT_EQ(filter->accept(1, RELAY_CANDIDATE), true);
+    EXPECT_EQ(filter->accept(1, RELAY_CANDIDATE_2), false);
+    EXPECT_EQ(filter->accept(1, SRFLX_CANDIDATE), true);
+    EXPECT_EQ(filter->accept(2, HOST_CANDIDATE_2), true);
+
+    filter->reset(1);
+    EXPECT_EQ(filter->stats(1).accepted, 0);
+    EXPECT_EQ(filter->accept(1, HOST_CANDIDATE_2), true);
+
+    auto stats = filter->stats();
+    EXPECT_EQ(stats.dropped[CandidateDrop::HOST_LIMIT], 1);
+    EXPECT_EQ(stats.dropped[CandidateDrop::RELAY_LIMIT], 1);
+    EXPECT_EQ(stats.accepted, 5);
+  }
+
+  TEST(CandidateFilterTest, shouldDropTheCandidatesListedInADescription) {
+    auto filter = std::make_shared<CandidateFilter>();
+    CandidatePolicy policy;
+    policy.relayOnly = true;
+    filter->configure(policy);
+
+    auto relayed = std::make_shared<SessionDescription>(
+      "v=0\r\n"
+      "m=audio 9 UDP/TLS/RTP/SAVPF 111\r\n"
+      "a=mid:0\r\n"
+      "a=" RELAY_CANDIDATE "\r\n"
+    );
+    EXPECT_EQ(filter->filter(1, relayed), relayed);
+
+    auto description = std::make_shared<SessionDescription>(
+      "v=0\r\n"
+      "m=audio 9 UDP/TLS/RTP/SAVPF 111\r\n"
+      "a=mid:0\r\n"
+      "a=" HOST_CANDIDATE "\r\n"
+      "a=" RELAY_CANDIDATE "\r\n"
+      "m=video 9 UDP/TLS/RTP/SAVPF 96\r\n"
+      "a=mid:1\r\n"
+      "a=" SRFLX_CANDIDATE "\r\n"
+    );
+    auto filtered = filter->filter(1, description);
+
+    EXPECT_EQ(filtered->str(),
+      "v=0\r\n"
+      "m=audio 9 UDP/TLS/RTP/SAVPF 111\r\n"
+      "a=mid:0\r\n"
+      "a=" RELAY_CANDIDATE "\r\n"
+      "m=video 9 UDP/TLS/RTP/SAVPF 96\r\n"
+      "a=mid:1\r\n"
+    );
+    EXPECT_EQ(filter->stats(1).accepted, 2);
+    EXPECT_EQ(filter->stats(1).dropped[CandidateDrop::NOT_RELAY], 2);
+  }
+
+}
@@ -21,6 +21,8 @@ namespace Janus {
     EXPECT_EQ(constraints.video.width, 1280);
     EXPECT_EQ(constraints.video.height, 720);
     EXPECT_EQ(constraints.video.camera, Camera::FRONT);
+    EXPECT_EQ(constraints.video.encodings.empty(), true);
+    EXPECT_EQ(constraints.ice_candidate_pool_size, 0);
   }
 
   TEST_F(ConstraintsBuilderImplTest, shouldToggleTheCamera) {
@@ -92,6 +94,24 @@ namespace Janus {
     EXPECT_EQ(constraints.video.fps, 69);
   }
 
+  TEST_F(ConstraintsBuilderImplTest, shouldAppendTheSimulcastEncodings) {
+    auto builder = std::make_shared<ConstraintsBuilderImpl>()->encoding("h", 2.0, 500, 30)->encoding("q", 4.0, 150, 15);
+    auto constraints = builder->build();
+
+    ASSERT_EQ(constraints.video.encodings.size(), 2u);
+    EXPECT_EQ(constraints.video.encodings[0].rid, "h");
+    EXPECT_EQ(constraints.video.encodings[0].scale_down, 2.0);
+    EXPECT_EQ(constraints.video.encodings[0].max_bitrate, 500);
+    EXPECT_EQ(constraints.video.encodings[0].max_fps, 30);
+    EXPECT_EQ(constraints.video.encodings[1].rid, "q");
+  }
+
+  TEST_F(ConstraintsBuilderImplTest, shouldSetTheIceCandidatePoolSize) {
+    auto constraints = std::make_shared<ConstraintsBuilderImpl>()->ice_candidate_pool(4)->build();
+
+    EXPECT_EQ(constraints.ice_candidate_pool_size, 4);
+  }
+
   TEST_F(ConstraintsBuilderImplTest, shouldSetSendOnlyMode) {
     auto builder = std::make_shared<ConstraintsBuilderImpl>()->send_only();
     auto c = builder->build();
@@ -0,0 +1,964 @@
+#include "emulator/gateway_emulator.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "janus/sdp.h"
+
+namespace Janus {
+
+  namespace Messages {
+
+    nlohmann::json gatewayError(const std::string& transaction, int code, const std::string& reason) {
+      return {
+        { "janus", "error" },
+        { "transaction", transaction },
+        { "error", { { "code", code }, { "reason", reason } } }
+      };
+    }
+
+    nlohmann::json gatewaySuccess(const std::string& transaction, int64_t sessionId) {
+      return {
+        { "janus", "success" },
+        { "session_id", sessionId },
+        { "transaction", transaction }
+      };
+    }
+
+    nlohmann::json gatewayAck(const std::string& transaction, int64_t sessionId) {
+      return {
+        { "janus", "ack" },
+        { "session_id", sessionId },
+        { "transaction", transaction }
+      };
+    }
+
+    nlohmann::json pluginData(const std::string& plugin, const nlohmann::json& data) {
+      return {
+        { "plugin", "janus.plugin." + plugin },
+        { "data", data }
+      };
+    }
+
+    nlohmann::json pluginEvent(int64_t sessionId, int64_t sender, const std::string& transaction, const std::string& plugin, const nlohmann::json& data) {
+      return {
+        { "janus", "event" },
+        { "session_id", sessionId },
+        { "sender", sender },
+        { "transaction", transaction },
+        { "plugindata", pluginData(plugin, data) }
+      };
+    }
+
+    nlohmann::json handleEvent(const std::string& type, int64_t sessionId, int64_t sender) {
+      return {
+        { "janus", type },
+        { "session_id", sessionId },
+        { "sender", sender }
+      };
+    }
+
+  }
+
+  namespace {
+
+    const char* FINGERPRINT = "sha-256 D2:B9:31:8F:DF:24:D8:0E:ED:D2:EF:25:9E:AF:6F:B8:34:AE:53:9C:E6:F3:8F:F2:64:15:FA:E8:7F:53:2D:38";
+
+    void transport(std::string& sdp, const std::string& setup) {
+      sdp += "c=IN IP4 127.0.0.1\r\n";
+      sdp += "a=ice-ufrag:emul\r\n";
+      sdp += "a=ice-pwd:emulatoremulatoremulato\r\n";
+      sdp += "a=ice-options:trickle\r\n";
+      sdp += std::string("a=fingerprint:") + FINGERPRINT + "\r\n";
+      sdp += "a=setup:" + setup + "\r\n";
+    }
+
+    void candidates(std::string& sdp) {
+      sdp += "a=candidate:1 1 udp 2013266431 127.0.0.1 20000 typ host\r\n";
+      sdp += "a=end-of-candidates\r\n";
+    }
+
+    std::string header(const std::vector<std::string>& mids) {
+      std::string sdp = "v=0\r\no=- 1 1 IN IP4 127.0.0.1\r\ns=Janus Emulator\r\nt=0 0\r\na=group:BUNDLE";
+      for(auto& mid : mids) {
+        sdp += " " + mid;
+      }
+
+      return sdp + "\r\na=ice-lite\r\na=msid-semantic: WMS janus\r\n";
+    }
+
+    std::string reverse(const SessionDescription& description, size_t media) {
+      SdpSlice value;
+      if(description.attribute(media, "sendonly", value) == true) {
+        return "recvonly";
+      }
+
+      if(description.attribute(media, "recvonly", value) == true) {
+        return "sendonly";
+      }
+
+      if(description.attribute(media, "inactive", value) == true) {
+        return "inactive";
+      }
+
+      return "sendrecv";
+    }
+
+    bool negotiable(const std::string& codec) {
+      for(auto skip : { "rtx", "red", "ulpfec", "flexfec-03", "CN", "telephone-event" }) {
+        if(codec == skip) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    // mirrors every m= line of the offer, keeping its first real codec
+    std::string answer(const std::string& offer) {
+      SessionDescription description(offer);
+
+      std::vector<std::string> mids;
+      std::string sections;
+      for(size_t media = 0; media < description.mediaCount(); media++) {
+        std::istringstream tokens(description.mline(media).str());
+        std::string kind, port, proto, format;
+        tokens >> kind >> port >> proto;
+
+        SdpSlice mid;
+        auto identifier = description.attribute(media, "mid", mid) == true ? mid.str() : std::to_string(media);
+
+        std::string chosen;
+        std::string rtpmap;
+        while(chosen.empty() == true && tokens >> format) {
+          if(kind == "m=application") {
+            chosen = format;
+            break;
+          }
+
+          for(auto& entry : description.attributes(media, "rtpmap")) {
+            auto value = entry.str();
+            if(value.compare(0, format.size() + 1, format + " ") != 0) {
+              continue;
+            }
+
+            auto codec = value.substr(format.size() + 1, value.find('/') - format.size() - 1);
+            if(negotiable(codec) == true) {
+              chosen = format;
+              rtpmap = value;
+            }
+          }
+        }
+
+        if(port == "0" || chosen.empty() == true) {
+          sections += kind + " 0 " + proto + " " + (chosen.empty() == true ? "0" : chosen) + "\r\na=mid:" + identifier + "\r\na=inactive\r\n";
+          continue;
+        }
+
+        mids.push_back(identifier);
+        sections += kind + " 9 " + proto + " " + chosen + "\r\n";
+        transport(sections, "active");
+        sections += "a=mid:" + identifier + "\r\n";
+
+        if(kind == "m=application") {
+          sections += "a=sctp-port:5000\r\n";
+        } else {
+          sections += "a=" + reverse(description, media) + "\r\n";
+          sections += "a=rtcp-mux\r\n";
+          sections += "a=rtpmap:" + rtpmap + "\r\n";
+
+          for(auto& entry : description.attributes(media, "fmtp")) {
+            if(entry.startsWith((chosen + " ").c_str()) == true) {
+              sections += "a=fmtp:" + entry.str() + "\r\n";
+            }
+          }
+        }
+
+        candidates(sections);
+      }
+
+      return header(mids) + sections;
+    }
+
+    std::string offer(bool audio, bool video, bool data) {
+      std::vector<std::string> mids;
+      std::string sections;
+
+      if(audio == true) {
+        mids.push_back(std::to_string(mids.size()));
+        sections += "m=audio 9 UDP/TLS/RTP/SAVPF 111\r\n";
+        transport(sections, "actpass");
+        sections += "a=mid:" + mids.back() + "\r\na=sendonly\r\na=rtcp-mux\r\na=rtpmap:111 opus/48000/2\r\na=fmtp:111 minptime=10;useinbandfec=1\r\n";
+        candidates(sections);
+      }
+
+      if(video == true) {
+        mids.push_back(std::to_string(mids.size()));
+        sections += "m=video 9 UDP/TLS/RTP/SAVPF 96\r\n";
+        transport(sections, "actpass");
+        sections += "a=mid:" + mids.back() + "\r\na=sendonly\r\na=rtcp-mux\r\na=rtpmap:96 VP8/90000\r\na=rtcp-fb:96 nack\r\na=rtcp-fb:96 nack pli\r\n";
+        candidates(sections);
+      }
+
+      if(data == true) {
+        mids.push_back(std::to_string(mids.size()));
+        sections += "m=application 9 UDP/DTLS/SCTP webrtc-datachannel\r\n";
+        transport(sections, "actpass");
+        sections += "a=mid:" + mids.back() + "\r\na=sctp-port:5000\r\n";
+        candidates(sections);
+      }
+
+      return header(mids) + sections;
+    }
+
+    nlohmann::json jsep(const std::string& type, const std::string& sdp) {
+      return {
+        { "type", type },
+        { "sdp", sdp }
+      };
+    }
+
+    bool isOffer(const nlohmann::json& jsep) {
+      return jsep.is_object() == true && jsep.value("type", "") == "offer";
+    }
+
+  }
+
+  GatewayEmulator::GatewayEmulator(uint32_t seed) : _random(seed) {
+    Room room;
+    room.id = EMULATOR_DEFAULT_ROOM;
+    room.description = "Demo Room";
+    this->_rooms[room.id] = room;
+
+    Mountpoint live;
+    live.id = 1;
+    live.description = "Opus/VP8 live stream coming from gstreamer";
+    this->_mountpoints[live.id] = live;
+
+    Mountpoint music;
+    music.id = 2;
+    music.description = "Opus file stream";
+    music.video = false;
+    this->_mountpoints[music.id] = music;
+
+    this->_scheduler = std::thread(&GatewayEmulator::_tick, this);
+  }
+
+  GatewayEmulator::~GatewayEmulator() {
+    this->stop();
+  }
+
+  void GatewayEmulator::script(const std::vector<GatewayRule>& rules) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_rules = rules;
+  }
+
+  void GatewayEmulator::longPollTimeout(int64_t milliseconds) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_longPollTimeout = milliseconds;
+  }
+
+  void GatewayEmulator::handle(const nlohmann::json& request, const GatewayOrigin& origin, const GatewayReply& reply) {
+    auto verb = request.value("janus", "");
+    auto key = verb == "message" ? request.value("body", nlohmann::json::object()).value("request", "") : verb;
+
+    GatewayRule rule;
+    int64_t delay = 0;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      rule = this->_rule(key);
+      delay = this->_delay(rule);
+    }
+
+    if(delay > 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    }
+
+    Events events;
+    nlohmann::json response;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      this->_stats.requests++;
+      response = this->_process(request, origin, events);
+    }
+
+    reply(response);
+
+    for(auto& event : events) {
+      this->_emit(event.first, event.second, rule);
+    }
+  }
+
+  nlohmann::json GatewayEmulator::poll(int64_t sessionId) {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+
+    auto entry = this->_sessions.find(sessionId);
+    if(entry == this->_sessions.end()) {
+      return Messages::gatewayError("", 458, "No such session " + std::to_string(sessionId));
+    }
+
+    auto session = entry->second;
+    auto timeout = std::chrono::milliseconds(this->_longPollTimeout);
+    session->ready.wait_for(lock, timeout, [this, &session] {
+      return session->events.empty() == false || session->destroyed == true || this->_running == false;
+    });
+
+    if(session->events.empty() == true && session->destroyed == true) {
+      return Messages::gatewayError("", 458, "No such session " + std::to_string(sessionId));
+    }
+
+    if(session->events.empty() == true) {
+      return { { "janus", "keepalive" } };
+    }
+
+    auto event = session->events.front();
+    session->events.pop_front();
+
+    return event;
+  }
+
+  void GatewayEmulator::release(int64_t owner) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    for(auto& entry : this->_sessions) {
+      if(entry.second->owner == owner) {
+        entry.second->owner = -1;
+        entry.second->sink = nullptr;
+      }
+    }
+  }
+
+  GatewayStats GatewayEmulator::stats() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto stats = this->_stats;
+    stats.sessions = this->_sessions.size();
+    stats.handles = this->_handles.size();
+
+    return stats;
+  }
+
+  void GatewayEmulator::stop() {
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      if(this->_running == false) {
+        return;
+      }
+
+      this->_running = false;
+      for(auto& entry : this->_sessions) {
+        entry.second->ready.notify_all();
+      }
+    }
+
+    this->_timer.notify_all();
+    this->_scheduler.join();
+  }
+
+  nlohmann::json GatewayEmulator::_process(const nlohmann::json& request, const GatewayOrigin& origin, Events& events) {
+    auto verb = request.value("janus", "");
+    auto transaction = request.value("transaction", "");
+
+    if(verb == "info") {
+      return {
+        { "janus", "server_info" },
+        { "transaction", transaction },
+        { "name", "Janus WebRTC Server (emulated)" },
+        { "version", 704 },
+        { "version_string", "0.7.4" },
+        { "plugins", {
+          { "janus.plugin.echotest", { { "name", "JANUS EchoTest plugin" } } },
+          { "janus.plugin.streaming", { { "name", "JANUS Streaming plugin" } } },
+          { "janus.plugin.videoroom", { { "name", "JANUS VideoRoom plugin" } } }
+        } }
+      };
+    }
+
+    if(verb == "ping") {
+      return { { "janus", "pong" }, { "transaction", transaction } };
+    }
+
+    if(verb == "create") {
+      auto session = std::make_shared<Session>();
+      session->id = this->_id();
+      session->owner = origin.owner;
+      session->sink = origin.sink;
+      this->_sessions[session->id] = session;
+
+      auto msg = Messages::gatewaySuccess(transaction, session->id);
+      msg.erase("session_id");
+      msg["data"] = { { "id", session->id } };
+
+      return msg;
+    }
+
+    auto sessionId = request.value("session_id", (int64_t) 0);
+    auto entry = this->_sessions.find(sessionId);
+    if(entry == this->_sessions.end()) {
+      return Messages::gatewayError(transaction, 458, "No such session " + std::to_string(sessionId));
+    }
+
+    auto session = entry->second;
+
+    if(verb == "keepalive") {
+      return Messages::gatewayAck(transaction, sessionId);
+    }
+
+    if(verb == "claim") {
+      session->owner = origin.owner;
+      session->sink = origin.sink;
+
+      return Messages::gatewaySuccess(transaction, sessionId);
+    }
+
+    if(verb == "destroy") {
+      auto handles = session->handles;
+      for(auto handleId : handles) {
+        this->_detach(handleId, events);
+      }
+
+      this->_sessions.erase(entry);
+      this->_horizon.erase(sessionId);
+      session->destroyed = true;
+      session->ready.notify_all();
+
+      return Messages::gatewaySuccess(transaction, sessionId);
+    }
+
+    if(verb == "attach") {
+      auto plugin = request.value("plugin", "");
+      auto prefix = std::string("janus.plugin.");
+      auto name = plugin.compare(0, prefix.size(), prefix) == 0 ? plugin.substr(prefix.size()) : "";
+      if(name != "echotest" && name != "streaming" && name != "videoroom") {
+        return Messages::gatewayError(transaction, 460, "No such plugin '" + plugin + "'");
+      }
+
+      Handle handle;
+      handle.id = this->_id();
+      handle.session = sessionId;
+      handle.plugin = name;
+      this->_handles[handle.id] = handle;
+      session->handles.push_back(handle.id);
+
+      auto msg = Messages::gatewaySuccess(transaction, sessionId);
+      msg["data"] = { { "id", handle.id } };
+
+      return msg;
+    }
+
+    auto handleId = request.value("handle_id", (int64_t) 0);
+    auto handle = this->_handles.find(handleId);
+    if(handle == this->_handles.end() || handle->second.session != sessionId) {
+      return Messages::gatewayError(transaction, 459, "No such handle " + std::to_string(handleId) + " in session " + std::to_string(sessionId));
+    }
+
+    if(verb == "trickle") {
+      return Messages::gatewayAck(transaction, sessionId);
+    }
+
+    if(verb == "hangup") {
+      auto& current = handle->second;
+      if(current.negotiated == true) {
+        current.negotiated = false;
+
+        auto msg = Messages::handleEvent("hangup", sessionId, handleId);
+        msg["reason"] = "Close PC";
+        events.emplace_back(sessionId, msg);
+      }
+
+      this->_leave(current, events);
+
+      return Messages::gatewaySuccess(transaction, sessionId);
+    }
+
+    if(verb == "detach") {
+      this->_detach(handleId, events);
+
+      return Messages::gatewaySuccess(transaction, sessionId);
+    }
+
+    if(verb == "message") {
+      auto body = request.value("body", nlohmann::json::object());
+      auto offer = request.value("jsep", nlohmann::json());
+      auto& current = handle->second;
+
+      if(current.plugin == "echotest") {
+        return this->_echotest(current, transaction, body, offer, events);
+      }
+
+      if(current.plugin == "streaming") {
+        return this->_streaming(current, transaction, body, offer, events);
+      }
+
+      return this->_videoroom(current, transaction, body, offer, events);
+    }
+
+    return Messages::gatewayError(transaction, 453, "Unknown request '" + verb + "'");
+  }
+
+  nlohmann::json GatewayEmulator::_echotest(Handle& handle, const std::string& transaction, const nlohmann::json& body, const nlohmann::json& offer, Events& events) {
+    auto msg = Messages::pluginEvent(handle.session, handle.id, transaction, "echotest", { { "echotest", "event" }, { "result", "ok" } });
+
+    if(isOffer(offer) == true) {
+      msg["jsep"] = jsep("answer", answer(offer.value("sdp", "")));
+      events.emplace_back(handle.session, msg);
+      this->_connected(handle, events);
+    } else {
+      events.emplace_back(handle.session, msg);
+    }
+
+    return Messages::gatewayAck(transaction, handle.session);
+  }
+
+  nlohmann::json GatewayEmulator::_streaming(Handle& handle, const std::string& transaction, const nlohmann::json& body, const nlohmann::json& remote, Events& events) {
+    auto request = body.value("request", "");
+    auto id = body.value("id", (int64_t) -1);
+    auto mountpoint = this->_mountpoints.find(id);
+
+    auto success = [&handle, &transaction](const nlohmann::json& data) {
+      auto msg = Messages::gatewaySuccess(transaction, handle.session);
+      msg["sender"] = handle.id;
+      msg["plugindata"] = Messages::pluginData("streaming", data);
+
+      return msg;
+    };
+
+    auto event = [&handle, &transaction, &events](const nlohmann::json& data) -> nlohmann::json& {
+      events.emplace_back(handle.session, Messages::pluginEvent(handle.session, handle.id, transaction, "streaming", data));
+
+      return events.back().second;
+    };
+
+    auto missing = nlohmann::json({ { "streaming", "event" }, { "error_code", 455 }, { "error", "No such mountpoint/stream " + std::to_string(id) } });
+
+    if(request == "list") {
+      auto list = nlohmann::json::array();
+      for(auto& entry : this->_mountpoints) {
+        list.push_back({ { "id", entry.second.id }, { "description", entry.second.description }, { "type", "live" } });
+      }
+
+      return success({ { "streaming", "list" }, { "list", list } });
+    }
+
+    if(request == "info") {
+      if(mountpoint == this->_mountpoints.end()) {
+        return success(missing);
+      }
+
+      auto& current = mountpoint->second;
+      return success({ { "streaming", "info" }, { "info", { { "id", current.id }, { "description", current.description }, { "type", "live" }, { "audio", current.audio }, { "video", current.video }, { "data", current.data } } } });
+    }
+
+    if(request == "watch" || request == "switch") {
+      if(mountpoint == this->_mountpoints.end()) {
+        event(missing);
+      } else if(request == "switch") {
+        handle.mountpoint = id;
+        event({ { "streaming", "event" }, { "result", { { "switched", "ok" }, { "id", id } } } });
+      } else {
+        auto& current = mountpoint->second;
+        handle.mountpoint = id;
+
+        auto& msg = event({ { "streaming", "event" }, { "result", { { "status", "preparing" } } } });
+        msg["jsep"] = jsep("offer", offer(current.audio && body.value("offer_audio", true), current.video && body.value("offer_video", true), current.data && body.value("offer_data", true)));
+      }
+
+      return Messages::gatewayAck(transaction, handle.session);
+    }
+
+    if(request == "start") {
+      event({ { "streaming", "event" }, { "result", { { "status", "starting" } } } });
+      if(remote.is_object() == true && handle.negotiated == false) {
+        this->_connected(handle, events);
+      }
+      event({ { "streaming", "event" }, { "result", { { "status", "started" } } } });
+
+      return Messages::gatewayAck(transaction, handle.session);
+    }
+
+    if(request == "pause") {
+      event({ { "streaming", "event" }, { "result", { { "status", "pausing" } } } });
+
+      return Messages::gatewayAck(transaction, handle.session);
+    }
+
+    if(request == "stop") {
+      event({ { "streaming", "event" }, { "result", { { "status", "stopping" } } } });
+      if(handle.negotiated == true) {
+        handle.negotiated = false;
+
+        auto msg = Messages::handleEvent("hangup", handle.session, handle.id);
+        msg["reason"] = "Close PC";
+        events.emplace_back(handle.session, msg);
+      }
+
+      return Messages::gatewayAck(transaction, handle.session);
+    }
+
+    return success({ { "streaming", "event" }, { "error_code", 451 }, { "error", "Unknown request '" + request + "'" } });
+  }
+
+  nlohmann::json GatewayEmulator::_videoroom(Handle& handle, const std::string& transaction, const nlohmann::json& body, const nlohmann::json& remote, Events& events) {
+    auto request = body.value("request", "");
+    auto roomId = body.value("room", handle.room);
+    auto room = this->_rooms.find(roomId);
+
+    auto success = [&handle, &transaction](const nlohmann::json& data) {
+      auto msg = Messages::gatewaySuccess(transaction, handle.session);
+      msg["sender"] = handle.id;
+      msg["plugindata"] = Messages::pluginData("videoroom", data);
+
+      return msg;
+    };
+
+    auto event = [&handle, &transaction, &events](const nlohmann::json& data) -> nlohmann::json& {
+      events.emplace_back(handle.session, Messages::pluginEvent(handle.session, handle.id, transaction, "videoroom", data));
+
+      return events.back().second;
+    };
+
+    auto ack = Messages::gatewayAck(transaction, handle.session);
+    auto missing = nlohmann::json({ { "videoroom", "event" }, { "error_code", 426 }, { "error", "No such room (" + std::to_string(roomId) + ")" } });
+
+    // the others in the room are told about a change by an event on their own handle
+    auto notify = [this, &events](const Room& target, int64_t except, const nlohmann::json& data) {
+      for(auto participant : target.participants) {
+        auto& other = this->_handles[participant];
+        if(participant != except && other.publisher == true) {
+          events.emplace_back(other.session, Messages::pluginEvent(other.session, other.id, "", "videoroom", data));
+        }
+      }
+    };
+
+    if(request == "create") {
+      if(room != this->_rooms.end()) {
+        return success({ { "videoroom", "event" }, { "error_code", 427 }, { "error", "Room " + std::to_string(roomId) + " already exists" } });
+      }
+
+      Room created;
+      created.id = roomId > 0 ? roomId : this->_id();
+      created.description = body.value("description", "Room " + std::to_string(created.id));
+      this->_rooms[created.id] = created;
+
+      return success({ { "videoroom", "created" }, { "room", created.id }, { "permanent", false } });
+    }
+
+    if(request == "exists") {
+      return success({ { "videoroom", "success" }, { "room", roomId }, { "exists", room != this->_rooms.end() } });
+    }
+
+    if(request == "list") {
+      auto list = nlohmann::json::array();
+      for(auto& entry : this->_rooms) {
+        list.push_back({ { "room", entry.second.id }, { "description", entry.second.description }, { "num_participants", entry.second.participants.size() }, { "max_publishers", 3 } });
+      }
+
+      return success({ { "videoroom", "success" }, { "list", list } });
+    }
+
+    if(request == "listparticipants") {
+      if(room == this->_rooms.end()) {
+        return success(missing);
+      }
+
+      auto participants = nlohmann::json::array();
+      for(auto participant : room->second.participants) {
+        auto& other = this->_handles[participant];
+        if(other.publisher == true) {
+          participants.push_back({ { "id", other.feed }, { "display", other.display }, { "publisher", other.publishing } });
+        }
+      }
+
+      return success({ { "videoroom", "participants" }, { "room", roomId }, { "participants", participants } });
+    }
+
+    if(request == "destroy") {
+      if(room == this->_rooms.end()) {
+        return success(missing);
+      }
+
+      notify(room->second, -1, { { "videoroom", "destroyed" }, { "room", roomId } });
+      for(auto participant : room->second.participants) {
+        this->_handles[participant].room = -1;
+      }
+      this->_rooms.erase(room);
+
+      return success({ { "videoroom", "destroyed" }, { "room", roomId } });
+    }
+
+    if(request == "join" || request == "joinandconfigure") {
+      if(room == this->_rooms.end()) {
+        event(missing);
+
+        return ack;
+      }
+
+      if(body.value("ptype", "") == "subscriber") {
+        auto feed = body.value("feed", (int64_t) -1);
+        auto publisher = std::find_if(room->second.participants.begin(), room->second.participants.end(), [this, feed](int64_t participant) {
+          auto& other = this->_handles[participant];
+          return other.feed == feed && other.publishing == true;
+        });
+
+        if(publisher == room->second.participants.end()) {
+          event({ { "videoroom", "event" }, { "error_code", 428 }, { "error", "No such feed (" + std::to_string(feed) + ")" } });
+
+          return ack;
+        }
+
+        handle.room = roomId;
+        handle.feed = feed;
+
+        auto& msg = event({ { "videoroom", "attached" }, { "room", roomId }, { "id", feed }, { "display", this->_handles[*publisher].display } });
+        msg["jsep"] = jsep("offer", offer(true, true, false));
+
+        return ack;
+      }
+
+      handle.room = roomId;
+      handle.publisher = true;
+      handle.feed = body.value("id", this->_id());
+      handle.display = body.value("display", "");
+      room->second.participants.push_back(handle.id);
+
+      auto& joined = event({ { "videoroom", "joined" }, { "room", roomId }, { "description", room->second.description }, { "id", handle.feed }, { "private_id", this->_id() }, { "publishers", this->_publishers(room->second, handle.id) } });
+      if(request == "joinandconfigure" && isOffer(remote) == true) {
+        handle.publishing = true;
+        joined["jsep"] = jsep("answer", answer(remote.value("sdp", "")));
+        this->_connected(handle, events);
+
+        notify(room->second, handle.id, { { "videoroom", "event" }, { "room", roomId }, { "publishers", { { { "id", handle.feed }, { "display", handle.display }, { "audio_codec", "opus" }, { "video_codec", "vp8" } } } } });
+      }
+
+      return ack;
+    }
+
+    if(request == "configure" || request == "publish") {
+      auto& msg = event({ { "videoroom", "event" }, { "room", handle.room }, { "configured", "ok" } });
+
+      if(handle.publisher == true && isOffer(remote) == true) {
+        msg["audio_codec"] = "opus";
+        msg["video_codec"] = "vp8";
+        msg["jsep"] = jsep("answer", answer(remote.value("sdp", "")));
+
+        auto announce = handle.publishing == false;
+        handle.publishing = true;
+        this->_connected(handle, events);
+
+        if(announce == true && room != this->_rooms.end()) {
+          notify(room->second, handle.id, { { "videoroom", "event" }, { "room", handle.room }, { "publishers", { { { "id", handle.feed }, { "display", handle.display }, { "audio_codec", "opus" }, { "video_codec", "vp8" } } } } });
+        }
+      }
+
+      return ack;
+    }
+
+    if(request == "unpublish") {
+      event({ { "videoroom", "event" }, { "room", handle.room }, { "unpublished", "ok" } });
+
+      if(handle.publishing == true && room != this->_rooms.end()) {
+        handle.publishing = false;
+        notify(room->second, handle.id, { { "videoroom", "event" }, { "room", handle.room }, { "unpublished", handle.feed } });
+      }
+
+      return ack;
+    }
+
+    if(request == "start") {
+      event({ { "videoroom", "event" }, { "room", handle.room }, { "started", "ok" } });
+      if(remote.is_object() == true) {
+        this->_connected(handle, events);
+      }
+
+      return ack;
+    }
+
+    if(request == "pause") {
+      event({ { "videoroom", "event" }, { "room", handle.room }, { "paused", "ok" } });
+
+      return ack;
+    }
+
+    if(request == "switch") {
+      handle.feed = body.value("feed", handle.feed);
+      event({ { "videoroom", "event" }, { "room", handle.room }, { "switched", "ok" }, { "id", handle.feed } });
+
+      return ack;
+    }
+
+    if(request == "leave") {
+      event({ { "videoroom", "event" }, { "room", handle.room }, { "leaving", "ok" } });
+      this->_leave(handle, events);
+
+      return ack;
+    }
+
+    return success({ { "videoroom", "event" }, { "error_code", 423 }, { "error", "Unknown request '" + request + "'" } });
+  }
+
+  void GatewayEmulator::_connected(Handle& handle, Events& events) {
+    handle.negotiated = true;
+
+    events.emplace_back(handle.session, Messages::handleEvent("webrtcup", handle.session, handle.id));
+    for(auto type : { "audio", "video" }) {
+      auto msg = Messages::handleEvent("media", handle.session, handle.id);
+      msg["type"] = type;
+      msg["receiving"] = true;
+      events.emplace_back(handle.session, msg);
+    }
+  }
+
+  void GatewayEmulator::_leave(Handle& handle, Events& events) {
+    auto room = this->_rooms.find(handle.room);
+    if(handle.publisher == false || room == this->_rooms.end()) {
+      handle.room = -1;
+
+      return;
+    }
+
+    auto& participants = room->second.participants;
+    participants.erase(std::remove(participants.begin(), participants.end(), handle.id), participants.end());
+
+    for(auto participant : participants) {
+      auto& other = this->_handles[participant];
+      if(other.publisher == false) {
+        continue;
+      }
+
+      if(handle.publishing == true) {
+        events.emplace_back(other.session, Messages::pluginEvent(other.session, other.id, "", "videoroom", { { "videoroom", "event" }, { "room", room->first }, { "unpublished", handle.feed } }));
+      }
+      events.emplace_back(other.session, Messages::pluginEvent(other.session, other.id, "", "videoroom", { { "videoroom", "event" }, { "room", room->first }, { "leaving", handle.feed } }));
+    }
+
+    handle.room = -1;
+    handle.publisher = false;
+    handle.publishing = false;
+  }
+
+  void GatewayEmulator::_detach(int64_t handleId, Events& events) {
+    auto handle = this->_handles.find(handleId);
+    if(handle == this->_handles.end()) {
+      return;
+    }
+
+    this->_leave(handle->second, events);
+    events.emplace_back(handle->second.session, Messages::handleEvent("detached", handle->second.session, handleId));
+
+    auto session = this->_sessions.find(handle->second.session);
+    if(session != this->_sessions.end()) {
+      auto& handles = session->second->handles;
+      handles.erase(std::remove(handles.begin(), handles.end(), handleId), handles.end());
+    }
+
+    this->_handles.erase(handle);
+  }
+
+  nlohmann::json GatewayEmulator::_publishers(const Room& room, int64_t except) {
+    auto publishers = nlohmann::json::array();
+    for(auto participant : room.participants) {
+      auto& other = this->_handles[participant];
+      if(participant != except && other.publishing == true) {
+        publishers.push_back({ { "id", other.feed }, { "display", other.display }, { "audio_codec", "opus" }, { "video_codec", "vp8" } });
+      }
+    }
+
+    return publishers;
+  }
+
+  GatewayRule GatewayEmulator::_rule(const std::string& key) {
+    for(auto& rule : this->_rules) {
+      if(rule.match.empty() == true || rule.match == key) {
+        return rule;
+      }
+    }
+
+    return GatewayRule();
+  }
+
+  int64_t GatewayEmulator::_delay(const GatewayRule& rule) {
+    if(rule.jitter <= 0) {
+      return rule.latency;
+    }
+
+    return rule.latency + (int64_t) (this->_random() % (uint64_t) (rule.jitter + 1));
+  }
+
+  int64_t GatewayEmulator::_id() {
+    // janus keeps its identifiers within the integers a javascript client can hold
+    return (int64_t) (this->_random() % ((1ULL << 53) - 1)) + 1;
+  }
+
+  void GatewayEmulator::_emit(int64_t sessionId, const nlohmann::json& event, const GatewayRule& rule) {
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+
+      if(rule.loss > 0 && std::uniform_real_distribution<double>(0, 1)(this->_random) < rule.loss) {
+        this->_stats.lost++;
+
+        return;
+      }
+
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(this->_delay(rule));
+      auto& horizon = this->_horizon[sessionId];
+      if(deadline < horizon) {
+        deadline = horizon;
+      }
+      horizon = deadline;
+
+      this->_pending.emplace(deadline, std::make_pair(sessionId, event));
+    }
+
+    this->_timer.notify_one();
+  }
+
+  void GatewayEmulator::_deliver(int64_t sessionId, const nlohmann::json& event) {
+    GatewaySink sink;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+
+      auto entry = this->_sessions.find(sessionId);
+      if(entry == this->_sessions.end()) {
+        return;
+      }
+
+      this->_stats.events++;
+      sink = entry->second->sink;
+      if(sink == nullptr) {
+        entry->second->events.push_back(event);
+        entry->second->ready.notify_one();
+
+        return;
+      }
+    }
+
+    sink(event);
+  }
+
+  void GatewayEmulator::_tick() {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+
+    while(this->_running == true) {
+      if(this->_pending.empty() == true) {
+        this->_timer.wait(lock);
+        continue;
+      }
+
+      auto next = this->_pending.begin();
+      if(next->first > std::chrono::steady_clock::now()) {
+        this->_timer.wait_until(lock, next->first);
+        continue;
+      }
+
+      auto delivery = next->second;
+      this->_pending.erase(next);
+
+      lock.unlock();
+      this->_deliver(delivery.first, delivery.second);
+      lock.lock();
+    }
+  }
+
+}
@@ -0,0 +1,157 @@
+/*!
+ * janus-client SDK
+ *
+ * gateway_emulator.h
+ * The Janus Gateway Emulator
+ * This module speaks the janus protocol in process: sessions, handles, long polls, and the echotest, streaming and videoroom plugins with fake JSEP.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#define EMULATOR_LONG_POLL_TIMEOUT 30000
+#define EMULATOR_DEFAULT_ROOM 1234
+
+namespace Janus {
+
+  using GatewayReply = std::function<void(const nlohmann::json&)>;
+  using GatewaySink = std::function<void(const nlohmann::json&)>;
+
+  // where a request comes from: a connection that can be pushed to (a websocket) binds the sessions it creates
+  struct GatewayOrigin {
+    int64_t owner = -1;
+    GatewaySink sink = nullptr;
+  };
+
+  // matched against the janus verb ("attach", "trickle") or the plugin request ("join", "watch"), an empty match applies to every request
+  struct GatewayRule {
+    std::string match = "";
+    int64_t latency = 0;
+    int64_t jitter = 0;
+    // the asynchronous events only, a reply is never lost so that an HTTP client is never left hanging
+    double loss = 0;
+  };
+
+  struct GatewayStats {
+    int64_t requests = 0;
+    int64_t events = 0;
+    int64_t lost = 0;
+    int64_t sessions = 0;
+    int64_t handles = 0;
+  };
+
+  class GatewayEmulator {
+    public:
+      GatewayEmulator(uint32_t seed = 0);
+      ~GatewayEmulator();
+
+      // the first matching rule wins
+      void script(const std::vector<GatewayRule>& rules);
+      void longPollTimeout(int64_t milliseconds);
+
+      // replies through the callback first, then schedules the asynchronous events the request triggers
+      void handle(const nlohmann::json& request, const GatewayOrigin& origin, const GatewayReply& reply);
+      // waits for the next event of the session, a keepalive comes back when the long poll expires
+      nlohmann::json poll(int64_t sessionId);
+      void release(int64_t owner);
+
+      GatewayStats stats();
+      void stop();
+
+    private:
+      struct Handle {
+        int64_t id = 0;
+        int64_t session = 0;
+        std::string plugin;
+
+        bool negotiated = false;
+
+        int64_t room = -1;
+        int64_t feed = -1;
+        std::string display;
+        bool publisher = false;
+        bool publishing = false;
+
+        int64_t mountpoint = -1;
+      };
+
+      struct Session {
+        int64_t id = 0;
+        std::deque<nlohmann::json> events;
+        std::condition_variable ready;
+        std::vector<int64_t> handles;
+        // ends the long polls still waiting on it
+        bool destroyed = false;
+
+        int64_t owner = -1;
+        GatewaySink sink = nullptr;
+      };
+
+      struct Room {
+        int64_t id = 0;
+        std::string description;
+        std::vector<int64_t> participants;
+      };
+
+      struct Mountpoint {
+        int64_t id = 0;
+        std::string description;
+        bool audio = true;
+        bool video = true;
+        bool data = false;
+      };
+
+      using Events = std::vector<std::pair<int64_t, nlohmann::json>>;
+
+      nlohmann::json _process(const nlohmann::json& request, const GatewayOrigin& origin, Events& events);
+      nlohmann::json _echotest(Handle& handle, const std::string& transaction, const nlohmann::json& body, const nlohmann::json& jsep, Events& events);
+      nlohmann::json _streaming(Handle& handle, const std::string& transaction, const nlohmann::json& body, const nlohmann::json& jsep, Events& events);
+      nlohmann::json _videoroom(Handle& handle, const std::string& transaction, const nlohmann::json& body, const nlohmann::json& jsep, Events& events);
+
+      void _connected(Handle& handle, Events& events);
+      void _leave(Handle& handle, Events& events);
+      void _detach(int64_t handleId, Events& events);
+      nlohmann::json _publishers(const Room& room, int64_t except);
+
+      GatewayRule _rule(const std::string& key);
+      int64_t _delay(const GatewayRule& rule);
+      int64_t _id();
+
+      void _emit(int64_t sessionId, const nlohmann::json& event, const GatewayRule& rule);
+      void _deliver(int64_t sessionId, const nlohmann::json& event);
+      void _tick();
+
+      std::unordered_map<int64_t, std::shared_ptr<Session>> _sessions;
+      std::unordered_map<int64_t, Handle> _handles;
+      std::map<int64_t, Room> _rooms;
+      std::map<int64_t, Mountpoint> _mountpoints;
+
+      std::vector<GatewayRule> _rules;
+      int64_t _longPollTimeout = EMULATOR_LONG_POLL_TIMEOUT;
+      GatewayStats _stats;
+      std::mt19937_64 _random;
+      std::mutex _mutex;
+
+      // the asynchronous events waiting for their latency, a session never sees them out of order
+      std::multimap<std::chrono::steady_clock::time_point, std::pair<int64_t, nlohmann::json>> _pending;
+      std::unordered_map<int64_t, std::chrono::steady_clock::time_point> _horizon;
+      std::condition_variable _timer;
+      bool _running = true;
+      std::thread _scheduler;
+  };
+
+}
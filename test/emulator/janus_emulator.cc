@@ -0,0 +1,569 @@
+#include "emulator/janus_emulator.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+namespace Janus {
+
+  namespace {
+
+    const char* WEBSOCKET_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+    uint32_t rotate(uint32_t value, int bits) {
+      return (value << bits) | (value >> (32 - bits));
+    }
+
+    std::string sha1(const std::string& input) {
+      uint32_t state[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+
+      std::string message = input;
+      uint64_t length = (uint64_t) input.size() * 8;
+      message += (char) 0x80;
+      while(message.size() % 64 != 56) {
+        message += (char) 0x00;
+      }
+      for(int shift = 56; shift >= 0; shift -= 8) {
+        message += (char) ((length >> shift) & 0xFF);
+      }
+
+      for(size_t chunk = 0; chunk < message.size(); chunk += 64) {
+        uint32_t words[80];
+        for(int i = 0; i < 16; i++) {
+          words[i] = 0;
+          for(int j = 0; j < 4; j++) {
+            words[i] = (words[i] << 8) | (uint8_t) message[chunk + i * 4 + j];
+          }
+        }
+        for(int i = 16; i < 80; i++) {
+          words[i] = rotate(words[i - 3] ^ words[i - 8] ^ words[i - 14] ^ words[i - 16], 1);
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+        for(int i = 0; i < 80; i++) {
+          uint32_t f, k;
+          if(i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999;
+          } else if(i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1;
+          } else if(i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDC;
+          } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6;
+          }
+
+          uint32_t temp = rotate(a, 5) + f + e + k + words[i];
+          e = d;
+          d = c;
+          c = rotate(b, 30);
+          b = a;
+          a = temp;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+      }
+
+      std::string digest;
+      for(auto word : state) {
+        for(int shift = 24; shift >= 0; shift -= 8) {
+          digest += (char) ((word >> shift) & 0xFF);
+        }
+      }
+
+      return digest;
+    }
+
+    std::string base64(const std::string& input) {
+      const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+      std::string output;
+      for(size_t i = 0; i < input.size(); i += 3) {
+        uint32_t group = (uint8_t) input[i] << 16;
+        if(i + 1 < input.size()) {
+          group |= (uint8_t) input[i + 1] << 8;
+        }
+        if(i + 2 < input.size()) {
+          group |= (uint8_t) input[i + 2];
+        }
+
+        output += alphabet[(group >> 18) & 0x3F];
+        output += alphabet[(group >> 12) & 0x3F];
+        output += i + 1 < input.size() ? alphabet[(group >> 6) & 0x3F] : '=';
+        output += i + 2 < input.size() ? alphabet[group & 0x3F] : '=';
+      }
+
+      return output;
+    }
+
+    std::string lower(std::string value) {
+      std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+        return std::tolower(c);
+      });
+
+      return value;
+    }
+
+    struct HttpRequest {
+      std::string method;
+      std::string path;
+      std::map<std::string, std::string> headers;
+      std::string body;
+
+      std::string header(const std::string& name) const {
+        auto entry = this->headers.find(name);
+        return entry == this->headers.end() ? "" : entry->second;
+      }
+    };
+
+    bool receive(int socket, std::string& buffer) {
+      char chunk[4096];
+      auto size = recv(socket, chunk, sizeof(chunk), 0);
+      if(size <= 0) {
+        return false;
+      }
+
+      buffer.append(chunk, size);
+
+      return true;
+    }
+
+    // consumes one request from the buffer, reading from the socket as long as it is incomplete
+    bool readRequest(int socket, std::string& buffer, HttpRequest& request) {
+      size_t end;
+      while((end = buffer.find("\r\n\r\n")) == std::string::npos) {
+        if(receive(socket, buffer) == false) {
+          return false;
+        }
+      }
+
+      auto head = buffer.substr(0, end);
+      buffer.erase(0, end + 4);
+
+      auto lineEnd = head.find("\r\n");
+      auto requestLine = head.substr(0, lineEnd);
+      auto firstSpace = requestLine.find(' ');
+      auto secondSpace = requestLine.find(' ', firstSpace + 1);
+      if(firstSpace == std::string::npos || secondSpace == std::string::npos) {
+        return false;
+      }
+
+      request.method = requestLine.substr(0, firstSpace);
+      request.path = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+      request.headers.clear();
+
+      while(lineEnd != std::string::npos) {
+        auto start = lineEnd + 2;
+        lineEnd = head.find("\r\n", start);
+        auto line = head.substr(start, lineEnd == std::string::npos ? std::string::npos : lineEnd - start);
+
+        auto colon = line.find(':');
+        if(colon == std::string::npos) {
+          continue;
+        }
+
+        auto value = line.substr(colon + 1);
+        value.erase(0, value.find_first_not_of(' '));
+        request.headers[lower(line.substr(0, colon))] = value;
+      }
+
+      auto length = (size_t) std::atol(request.header("content-length").c_str());
+
+      // curl holds the larger bodies, like an SDP offer, back until it is told to go on
+      if(lower(request.header("expect")) == "100-continue" && buffer.size() < length) {
+        std::string proceed = "HTTP/1.1 100 Continue\r\n\r\n";
+        send(socket, proceed.data(), proceed.size(), MSG_NOSIGNAL);
+      }
+
+      while(buffer.size() < length) {
+        if(receive(socket, buffer) == false) {
+          return false;
+        }
+      }
+
+      request.body = buffer.substr(0, length);
+      buffer.erase(0, length);
+
+      return true;
+    }
+
+    std::string httpResponse(int status, const std::string& reason, const std::string& body) {
+      return "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n" + body;
+    }
+
+    std::string frame(uint8_t opcode, const std::string& payload) {
+      std::string data;
+      data += (char) (0x80 | opcode);
+
+      if(payload.size() < 126) {
+        data += (char) payload.size();
+      } else if(payload.size() < 65536) {
+        data += (char) 126;
+        data += (char) ((payload.size() >> 8) & 0xFF);
+        data += (char) (payload.size() & 0xFF);
+      } else {
+        data += (char) 127;
+        for(int shift = 56; shift >= 0; shift -= 8) {
+          data += (char) (((uint64_t) payload.size() >> shift) & 0xFF);
+        }
+      }
+
+      return data + payload;
+    }
+
+    // reads one whole frame, the client side masks every payload
+    bool readFrame(int socket, std::string& buffer, uint8_t& opcode, bool& fin, std::string& payload) {
+      while(buffer.size() < 2) {
+        if(receive(socket, buffer) == false) {
+          return false;
+        }
+      }
+
+      fin = ((uint8_t) buffer[0] & 0x80) != 0;
+      opcode = (uint8_t) buffer[0] & 0x0F;
+      auto masked = ((uint8_t) buffer[1] & 0x80) != 0;
+      uint64_t length = (uint8_t) buffer[1] & 0x7F;
+
+      size_t header = 2;
+      size_t extended = length == 126 ? 2 : length == 127 ? 8 : 0;
+      while(buffer.size() < header + extended + (masked ? 4 : 0)) {
+        if(receive(socket, buffer) == false) {
+          return false;
+        }
+      }
+
+      if(extended > 0) {
+        length = 0;
+        for(size_t i = 0; i < extended; i++) {
+          length = (length << 8) | (uint8_t) buffer[header + i];
+        }
+        header += extended;
+      }
+
+      char mask[4] = { 0, 0, 0, 0 };
+      if(masked == true) {
+        std::memcpy(mask, buffer.data() + header, 4);
+        header += 4;
+      }
+
+      while(buffer.size() < header + length) {
+        if(receive(socket, buffer) == false) {
+          return false;
+        }
+      }
+
+      payload = buffer.substr(header, length);
+      for(size_t i = 0; i < payload.size(); i++) {
+        payload[i] ^= mask[i % 4];
+      }
+
+      buffer.erase(0, header + length);
+
+      return true;
+    }
+
+    // splits /janus/<session>/<handle>, false when the path is not a janus one
+    bool route(const std::string& path, int64_t& sessionId, int64_t& handleId) {
+      auto clean = path.substr(0, path.find('?'));
+      auto base = std::string("/janus");
+      if(clean.compare(0, base.size(), base) != 0) {
+        return false;
+      }
+
+      sessionId = 0;
+      handleId = 0;
+
+      auto rest = clean.substr(base.size());
+      if(rest.empty() == true || rest == "/") {
+        return true;
+      }
+
+      auto separator = rest.find('/', 1);
+      sessionId = std::atoll(rest.substr(1, separator == std::string::npos ? std::string::npos : separator - 1).c_str());
+      if(separator != std::string::npos) {
+        handleId = std::atoll(rest.substr(separator + 1).c_str());
+      }
+
+      return true;
+    }
+
+  }
+
+  JanusEmulator::JanusEmulator(int port, uint32_t seed) {
+    this->_port = port;
+    this->_gateway = std::make_shared<GatewayEmulator>(seed);
+  }
+
+  JanusEmulator::~JanusEmulator() {
+    this->stop();
+  }
+
+  void JanusEmulator::start() {
+    this->_listener = socket(AF_INET, SOCK_STREAM, 0);
+    if(this->_listener < 0) {
+      throw std::runtime_error("cannot create the emulator socket");
+    }
+
+    int reuse = 1;
+    setsockopt(this->_listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(this->_port);
+
+    if(bind(this->_listener, (sockaddr*) &address, sizeof(address)) != 0 || listen(this->_listener, 128) != 0) {
+      close(this->_listener);
+      this->_listener = -1;
+
+      throw std::runtime_error("cannot listen on port " + std::to_string(this->_port));
+    }
+
+    socklen_t size = sizeof(address);
+    getsockname(this->_listener, (sockaddr*) &address, &size);
+    this->_port = ntohs(address.sin_port);
+
+    this->_running = true;
+    this->_acceptor = std::thread(&JanusEmulator::_accept, this);
+  }
+
+  void JanusEmulator::stop() {
+    if(this->_running.exchange(false) == false) {
+      return;
+    }
+
+    shutdown(this->_listener, SHUT_RDWR);
+    close(this->_listener);
+    this->_acceptor.join();
+
+    // the long polls waiting on the gateway return before their connections go
+    this->_gateway->stop();
+    this->_reap(true);
+  }
+
+  int JanusEmulator::port() {
+    return this->_port;
+  }
+
+  std::string JanusEmulator::url() {
+    return "http://127.0.0.1:" + std::to_string(this->_port) + "/janus";
+  }
+
+  std::string JanusEmulator::wsUrl() {
+    return "ws://127.0.0.1:" + std::to_string(this->_port) + "/janus";
+  }
+
+  std::shared_ptr<GatewayEmulator> JanusEmulator::gateway() {
+    return this->_gateway;
+  }
+
+  void JanusEmulator::_accept() {
+    while(this->_running == true) {
+      auto client = accept(this->_listener, nullptr, nullptr);
+      if(client < 0) {
+        continue;
+      }
+
+      int noDelay = 1;
+      setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+      auto connection = std::make_shared<Connection>();
+      connection->socket = client;
+
+      this->_reap(false);
+
+      std::lock_guard<std::mutex> lock(this->_connectionsMutex);
+      connection->id = this->_nextConnection++;
+      connection->thread = std::thread(&JanusEmulator::_serve, this, connection);
+      this->_connections.push_back(connection);
+    }
+  }
+
+  void JanusEmulator::_serve(const std::shared_ptr<Connection>& connection) {
+    std::string buffer;
+    HttpRequest request;
+
+    while(this->_running == true && readRequest(connection->socket, buffer, request) == true) {
+      if(lower(request.header("upgrade")) == "websocket") {
+        auto key = request.header("sec-websocket-key");
+        auto accept = base64(sha1(key + WEBSOCKET_GUID));
+
+        std::string handshake = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: " + accept + "\r\n";
+        if(request.header("sec-websocket-protocol").find("janus-protocol") != std::string::npos) {
+          handshake += "Sec-WebSocket-Protocol: janus-protocol\r\n";
+        }
+
+        if(JanusEmulator::_write(connection, handshake + "\r\n") == true) {
+          this->_websocket(connection, buffer);
+        }
+
+        break;
+      }
+
+      int64_t sessionId = 0;
+      int64_t handleId = 0;
+      if(route(request.path, sessionId, handleId) == false) {
+        JanusEmulator::_write(connection, httpResponse(404, "Not Found", "{}"));
+        continue;
+      }
+
+      if(request.method == "GET" && sessionId != 0) {
+        JanusEmulator::_write(connection, httpResponse(200, "OK", this->_gateway->poll(sessionId).dump()));
+        continue;
+      }
+
+      if(request.method == "GET") {
+        this->_gateway->handle({ { "janus", "info" } }, GatewayOrigin(), [&connection](const nlohmann::json& reply) {
+          JanusEmulator::_write(connection, httpResponse(200, "OK", reply.dump()));
+        });
+        continue;
+      }
+
+      auto message = nlohmann::json::parse(request.body, nullptr, false);
+      if(message.is_discarded() == true || message.is_object() == false) {
+        nlohmann::json error = { { "janus", "error" }, { "error", { { "code", 454 }, { "reason", "JSON error" } } } };
+        JanusEmulator::_write(connection, httpResponse(200, "OK", error.dump()));
+        continue;
+      }
+
+      if(sessionId != 0) {
+        message["session_id"] = sessionId;
+      }
+      if(handleId != 0) {
+        message["handle_id"] = handleId;
+      }
+
+      this->_gateway->handle(message, GatewayOrigin(), [&connection](const nlohmann::json& reply) {
+        JanusEmulator::_write(connection, httpResponse(200, "OK", reply.dump()));
+      });
+    }
+
+    JanusEmulator::_close(connection);
+    connection->done = true;
+  }
+
+  void JanusEmulator::_websocket(const std::shared_ptr<Connection>& connection, std::string buffer) {
+    GatewayOrigin origin;
+    origin.owner = connection->id;
+    origin.sink = [connection](const nlohmann::json& event) {
+      JanusEmulator::_write(connection, frame(0x1, event.dump()));
+    };
+
+    std::string message;
+    uint8_t opcode = 0;
+    bool fin = false;
+    std::string payload;
+
+    while(this->_running == true && readFrame(connection->socket, buffer, opcode, fin, payload) == true) {
+      if(opcode == 0x8) {
+        JanusEmulator::_write(connection, frame(0x8, payload.substr(0, 2)));
+        break;
+      }
+
+      if(opcode == 0x9) {
+        JanusEmulator::_write(connection, frame(0xA, payload));
+        continue;
+      }
+
+      if(opcode != 0x1 && opcode != 0x0) {
+        continue;
+      }
+
+      message += payload;
+      if(fin == false) {
+        continue;
+      }
+
+      auto request = nlohmann::json::parse(message, nullptr, false);
+      message.clear();
+
+      if(request.is_discarded() == true || request.is_object() == false) {
+        nlohmann::json error = { { "janus", "error" }, { "error", { { "code", 454 }, { "reason", "JSON error" } } } };
+        origin.sink(error);
+        continue;
+      }
+
+      this->_gateway->handle(request, origin, origin.sink);
+    }
+
+    this->_gateway->release(connection->id);
+  }
+
+  void JanusEmulator::_reap(bool all) {
+    std::list<std::shared_ptr<Connection>> finished;
+    {
+      std::lock_guard<std::mutex> lock(this->_connectionsMutex);
+      for(auto entry = this->_connections.begin(); entry != this->_connections.end();) {
+        if(all == true || (*entry)->done == true) {
+          finished.push_back(*entry);
+          entry = this->_connections.erase(entry);
+        } else {
+          entry++;
+        }
+      }
+    }
+
+    for(auto& connection : finished) {
+      // only the reading side goes, the reply a connection is still writing reaches its client
+      if(all == true) {
+        std::lock_guard<std::mutex> lock(connection->writing);
+        if(connection->closed == false) {
+          shutdown(connection->socket, SHUT_RD);
+        }
+      }
+
+      connection->thread.join();
+    }
+  }
+
+  bool JanusEmulator::_write(const std::shared_ptr<Connection>& connection, const std::string& data) {
+    std::lock_guard<std::mutex> lock(connection->writing);
+    if(connection->closed == true) {
+      return false;
+    }
+
+    size_t sent = 0;
+    while(sent < data.size()) {
+      auto size = send(connection->socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+      if(size <= 0) {
+        return false;
+      }
+
+      sent += size;
+    }
+
+    return true;
+  }
+
+  void JanusEmulator::_close(const std::shared_ptr<Connection>& connection) {
+    std::lock_guard<std::mutex> lock(connection->writing);
+    if(connection->closed == true) {
+      return;
+    }
+
+    connection->closed = true;
+    close(connection->socket);
+  }
+
+}
@@ -0,0 +1,70 @@
+/*!
+ * janus-client SDK
+ *
+ * janus_emulator.h
+ * The Janus Emulator Server
+ * This module serves a gateway emulator on localhost, over HTTP with long polls and over WebSocket.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "emulator/gateway_emulator.h"
+
+namespace Janus {
+
+  class JanusEmulator {
+    public:
+      // port 0 lets the system pick a free one
+      JanusEmulator(int port = 0, uint32_t seed = 0);
+      ~JanusEmulator();
+
+      // throws std::runtime_error when the port cannot be bound
+      void start();
+      void stop();
+
+      int port();
+      std::string url();
+      std::string wsUrl();
+
+      std::shared_ptr<GatewayEmulator> gateway();
+
+    private:
+      struct Connection {
+        int64_t id = 0;
+        int socket = -1;
+        bool closed = false;
+        std::mutex writing;
+        std::atomic<bool> done { false };
+        std::thread thread;
+      };
+
+      void _accept();
+      void _serve(const std::shared_ptr<Connection>& connection);
+      void _websocket(const std::shared_ptr<Connection>& connection, std::string buffer);
+      void _reap(bool all);
+
+      static bool _write(const std::shared_ptr<Connection>& connection, const std::string& data);
+      static void _close(const std::shared_ptr<Connection>& connection);
+
+      int _port = 0;
+      int _listener = -1;
+      std::atomic<bool> _running { false };
+      std::thread _acceptor;
+
+      std::shared_ptr<GatewayEmulator> _gateway;
+
+      std::list<std::shared_ptr<Connection>> _connections;
+      int64_t _nextConnection = 0;
+      std::mutex _connectionsMutex;
+  };
+
+}
@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+
+#include <future>
+#include <thread>
+
+#include "emulator/gateway_emulator.h"
+#include "janus/sdp.h"
+
+namespace Janus {
+
+  class GatewayEmulatorTest : public testing::Test {
+    protected:
+      void SetUp() override {
+        this->_gateway = std::make_shared<GatewayEmulator>(42);
+        this->_gateway->longPollTimeout(200);
+      }
+
+      nlohmann::json _request(const nlohmann::json& request) {
+        nlohmann::json reply;
+        this->_gateway->handle(request, GatewayOrigin(), [&reply](const nlohmann::json& message) {
+          reply = message;
+        });
+
+        return reply;
+      }
+
+      int64_t _session() {
+        return this->_request({ { "janus", "create" }, { "transaction", "create" } })["data"]["id"];
+      }
+
+      int64_t _attach(int64_t sessionId, const std::string& plugin) {
+        return this->_request({ { "janus", "attach" }, { "transaction", "attach" }, { "session_id", sessionId }, { "plugin", "janus.plugin." + plugin } })["data"]["id"];
+      }
+
+      nlohmann::json _message(int64_t sessionId, int64_t handleId, const nlohmann::json& body, const nlohmann::json& jsep = nullptr) {
+        nlohmann::json msg = { { "janus", "message" }, { "transaction", "message" }, { "session_id", sessionId }, { "handle_id", handleId }, { "body", body } };
+        if(jsep.is_null() == false) {
+          msg["jsep"] = jsep;
+        }
+
+        return this->_request(msg);
+      }
+
+      std::shared_ptr<GatewayEmulator> _gateway;
+  };
+
+  namespace {
+
+    const char* EMULATOR_OFFER =
+      "v=0\r\n"
+      "o=- 1 2 IN IP4 127.0.0.1\r\n"
+      "s=-\r\n"
+      "t=0 0\r\n"
+      "m=audio 9 UDP/TLS/RTP/SAVPF 111 0\r\n"
+      "a=mid:0\r\n"
+      "a=sendrecv\r\n"
+      "a=rtpmap:111 opus/48000/2\r\n"
+      "a=rtpmap:0 PCMU/8000\r\n"
+      "m=video 9 UDP/TLS/RTP/SAVPF 97 96\r\n"
+      "a=mid:1\r\n"
+      "a=sendonly\r\n"
+      "a=rtpmap:97 rtx/90000\r\n"
+      "a=fmtp:97 apt=96\r\n"
+      "a=rtpmap:96 VP8/90000\r\n";
+
+  }
+
+  TEST_F(GatewayEmulatorTest, shouldCreateSessionsAndHandles) {
+    auto sessionId = this->_session();
+    EXPECT_GT(sessionId, 0);
+
+    auto handleId = this->_attach(sessionId, "echotest");
+    EXPECT_GT(handleId, 0);
+
+    auto stats = this->_gateway->stats();
+    EXPECT_EQ(stats.sessions, 1);
+    EXPECT_EQ(stats.handles, 1);
+  }
+
+  TEST_F(GatewayEmulatorTest, shouldReplyWithTheJanusErrors) {
+    auto missing = this->_request({ { "janus", "attach" }, { "transaction", "t" }, { "session_id", 69 }, { "plugin", "janus.plugin.echotest" } });
+    EXPECT_EQ(missing["janus"], "error");
+    EXPECT_EQ(missing["error"]["code"], 458);
+
+    auto sessionId = this->_session();
+    auto plugin = this->_request({ { "janus", "attach" }, { "transaction", "t" }, { "session_id", sessionId }, { "plugin", "janus.plugin.yolo" } });
+    EXPECT_EQ(plugin["error"]["code"], 460);
+
+    auto handle = this->_message(sessionId, 69, { { "request", "list" } });
+    EXPECT_EQ(handle["error"]["code"], 459);
+  }
+
+  TEST_F(GatewayEmulatorTest, shouldAnswerTheEchotestOffer) {
+    auto sessionId = this->_session();
+    auto handleId = this->_attach(sessionId, "echotest");
+
+    auto ack = this->_message(sessionId, handleId, { { "audio", true }, { "video", true } }, { { "type", "offer" }, { "sdp", EMULATOR_OFFER } });
+    EXPECT_EQ(ack["janus"], "ack");
+
+    auto event = this->_gateway->poll(sessionId);
+    EXPECT_EQ(event["janus"], "event");
+    EXPECT_EQ(event["sender"], handleId);
+    EXPECT_EQ(event["plugindata"]["data"]["result"], "ok");
+    EXPECT_EQ(event["jsep"]["type"], "answer");
+
+    SessionDescription answer(event["jsep"]["sdp"].get<std::string>());
+    ASSERT_EQ(answer.mediaCount(), 2u);
+    EXPECT_TRUE(answer.mline(0).equals("m=audio 9 UDP/TLS/RTP/SAVPF 111"));
+    EXPECT_TRUE(answer.mline(1).equals("m=video 9 UDP/TLS/RTP/SAVPF 96"));
+
+    SdpSlice direction;
+    EXPECT_TRUE(answer.attribute(1, "recvonly", direction));
+
+    EXPECT_EQ(this->_gateway->poll(sessionId)["janus"], "webrtcup");
+    EXPECT_EQ(this->_gateway->poll(sessionId)["janus"], "media");
+  }
+
+  TEST_F(GatewayEmulatorTest, shouldKeepTheLongPollAlive) {
+    auto sessionId = this->_session();
+
+    EXPECT_EQ(this->_gateway->poll(sessionId)["janus"], "keepalive");
+  }
+
+  TEST_F(GatewayEmulatorTest, shouldEndTheLongPollOfADestroyedSession) {
+    this->_gateway->longPollTimeout(30000);
+    auto sessionId = this->_session();
+
+    auto poll = std::async(std::launch::async, [this, sessionId] {
+      return this->_gateway->poll(sessionId);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    this->_request({ { "janus", "destroy" }, { "transaction", "destroy" }, { "session_id", sessionId } });
+
+    ASSERT_EQ(poll.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    auto reply = poll.get();
+    EXPECT_EQ(reply["janus"], "error");
+    EXPECT_EQ(reply["error"]["code"], 458);
+  }
+
+  TEST_F(GatewayEmulatorTest, shouldOfferTheStreamingMountpoint) {
+    auto sessionId = this->_session();
+    auto handleId = this->_attach(sessionId, "streaming");
+
+    auto list = this->_message(sessionId, handleId, { { "request", "list" } });
+    EXPECT_EQ(list["janus"], "success");
+    EXPECT_EQ(list["plugindata"]["data"]["list"].size(), 2u);
+
+    this->_message(sessionId, handleId, { { "request", "watch" }, { "id", 2 } });
+    auto preparing = this->_gateway->poll(sessionId);
+    EXPECT_EQ(preparing["plugindata"]["data"]["result"]["status"], "preparing");
+    EXPECT_EQ(preparing["jsep"]["type"], "offer");
+    EXPECT_EQ(SessionDescription(preparing["jsep"]["sdp"].get<std::string>()).mediaCount(), 1u);
+
+    this->_message(sessionId, handleId, { { "request", "start" } }, { { "type", "answer" }, { "sdp", "v=0\r\n" } });
+    EXPECT_EQ(this->_gateway->poll(sessionId)["plugindata"]["data"]["result"]["status"], "starting");
+    EXPECT_EQ(this->_gateway->poll(sessionId)["janus"], "webrtcup");
+  }
+
+  TEST_F(GatewayEmulatorTest, shouldTellThePublishersAboutEachOther) {
+    auto firstSession = this->_session();
+    auto first = this->_attach(firstSession, "videoroom");
+    auto secondSession = this->_session();
+    auto second = this->_attach(secondSession, "videoroom");
+
+    this->_message(firstSession, first, { { "request", "joinandconfigure" }, { "ptype", "publisher" }, { "room", EMULATOR_DEFAULT_ROOM }, { "id", 1 }, { "display", "first" } }, { { "type", "offer" }, { "sdp", EMULATOR_OFFER } });
+    auto joined = this->_gateway->poll(firstSession);
+    EXPECT_EQ(joined["plugindata"]["data"]["videoroom"], "joined");
+    EXPECT_EQ(joined["jsep"]["type"], "answer");
+
+    this->_message(secondSession, second, { { "request", "join" }, { "ptype", "publisher" }, { "room", EMULATOR_DEFAULT_ROOM }, { "id", 2 } });
+    auto publishers = this->_gateway->poll(secondSession)["plugindata"]["data"]["publishers"];
+    ASSERT_EQ(publishers.size(), 1u);
+    EXPECT_EQ(publishers[0]["id"], 1);
+    EXPECT_EQ(publishers[0]["display"], "first");
+
+    this->_request({ { "janus", "detach" }, { "transaction", "t" }, { "session_id", firstSession }, { "handle_id", first } });
+
+    EXPECT_EQ(this->_gateway->poll(secondSession)["plugindata"]["data"]["unpublished"], 1);
+    EXPECT_EQ(this->_gateway->poll(secondSession)["plugindata"]["data"]["leaving"], 1);
+  }
+
+  TEST_F(GatewayEmulatorTest, shouldOfferTheFeedToASubscriber) {
+    auto sessionId = this->_session();
+    auto publisher = this->_attach(sessionId, "videoroom");
+    auto subscriber = this->_attach(sessionId, "videoroom");
+
+    this->_message(sessionId, subscriber, { { "request", "join" }, { "ptype", "subscriber" }, { "room", EMULATOR_DEFAULT_ROOM }, { "feed", 1 } });
+    EXPECT_EQ(this->_gateway->poll(sessionId)["plugindata"]["data"]["error_code"], 428);
+
+    this->_message(sessionId, publisher, { { "request", "joinandconfigure" }, { "ptype", "publisher" }, { "room", EMULATOR_DEFAULT_ROOM }, { "id", 1 } }, { { "type", "offer" }, { "sdp", EMULATOR_OFFER } });
+    for(int i = 0; i < 4; i++) {
+      this->_gateway->poll(sessionId);
+    }
+
+    this->_message(sessionId, subscriber, { { "request", "join" }, { "ptype", "subscriber" }, { "room", EMULATOR_DEFAULT_ROOM }, { "feed", 1 } });
+    auto attached = this->_gateway->poll(sessionId);
+    EXPECT_EQ(attached["sender"], subscriber);
+    EXPECT_EQ(attached["plugindata"]["data"]["videoroom"], "attached");
+    EXPECT_EQ(attached["jsep"]["type"], "offer");
+  }
+
+  TEST_F(GatewayEmulatorTest, shouldDelayTheScriptedRequests) {
+    GatewayRule rule;
+    rule.match = "attach";
+    rule.latency = 50;
+
+    this->_gateway->script({ rule });
+    auto sessionId = this->_session();
+
+    auto start = std::chrono::steady_clock::now();
+    this->_attach(sessionId, "echotest");
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_GE(elapsed, 50);
+  }
+
+  TEST_F(GatewayEmulatorTest, shouldLoseTheScriptedEvents) {
+    GatewayRule rule;
+    rule.loss = 1;
+
+    this->_gateway->script({ rule });
+    auto sessionId = this->_session();
+    auto handleId = this->_attach(sessionId, "echotest");
+
+    EXPECT_EQ(this->_message(sessionId, handleId, { { "audio", true } })["janus"], "ack");
+    EXPECT_EQ(this->_gateway->poll(sessionId)["janus"], "keepalive");
+    EXPECT_EQ(this->_gateway->stats().lost, 1);
+  }
+
+  TEST_F(GatewayEmulatorTest, shouldPushTheEventsToABoundSink) {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<nlohmann::json> pushed;
+
+    GatewayOrigin origin;
+    origin.owner = 1;
+    origin.sink = [&](const nlohmann::json& event) {
+      std::lock_guard<std::mutex> lock(mutex);
+      pushed.push_back(event);
+      condition.notify_one();
+    };
+
+    int64_t sessionId = 0;
+    this->_gateway->handle({ { "janus", "create" }, { "transaction", "t" } }, origin, [&sessionId](const nlohmann::json& reply) {
+      sessionId = reply["data"]["id"];
+    });
+
+    auto handleId = this->_attach(sessionId, "echotest");
+    this->_message(sessionId, handleId, { { "audio", true } });
+
+    std::unique_lock<std::mutex> lock(mutex);
+    EXPECT_TRUE(condition.wait_for(lock, std::chrono::seconds(1), [&pushed] { return pushed.empty() == false; }));
+    EXPECT_EQ(pushed.front()["plugindata"]["data"]["echotest"], "event");
+  }
+
+}
@@ -7,6 +7,11 @@
 #include "janus/platform.hpp"
 #include "janus/protocol_delegate.hpp"
 #include "janus/janus.hpp"
+#include "janus/janus_api.h"
+#include "janus/random.h"
+#include "janus/trace.h"
+
+#include "emulator/janus_emulator.h"
 
 #include "mocks/peer_factory.h"
 #include "mocks/peer.h"
@@ -18,15 +23,30 @@ using testing::Return;
 namespace Janus {
 
   class ApiTest : public testing::Test {
+    protected:
+      void SetUp() override {
+        this->_emulator = std::make_shared<JanusEmulator>();
+        this->_emulator->start();
+      }
+
+      void TearDown() override {
+        this->_emulator->stop();
+      }
+
+      std::shared_ptr<JanusEmulator> _emulator;
   };
 
   class Delegate : public ProtocolDelegate {
     public:
       void onReady() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->ready = true;
         this->condition.notify_one();
       }
 
       void onClose() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->closed = true;
         this->condition.notify_one();
       }
 
@@ -36,6 +56,8 @@ namespace Janus {
 
       std::mutex mutex;
       std::condition_variable condition;
+      bool ready = false;
+      bool closed = false;
   };
 
   TEST_F(ApiTest, shouldCreateANewSession) {
@@ -43,7 +65,7 @@ namespace Janus {
     auto factory = std::make_shared<NiceMock<PeerFactoryMock>>();
 
     auto conf = std::make_shared<NiceMock<JanusConfMock>>();
-    ON_CALL(*conf, url()).WillByDefault(Return("http://janus:8088/janus"));
+    ON_CALL(*conf, url()).WillByDefault(Return(this->_emulator->url()));
     ON_CALL(*conf, plugin()).WillByDefault(Return("janus.plugin.echotest"));
 
     auto delegate = std::make_shared<Delegate>();
@@ -55,15 +77,66 @@ namespace Janus {
 
     {
       std::unique_lock<std::mutex> lock(delegate->mutex);
-      delegate->condition.wait(lock);
+      delegate->condition.wait(lock, [&delegate] { return delegate->ready; });
     }
 
     janus->close();
 
     {
       std::unique_lock<std::mutex> lock(delegate->mutex);
-      delegate->condition.wait(lock);
+      delegate->condition.wait(lock, [&delegate] { return delegate->closed; });
     }
   }
 
+  TEST_F(ApiTest, shouldReplayARecordedSession) {
+    auto path = testing::TempDir() + "janus_integration_trace.jsonl";
+    std::remove(path.c_str());
+    this->_emulator->gateway()->longPollTimeout(200);
+
+    auto run = [](const std::shared_ptr<TransportFactory>& transportFactory, const std::string& url) {
+      auto factory = std::make_shared<NiceMock<PeerFactoryMock>>();
+
+      auto conf = std::make_shared<NiceMock<JanusConfMock>>();
+      ON_CALL(*conf, url()).WillByDefault(Return(url));
+      ON_CALL(*conf, plugin()).WillByDefault(Return("janus.plugin.echotest"));
+
+      auto delegate = std::make_shared<Delegate>();
+
+      auto platform = Platform::create(factory);
+      platform->protocol(std::make_shared<JanusApi>(std::make_shared<RandomImpl>(), transportFactory));
+      auto janus = Janus::create(conf, platform, delegate);
+
+      janus->init();
+
+      {
+        std::unique_lock<std::mutex> lock(delegate->mutex);
+        EXPECT_TRUE(delegate->condition.wait_for(lock, std::chrono::seconds(5), [&delegate] { return delegate->ready; }));
+      }
+
+      janus->close();
+
+      {
+        std::unique_lock<std::mutex> lock(delegate->mutex);
+        EXPECT_TRUE(delegate->condition.wait_for(lock, std::chrono::seconds(5), [&delegate] { return delegate->closed; }));
+      }
+    };
+
+    auto recorder = std::make_shared<TraceRecorder>(path);
+    run(std::make_shared<TracingTransportFactory>(std::make_shared<TransportFactoryImpl>(), recorder), this->_emulator->url());
+
+    auto entries = readTrace(path);
+    EXPECT_GE(entries.size(), 6u);
+
+    auto replay = std::make_shared<ReplayTransportFactory>(entries);
+    run(replay, "http://replay");
+
+    auto stats = replay->transport()->wait(5000);
+    EXPECT_TRUE(stats.done);
+    EXPECT_FALSE(stats.stalled);
+    EXPECT_EQ(stats.mismatched, 0);
+    EXPECT_EQ(stats.sent, 3);
+
+    std::remove(path.c_str());
+  }
+
 }
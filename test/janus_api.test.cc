@@ -1,9 +1,12 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <thread>
+
 #include "janus/janus_api.h"
 
 #include "janus/janus_error.hpp"
+#include "janus/janus_commands.hpp"
 
 #include "mocks/transport_factory.h"
 #include "mocks/transport.h"
@@ -25,6 +28,8 @@ using testing::InSequence;
 using testing::IsEvent;
 using testing::HasJsep;
 using testing::IsError;
+using testing::SizeIs;
+using testing::Invoke;
 
 #define TEST_SESSION_ID 276911837174840
 #define TEST_STRING_SESSION_ID "276911837174840"
@@ -160,7 +165,7 @@ namespace Janus {
 
   TEST_F(JanusApiTest, shouldHandleTheHangupEvent) {
     EXPECT_CALL(*this->_delegate, onHangup("my yolo reason")).Times(1);
-    EXPECT_CALL(*this->_plugin, onHangup("my yolo reason")).Times(1);
+    EXPECT_CALL(*this->_plugin, onHangup("my yolo reason", testing::BundleHasInt("handleId", TEST_HANDLE_ID))).Times(1);
 
     nlohmann::json message = {
       { "janus", "hangup" },
@@ -211,6 +216,91 @@ namespace Janus {
     api->onIceCandidate("yolo", 69, "my yolo candidate", TEST_HANDLE_ID);
   }
 
+  TEST_F(JanusApiTest, shouldFilterTheCandidatesBeforeTheTrickle) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto relay = "candidate:6 1 udp 41885439 5.6.7.8 3478 typ relay raddr 1.2.3.4 rport 50003";
+    auto host = "candidate:1 1 udp 2122260223 192.168.1.2 50000 typ host";
+
+    std::shared_ptr<JanusEvent> stats;
+    EXPECT_CALL(*this->_delegate, onEvent(IsEvent("janus", "candidate-filter"), _)).Times(2).WillRepeatedly(testing::SaveArg<0>(&stats));
+    EXPECT_CALL(*this->_transport, send(_, BundleHasString("candidate", relay))).Times(1);
+    EXPECT_CALL(*this->_transport, send(_, BundleHasString("candidate", host))).Times(0);
+
+    auto policy = Bundle::create();
+    policy->setBool("relay_only", true);
+    api->dispatch(JanusCommands::CANDIDATE_FILTER, policy);
+
+    api->onIceCandidate("0", 0, host, TEST_HANDLE_ID);
+    api->onIceCandidate("0", 0, relay, TEST_HANDLE_ID);
+
+    api->dispatch(JanusCommands::CANDIDATE_FILTER, policy);
+
+    EXPECT_EQ(stats->data()->getInt("accepted", -1), 1);
+    EXPECT_EQ(stats->data()->getInt("dropped", -1), 1);
+    EXPECT_EQ(stats->data()->getInt("dropped_not_relay", -1), 1);
+  }
+
+  TEST_F(JanusApiTest, shouldFilterTheCandidatesOfALocalDescription) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto bundle = Bundle::create();
+    bundle->setString("command", "attach");
+    bundle->setString("plugin", "my yolo plugin");
+    nlohmann::json message = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_HANDLE_ID } } }
+    };
+    api->onMessage(message, bundle);
+
+    auto policy = Bundle::create();
+    policy->setBool("relay_only", true);
+    api->dispatch(JanusCommands::CANDIDATE_FILTER, policy);
+
+    auto relay = "a=candidate:6 1 udp 41885439 5.6.7.8 3478 typ relay raddr 1.2.3.4 rport 50003\r\n";
+    auto host = "a=candidate:1 1 udp 2122260223 192.168.1.2 50000 typ host\r\n";
+    auto offer = std::string("v=0\r\nm=audio 9 UDP/TLS/RTP/SAVPF 111\r\n") + host + relay;
+
+    auto context = Bundle::create();
+    context->setInt("handleId", TEST_HANDLE_ID);
+    EXPECT_CALL(*this->_plugin, onOffer(std::string("v=0\r\nm=audio 9 UDP/TLS/RTP/SAVPF 111\r\n") + relay, context)).Times(1);
+
+    api->onOffer(offer, context);
+  }
+
+  TEST_F(JanusApiTest, shouldNotTimeACandidateTheFilterDropped) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto bundle = Bundle::create();
+    bundle->setString("command", "attach");
+    bundle->setString("plugin", "my yolo plugin");
+    nlohmann::json message = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_HANDLE_ID } } }
+    };
+    api->onMessage(message, bundle);
+
+    auto policy = Bundle::create();
+    policy->setBool("relay_only", true);
+    api->dispatch(JanusCommands::CANDIDATE_FILTER, policy);
+
+    std::shared_ptr<JanusEvent> timing;
+    EXPECT_CALL(*this->_delegate, onEvent(IsEvent("janus", "setup-timing"), _)).WillOnce(testing::SaveArg<0>(&timing));
+
+    api->dispatch(JanusCommands::PREPARE, Bundle::create());
+    api->onIceCandidate("0", 0, "candidate:1 1 udp 2122260223 192.168.1.2 50000 typ host", TEST_HANDLE_ID);
+    api->onIceCompleted(TEST_HANDLE_ID);
+    api->onMessage({ { "janus", "media" }, { "sender", TEST_HANDLE_ID }, { "type", "audio" }, { "receiving", true } }, bundle);
+
+    ASSERT_NE(timing, nullptr);
+    EXPECT_EQ(timing->data()->getInt("first_candidate", 0), -1);
+    EXPECT_EQ(timing->data()->getObject("ice")->getInt("first_candidate", 0), -1);
+    EXPECT_EQ(timing->data()->getObject("ice")->getInt("candidates_dropped", -1), 1);
+  }
+
   TEST_F(JanusApiTest, shouldSendATrickleCompletedMessageOnIceCompleted) {
     auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
     api->init(this->_conf, this->_platform, this->_delegate);
@@ -240,6 +330,236 @@ namespace Janus {
     api->onIceCompleted(TEST_HANDLE_ID);
   }
 
+  TEST_F(JanusApiTest, shouldNestTheIceTimingInTheSetupReport) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto bundle = Bundle::create();
+    bundle->setString("command", "attach");
+    bundle->setString("plugin", "my yolo plugin");
+    nlohmann::json message = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_HANDLE_ID } } }
+    };
+    api->onMessage(message, bundle);
+
+    std::shared_ptr<JanusEvent> timing;
+    EXPECT_CALL(*this->_delegate, onEvent(IsEvent("janus", "setup-timing"), _)).WillOnce(testing::SaveArg<0>(&timing));
+
+    api->dispatch(JanusCommands::PREPARE, Bundle::create());
+    api->onIceCandidate("yolo", 69, "my yolo candidate", TEST_HANDLE_ID);
+    api->onOffer("the sdp", Bundle::create());
+    api->onIceCompleted(TEST_HANDLE_ID);
+    // a restart gathers again, the report keeps the first gathering
+    api->onIceCompleted(TEST_HANDLE_ID);
+    api->onMessage({ { "janus", "media" }, { "sender", TEST_HANDLE_ID }, { "type", "audio" }, { "receiving", true } }, bundle);
+
+    ASSERT_NE(timing, nullptr);
+    EXPECT_EQ(timing->sender(), TEST_HANDLE_ID);
+    EXPECT_GE(timing->data()->getInt("prepare", -1), 0);
+    EXPECT_GE(timing->data()->getInt("offer", -1), 0);
+    EXPECT_EQ(timing->data()->getInt("answer_applied", 0), -1);
+
+    auto ice = timing->data()->getObject("ice");
+    EXPECT_GE(ice->getInt("first_candidate", -1), 0);
+    EXPECT_GE(ice->getInt("completed", -1), 0);
+    EXPECT_EQ(ice->getInt("candidates", -1), 1);
+    EXPECT_EQ(ice->getInt("candidates_dropped", -1), 0);
+  }
+
+  TEST_F(JanusApiTest, shouldReportTheCandidatesSoFarOfAHandleStillGathering) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto bundle = Bundle::create();
+    bundle->setString("command", "attach");
+    bundle->setString("plugin", "my yolo plugin");
+    api->onMessage({ { "janus", "success" }, { "data", { { "id", TEST_HANDLE_ID } } } }, bundle);
+
+    std::shared_ptr<JanusEvent> timing;
+    EXPECT_CALL(*this->_delegate, onEvent(IsEvent("janus", "setup-timing"), _)).WillOnce(testing::SaveArg<0>(&timing));
+
+    api->onIceCandidate("yolo", 69, "my yolo candidate", TEST_HANDLE_ID);
+    api->onMessage({ { "janus", "media" }, { "sender", TEST_HANDLE_ID }, { "type", "audio" }, { "receiving", true } }, bundle);
+    // the handle reported already
+    api->onIceCompleted(TEST_HANDLE_ID);
+
+    ASSERT_NE(timing, nullptr);
+    EXPECT_EQ(timing->data()->getObject("ice")->getInt("candidates", -1), 1);
+    EXPECT_EQ(timing->data()->getObject("ice")->getInt("completed", 0), -1);
+  }
+
+  TEST_F(JanusApiTest, shouldMarkTheAnswerOnceApplied) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto bundle = Bundle::create();
+    bundle->setString("command", "attach");
+    bundle->setString("plugin", "my yolo plugin");
+    api->onMessage({ { "janus", "success" }, { "data", { { "id", TEST_HANDLE_ID } } } }, bundle);
+
+    std::shared_ptr<JanusEvent> timing;
+    EXPECT_CALL(*this->_delegate, onEvent(IsEvent("janus", "setup-timing"), _)).WillOnce(testing::SaveArg<0>(&timing));
+
+    // the answer of janus counts once the plugin handed it over, not when it arrives
+    EXPECT_CALL(*this->_plugin, onEvent(_, _)).WillRepeatedly(testing::InvokeWithoutArgs([]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }));
+
+    auto context = Bundle::create();
+    api->onOffer("the sdp", context);
+    api->onMessage({
+      { "janus", "event" },
+      { "sender", TEST_HANDLE_ID },
+      { "plugindata", { { "data", { { "yolo", "joined" } } } } },
+      { "jsep", { { "type", "answer" }, { "sdp", "the answer" } } }
+    }, context);
+    api->onMessage({ { "janus", "media" }, { "sender", TEST_HANDLE_ID }, { "type", "audio" }, { "receiving", true } }, context);
+
+    ASSERT_NE(timing, nullptr);
+    EXPECT_GE(timing->data()->getInt("answer_applied", -1) - timing->data()->getInt("join", 0), 20);
+  }
+
+  TEST_F(JanusApiTest, shouldReportTheSetupTimingOfAHandleOnItsFirstMedia) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto create = Bundle::create();
+    create->setString("command", "create");
+    create->setString("plugin", "my yolo plugin");
+    api->onMessage({ { "janus", "success" }, { "data", { { "id", TEST_SESSION_ID } } } }, create);
+    api->onMessage({ { "janus", "success" }, { "data", { { "id", TEST_HANDLE_ID } } } }, create);
+
+    std::shared_ptr<JanusEvent> timing;
+    EXPECT_CALL(*this->_delegate, onEvent(_, _)).Times(testing::AnyNumber());
+    EXPECT_CALL(*this->_delegate, onEvent(IsEvent("janus", "setup-timing"), _)).WillOnce(testing::SaveArg<0>(&timing));
+
+    auto context = Bundle::create();
+    api->onOffer("the sdp", context);
+    api->onIceCandidate("yolo", 69, "my yolo candidate", TEST_HANDLE_ID);
+    api->onMessage({
+      { "janus", "event" },
+      { "sender", TEST_HANDLE_ID },
+      { "plugindata", { { "data", { { "yolo", "joined" } } } } },
+      { "jsep", { { "type", "answer" }, { "sdp", "the answer" } } }
+    }, context);
+    api->onIceCompleted(TEST_HANDLE_ID);
+    api->onMessage({ { "janus", "webrtcup" }, { "sender", TEST_HANDLE_ID } }, context);
+    api->onMessage({ { "janus", "media" }, { "sender", TEST_HANDLE_ID }, { "type", "audio" }, { "receiving", false } }, context);
+    api->onMessage({ { "janus", "media" }, { "sender", TEST_HANDLE_ID }, { "type", "audio" }, { "receiving", true } }, context);
+    api->onMessage({ { "janus", "media" }, { "sender", TEST_HANDLE_ID }, { "type", "video" }, { "receiving", true } }, context);
+
+    ASSERT_NE(timing, nullptr);
+    EXPECT_EQ(timing->sender(), TEST_HANDLE_ID);
+
+    auto previous = (int64_t) 0;
+    for(auto& stage : { "create", "attach", "offer", "first_candidate", "join", "answer_applied", "trickle_complete", "webrtcup", "media" }) {
+      auto mark = timing->data()->getInt(stage, -1);
+      EXPECT_GE(mark, previous) << stage;
+      previous = mark;
+    }
+  }
+
+  TEST_F(JanusApiTest, shouldLeaveTheMissingSetupStagesOut) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto attach = Bundle::create();
+    attach->setString("command", "attach");
+    attach->setString("plugin", "my yolo plugin");
+    api->onMessage({ { "janus", "success" }, { "data", { { "id", TEST_HANDLE_ID } } } }, attach);
+
+    std::shared_ptr<JanusEvent> timing;
+    EXPECT_CALL(*this->_delegate, onEvent(IsEvent("janus", "setup-timing"), _)).WillOnce(testing::SaveArg<0>(&timing));
+
+    api->onMessage({ { "janus", "media" }, { "sender", TEST_HANDLE_ID }, { "type", "audio" } }, attach);
+
+    ASSERT_NE(timing, nullptr);
+    EXPECT_EQ(timing->data()->getInt("create", 0), -1);
+    EXPECT_GE(timing->data()->getInt("attach", -1), 0);
+    EXPECT_EQ(timing->data()->getInt("offer", 0), -1);
+    EXPECT_EQ(timing->data()->getInt("webrtcup", 0), -1);
+    EXPECT_GE(timing->data()->getInt("media", -1), 0);
+  }
+
+  TEST_F(JanusApiTest, shouldReportTheSetupTimingOfAReceiveOnlyHandleOnWebrtcup) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto attach = Bundle::create();
+    attach->setString("command", "attach");
+    attach->setString("plugin", "my yolo plugin");
+    api->onMessage({ { "janus", "success" }, { "data", { { "id", TEST_HANDLE_ID } } } }, attach);
+
+    std::shared_ptr<JanusEvent> timing;
+    EXPECT_CALL(*this->_delegate, onEvent(IsEvent("janus", "setup-timing"), _)).WillOnce(testing::SaveArg<0>(&timing));
+
+    auto context = Bundle::create();
+    api->onAnswer("v=0\r\nm=audio 9 UDP/TLS/RTP/SAVPF 111\r\na=recvonly\r\nm=video 9 UDP/TLS/RTP/SAVPF 96\r\na=recvonly\r\n", context);
+    api->onMessage({ { "janus", "webrtcup" }, { "sender", TEST_HANDLE_ID } }, context);
+    api->onMessage({ { "janus", "media" }, { "sender", TEST_HANDLE_ID }, { "type", "video" }, { "receiving", true } }, context);
+
+    ASSERT_NE(timing, nullptr);
+    EXPECT_EQ(timing->data()->getBool("sends", true), false);
+    EXPECT_GE(timing->data()->getInt("answer_applied", -1), 0);
+    EXPECT_GE(timing->data()->getInt("webrtcup", -1), 0);
+    EXPECT_EQ(timing->data()->getInt("media", 0), -1);
+  }
+
+  TEST_F(JanusApiTest, shouldReportTheRequestsOfTheSetupAsItsFlow) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto attach = Bundle::create();
+    attach->setString("command", "attach");
+    attach->setString("plugin", "my yolo plugin");
+    api->onMessage({ { "janus", "success" }, { "data", { { "id", TEST_HANDLE_ID } } } }, attach);
+
+    std::shared_ptr<JanusEvent> timing;
+    EXPECT_CALL(*this->_delegate, onEvent(IsEvent("janus", "setup-timing"), _)).WillOnce(testing::SaveArg<0>(&timing));
+
+    auto context = Bundle::create();
+    api->onCommandResult({ { "body", { { "request", "join" } } } }, context);
+    api->onCommandResult({ { "body", { { "request", "configure" } } } }, context);
+    api->onMessage({ { "janus", "media" }, { "sender", TEST_HANDLE_ID }, { "type", "video" }, { "receiving", true } }, context);
+    api->onCommandResult({ { "body", { { "request", "list" } } } }, context);
+
+    ASSERT_NE(timing, nullptr);
+    EXPECT_EQ(timing->data()->getString("flow", ""), "join+configure");
+    EXPECT_EQ(timing->data()->getBool("sends", false), true);
+    EXPECT_GE(timing->data()->getInt("request", -1), 0);
+  }
+
+  TEST_F(JanusApiTest, shouldSendADetachMessageForTheGivenHandle) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    nlohmann::json detach = {
+      { "janus", "detach" },
+      { "transaction", "yolo random string" },
+      { "handle_id", 420 }
+    };
+
+    {
+      InSequence sequence;
+
+      EXPECT_CALL(*this->_transport, send(IsJsonEq(detach), BundleHasString("command", "detach"))).Times(1);
+      EXPECT_CALL(*this->_transport, send(_, BundleHasString("command", "destroy"))).Times(1);
+    }
+
+    auto bundle = Bundle::create();
+    bundle->setString("command", "attach");
+    nlohmann::json message = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_HANDLE_ID } } }
+    };
+    api->onMessage(message, bundle);
+
+    auto payload = Bundle::create();
+    payload->setInt("handleId", 420);
+    api->dispatch(JanusCommands::DETACH, payload);
+  }
+
   TEST_F(JanusApiTest, shouldDelegateSdpEventsToPlugins) {
     auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
     api->init(this->_conf, this->_platform, this->_delegate);
@@ -295,6 +615,113 @@ namespace Janus {
 
   }
 
+  TEST_F(JanusApiTest, shouldSendBatchedCommandsAsASingleTransportBatch) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto trickle = Bundle::create();
+    trickle->setString("command", "trickle");
+    trickle->setString("candidate", "my yolo candidate");
+    auto completed = Bundle::create();
+    completed->setString("command", "trickle_completed");
+
+    EXPECT_CALL(*this->_transport, send(_, _)).Times(0);
+    EXPECT_CALL(*this->_transport, sendBatch(SizeIs(2))).WillOnce(Invoke([&](const std::vector<TransportMessage>& messages) {
+      EXPECT_EQ(messages[0].message.value("janus", ""), "trickle");
+      EXPECT_EQ(messages[0].context, trickle);
+      EXPECT_EQ(messages[1].message.value("candidate", nlohmann::json::object()).value("completed", false), true);
+      EXPECT_EQ(messages[1].context, completed);
+    }));
+
+    api->dispatchBatch({ trickle, completed });
+  }
+
+  TEST_F(JanusApiTest, shouldJoinANestedBatchToTheOuterOne) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto attachBundle = Bundle::create();
+    attachBundle->setString("command", "attach");
+    attachBundle->setString("plugin", "my yolo plugin");
+    nlohmann::json attachMessage = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_HANDLE_ID } } }
+    };
+    api->onMessage(attachMessage, attachBundle);
+
+    auto custom = Bundle::create();
+    custom->setString("command", "custom command");
+    auto nested = Bundle::create();
+    nested->setString("command", "trickle");
+    auto completed = Bundle::create();
+    completed->setString("command", "trickle_completed");
+
+    // the plugin batches a trickle of its own while the outer batch is open
+    JanusApi* raw = api.get();
+    EXPECT_CALL(*this->_plugin, command("custom command", custom)).WillOnce(Invoke([raw, nested](const std::string& command, const std::shared_ptr<Bundle>& payload) {
+      raw->dispatchBatch({ nested });
+    }));
+
+    EXPECT_CALL(*this->_transport, send(_, _)).Times(testing::AnyNumber());
+    EXPECT_CALL(*this->_transport, send(IsJanusMessage("trickle"), _)).Times(0);
+    EXPECT_CALL(*this->_transport, sendBatch(SizeIs(2))).Times(1);
+
+    api->dispatchBatch({ custom, completed });
+  }
+
+  TEST_F(JanusApiTest, shouldKeepTheBatchesOfConcurrentThreadsApart) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    EXPECT_CALL(*this->_transport, send(_, _)).Times(0);
+    EXPECT_CALL(*this->_transport, sendBatch(SizeIs(2))).Times(200);
+
+    auto batches = [api] {
+      for(int index = 0; index < 100; index++) {
+        auto trickle = Bundle::create();
+        trickle->setString("command", "trickle");
+        auto completed = Bundle::create();
+        completed->setString("command", "trickle_completed");
+
+        api->dispatchBatch({ trickle, completed });
+      }
+    };
+
+    std::thread first(batches);
+    std::thread second(batches);
+    first.join();
+    second.join();
+  }
+
+  TEST_F(JanusApiTest, shouldDelegateBatchedPluginCommandsToPlugin) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto attachBundle = Bundle::create();
+    attachBundle->setString("command", "attach");
+    attachBundle->setString("plugin", "my yolo plugin");
+    nlohmann::json attachMessage = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_HANDLE_ID } } }
+    };
+    api->onMessage(attachMessage, attachBundle);
+
+    auto first = Bundle::create();
+    first->setString("command", "first command");
+    auto second = Bundle::create();
+    second->setString("command", "second command");
+
+    {
+      InSequence sequence;
+
+      EXPECT_CALL(*this->_plugin, command("first command", first)).Times(1);
+      EXPECT_CALL(*this->_plugin, command("second command", second)).Times(1);
+    }
+    EXPECT_CALL(*this->_transport, sendBatch(_)).Times(0);
+
+    api->dispatchBatch({ first, second });
+  }
+
   TEST_F(JanusApiTest, shouldDelegateToPluginCustomCommands) {
     auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
     api->init(this->_conf, this->_platform, this->_delegate);
@@ -397,6 +824,31 @@ namespace Janus {
     api->hangup();
   }
 
+  TEST_F(JanusApiTest, shouldDelegateTheMediaEventsToThePlugin) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    auto attachBundle = Bundle::create();
+    attachBundle->setString("command", "attach");
+    attachBundle->setString("plugin", "my yolo plugin");
+    nlohmann::json attachMessage = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_HANDLE_ID } } }
+    };
+    api->onMessage(attachMessage, attachBundle);
+
+    auto bundle = Bundle::create();
+
+    EXPECT_CALL(*this->_plugin, onEvent(IsEvent("janus", "webrtcup"), bundle));
+    EXPECT_CALL(*this->_plugin, onEvent(IsEvent("janus", "media"), bundle));
+    // only the setup report of the handle
+    EXPECT_CALL(*this->_delegate, onEvent(testing::Not(IsEvent("janus", "setup-timing")), _)).Times(0);
+    EXPECT_CALL(*this->_delegate, onEvent(IsEvent("janus", "setup-timing"), _)).Times(1);
+
+    api->onMessage({ { "janus", "webrtcup" }, { "sender", TEST_HANDLE_ID } }, bundle);
+    api->onMessage({ { "janus", "media" }, { "sender", TEST_HANDLE_ID }, { "type", "audio" }, { "receiving", true } }, bundle);
+  }
+
   TEST_F(JanusApiTest, shouldDelegateAllTheOtherEvents) {
     auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
     api->init(this->_conf, this->_platform, this->_delegate);
@@ -468,6 +920,161 @@ namespace Janus {
     api->onMessage(message, bundle);
   }
 
+  TEST_F(JanusApiTest, shouldSendOnlyOneRequestForIdenticalQueries) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    nlohmann::json query = {
+      { "body", { { "request", "list" } } }
+    };
+    nlohmann::json reply = {
+      { "janus", "success" },
+      { "sender", TEST_HANDLE_ID },
+      { "plugindata", { { "data", { { "list", nlohmann::json::array() } } } } }
+    };
+
+    auto first = Bundle::create();
+    auto second = Bundle::create();
+
+    EXPECT_CALL(*this->_transport, send(IsJanusMessage("message"), first)).Times(1);
+    EXPECT_CALL(*this->_transport, send(IsJanusMessage("message"), second)).Times(0);
+    EXPECT_CALL(*this->_delegate, onEvent(_, first)).Times(1);
+    EXPECT_CALL(*this->_delegate, onEvent(_, second)).Times(1);
+
+    api->onQuery(query, first, "videoroom");
+    api->onQuery(query, second, "videoroom");
+
+    api->onMessage(reply, first);
+  }
+
+  TEST_F(JanusApiTest, shouldServeCachedQueries) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    nlohmann::json query = {
+      { "body", { { "request", "list" } } }
+    };
+    nlohmann::json reply = {
+      { "janus", "success" },
+      { "sender", TEST_HANDLE_ID },
+      { "plugindata", { { "data", { { "list", nlohmann::json::array() } } } } }
+    };
+
+    auto first = Bundle::create();
+    auto second = Bundle::create();
+    auto third = Bundle::create();
+
+    EXPECT_CALL(*this->_transport, send(IsJanusMessage("message"), _)).Times(2);
+    EXPECT_CALL(*this->_delegate, onEvent(IsEvent("janus", "success"), _)).Times(3);
+
+    api->onQuery(query, first, "videoroom");
+    api->onMessage(reply, first);
+    api->onQuery(query, second, "videoroom");
+
+    api->invalidateQueries("videoroom");
+    api->onQuery(query, third, "videoroom");
+    api->onMessage(reply, third);
+  }
+
+  TEST_F(JanusApiTest, shouldDropTheCachedQueriesWithTheSession) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    nlohmann::json query = {
+      { "body", { { "request", "list" } } }
+    };
+    nlohmann::json reply = {
+      { "janus", "success" },
+      { "sender", TEST_HANDLE_ID },
+      { "plugindata", { { "data", { { "list", nlohmann::json::array() } } } } }
+    };
+
+    auto first = Bundle::create();
+    auto second = Bundle::create();
+
+    EXPECT_CALL(*this->_transport, send(IsJanusMessage("message"), _)).Times(2);
+
+    api->onQuery(query, first, "videoroom");
+    api->onMessage(reply, first);
+
+    auto destroy = Bundle::create();
+    destroy->setString("command", JanusCommands::DESTROY);
+    api->onMessage({ { "janus", "success" } }, destroy);
+
+    api->onQuery(query, second, "videoroom");
+  }
+
+  TEST_F(JanusApiTest, shouldDeliverQueryErrorsToEveryWaiter) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    nlohmann::json query = {
+      { "body", { { "request", "list" } } }
+    };
+    nlohmann::json error = {
+      { "janus", "error" },
+      { "error", {
+        { "code", 69 },
+        { "reason", "you only live once" }
+      } }
+    };
+
+    auto first = Bundle::create();
+    auto second = Bundle::create();
+
+    EXPECT_CALL(*this->_delegate, onError(IsError(69, "you only live once"), first)).Times(1);
+    EXPECT_CALL(*this->_delegate, onError(IsError(69, "you only live once"), second)).Times(1);
+
+    api->onQuery(query, first, "videoroom");
+    api->onQuery(query, second, "videoroom");
+    api->onMessage(error, first);
+  }
+
+  TEST_F(JanusApiTest, shouldFailTheQueriesInFlightWhenTheSessionCloses) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    nlohmann::json query = {
+      { "body", { { "request", "list" } } }
+    };
+
+    auto first = Bundle::create();
+    auto second = Bundle::create();
+    api->onQuery(query, first, "videoroom");
+    api->onQuery(query, second, "videoroom");
+
+    EXPECT_CALL(*this->_delegate, onError(IsError(-1, "the session closed before the query got a reply"), first)).Times(1);
+    EXPECT_CALL(*this->_delegate, onError(IsError(-1, "the session closed before the query got a reply"), second)).Times(1);
+    EXPECT_CALL(*this->_delegate, onClose()).Times(1);
+
+    auto destroy = Bundle::create();
+    destroy->setString("command", "destroy");
+    api->onMessage({ { "janus", "success" } }, destroy);
+
+    // nothing is left waiting, the next query goes out again
+    EXPECT_CALL(*this->_transport, send(IsJanusMessage("message"), _)).Times(1);
+    api->onQuery(query, Bundle::create(), "videoroom");
+  }
+
+  TEST_F(JanusApiTest, shouldBypassTheQueryCacheOnRequest) {
+    auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
+    api->init(this->_conf, this->_platform, this->_delegate);
+
+    nlohmann::json query = {
+      { "body", { { "request", "list" } } }
+    };
+
+    auto first = Bundle::create();
+    first->setBool("cache", false);
+    auto second = Bundle::create();
+    second->setBool("cache", false);
+
+    EXPECT_CALL(*this->_transport, send(IsJanusMessage("message"), _)).Times(2);
+
+    api->onQuery(query, first, "videoroom");
+    api->onQuery(query, second, "videoroom");
+  }
+
   TEST_F(JanusApiTest, shouldOverrideTHeHandleIdWithContext) {
     auto api = std::make_shared<JanusApi>(this->_random, this->_factory);
 
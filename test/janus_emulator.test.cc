@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "emulator/janus_emulator.h"
+#include "janus/http.h"
+
+namespace Janus {
+
+  namespace {
+
+    int connectTo(int port) {
+      auto client = socket(AF_INET, SOCK_STREAM, 0);
+
+      sockaddr_in address;
+      std::memset(&address, 0, sizeof(address));
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      address.sin_port = htons(port);
+      connect(client, (sockaddr*) &address, sizeof(address));
+
+      return client;
+    }
+
+    std::string readUntil(int client, const std::string& terminator) {
+      std::string data;
+      char byte;
+      while(data.find(terminator) == std::string::npos && recv(client, &byte, 1, 0) == 1) {
+        data += byte;
+      }
+
+      return data;
+    }
+
+    void sendText(int client, const std::string& text) {
+      std::string frame;
+      frame += (char) 0x81;
+      frame += (char) (0x80 | 126);
+      frame += (char) ((text.size() >> 8) & 0xFF);
+      frame += (char) (text.size() & 0xFF);
+
+      const char mask[4] = { 0x12, 0x34, 0x56, 0x78 };
+      frame.append(mask, 4);
+      for(size_t i = 0; i < text.size(); i++) {
+        frame += (char) (text[i] ^ mask[i % 4]);
+      }
+
+      send(client, frame.data(), frame.size(), 0);
+    }
+
+    nlohmann::json receiveText(int client) {
+      unsigned char header[2];
+      recv(client, header, 2, MSG_WAITALL);
+
+      size_t length = header[1] & 0x7F;
+      if(length == 126) {
+        unsigned char extended[2];
+        recv(client, extended, 2, MSG_WAITALL);
+        length = (extended[0] << 8) | extended[1];
+      }
+
+      std::string payload(length, '\0');
+      recv(client, &payload[0], length, MSG_WAITALL);
+
+      return nlohmann::json::parse(payload);
+    }
+
+  }
+
+  class JanusEmulatorTest : public testing::Test {
+    protected:
+      void SetUp() override {
+        this->_emulator = std::make_shared<JanusEmulator>();
+        this->_emulator->gateway()->longPollTimeout(200);
+        this->_emulator->start();
+      }
+
+      void TearDown() override {
+        this->_emulator->stop();
+      }
+
+      std::shared_ptr<JanusEmulator> _emulator;
+  };
+
+  TEST_F(JanusEmulatorTest, shouldServeTheHttpApi) {
+    EXPECT_GT(this->_emulator->port(), 0);
+
+    HttpImpl http(this->_emulator->url());
+
+    auto created = http.post("", "{\"janus\":\"create\",\"transaction\":\"create\"}");
+    EXPECT_EQ(created->status(), 200);
+
+    auto sessionId = nlohmann::json::parse(created->body())["data"]["id"].get<int64_t>();
+    auto path = "/" + std::to_string(sessionId);
+
+    auto attached = nlohmann::json::parse(http.post(path, "{\"janus\":\"attach\",\"transaction\":\"attach\",\"plugin\":\"janus.plugin.echotest\"}")->body());
+    EXPECT_EQ(attached["janus"], "success");
+
+    auto handleId = attached["data"]["id"].get<int64_t>();
+    nlohmann::json message = { { "janus", "message" }, { "transaction", "message" }, { "handle_id", handleId }, { "body", { { "audio", true } } } };
+    EXPECT_EQ(nlohmann::json::parse(http.post(path, message.dump())->body())["janus"], "ack");
+
+    auto event = nlohmann::json::parse(http.get(path)->body());
+    EXPECT_EQ(event["janus"], "event");
+    EXPECT_EQ(event["sender"], handleId);
+
+    EXPECT_EQ(nlohmann::json::parse(http.get(path)->body())["janus"], "keepalive");
+  }
+
+  TEST_F(JanusEmulatorTest, shouldAnswerTheServerInfo) {
+    HttpImpl http(this->_emulator->url());
+
+    auto info = nlohmann::json::parse(http.get("/info")->body());
+    EXPECT_EQ(info["janus"], "server_info");
+  }
+
+  TEST_F(JanusEmulatorTest, shouldServeTheWebSocketApi) {
+    auto client = connectTo(this->_emulator->port());
+
+    std::string upgrade =
+      "GET /janus HTTP/1.1\r\n"
+      "Host: 127.0.0.1\r\n"
+      "Upgrade: websocket\r\n"
+      "Connection: Upgrade\r\n"
+      "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+      "Sec-WebSocket-Protocol: janus-protocol\r\n"
+      "Sec-WebSocket-Version: 13\r\n"
+      "\r\n";
+    send(client, upgrade.data(), upgrade.size(), 0);
+
+    auto handshake = readUntil(client, "\r\n\r\n");
+    EXPECT_NE(handshake.find("101 Switching Protocols"), std::string::npos);
+    EXPECT_NE(handshake.find("Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo="), std::string::npos);
+    EXPECT_NE(handshake.find("Sec-WebSocket-Protocol: janus-protocol"), std::string::npos);
+
+    sendText(client, "{\"janus\":\"create\",\"transaction\":\"create\"}");
+    auto sessionId = receiveText(client)["data"]["id"].get<int64_t>();
+
+    nlohmann::json attach = { { "janus", "attach" }, { "transaction", "attach" }, { "session_id", sessionId }, { "plugin", "janus.plugin.echotest" } };
+    sendText(client, attach.dump());
+    auto handleId = receiveText(client)["data"]["id"].get<int64_t>();
+
+    nlohmann::json message = { { "janus", "message" }, { "transaction", "message" }, { "session_id", sessionId }, { "handle_id", handleId }, { "body", { { "audio", true } } } };
+    sendText(client, message.dump());
+    EXPECT_EQ(receiveText(client)["janus"], "ack");
+
+    auto event = receiveText(client);
+    EXPECT_EQ(event["janus"], "event");
+    EXPECT_EQ(event["transaction"], "message");
+
+    close(client);
+  }
+
+}
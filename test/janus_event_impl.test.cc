@@ -44,6 +44,23 @@ namespace Janus {
     EXPECT_EQ(data->getList("my list").size(), 0);
   }
 
+  TEST_F(JanusEventImplTest, shouldReturnDefaultsOnTypeMismatch) {
+    nlohmann::json content = {
+      { "leaving", "ok" },
+      { "my int", 420 },
+      { "my string", "a string" }
+    };
+
+    auto evt = std::make_shared<JanusEventImpl>(69, content);
+    auto data = evt->data();
+
+    EXPECT_EQ(data->getInt("leaving", 69), 69);
+    EXPECT_EQ(data->getString("my int", "default"), "default");
+    EXPECT_EQ(data->getBool("my string", false), false);
+    EXPECT_EQ(data->getObject("my int")->getInt("my int", 69), 69);
+    EXPECT_EQ(data->getList("my string").size(), 0);
+  }
+
   TEST_F(JanusEventImplTest, shouldParseTheJsep) {
     nlohmann::json content = nlohmann::json::object();
     nlohmann::json offerMsg = {
@@ -66,6 +83,21 @@ namespace Janus {
     EXPECT_EQ(answer->type(), SdpType::ANSWER);
   }
 
+  TEST_F(JanusEventImplTest, shouldShareTheDescriptionOfTheJsep) {
+    nlohmann::json content = nlohmann::json::object();
+    nlohmann::json offerMsg = {
+      { "type", "offer" },
+      { "sdp", "v=0\r\nm=audio 9 RTP/AVP 0\r\n" }
+    };
+
+    auto evt = std::make_shared<JanusEventImpl>(69, content, offerMsg);
+    auto description = descriptionOf(evt->jsep());
+
+    EXPECT_EQ(description, descriptionOf(evt->jsep()));
+    EXPECT_EQ(description->str().data(), descriptionOf(evt->jsep())->str().data());
+    EXPECT_EQ(description->mediaCount(), 1u);
+  }
+
   TEST_F(JanusEventImplTest, shouldReturnNullOnEmptyJsep) {
     nlohmann::json content = nlohmann::json::object();
 
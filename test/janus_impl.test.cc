@@ -54,6 +54,14 @@ namespace Janus {
     janus->dispatch("my command", this->_payload);
   }
 
+  TEST_F(JanusImplTest, shouldDelegateDispatchBatchToProtocol) {
+    std::vector<std::shared_ptr<Bundle>> payloads = { this->_payload };
+    EXPECT_CALL(*this->_protocol, dispatchBatch(Eq(payloads)));
+
+    auto janus = std::make_shared<JanusImpl>(this->_conf, this->_platform, this->_delegate);
+    janus->dispatchBatch(payloads);
+  }
+
   TEST_F(JanusImplTest, shouldDelegateTheCloseCommandToProtocol) {
     EXPECT_CALL(*this->_protocol, close());
 
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <future>
+#include <thread>
+
+#include "janus/metrics_impl.h"
+#include "janus/transport.h"
+
+#include "mocks/transport_delegate.h"
+#include "mocks/http_factory.h"
+#include "mocks/http.h"
+#include "mocks/async.h"
+
+using testing::NiceMock;
+using testing::Return;
+using testing::Invoke;
+using testing::_;
+
+namespace Janus {
+
+  class MetricsTest : public testing::Test {
+    protected:
+      void SetUp() override {
+        Metrics::reset();
+      }
+
+      int64_t _counter(const std::string& name) {
+        auto snapshot = Metrics::snapshot();
+        auto entry = snapshot.counters.find(name);
+
+        return entry != snapshot.counters.end() ? entry->second : 0;
+      }
+
+      int64_t _gauge(const std::string& name) {
+        auto snapshot = Metrics::snapshot();
+        auto entry = snapshot.gauges.find(name);
+
+        return entry != snapshot.gauges.end() ? entry->second : 0;
+      }
+
+      MetricHistogram _histogram(const std::string& name) {
+        for(auto& histogram : Metrics::snapshot().histograms) {
+          if(histogram.name == name) {
+            return histogram;
+          }
+        }
+
+        return MetricHistogram(name, 0, 0, 0, 0, 0, 0, 0, 0);
+      }
+  };
+
+  TEST_F(MetricsTest, shouldCountAndResetTheCounters) {
+    auto& counter = MetricsRegistry::instance().counter("test.counter");
+    counter.add();
+    counter.add(41);
+
+    EXPECT_EQ(this->_counter("test.counter"), 42);
+    EXPECT_EQ(&counter, &MetricsRegistry::instance().counter("test.counter"));
+
+    Metrics::reset();
+    EXPECT_EQ(this->_counter("test.counter"), 0);
+  }
+
+  TEST_F(MetricsTest, shouldKeepTheGaugesAcrossAReset) {
+    auto& gauge = MetricsRegistry::instance().gauge("test.gauge");
+    gauge.set(10);
+    gauge.add(-3);
+
+    Metrics::reset();
+    EXPECT_EQ(this->_gauge("test.gauge"), 7);
+  }
+
+  TEST_F(MetricsTest, shouldBucketTheValuesWithinTheirPrecision) {
+    for(int64_t value : { (int64_t) 0, (int64_t) 63, (int64_t) 64, (int64_t) 1000, (int64_t) 123456789, INT64_MAX }) {
+      auto bucket = MetricHistogramImpl::bucketOf(value);
+      ASSERT_LT(bucket, METRICS_HISTOGRAM_BUCKETS) << value;
+
+      auto highest = MetricHistogramImpl::highestOf(bucket);
+      EXPECT_GE(highest, value);
+      EXPECT_LE(highest - value, value / 32) << value;
+    }
+
+    EXPECT_LT(MetricHistogramImpl::bucketOf(100), MetricHistogramImpl::bucketOf(200));
+  }
+
+  TEST_F(MetricsTest, shouldTellThePercentilesOfAHistogram) {
+    auto& histogram = MetricsRegistry::instance().histogram("test.histogram");
+    for(int64_t value = 1; value <= 1000; value++) {
+      histogram.record(value);
+    }
+    histogram.record(-5);
+
+    auto snapshot = this->_histogram("test.histogram");
+    EXPECT_EQ(snapshot.count, 1001);
+    EXPECT_EQ(snapshot.min, 0);
+    EXPECT_EQ(snapshot.max, 1000);
+    EXPECT_NEAR(snapshot.mean, 500.0, 1.0);
+    EXPECT_NEAR(snapshot.p50, 500, 500 / 32);
+    EXPECT_NEAR(snapshot.p90, 900, 900 / 32);
+    EXPECT_NEAR(snapshot.p99, 990, 990 / 32);
+    EXPECT_EQ(snapshot.p999, 1000);
+
+    Metrics::reset();
+    snapshot = this->_histogram("test.histogram");
+    EXPECT_EQ(snapshot.count, 0);
+    EXPECT_EQ(snapshot.p50, 0);
+  }
+
+  TEST_F(MetricsTest, shouldCountFromManyThreads) {
+    auto& counter = MetricsRegistry::instance().counter("test.threads");
+    auto& histogram = MetricsRegistry::instance().histogram("test.threads");
+
+    std::vector<std::thread> threads;
+    for(int index = 0; index < 4; index++) {
+      threads.emplace_back([&counter, &histogram] {
+        for(int64_t value = 0; value < 10000; value++) {
+          counter.add();
+          histogram.record(value);
+        }
+      });
+    }
+
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    EXPECT_EQ(this->_counter("test.threads"), 40000);
+    EXPECT_EQ(this->_histogram("test.threads").count, 40000);
+    EXPECT_EQ(this->_histogram("test.threads").max, 9999);
+  }
+
+  TEST_F(MetricsTest, shouldMeasureTheHttpTraffic) {
+    auto delegate = std::make_shared<NiceMock<TransportDelegateMock>>();
+
+    nlohmann::json reply = { { "janus", "ack" }, { "transaction", "a transaction" } };
+    auto client = std::make_shared<NiceMock<HttpMock>>();
+    ON_CALL(*client, post(_, _)).WillByDefault(Return(std::make_shared<HttpResponse>(200, reply.dump())));
+
+    auto factory = std::make_shared<NiceMock<HttpFactoryMock>>();
+    ON_CALL(*factory, create("http://base")).WillByDefault(Return(client));
+
+    auto async = std::make_shared<NiceMock<AsyncMock>>();
+    ON_CALL(*async, submit(_)).WillByDefault(Invoke([](Task task) {
+      task();
+    }));
+
+    nlohmann::json message = { { "janus", "message" }, { "transaction", "a transaction" } };
+    auto transport = std::make_shared<HttpTransport>("http://base", delegate, factory, async);
+    transport->send(message, Bundle::create());
+    transport->sendBatch({ TransportMessage(message, Bundle::create()), TransportMessage(message, Bundle::create()) });
+
+    EXPECT_EQ(this->_counter(METRIC_HTTP_REQUESTS), 3);
+    EXPECT_EQ(this->_counter(METRIC_HTTP_BYTES_OUT), 3 * (int64_t) message.dump().size());
+    EXPECT_EQ(this->_counter(METRIC_HTTP_BYTES_IN), 3 * (int64_t) reply.dump().size());
+    EXPECT_EQ(this->_counter(METRIC_HTTP_ERRORS), 0);
+    EXPECT_EQ(this->_histogram(METRIC_HTTP_REQUEST_US).count, 3);
+  }
+
+  TEST_F(MetricsTest, shouldTrackTheDepthOfTheQueue) {
+    auto depth = this->_gauge(METRIC_ASYNC_QUEUE_DEPTH);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::promise<void> done;
+
+    {
+      AsyncImpl async;
+
+      // both the workers block, so the third task waits in the queue
+      async.submit([released] { released.wait(); });
+      async.submit([released] { released.wait(); });
+      async.submit([&done] { done.set_value(); });
+      async.submit([] {});
+
+      EXPECT_GE(this->_gauge(METRIC_ASYNC_QUEUE_DEPTH), depth + 1);
+
+      release.set_value();
+      done.get_future().wait();
+    }
+
+    EXPECT_EQ(this->_gauge(METRIC_ASYNC_QUEUE_DEPTH), depth);
+    EXPECT_GE(this->_counter(METRIC_ASYNC_TASKS), 4);
+    EXPECT_GE(this->_histogram(METRIC_ASYNC_QUEUE_US).count, 3);
+  }
+
+}
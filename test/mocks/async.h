@@ -9,4 +9,9 @@ namespace Janus {
       MOCK_METHOD1(submit, void(Task task));
   };
 
+  class SchedulerMock : public Scheduler {
+    public:
+      MOCK_METHOD2(post, void(int64_t delay, const Task& task));
+  };
+
 }
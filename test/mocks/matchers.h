@@ -1,5 +1,9 @@
 #pragma once
 
+#include <algorithm>
+
+#include "janus/video_encoding.hpp"
+
 namespace testing {
 
   MATCHER_P(IsJsonEq, value, "") {
@@ -39,7 +43,12 @@ namespace testing {
       arg.video.width == value.video.width &&
       arg.video.height == value.video.height &&
       arg.video.fps == value.video.fps &&
-      arg.video.camera == value.video.camera;
+      arg.video.camera == value.video.camera &&
+      arg.ice_candidate_pool_size == value.ice_candidate_pool_size &&
+      arg.video.encodings.size() == value.video.encodings.size() &&
+      std::equal(arg.video.encodings.begin(), arg.video.encodings.end(), value.video.encodings.begin(), [](const Janus::VideoEncoding& a, const Janus::VideoEncoding& b) {
+        return a.rid == b.rid && a.scale_down == b.scale_down && a.max_bitrate == b.max_bitrate && a.max_fps == b.max_fps;
+      });
   }
 
 }
@@ -8,6 +8,7 @@ namespace Janus {
   class PeerMock : public Peer {
     public:
       MOCK_METHOD0(close, void());
+      MOCK_METHOD1(prepare, void(const Constraints & constraints));
       MOCK_METHOD2(createOffer, void(const Constraints & constraints, const std::shared_ptr<Bundle>& context));
       MOCK_METHOD2(createAnswer, void(const Constraints & constraints, const std::shared_ptr<Bundle>& context));
       MOCK_METHOD2(setLocalDescription, void(SdpType type, const std::string & sdp));
@@ -10,6 +10,7 @@ namespace Janus {
       MOCK_METHOD0(protocol, std::shared_ptr<Protocol>());
 
       MOCK_METHOD0(peerFactory, std::shared_ptr<PeerFactory>());
+      MOCK_METHOD1(drainCallbacks, int32_t(int64_t timeoutMs));
 
       MOCK_METHOD2(pluginFactory, void(const std::string& id, const std::shared_ptr<PluginFactory>& factory));
       MOCK_METHOD3(plugin, std::shared_ptr<Plugin>(const std::string& id, int64_t handleId, const std::shared_ptr<Protocol>& owner));
@@ -8,6 +8,9 @@ namespace Janus {
     public:
       MOCK_METHOD2(onCommandResult, void(const nlohmann::json& body, const std::shared_ptr<Bundle>& context));
       MOCK_METHOD2(onPluginEvent, void(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context));
+      MOCK_METHOD2(onPluginError, void(const JanusError& error, const std::shared_ptr<Bundle>& context));
+      MOCK_METHOD3(onQuery, void(const nlohmann::json& body, const std::shared_ptr<Bundle>& context, const std::string& scope));
+      MOCK_METHOD1(invalidateQueries, void(const std::string& scope));
   };
 
 };
@@ -11,6 +11,7 @@ namespace Janus {
       MOCK_METHOD0(hangup, void());
       MOCK_METHOD3(init, void(const std::shared_ptr<JanusConf>& conf, const std::shared_ptr<Platform>& platform, const std::shared_ptr<ProtocolDelegate>& delegate));
       MOCK_METHOD2(dispatch, void(const std::string& command, const std::shared_ptr<Bundle>& payload));
+      MOCK_METHOD1(dispatchBatch, void(const std::vector<std::shared_ptr<Bundle>>& payloads));
 
       MOCK_METHOD2(onOffer, void(const std::string& sdp, const std::shared_ptr<Bundle>& context));
       MOCK_METHOD2(onAnswer, void(const std::string& sdp, const std::shared_ptr<Bundle>& context));
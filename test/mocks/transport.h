@@ -8,6 +8,7 @@ namespace Janus {
     public:
       MOCK_METHOD0(type, TransportType());
       MOCK_METHOD2(send, void(const nlohmann::json& message, const std::shared_ptr<Bundle>& context));
+      MOCK_METHOD1(sendBatch, void(const std::vector<TransportMessage>& messages));
       MOCK_METHOD1(sessionId, void(const std::string& sessionId));
       MOCK_METHOD0(close, void());
   };
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "janus/peer_pool.h"
+
+#include "mocks/async.h"
+#include "mocks/peer.h"
+#include "mocks/peer_factory.h"
+#include "mocks/protocol.h"
+
+using testing::NiceMock;
+using testing::Return;
+using testing::_;
+using testing::Eq;
+using testing::Invoke;
+using testing::SaveArg;
+using testing::DoAll;
+
+namespace Janus {
+
+  class PeerPoolTest : public testing::Test {
+    protected:
+      void SetUp() override {
+        this->_owner = std::make_shared<NiceMock<ProtocolMock>>();
+        this->_factory = std::make_shared<NiceMock<PeerFactoryMock>>();
+
+        this->_async = std::make_shared<NiceMock<AsyncMock>>();
+        ON_CALL(*this->_async, submit(_)).WillByDefault(Invoke([this](Task task) {
+          this->_tasks.push_back(task);
+        }));
+      }
+
+      void _run() {
+        auto tasks = this->_tasks;
+        this->_tasks.clear();
+
+        for(auto& task : tasks) {
+          task();
+        }
+      }
+
+      std::shared_ptr<NiceMock<ProtocolMock>> _owner;
+      std::shared_ptr<NiceMock<PeerFactoryMock>> _factory;
+      std::shared_ptr<NiceMock<AsyncMock>> _async;
+      std::vector<Task> _tasks;
+  };
+
+  TEST_F(PeerPoolTest, shouldCreateTheWarmPeersInBackground) {
+    auto first = std::make_shared<NiceMock<PeerMock>>();
+    auto second = std::make_shared<NiceMock<PeerMock>>();
+
+    EXPECT_CALL(*this->_factory, create(-1, _)).WillOnce(Return(first)).WillOnce(Return(second));
+    auto pool = std::make_shared<PeerPool>(this->_factory, this->_owner, this->_async, 2);
+
+    EXPECT_EQ(this->_tasks.size(), 2u);
+    EXPECT_EQ(pool->stats().idle, 0u);
+
+    this->_run();
+
+    EXPECT_EQ(pool->stats().idle, 2u);
+  }
+
+  TEST_F(PeerPoolTest, shouldBindAWarmPeerToTheHandle) {
+    auto warm = std::make_shared<NiceMock<PeerMock>>();
+    auto refill = std::make_shared<NiceMock<PeerMock>>();
+
+    std::shared_ptr<Protocol> binding;
+    EXPECT_CALL(*this->_factory, create(-1, _)).WillOnce(DoAll(SaveArg<1>(&binding), Return(warm))).WillOnce(Return(refill));
+    auto pool = std::make_shared<PeerPool>(this->_factory, this->_owner, this->_async, 1);
+    this->_run();
+
+    auto peer = pool->create(1234, this->_owner);
+    EXPECT_EQ(peer, warm);
+
+    EXPECT_CALL(*this->_owner, onIceCandidate("mid", 0, "candidate", 1234));
+    EXPECT_CALL(*this->_owner, onIceCompleted(1234));
+    binding->onIceCandidate("mid", 0, "candidate", -1);
+    binding->onIceCompleted(-1);
+
+    this->_run();
+
+    auto stats = pool->stats();
+    EXPECT_EQ(stats.idle, 1u);
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 0);
+  }
+
+  TEST_F(PeerPoolTest, shouldFallBackToTheFactoryWhenEmpty) {
+    auto peer = std::make_shared<NiceMock<PeerMock>>();
+
+    EXPECT_CALL(*this->_factory, create(-1, _)).Times(0);
+    EXPECT_CALL(*this->_factory, create(1234, Eq(this->_owner))).WillOnce(Return(peer));
+    auto pool = std::make_shared<PeerPool>(this->_factory, this->_owner, this->_async, 1);
+
+    EXPECT_EQ(pool->create(1234, this->_owner), peer);
+
+    auto stats = pool->stats();
+    EXPECT_EQ(stats.hits, 0);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.hitRate(), 0);
+    EXPECT_EQ(this->_tasks.size(), 1u);
+  }
+
+  TEST_F(PeerPoolTest, shouldCloseTheExtraPeersWhenShrinking) {
+    auto first = std::make_shared<NiceMock<PeerMock>>();
+    auto second = std::make_shared<NiceMock<PeerMock>>();
+
+    EXPECT_CALL(*this->_factory, create(-1, _)).WillOnce(Return(first)).WillOnce(Return(second));
+    auto pool = std::make_shared<PeerPool>(this->_factory, this->_owner, this->_async, 2);
+    this->_run();
+
+    EXPECT_CALL(*first, close()).Times(0);
+    EXPECT_CALL(*second, close());
+    pool->resize(1);
+    testing::Mock::VerifyAndClearExpectations(first.get());
+
+    EXPECT_EQ(pool->stats().idle, 1u);
+    EXPECT_EQ(this->_tasks.size(), 0u);
+  }
+
+  TEST_F(PeerPoolTest, shouldCloseAPeerCreatedAfterThePoolIsGone) {
+    auto peer = std::make_shared<NiceMock<PeerMock>>();
+
+    EXPECT_CALL(*this->_factory, create(-1, _)).WillOnce(Return(peer));
+    EXPECT_CALL(*peer, close());
+
+    auto pool = std::make_shared<PeerPool>(this->_factory, this->_owner, this->_async, 1);
+    pool = nullptr;
+
+    this->_run();
+  }
+
+}
@@ -1,10 +1,16 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
 #include "janus/platform_impl.h"
 
 #include "janus/janus_plugins.hpp"
 #include "janus/janus_api.h"
+#include "janus/platform_options.hpp"
+#include "janus/trace.h"
 
 #include "mocks/protocol.h"
 #include "mocks/peer_factory.h"
@@ -79,4 +85,38 @@ namespace Janus {
     EXPECT_NE(platform, nullptr);
   }
 
+  TEST_F(PlatformTest, shouldRecordATraceWhenAsked) {
+    auto path = testing::TempDir() + "janus_trace_platform.jsonl";
+    {
+      std::ofstream file(path);
+      file << "{\"t\":0,\"d\":\"out\",\"s\":0,\"m\":{\"janus\":\"create\"}}\n";
+    }
+
+    auto options = Bundle::create();
+    options->setString(PlatformOptions::TRACE, path);
+    auto platform = Platform::createWith(this->_factory, options);
+
+    EXPECT_NE(platform, nullptr);
+    EXPECT_EQ(readTrace(path).size(), 0u);
+
+    std::remove(path.c_str());
+  }
+
+  TEST_F(PlatformTest, shouldQueueTheCallbacksForTheAppWhenAsked) {
+    auto options = Bundle::create();
+    options->setString(PlatformOptions::CALLBACKS, PlatformOptions::CALLBACKS_QUEUE);
+    auto queued = Platform::createWith(this->_factory, options);
+
+    // nothing came back yet, the drain waits for it
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(queued->drainCallbacks(20), 0);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    // the callbacks have a thread of their own, there is nothing to drain
+    start = std::chrono::steady_clock::now();
+    auto threaded = Platform::create(this->_factory);
+    EXPECT_EQ(threaded->drainCallbacks(1000), 0);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+  }
+
 }
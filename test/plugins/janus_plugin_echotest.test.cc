@@ -20,6 +20,7 @@ using testing::IsJsonEq;
 using testing::Return;
 using testing::Eq;
 using testing::InSequence;
+using testing::_;
 
 namespace Janus {
 
@@ -68,6 +69,33 @@ namespace Janus {
     plugin->command(JanusCommands::CALL, bundle);
   }
 
+  TEST_F(JanusPluginEchotestTest, shouldCallWithThePreparedPeer) {
+    auto bundle = Bundle::create();
+    auto constraints = ConstraintsBuilder::create()->ice_candidate_pool(2)->build();
+    bundle->setConstraints(constraints);
+
+    {
+      InSequence sequence;
+
+      EXPECT_CALL(*this->_peerFactory, create(69, Eq(this->_owner))).WillOnce(Return(this->_peer));
+      EXPECT_CALL(*this->_peer, prepare(HasConstraints(constraints))).Times(1);
+      EXPECT_CALL(*this->_peer, createOffer(_, bundle)).Times(1);
+    }
+    auto plugin = std::make_shared<JanusPluginEchotest>(69, this->_delegate, this->_peerFactory, this->_owner);
+
+    plugin->command(JanusCommands::PREPARE, bundle);
+    plugin->command(JanusCommands::PREPARE, bundle);
+    plugin->command(JanusCommands::CALL, bundle);
+  }
+
+  TEST_F(JanusPluginEchotestTest, shouldCloseThePreparedPeerOnClose) {
+    EXPECT_CALL(*this->_peer, close()).Times(1);
+    auto plugin = std::make_shared<JanusPluginEchotest>(69, this->_delegate, this->_peerFactory, this->_owner);
+
+    plugin->command(JanusCommands::PREPARE, Bundle::create());
+    plugin->onClose();
+  }
+
   TEST_F(JanusPluginEchotestTest, shouldUpdateTheCurrentSession) {
     nlohmann::json msg = {
       { "body", { { "audio", false }, { "video", false } } }
@@ -117,6 +145,32 @@ namespace Janus {
     plugin->onOffer("the sdp", context);
   }
 
+  TEST_F(JanusPluginEchotestTest, shouldRewriteTheOfferBeforeUsingIt) {
+    auto offer = "v=0\r\nm=audio 9 UDP/TLS/RTP/SAVPF 111 0\r\na=rtpmap:111 opus/48000/2\r\na=rtpmap:0 PCMU/8000\r\n";
+    auto rewritten = "v=0\r\nm=audio 9 UDP/TLS/RTP/SAVPF 0 111\r\nb=AS:32\r\nb=TIAS:32000\r\na=rtpmap:111 opus/48000/2\r\na=rtpmap:0 PCMU/8000\r\n";
+
+    nlohmann::json msg = {
+      { "body", { { "audio", true }, { "video", true } } },
+      { "jsep", { { "type", "offer" }, { "sdp", rewritten } } }
+    };
+
+    auto context = Bundle::create();
+
+    EXPECT_CALL(*this->_peer, setLocalDescription(SdpType::OFFER, rewritten));
+    EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(msg), context));
+    auto plugin = std::make_shared<JanusPluginEchotest>(69, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto transform = Bundle::create();
+    transform->setString("audio_codecs", "pcmu");
+    transform->setInt("audio_bandwidth", 32);
+    plugin->command(JanusCommands::SDP_TRANSFORM, transform);
+
+    auto bundle = Bundle::create();
+    plugin->command(JanusCommands::CALL, bundle);
+
+    plugin->onOffer(offer, context);
+  }
+
   TEST_F(JanusPluginEchotestTest, shouldSetTheRemoteDescriptionOnJsepEvent) {
     EXPECT_CALL(*this->_peer, setRemoteDescription(SdpType::ANSWER, "the sdp"));
 
@@ -143,7 +197,21 @@ namespace Janus {
 
     auto bundle = Bundle::create();
     plugin->command(JanusCommands::CALL, bundle);
-    plugin->onHangup("my reason");
+    plugin->onHangup("my reason", Bundle::create());
+  }
+
+  TEST_F(JanusPluginEchotestTest, shouldKeepThePeerOnTheHangupOfAnotherHandle) {
+    EXPECT_CALL(*this->_peer, close()).Times(0);
+    auto plugin = std::make_shared<JanusPluginEchotest>(69, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto bundle = Bundle::create();
+    plugin->command(JanusCommands::CALL, bundle);
+
+    auto context = Bundle::create();
+    context->setInt("handleId", 70);
+    plugin->onHangup("my reason", context);
+
+    testing::Mock::VerifyAndClearExpectations(this->_peer.get());
   }
 
   TEST_F(JanusPluginEchotestTest, shouldAvoidSegFaultOnClose) {
@@ -17,6 +17,8 @@ using testing::IsJsonEq;
 using testing::HasConstraints;
 using testing::InSequence;
 using testing::Eq;
+using testing::BundleHasInt;
+using testing::_;
 
 namespace Janus {
 
@@ -45,11 +47,24 @@ namespace Janus {
 
     auto bundle = Bundle::create();
 
-    EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(msg), bundle));
+    EXPECT_CALL(*this->_delegate, onQuery(IsJsonEq(msg), bundle, "streaming"));
     auto plugin = std::make_shared<JanusPluginStreaming>(69, this->_delegate, this->_peerFactory, this->_owner);
     plugin->command(JanusCommands::LIST, bundle);
   }
 
+  TEST_F(JanusPluginStreamingTest, shouldSendAnInfoMessage) {
+    nlohmann::json msg = {
+      { "body", { { "request", "info" }, { "id", 42069 } } }
+    };
+
+    auto bundle = Bundle::create();
+    bundle->setInt("id", 42069);
+
+    EXPECT_CALL(*this->_delegate, onQuery(IsJsonEq(msg), bundle, "streaming/42069"));
+    auto plugin = std::make_shared<JanusPluginStreaming>(69, this->_delegate, this->_peerFactory, this->_owner);
+    plugin->command(JanusCommands::INFO, bundle);
+  }
+
   TEST_F(JanusPluginStreamingTest, shouldSendAWatchMessage) {
     nlohmann::json msg = {
       { "body", {
@@ -175,6 +190,178 @@ namespace Janus {
     plugin->command(JanusCommands::PAUSE, bundle);
   }
 
+  TEST_F(JanusPluginStreamingTest, shouldSendASwitchMessage) {
+    nlohmann::json msg = {
+      { "body", { { "request", "switch" }, { "id", 42070 } } }
+    };
+
+    auto watchBundle = Bundle::create();
+    watchBundle->setInt("id", 42069);
+
+    auto plugin = std::make_shared<JanusPluginStreaming>(69, this->_delegate, this->_peerFactory, this->_owner);
+    plugin->command(JanusCommands::WATCH, watchBundle);
+
+    auto bundle = Bundle::create();
+    bundle->setInt("id", 42070);
+
+    EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(msg), bundle));
+    plugin->command(JanusCommands::SWITCH, bundle);
+
+    EXPECT_EQ(watchBundle->getInt("id", -1), 42070);
+  }
+
+  TEST_F(JanusPluginStreamingTest, shouldReuseThePeerOnRenegotiation) {
+    nlohmann::json jsep = {
+      { "type", "offer" },
+      { "sdp", "the sdp" }
+    };
+
+    EXPECT_CALL(*this->_peerFactory, create(69, _)).Times(1);
+    EXPECT_CALL(*this->_peer, setRemoteDescription(SdpType::OFFER, "the sdp")).Times(2);
+
+    auto plugin = std::make_shared<JanusPluginStreaming>(69, this->_delegate, this->_peerFactory, this->_owner);
+    plugin->command(JanusCommands::WATCH, Bundle::create());
+
+    plugin->onEvent(std::make_shared<JanusEventImpl>(69, nlohmann::json::object(), jsep), Bundle::create());
+    plugin->onEvent(std::make_shared<JanusEventImpl>(69, nlohmann::json::object(), jsep), Bundle::create());
+  }
+
+  TEST_F(JanusPluginStreamingTest, shouldWatchConcurrentlyOnANewHandle) {
+    nlohmann::json watchMsg = {
+      { "body", {
+        { "request", "watch" },
+        { "id", 42070 },
+        { "offer_audio", true },
+        { "offer_video", true },
+        { "offer_data", true }
+      } }
+    };
+    nlohmann::json startMsg = {
+      { "body", { { "request", "start" } } },
+      { "jsep", { { "type", "answer" }, { "sdp", "the answer" } } }
+    };
+    nlohmann::json jsep = {
+      { "type", "offer" },
+      { "sdp", "the sdp" }
+    };
+
+    auto concurrentPeer = std::make_shared<NiceMock<PeerMock>>();
+    ON_CALL(*this->_peerFactory, create(70, Eq(this->_owner))).WillByDefault(Return(concurrentPeer));
+
+    auto plugin = std::make_shared<JanusPluginStreaming>(69, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto bundle = Bundle::create();
+    bundle->setInt("id", 42070);
+    bundle->setBool("concurrent", true);
+
+    EXPECT_CALL(*this->_owner, dispatch(JanusCommands::ATTACH, bundle));
+    plugin->command(JanusCommands::WATCH, bundle);
+
+    bundle->setString("command", JanusCommands::ATTACH);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", 70 } } }
+    };
+
+    {
+      InSequence seq;
+      EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(watchMsg), BundleHasInt("handleId", 70)));
+      EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(startMsg), BundleHasInt("handleId", 70)));
+    }
+    EXPECT_CALL(*concurrentPeer, setRemoteDescription(SdpType::OFFER, "the sdp"));
+    EXPECT_CALL(*concurrentPeer, setLocalDescription(SdpType::ANSWER, "the answer"));
+    EXPECT_CALL(*this->_peer, setRemoteDescription(_, _)).Times(0);
+
+    plugin->onEvent(std::make_shared<JanusEventImpl>(70, attachEvent), bundle);
+
+    auto context = Bundle::create();
+    plugin->onEvent(std::make_shared<JanusEventImpl>(70, nlohmann::json::object(), jsep), context);
+    plugin->onAnswer("the answer", context);
+
+    auto stop = Bundle::create();
+
+    EXPECT_CALL(*this->_delegate, onCommandResult(_, stop));
+    EXPECT_CALL(*concurrentPeer, close());
+    EXPECT_CALL(*this->_owner, dispatch(JanusCommands::DETACH, BundleHasInt("handleId", 70)));
+
+    stop->setInt("handleId", 70);
+    plugin->command(JanusCommands::STOP, stop);
+  }
+
+  TEST_F(JanusPluginStreamingTest, shouldCloseOnlyThePeerOfTheHandleThatHungUp) {
+    nlohmann::json jsep = {
+      { "type", "offer" },
+      { "sdp", "the sdp" }
+    };
+
+    auto concurrentPeer = std::make_shared<NiceMock<PeerMock>>();
+    ON_CALL(*this->_peerFactory, create(70, Eq(this->_owner))).WillByDefault(Return(concurrentPeer));
+
+    auto plugin = std::make_shared<JanusPluginStreaming>(69, this->_delegate, this->_peerFactory, this->_owner);
+    plugin->command(JanusCommands::WATCH, Bundle::create());
+    plugin->onEvent(std::make_shared<JanusEventImpl>(69, nlohmann::json::object(), jsep), Bundle::create());
+
+    auto bundle = Bundle::create();
+    bundle->setInt("handleId", 70);
+    plugin->command(JanusCommands::WATCH, bundle);
+    plugin->onEvent(std::make_shared<JanusEventImpl>(70, nlohmann::json::object(), jsep), Bundle::create());
+
+    EXPECT_CALL(*concurrentPeer, close());
+    EXPECT_CALL(*this->_peer, close()).Times(0);
+
+    auto context = Bundle::create();
+    context->setInt("handleId", 70);
+    plugin->onHangup("my reason", context);
+
+    testing::Mock::VerifyAndClearExpectations(this->_peer.get());
+  }
+
+  TEST_F(JanusPluginStreamingTest, shouldFailTheSwitchOfAHandleWithoutWatch) {
+    auto plugin = std::make_shared<JanusPluginStreaming>(69, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto bundle = Bundle::create();
+    bundle->setInt("id", 42070);
+
+    EXPECT_CALL(*this->_delegate, onCommandResult(_, _)).Times(0);
+    EXPECT_CALL(*this->_delegate, onPluginError(testing::Field(&JanusError::code, 460), bundle));
+    plugin->command(JanusCommands::SWITCH, bundle);
+
+    // the failed switch does not start a watch either
+    EXPECT_CALL(*this->_peerFactory, create(_, _)).Times(0);
+    EXPECT_CALL(*this->_delegate, onPluginError(_, _));
+    nlohmann::json jsep = {
+      { "type", "offer" },
+      { "sdp", "the sdp" }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(69, nlohmann::json::object(), jsep), Bundle::create());
+  }
+
+  TEST_F(JanusPluginStreamingTest, shouldDropTheAnswerOfAStoppedWatch) {
+    auto plugin = std::make_shared<JanusPluginStreaming>(69, this->_delegate, this->_peerFactory, this->_owner);
+    plugin->command(JanusCommands::WATCH, Bundle::create());
+
+    EXPECT_CALL(*this->_delegate, onCommandResult(_, _)).Times(0);
+    plugin->onAnswer("the sdp", Bundle::create());
+  }
+
+  TEST_F(JanusPluginStreamingTest, shouldCloseThePeerOutsideTheWatches) {
+    nlohmann::json jsep = {
+      { "type", "offer" },
+      { "sdp", "the sdp" }
+    };
+
+    auto plugin = std::make_shared<JanusPluginStreaming>(69, this->_delegate, this->_peerFactory, this->_owner);
+    plugin->command(JanusCommands::WATCH, Bundle::create());
+    plugin->onEvent(std::make_shared<JanusEventImpl>(69, nlohmann::json::object(), jsep), Bundle::create());
+
+    // the closing peer hangs up on the same thread, the watches are free again by then
+    auto raw = plugin.get();
+    EXPECT_CALL(*this->_peer, close()).WillOnce(testing::Invoke([raw]() {
+      raw->onHangup("closed", Bundle::create());
+    }));
+    plugin->command(JanusCommands::STOP, Bundle::create());
+  }
+
   TEST_F(JanusPluginStreamingTest, shouldDelegateUnhandledEvents) {
     auto context = Bundle::create();
     auto event = std::make_shared<JanusEventImpl>(69, nlohmann::json::object());
@@ -11,6 +11,7 @@
 #include "mocks/plugin_command_delegate.h"
 #include "mocks/peer.h"
 #include "mocks/matchers.h"
+#include "mocks/async.h"
 
 using testing::NiceMock;
 using testing::IsJsonEq;
@@ -19,6 +20,7 @@ using testing::HasConstraints;
 using testing::BundleHasString;
 using testing::BundleHasInt;
 using testing::InSequence;
+using testing::IsEvent;
 using testing::_;
 
 #define TEST_PUBLISHER_ID 12345
@@ -54,7 +56,7 @@ namespace Janus {
 
     auto bundle = Bundle::create();
 
-    EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(msg), bundle));
+    EXPECT_CALL(*this->_delegate, onQuery(IsJsonEq(msg), bundle, "videoroom"));
     auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
     plugin->command(JanusCommands::LIST, bundle);
   }
@@ -67,7 +69,7 @@ namespace Janus {
     auto bundle = Bundle::create();
     bundle->setInt("room", 42069);
 
-    EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(msg), bundle));
+    EXPECT_CALL(*this->_delegate, onQuery(IsJsonEq(msg), bundle, "videoroom/42069"));
     auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
     plugin->command(JanusCommands::LISTPARTICIPANTS, bundle);
   }
@@ -121,6 +123,66 @@ namespace Janus {
     plugin->onEvent(event, context);
   }
 
+  TEST_F(JanusPluginVideoroomTest, shouldInvalidateQueriesOnParticipantsEvents) {
+    auto context = Bundle::create();
+    nlohmann::json joined = { { "videoroom", "joined" }, { "room", 1234 } };
+    nlohmann::json leaving = { { "videoroom", "event" }, { "room", 1234 }, { "leaving", 42069 } };
+    nlohmann::json talking = { { "videoroom", "talking" }, { "room", 1234 } };
+
+    // the list of rooms and the room itself, never the queries of another room or plugin
+    EXPECT_CALL(*this->_delegate, invalidateQueries("videoroom")).Times(2);
+    EXPECT_CALL(*this->_delegate, invalidateQueries("videoroom/1234")).Times(2);
+    EXPECT_CALL(*this->_delegate, onPluginEvent(_, Eq(context))).Times(3);
+
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+    plugin->onEvent(std::make_shared<JanusEventImpl>(69, joined), context);
+    plugin->onEvent(std::make_shared<JanusEventImpl>(69, leaving), context);
+    plugin->onEvent(std::make_shared<JanusEventImpl>(69, talking), context);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldNotifyRoomStateChanges) {
+    auto context = Bundle::create();
+    nlohmann::json joined = {
+      { "videoroom", "joined" },
+      { "room", 1234 },
+      { "publishers", { { { "id", 1 }, { "display", "one" } } } }
+    };
+
+    {
+      InSequence sequence;
+
+      EXPECT_CALL(*this->_delegate, onPluginEvent(IsEvent("videoroom", "room-changed"), Eq(context))).Times(1);
+      EXPECT_CALL(*this->_delegate, onPluginEvent(IsEvent("videoroom", "joined"), Eq(context))).Times(1);
+    }
+
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+    plugin->onEvent(std::make_shared<JanusEventImpl>(69, joined), context);
+
+    EXPECT_EQ(plugin->roomState()->size(), 1);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldServeTheRoomStateSnapshot) {
+    nlohmann::json joined = {
+      { "videoroom", "joined" },
+      { "room", 1234 },
+      { "publishers", { { { "id", 1 }, { "display", "one" } } } }
+    };
+
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+    plugin->onEvent(std::make_shared<JanusEventImpl>(69, joined), Bundle::create());
+
+    auto payload = Bundle::create();
+    std::shared_ptr<JanusEvent> snapshot;
+    EXPECT_CALL(*this->_delegate, onPluginEvent(_, Eq(payload))).WillOnce(testing::SaveArg<0>(&snapshot));
+
+    plugin->command(JanusCommands::PARTICIPANTS, payload);
+
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->data()->getString("videoroom", ""), "room-state");
+    EXPECT_EQ(snapshot->data()->getInt("room", -1), 1234);
+    EXPECT_EQ(snapshot->data()->getList("participants")[0]->getString("display", ""), "one");
+  }
+
   TEST_F(JanusPluginVideoroomTest, shouldCreateAnOfferOnPublish) {
     auto context = Bundle::create();
 
@@ -165,6 +227,103 @@ namespace Janus {
     plugin->onOffer("the sdp", context);
   }
 
+  TEST_F(JanusPluginVideoroomTest, shouldFlagTheSimulcastPublishing) {
+    nlohmann::json msg = {
+      { "body", { { "request", "publish" }, { "audio", true }, { "video", true }, { "data", true }, { "simulcast", true } } },
+      { "jsep", { { "type", "offer" }, { "sdp", "the sdp" } } }
+    };
+
+    auto constraints = ConstraintsBuilder::create()->encoding("f", 1.0, 1500, 30)->encoding("h", 2.0, 500, 30)->encoding("q", 4.0, 150, 15)->build();
+    auto context = Bundle::create();
+    context->setConstraints(constraints);
+
+    EXPECT_CALL(*this->_peer, createOffer(_, context));
+    EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(msg), context));
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    plugin->command(JanusCommands::PUBLISH, context);
+
+    plugin->onOffer("the sdp", context);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldJoinAndPublishInASingleMessage) {
+    nlohmann::json msg = {
+      { "body", {
+        { "request", "joinandconfigure" },
+        { "ptype", "publisher" },
+        { "room", 1234 },
+        { "display", "yolo" },
+        { "audio", true },
+        { "video", true },
+        { "data", true }
+      } },
+      { "jsep", { { "type", "offer" }, { "sdp", "the sdp" } } }
+    };
+
+    auto context = Bundle::create();
+    context->setString("command", JanusCommands::JOIN_AND_PUBLISH);
+    context->setInt("room", 1234);
+    context->setString("display", "yolo");
+
+    EXPECT_CALL(*this->_peer, createOffer(_, context));
+    EXPECT_CALL(*this->_peer, setLocalDescription(SdpType::OFFER, "the sdp"));
+    EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(msg), context));
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    plugin->command(JanusCommands::JOIN_AND_PUBLISH, context);
+
+    plugin->onOffer("the sdp", context);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldApplyTheAnswerOfTheJoinedEvent) {
+    auto context = Bundle::create();
+    context->setString("command", JanusCommands::JOIN_AND_PUBLISH);
+
+    nlohmann::json data = {
+      { "videoroom", "joined" },
+      { "room", 1234 }
+    };
+    nlohmann::json jsep = {
+      { "type", "answer" },
+      { "sdp", "the sdp" }
+    };
+
+    EXPECT_CALL(*this->_peer, setRemoteDescription(SdpType::ANSWER, "the sdp"));
+    EXPECT_CALL(*this->_delegate, onPluginEvent(IsEvent("videoroom", "joined"), Eq(context)));
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    plugin->command(JanusCommands::JOIN_AND_PUBLISH, context);
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_PUBLISHER_ID, data, jsep), context);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldTakeTheSubscriberPeersFromThePool) {
+    auto poolContext = Bundle::create();
+    poolContext->setInt("size", 0);
+
+    auto attachContext = Bundle::create();
+    attachContext->setString("command", "attach");
+    attachContext->setInt("feed", 1);
+    nlohmann::json attached = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+
+    std::shared_ptr<JanusEvent> stats;
+    EXPECT_CALL(*this->_delegate, onPluginEvent(IsEvent("videoroom", "peer-pool"), _)).Times(2).WillRepeatedly(testing::SaveArg<0>(&stats));
+    EXPECT_CALL(*this->_peerFactory, create(TEST_SUBSCRIBER_ID, Eq(this->_owner))).WillOnce(Return(this->_subscriberPeer));
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    plugin->command(JanusCommands::PEER_POOL, poolContext);
+    ASSERT_NE(plugin->pool(), nullptr);
+
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attached), attachContext);
+    plugin->command(JanusCommands::PEER_POOL, Bundle::create());
+
+    EXPECT_EQ(stats->data()->getInt("size", -1), 0);
+    EXPECT_EQ(stats->data()->getInt("hits", -1), 0);
+    EXPECT_EQ(stats->data()->getInt("misses", -1), 1);
+  }
+
   TEST_F(JanusPluginVideoroomTest, shouldSetTheRemoteDescriptionOnConfiguredEvent) {
     EXPECT_CALL(*this->_peer, setRemoteDescription(SdpType::ANSWER, "the sdp"));
 
@@ -291,6 +450,530 @@ namespace Janus {
     plugin->onAnswer("the sdp", actualContext);
   }
 
+  TEST_F(JanusPluginVideoroomTest, shouldAttachTheVisibleFeedsOnViewport) {
+    {
+      InSequence seq;
+      EXPECT_CALL(*this->_owner, dispatch(JanusCommands::ATTACH, BundleHasInt("feed", 1)));
+      EXPECT_CALL(*this->_owner, dispatch(JanusCommands::ATTACH, BundleHasInt("feed", 2)));
+    }
+
+    auto bundle = Bundle::create();
+    bundle->setString("feeds", "1,2,3");
+    bundle->setInt("room", 69);
+    bundle->setInt("max_active", 2);
+
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+
+    EXPECT_EQ(plugin->subscriptions()->active(), 2u);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldPauseAndResumeTheViewportSubscribers) {
+    nlohmann::json pause = {
+      { "body", { { "request", "pause" } } }
+    };
+    nlohmann::json resume = {
+      { "body", { { "request", "start" } } }
+    };
+
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto bundle = Bundle::create();
+    bundle->setString("feeds", "420");
+    bundle->setInt("hysteresis", 0);
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setBool("viewport", true);
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+    plugin->onAnswer("the sdp", context);
+
+    {
+      InSequence seq;
+      EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(pause), BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+      EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(resume), BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+    }
+
+    bundle->setString("feeds", "");
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+
+    bundle->setString("feeds", "420");
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldPauseAFeedHiddenWhileItsSubscriberWasStarting) {
+    nlohmann::json start = {
+      { "body", { { "request", "start" } } },
+      { "jsep", { { "type", "answer" }, { "sdp", "the sdp" } } }
+    };
+    nlohmann::json pause = {
+      { "body", { { "request", "pause" } } }
+    };
+
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto bundle = Bundle::create();
+    bundle->setString("feeds", "420");
+    bundle->setInt("hysteresis", 0);
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+
+    EXPECT_CALL(*this->_delegate, onCommandResult(_, _)).Times(testing::AnyNumber());
+    EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(pause), _)).Times(0);
+
+    // hidden before the attach even completed
+    bundle->setString("feeds", "");
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+    EXPECT_EQ(plugin->subscriptions()->warm(), 1u);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setBool("viewport", true);
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+
+    testing::Mock::VerifyAndClearExpectations(this->_delegate.get());
+
+    {
+      InSequence seq;
+      EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(start), BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+      EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(pause), BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+    }
+
+    plugin->onAnswer("the sdp", context);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldPauseAHiddenFeedOnceItsHysteresisExpires) {
+    nlohmann::json pause = {
+      { "body", { { "request", "pause" } } }
+    };
+
+    auto scheduler = std::make_shared<NiceMock<SchedulerMock>>();
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner, scheduler);
+
+    auto bundle = Bundle::create();
+    bundle->setString("feeds", "420");
+    bundle->setInt("hysteresis", 100);
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setBool("viewport", true);
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+    plugin->onAnswer("the sdp", context);
+
+    Task tick;
+    EXPECT_CALL(*scheduler, post(testing::Le(100), _)).WillOnce(testing::SaveArg<1>(&tick));
+
+    bundle->setString("feeds", "");
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+    ASSERT_NE(tick, nullptr);
+
+    // the tick goes through the owner, like any other command
+    std::shared_ptr<Bundle> ticked;
+    EXPECT_CALL(*this->_owner, dispatch(JanusCommands::VIEWPORT, _)).WillOnce(testing::SaveArg<1>(&ticked));
+    tick();
+    ASSERT_NE(ticked, nullptr);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+
+    EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(pause), BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+    plugin->command(JanusCommands::VIEWPORT, ticked);
+
+    EXPECT_EQ(plugin->subscriptions()->warm(), 1u);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldDetachASubscriberAttachedAfterTheViewportMovedAway) {
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto bundle = Bundle::create();
+    bundle->setString("feeds", "420");
+    bundle->setInt("hysteresis", 0);
+    bundle->setInt("max_warm", 0);
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+
+    bundle->setString("feeds", "");
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+
+    EXPECT_CALL(*this->_peerFactory, create(_, _)).Times(0);
+    EXPECT_CALL(*this->_owner, dispatch(JanusCommands::DETACH, BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setBool("viewport", true);
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldDetachTheViewportSubscriberOfALeavingPublisher) {
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_PUBLISHER_ID, nlohmann::json({
+      { "videoroom", "joined" },
+      { "room", 69 },
+      { "publishers", { { { "id", 420 } } } }
+    })), Bundle::create());
+
+    auto bundle = Bundle::create();
+    bundle->setString("feeds", "420");
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setBool("viewport", true);
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+
+    EXPECT_CALL(*this->_subscriberPeer, close());
+    EXPECT_CALL(*this->_owner, dispatch(JanusCommands::DETACH, BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_PUBLISHER_ID, nlohmann::json({
+      { "videoroom", "event" },
+      { "room", 69 },
+      { "leaving", 420 }
+    })), Bundle::create());
+
+    EXPECT_EQ(plugin->subscriptions()->tracks(420), false);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldDropTheOfferAndTheAnswerOfADetachedSubscriber) {
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto bundle = Bundle::create();
+    bundle->setString("feeds", "420");
+    bundle->setInt("hysteresis", 0);
+    bundle->setInt("max_warm", 0);
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setBool("viewport", true);
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+
+    // the feed leaves the viewport while janus offers and the peer answers
+    EXPECT_CALL(*this->_subscriberPeer, close());
+    bundle->setString("feeds", "");
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+
+    EXPECT_CALL(*this->_subscriberPeer, setRemoteDescription(_, _)).Times(0);
+    EXPECT_CALL(*this->_subscriberPeer, setLocalDescription(_, _)).Times(0);
+    EXPECT_CALL(*this->_delegate, onCommandResult(_, _)).Times(0);
+
+    nlohmann::json jsep = {
+      { "type", "offer" },
+      { "sdp", "the sdp" }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, nlohmann::json({ { "videoroom", "attached" } }), jsep), Bundle::create());
+    plugin->onAnswer("the sdp", context);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldNotifyTheActiveSpeakersOnTalkingEvents) {
+    auto context = Bundle::create();
+    nlohmann::json talking = { { "videoroom", "talking" }, { "room", 69 }, { "id", 420 } };
+
+    {
+      InSequence seq;
+      EXPECT_CALL(*this->_delegate, onPluginEvent(IsEvent("videoroom", "speakers"), Eq(context)));
+      EXPECT_CALL(*this->_delegate, onPluginEvent(IsEvent("videoroom", "talking"), Eq(context)));
+    }
+
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_PUBLISHER_ID, talking), context);
+
+    EXPECT_THAT(plugin->speakers()->ranking(), testing::ElementsAre(420));
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldSubscribeTheActiveSpeakersWhenFollowingThem) {
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto bundle = Bundle::create();
+    bundle->setInt("size", 1);
+    bundle->setInt("room", 69);
+    bundle->setBool("follow", true);
+
+    EXPECT_CALL(*this->_delegate, onPluginEvent(_, _)).Times(testing::AnyNumber());
+    EXPECT_CALL(*this->_delegate, onPluginEvent(IsEvent("videoroom", "speakers"), Eq(bundle)));
+    plugin->command(JanusCommands::SPEAKERS, bundle);
+
+    EXPECT_CALL(*this->_owner, dispatch(JanusCommands::ATTACH, BundleHasInt("feed", 420)));
+    EXPECT_CALL(*this->_owner, dispatch(JanusCommands::ATTACH, BundleHasInt("feed", 421)));
+
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_PUBLISHER_ID, nlohmann::json({ { "videoroom", "talking" }, { "id", 420 } })), Bundle::create());
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_PUBLISHER_ID, nlohmann::json({ { "videoroom", "talking" }, { "id", 421 } })), Bundle::create());
+
+    EXPECT_EQ(plugin->subscriptions()->active(), 1u);
+    EXPECT_EQ(plugin->subscriptions()->tracks(421), true);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldSendTheLayersToTheFeedSubscriber) {
+    nlohmann::json simulcast = {
+      { "body", { { "request", "configure" }, { "substream", 0 }, { "temporal", 1 } } }
+    };
+    nlohmann::json svc = {
+      { "body", { { "request", "configure" }, { "spatial_layer", 1 }, { "temporal_layer", 0 } } }
+    };
+
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+    plugin->onAnswer("the sdp", context);
+
+    {
+      InSequence seq;
+      EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(simulcast), BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+      EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(svc), BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+    }
+
+    auto bundle = Bundle::create();
+    bundle->setInt("feed", 420);
+    bundle->setInt("substream", 0);
+    bundle->setInt("temporal", 1);
+    plugin->command(JanusCommands::LAYERS, bundle);
+
+    bundle->setBool("svc", true);
+    bundle->setInt("spatial_layer", 1);
+    bundle->setInt("temporal_layer", 0);
+    plugin->command(JanusCommands::LAYERS, bundle);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldBatchThePolicyLayerSwitches) {
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+
+    std::vector<std::shared_ptr<Bundle>> switches;
+    EXPECT_CALL(*this->_owner, dispatchBatch(_)).WillOnce(testing::SaveArg<0>(&switches));
+
+    auto bundle = Bundle::create();
+    bundle->setString("tiles", "420:320x180,421:1280x720");
+    plugin->command(JanusCommands::LAYER_POLICY, bundle);
+
+    ASSERT_EQ(switches.size(), 1u);
+    EXPECT_EQ(switches[0]->getString("command", ""), JanusCommands::LAYERS);
+    EXPECT_EQ(switches[0]->getInt("feed", -1), 420);
+    EXPECT_EQ(switches[0]->getInt("substream", -1), 0);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldReplanALayerSwitchTheIntervalHeldBack) {
+    auto scheduler = std::make_shared<NiceMock<SchedulerMock>>();
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner, scheduler);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+
+    auto bundle = Bundle::create();
+    bundle->setInt("interval", 100);
+    bundle->setString("tiles", "420:1280x720");
+    plugin->command(JanusCommands::LAYER_POLICY, bundle);
+
+    Task tick;
+    EXPECT_CALL(*scheduler, post(testing::Le(100), _)).WillOnce(testing::SaveArg<1>(&tick));
+    EXPECT_CALL(*this->_owner, dispatchBatch(_)).Times(0);
+
+    // the tile shrinks right after the first switch
+    bundle->setString("tiles", "420:320x180");
+    plugin->command(JanusCommands::LAYER_POLICY, bundle);
+    ASSERT_NE(tick, nullptr);
+
+    std::shared_ptr<Bundle> ticked;
+    EXPECT_CALL(*this->_owner, dispatch(JanusCommands::LAYER_POLICY, _)).WillOnce(testing::SaveArg<1>(&ticked));
+    tick();
+    ASSERT_NE(ticked, nullptr);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+
+    testing::Mock::VerifyAndClearExpectations(this->_owner.get());
+    std::vector<std::shared_ptr<Bundle>> switches;
+    EXPECT_CALL(*this->_owner, dispatchBatch(_)).WillOnce(testing::SaveArg<0>(&switches));
+
+    plugin->command(JanusCommands::LAYER_POLICY, ticked);
+
+    ASSERT_EQ(switches.size(), 1u);
+    EXPECT_EQ(switches[0]->getInt("feed", -1), 420);
+    EXPECT_EQ(switches[0]->getInt("substream", -1), 0);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldSwitchTheFeedOfAnExistingSubscriber) {
+    nlohmann::json msg = {
+      { "body", { { "request", "switch" }, { "feed", 421 } } }
+    };
+
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+
+    EXPECT_CALL(*this->_peerFactory, create(_, _)).Times(0);
+    EXPECT_CALL(*this->_owner, dispatch(_, _)).Times(0);
+    EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(msg), BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+
+    auto bundle = Bundle::create();
+    bundle->setInt("from", 420);
+    bundle->setInt("feed", 421);
+    plugin->command(JanusCommands::SWITCH, bundle);
+
+    EXPECT_EQ(context->getInt("feed", -1), 421);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldFailTheSwitchOfAFeedWithoutSubscriber) {
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto bundle = Bundle::create();
+    bundle->setInt("from", 420);
+    bundle->setInt("feed", 421);
+
+    EXPECT_CALL(*this->_delegate, onCommandResult(_, _)).Times(0);
+    EXPECT_CALL(*this->_delegate, onPluginError(testing::Field(&JanusError::code, 428), bundle));
+
+    plugin->command(JanusCommands::SWITCH, bundle);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldMoveTheViewportStateOnAManualSwitch) {
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto viewport = Bundle::create();
+    viewport->setString("feeds", "420");
+    plugin->command(JanusCommands::VIEWPORT, viewport);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setBool("viewport", true);
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+
+    auto bundle = Bundle::create();
+    bundle->setInt("from", 420);
+    bundle->setInt("feed", 421);
+    plugin->command(JanusCommands::SWITCH, bundle);
+
+    EXPECT_EQ(plugin->subscriptions()->tracks(420), false);
+    EXPECT_EQ(plugin->subscriptions()->tracks(421), true);
+    EXPECT_EQ(plugin->subscriptions()->active(), 1u);
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldAnswerTheRenegotiationOfASwitch) {
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+
+    EXPECT_CALL(*this->_subscriberPeer, setRemoteDescription(SdpType::OFFER, "the sdp"));
+    EXPECT_CALL(*this->_subscriberPeer, createAnswer(_, context));
+
+    nlohmann::json data = {
+      { "videoroom", "event" },
+      { "switched", "ok" },
+      { "id", 421 }
+    };
+    nlohmann::json jsep = {
+      { "type", "offer" },
+      { "sdp", "the sdp" }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, data, jsep), Bundle::create());
+  }
+
+  TEST_F(JanusPluginVideoroomTest, shouldRecycleAnEvictedViewportSubscriber) {
+    nlohmann::json switchFeed = {
+      { "body", { { "request", "switch" }, { "feed", 421 } } }
+    };
+    nlohmann::json resume = {
+      { "body", { { "request", "start" } } }
+    };
+
+    auto plugin = std::make_shared<JanusPluginVideoroom>(TEST_PUBLISHER_ID, this->_delegate, this->_peerFactory, this->_owner);
+
+    auto bundle = Bundle::create();
+    bundle->setString("feeds", "420");
+    bundle->setInt("max_active", 1);
+    bundle->setInt("max_warm", 0);
+    bundle->setInt("hysteresis", 0);
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+
+    auto context = Bundle::create();
+    context->setString("command", "attach");
+    context->setBool("viewport", true);
+    context->setInt("feed", 420);
+    nlohmann::json attachEvent = {
+      { "janus", "success" },
+      { "data", { { "id", TEST_SUBSCRIBER_ID } } }
+    };
+    plugin->onEvent(std::make_shared<JanusEventImpl>(TEST_SUBSCRIBER_ID, attachEvent), context);
+    plugin->onAnswer("the sdp", context);
+
+    EXPECT_CALL(*this->_owner, dispatch(_, _)).Times(0);
+    {
+      InSequence seq;
+      EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(switchFeed), BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+      EXPECT_CALL(*this->_delegate, onCommandResult(IsJsonEq(resume), BundleHasInt("handleId", TEST_SUBSCRIBER_ID)));
+    }
+
+    bundle->setString("feeds", "421");
+    plugin->command(JanusCommands::VIEWPORT, bundle);
+  }
+
 
   class JanusPluginVideoroomFactoryTest : public testing::Test {
   };
@@ -304,4 +987,21 @@ namespace Janus {
     EXPECT_NE(factory->create(69, owner), nullptr);
   }
 
+  TEST_F(JanusPluginVideoroomFactoryTest, shouldWarmThePeersOfEveryPluginOnTheSameAsync) {
+    auto peerFactory = std::make_shared<NiceMock<PeerFactoryMock>>();
+    auto owner = std::make_shared<NiceMock<ProtocolMock>>();
+    auto delegate = std::make_shared<NiceMock<PluginCommandDelegateMock>>();
+    auto scheduler = std::make_shared<NiceMock<SchedulerMock>>();
+    auto async = std::make_shared<NiceMock<AsyncMock>>();
+
+    EXPECT_CALL(*async, submit(_)).Times(2);
+
+    auto factory = std::make_shared<JanusPluginVideoroomFactory>(delegate, peerFactory, scheduler, async);
+
+    auto bundle = Bundle::create();
+    bundle->setInt("size", 1);
+    factory->create(69, owner)->command(JanusCommands::PEER_POOL, bundle);
+    factory->create(70, owner)->command(JanusCommands::PEER_POOL, bundle);
+  }
+
 }
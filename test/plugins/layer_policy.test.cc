@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "janus/plugins/layer_policy.h"
+
+using testing::IsEmpty;
+
+namespace Janus {
+
+  class LayerPolicyTest : public testing::Test {
+    protected:
+      std::chrono::steady_clock::time_point _at(int64_t ms) {
+        return this->_origin + std::chrono::milliseconds(ms);
+      }
+
+      std::chrono::steady_clock::time_point _origin = std::chrono::steady_clock::now();
+  };
+
+  TEST_F(LayerPolicyTest, shouldPickTheLayersFromTheTileSize) {
+    auto policy = std::make_shared<LayerPolicy>(10000, 2000);
+    policy->tile(1, 160, 90);
+    policy->tile(2, 640, 360);
+    policy->tile(3, 1280, 720);
+    policy->tile(4, 0, 0);
+
+    auto switches = policy->plan(this->_at(0));
+
+    ASSERT_EQ(switches.size(), 4u);
+    EXPECT_EQ(switches[0].feed, 1);
+    EXPECT_EQ(switches[0].substream, 0);
+    EXPECT_EQ(switches[0].temporal, 2);
+    EXPECT_EQ(switches[1].substream, 1);
+    EXPECT_EQ(switches[2].substream, 2);
+    EXPECT_EQ(switches[3].substream, 0);
+    EXPECT_EQ(switches[3].temporal, 0);
+  }
+
+  TEST_F(LayerPolicyTest, shouldStepDownTheRichestLayersToFitTheBudget) {
+    auto policy = std::make_shared<LayerPolicy>(2000, 2000);
+    policy->tile(1, 1280, 720);
+    policy->tile(2, 1280, 720);
+    policy->tile(3, 160, 90);
+
+    auto switches = policy->plan(this->_at(0));
+
+    ASSERT_EQ(switches.size(), 3u);
+    EXPECT_EQ(switches[0].substream, 1);
+    EXPECT_EQ(switches[1].substream, 1);
+    EXPECT_EQ(switches[2].substream, 0);
+  }
+
+  TEST_F(LayerPolicyTest, shouldRateLimitTheSwitchesOfAFeed) {
+    auto policy = std::make_shared<LayerPolicy>(10000, 2000);
+    policy->tile(1, 1280, 720);
+    EXPECT_EQ(policy->plan(this->_at(0)).size(), 1u);
+
+    EXPECT_EQ(policy->due(this->_at(0)), -1);
+
+    policy->tile(1, 320, 180);
+    EXPECT_THAT(policy->plan(this->_at(500)), IsEmpty());
+    EXPECT_EQ(policy->due(this->_at(500)), 1500);
+
+    auto switches = policy->plan(this->_at(2500));
+    ASSERT_EQ(switches.size(), 1u);
+    EXPECT_EQ(switches[0].substream, 0);
+
+    EXPECT_THAT(policy->plan(this->_at(5000)), IsEmpty());
+    EXPECT_EQ(policy->due(this->_at(5000)), -1);
+  }
+
+  TEST_F(LayerPolicyTest, shouldForgetADetachedFeed) {
+    auto policy = std::make_shared<LayerPolicy>(10000, 2000);
+    policy->tile(1, 1280, 720);
+    policy->forget(1);
+
+    EXPECT_THAT(policy->plan(this->_at(0)), IsEmpty());
+  }
+
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "janus/plugins/room_state.h"
+#include "janus/janus_event_impl.h"
+
+using testing::ElementsAre;
+
+namespace Janus {
+
+  class RoomStateTest : public testing::Test {
+    protected:
+      std::shared_ptr<JanusData> _data(const nlohmann::json& content) {
+        return std::make_shared<JanusDataImpl>(content);
+      }
+
+      std::vector<int64_t> _ids(const std::vector<Participant>& participants) {
+        std::vector<int64_t> ids;
+        for(auto& participant : participants) {
+          ids.push_back(participant.id);
+        }
+
+        return ids;
+      }
+  };
+
+  TEST_F(RoomStateTest, shouldLoadThePublishersOnJoined) {
+    auto state = std::make_shared<RoomState>();
+
+    auto delta = state->apply(this->_data({
+      { "videoroom", "joined" },
+      { "room", 1234 },
+      { "publishers", { { { "id", 3 }, { "display", "three" } }, { { "id", 1 }, { "display", "one" } } } }
+    }));
+
+    EXPECT_THAT(this->_ids(delta.joined), ElementsAre(3, 1));
+    EXPECT_THAT(this->_ids(state->snapshot()), ElementsAre(3, 1));
+    EXPECT_EQ(state->room(), 1234);
+    EXPECT_EQ(state->snapshot()[0].display, "three");
+    EXPECT_EQ(state->snapshot()[0].publisher, true);
+  }
+
+  TEST_F(RoomStateTest, shouldApplyEventsAsDeltasKeepingTheJoinOrder) {
+    auto state = std::make_shared<RoomState>();
+    state->apply(this->_data({
+      { "videoroom", "joined" },
+      { "room", 1234 },
+      { "publishers", { { { "id", 1 } }, { { "id", 2 } }, { { "id", 3 } } } }
+    }));
+
+    auto left = state->apply(this->_data({ { "videoroom", "event" }, { "leaving", 2 } }));
+    EXPECT_THAT(left.left, ElementsAre(2));
+    EXPECT_TRUE(left.joined.empty());
+
+    auto joined = state->apply(this->_data({ { "videoroom", "event" }, { "publishers", { { { "id", 4 }, { "display", "four" } } } } }));
+    EXPECT_THAT(this->_ids(joined.joined), ElementsAre(4));
+
+    auto unpublished = state->apply(this->_data({ { "videoroom", "event" }, { "unpublished", 1 } }));
+    EXPECT_THAT(this->_ids(unpublished.updated), ElementsAre(1));
+    EXPECT_EQ(unpublished.updated[0].publisher, false);
+
+    EXPECT_THAT(this->_ids(state->snapshot()), ElementsAre(1, 3, 4));
+  }
+
+  TEST_F(RoomStateTest, shouldIgnoreUnknownAndSelfReferences) {
+    auto state = std::make_shared<RoomState>();
+    state->apply(this->_data({ { "videoroom", "joined" }, { "room", 1234 }, { "publishers", { { { "id", 1 } } } } }));
+
+    EXPECT_TRUE(state->apply(this->_data({ { "videoroom", "event" }, { "leaving", "ok" } })).empty());
+    EXPECT_TRUE(state->apply(this->_data({ { "videoroom", "event" }, { "leaving", 42 } })).empty());
+    EXPECT_TRUE(state->apply(this->_data({ { "videoroom", "talking" }, { "id", 1 } })).empty());
+    EXPECT_EQ(state->size(), 1);
+  }
+
+  TEST_F(RoomStateTest, shouldTrackAttendeesWithoutDemotingPublishers) {
+    auto state = std::make_shared<RoomState>();
+    state->apply(this->_data({ { "videoroom", "joined" }, { "room", 1234 }, { "publishers", { { { "id", 1 }, { "display", "one" } } } } }));
+
+    auto delta = state->apply(this->_data({ { "videoroom", "event" }, { "joining", { { "id", 2 }, { "display", "two" } } } }));
+    EXPECT_THAT(this->_ids(delta.joined), ElementsAre(2));
+    EXPECT_EQ(delta.joined[0].publisher, false);
+
+    EXPECT_TRUE(state->apply(this->_data({ { "videoroom", "event" }, { "joining", { { "id", 1 }, { "display", "one" } } } })).empty());
+
+    Participant participant(-1, "", false, "", "");
+    EXPECT_TRUE(state->find(1, participant));
+    EXPECT_EQ(participant.publisher, true);
+  }
+
+  TEST_F(RoomStateTest, shouldResetTheTableOnRoomChangeOrDestroy) {
+    auto state = std::make_shared<RoomState>();
+    state->apply(this->_data({ { "videoroom", "joined" }, { "room", 1 }, { "publishers", { { { "id", 1 } } } } }));
+
+    auto delta = state->apply(this->_data({ { "videoroom", "joined" }, { "room", 2 }, { "publishers", { { { "id", 2 } } } } }));
+    EXPECT_THAT(delta.left, ElementsAre(1));
+    EXPECT_THAT(this->_ids(delta.joined), ElementsAre(2));
+
+    auto destroyed = state->apply(this->_data({ { "videoroom", "destroyed" }, { "room", 2 } }));
+    EXPECT_THAT(destroyed.left, ElementsAre(2));
+    EXPECT_EQ(state->size(), 0);
+  }
+
+}
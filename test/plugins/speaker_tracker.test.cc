@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "janus/plugins/speaker_tracker.h"
+#include "janus/janus_event_impl.h"
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+namespace Janus {
+
+  class SpeakerTrackerTest : public testing::Test {
+    protected:
+      std::shared_ptr<JanusData> _talking(int64_t id) {
+        return std::make_shared<JanusDataImpl>(nlohmann::json({ { "videoroom", "talking" }, { "id", id } }));
+      }
+
+      std::shared_ptr<JanusData> _stopped(int64_t id) {
+        return std::make_shared<JanusDataImpl>(nlohmann::json({ { "videoroom", "stopped-talking" }, { "id", id } }));
+      }
+  };
+
+  TEST_F(SpeakerTrackerTest, shouldRankTheLatestSpeakerFirst) {
+    auto tracker = std::make_shared<SpeakerTracker>(3);
+
+    EXPECT_EQ(tracker->apply(this->_talking(1)), true);
+    EXPECT_EQ(tracker->apply(this->_talking(2)), true);
+
+    EXPECT_THAT(tracker->ranking(), ElementsAre(2, 1));
+  }
+
+  TEST_F(SpeakerTrackerTest, shouldRankTheTalkingSpeakersAboveTheSilentOnes) {
+    auto tracker = std::make_shared<SpeakerTracker>(3);
+
+    tracker->apply(this->_talking(1));
+    tracker->apply(this->_talking(2));
+    tracker->apply(this->_stopped(2));
+    tracker->apply(this->_talking(3));
+    tracker->apply(this->_stopped(3));
+
+    EXPECT_THAT(tracker->ranking(), ElementsAre(1, 3, 2));
+  }
+
+  TEST_F(SpeakerTrackerTest, shouldKeepOnlyTheTopSpeakers) {
+    auto tracker = std::make_shared<SpeakerTracker>(2);
+
+    tracker->apply(this->_talking(1));
+    tracker->apply(this->_talking(2));
+    tracker->apply(this->_talking(3));
+
+    EXPECT_THAT(tracker->ranking(), ElementsAre(3, 2));
+    EXPECT_EQ(tracker->apply(this->_stopped(1)), false);
+    EXPECT_EQ(tracker->resize(3), true);
+    EXPECT_THAT(tracker->ranking(), ElementsAre(3, 2, 1));
+  }
+
+  TEST_F(SpeakerTrackerTest, shouldIgnoreTheOtherEvents) {
+    auto tracker = std::make_shared<SpeakerTracker>(2);
+
+    EXPECT_EQ(tracker->apply(std::make_shared<JanusDataImpl>(nlohmann::json({ { "videoroom", "event" }, { "id", 1 } }))), false);
+    EXPECT_EQ(tracker->apply(std::make_shared<JanusDataImpl>(nlohmann::json({ { "videoroom", "talking" } }))), false);
+    EXPECT_THAT(tracker->ranking(), IsEmpty());
+  }
+
+  TEST_F(SpeakerTrackerTest, shouldRemoveALeavingSpeaker) {
+    auto tracker = std::make_shared<SpeakerTracker>(2);
+
+    tracker->apply(this->_talking(1));
+    tracker->apply(this->_talking(2));
+
+    EXPECT_EQ(tracker->remove(2), true);
+    EXPECT_EQ(tracker->remove(2), false);
+    EXPECT_THAT(tracker->ranking(), ElementsAre(1));
+  }
+
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "janus/plugins/subscription_manager.h"
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+using testing::UnorderedElementsAre;
+
+namespace Janus {
+
+  class SubscriptionManagerTest : public testing::Test {
+    protected:
+      std::chrono::steady_clock::time_point _at(int64_t ms) {
+        return this->_origin + std::chrono::milliseconds(ms);
+      }
+
+      std::chrono::steady_clock::time_point _origin = std::chrono::steady_clock::now();
+  };
+
+  TEST_F(SubscriptionManagerTest, shouldAttachTheVisibleFeedsUpToTheMaxConcurrency) {
+    auto manager = std::make_shared<SubscriptionManager>(2, 1, 1000);
+
+    auto plan = manager->update({ 1, 2, 3 }, this->_at(0));
+
+    EXPECT_THAT(plan.attach, ElementsAre(1, 2));
+    EXPECT_THAT(plan.pause, IsEmpty());
+    EXPECT_EQ(manager->active(), 2u);
+    EXPECT_EQ(manager->tracks(3), false);
+  }
+
+  TEST_F(SubscriptionManagerTest, shouldKeepAHiddenFeedUntilTheHysteresisExpires) {
+    auto manager = std::make_shared<SubscriptionManager>(3, 1, 1000);
+
+    manager->update({ 1, 2 }, this->_at(0));
+
+    auto plan = manager->update({ 1 }, this->_at(100));
+    EXPECT_EQ(plan.empty(), true);
+
+    plan = manager->update({ 1, 2 }, this->_at(500));
+    EXPECT_EQ(plan.empty(), true);
+
+    manager->update({ 1 }, this->_at(600));
+    plan = manager->update({ 1 }, this->_at(1600));
+    EXPECT_THAT(plan.pause, ElementsAre(2));
+    EXPECT_EQ(manager->warm(), 1u);
+  }
+
+  TEST_F(SubscriptionManagerTest, shouldPauseTheOldestHiddenFeedWhenItsSlotIsNeeded) {
+    auto manager = std::make_shared<SubscriptionManager>(2, 2, 1000);
+
+    manager->update({ 1, 2 }, this->_at(0));
+    manager->update({ 2 }, this->_at(100));
+
+    auto plan = manager->update({ 2, 3 }, this->_at(200));
+
+    EXPECT_THAT(plan.attach, ElementsAre(3));
+    EXPECT_THAT(plan.pause, ElementsAre(1));
+    EXPECT_EQ(manager->active(), 2u);
+  }
+
+  TEST_F(SubscriptionManagerTest, shouldResumeAWarmFeed) {
+    auto manager = std::make_shared<SubscriptionManager>(1, 1, 0);
+
+    manager->update({ 1 }, this->_at(0));
+    manager->update({ 2 }, this->_at(100));
+
+    auto plan = manager->update({ 1 }, this->_at(200));
+
+    EXPECT_THAT(plan.resume, ElementsAre(1));
+    EXPECT_THAT(plan.pause, ElementsAre(2));
+    EXPECT_THAT(plan.attach, IsEmpty());
+  }
+
+  TEST_F(SubscriptionManagerTest, shouldDetachTheLeastRecentlyHiddenFeedsOutOfTheWarmPool) {
+    auto manager = std::make_shared<SubscriptionManager>(4, 1, 0);
+
+    manager->update({ 1, 2, 3 }, this->_at(0));
+    manager->update({ 2, 3 }, this->_at(100));
+
+    auto plan = manager->update({ 4 }, this->_at(200));
+
+    EXPECT_THAT(plan.pause, UnorderedElementsAre(2, 3));
+    EXPECT_THAT(plan.detach, UnorderedElementsAre(1, 2));
+    EXPECT_EQ(manager->warm(), 1u);
+    EXPECT_EQ(manager->tracks(3), true);
+  }
+
+  TEST_F(SubscriptionManagerTest, shouldDetachARemovedFeed) {
+    auto manager = std::make_shared<SubscriptionManager>(2, 1, 1000);
+
+    manager->update({ 1, 2 }, this->_at(0));
+
+    EXPECT_THAT(manager->remove(2).detach, ElementsAre(2));
+    EXPECT_EQ(manager->remove(2).empty(), true);
+    EXPECT_EQ(manager->tracks(2), false);
+  }
+
+  TEST_F(SubscriptionManagerTest, shouldPauseAHiddenFeedOnTheTickAfterTheHysteresis) {
+    auto manager = std::make_shared<SubscriptionManager>(3, 1, 1000);
+
+    manager->update({ 1, 2 }, this->_at(0));
+    EXPECT_EQ(manager->due(this->_at(0)), -1);
+
+    manager->update({ 1 }, this->_at(100));
+    EXPECT_EQ(manager->due(this->_at(600)), 500);
+
+    EXPECT_EQ(manager->tick(this->_at(1000)).empty(), true);
+
+    auto plan = manager->tick(this->_at(1100));
+    EXPECT_THAT(plan.pause, ElementsAre(2));
+    EXPECT_THAT(plan.attach, IsEmpty());
+    EXPECT_EQ(manager->due(this->_at(1100)), -1);
+  }
+
+  TEST_F(SubscriptionManagerTest, shouldCountNegativeLimitsAsZero) {
+    auto manager = std::make_shared<SubscriptionManager>(-1, -3, -1000);
+
+    auto plan = manager->update({ 1, 2 }, this->_at(0));
+
+    EXPECT_THAT(plan.attach, IsEmpty());
+    EXPECT_EQ(manager->active(), 0u);
+  }
+
+  TEST_F(SubscriptionManagerTest, shouldMoveTheStateOfAReplacedFeed) {
+    auto manager = std::make_shared<SubscriptionManager>(2, 1, 0);
+
+    manager->update({ 1, 2 }, this->_at(0));
+    manager->update({ 1 }, this->_at(100));
+    EXPECT_EQ(manager->warm(), 1u);
+
+    manager->replace(2, 3);
+    manager->replace(4, 5);
+
+    EXPECT_EQ(manager->tracks(2), false);
+    EXPECT_EQ(manager->tracks(3), true);
+    EXPECT_EQ(manager->tracks(5), false);
+    EXPECT_EQ(manager->warm(), 1u);
+  }
+
+}
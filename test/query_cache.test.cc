@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <unistd.h>
+
+#include "janus/query_cache.h"
+
+using testing::ElementsAre;
+
+namespace Janus {
+
+  class QueryCacheTest : public testing::Test {
+    protected:
+      void SetUp() override {
+        this->_reply = {
+          { "janus", "success" },
+          { "plugindata", { { "data", { { "list", nlohmann::json::array() } } } } }
+        };
+      }
+
+      nlohmann::json _reply;
+  };
+
+  TEST_F(QueryCacheTest, shouldMergeIdenticalInFlightQueries) {
+    auto cache = std::make_shared<QueryCache>();
+    auto first = Bundle::create();
+    auto second = Bundle::create();
+    nlohmann::json reply;
+
+    EXPECT_EQ(cache->acquire("list", "scope", first, reply), QueryStatus::MISS);
+    EXPECT_EQ(cache->acquire("list", "scope", second, reply), QueryStatus::PENDING);
+    EXPECT_EQ(cache->acquire("other", "scope", second, reply), QueryStatus::MISS);
+
+    EXPECT_THAT(cache->complete("list", this->_reply, true), ElementsAre(first, second));
+  }
+
+  TEST_F(QueryCacheTest, shouldServeCompletedQueriesFromCache) {
+    auto cache = std::make_shared<QueryCache>();
+    auto context = Bundle::create();
+    nlohmann::json reply;
+
+    cache->acquire("list", "scope", context, reply);
+    cache->complete("list", this->_reply, true);
+
+    EXPECT_EQ(cache->acquire("list", "scope", context, reply), QueryStatus::HIT);
+    EXPECT_EQ(reply, this->_reply);
+  }
+
+  TEST_F(QueryCacheTest, shouldNotCacheFailedQueries) {
+    auto cache = std::make_shared<QueryCache>();
+    auto context = Bundle::create();
+    nlohmann::json reply;
+
+    cache->acquire("list", "scope", context, reply);
+    cache->complete("list", this->_reply, false);
+
+    EXPECT_EQ(cache->acquire("list", "scope", context, reply), QueryStatus::MISS);
+  }
+
+  TEST_F(QueryCacheTest, shouldExpireEntriesAfterTheTtl) {
+    auto cache = std::make_shared<QueryCache>(1);
+    auto context = Bundle::create();
+    nlohmann::json reply;
+
+    cache->acquire("list", "scope", context, reply);
+    cache->complete("list", this->_reply, true);
+
+    usleep(5000);
+
+    EXPECT_EQ(cache->acquire("list", "scope", context, reply), QueryStatus::MISS);
+  }
+
+  TEST_F(QueryCacheTest, shouldDropEntriesOnInvalidate) {
+    auto cache = std::make_shared<QueryCache>();
+    auto context = Bundle::create();
+    nlohmann::json reply;
+
+    cache->acquire("list", "scope", context, reply);
+    cache->complete("list", this->_reply, true);
+    cache->invalidate("scope");
+
+    EXPECT_EQ(cache->acquire("list", "scope", context, reply), QueryStatus::MISS);
+  }
+
+  TEST_F(QueryCacheTest, shouldNotCacheRepliesRequestedBeforeAnInvalidation) {
+    auto cache = std::make_shared<QueryCache>();
+    auto context = Bundle::create();
+    nlohmann::json reply;
+
+    cache->acquire("list", "scope", context, reply);
+    cache->invalidate("scope");
+
+    EXPECT_THAT(cache->complete("list", this->_reply, true), ElementsAre(context));
+    EXPECT_EQ(cache->acquire("list", "scope", context, reply), QueryStatus::MISS);
+  }
+
+  TEST_F(QueryCacheTest, shouldKeepTheOtherScopesOnInvalidate) {
+    auto cache = std::make_shared<QueryCache>();
+    auto context = Bundle::create();
+    nlohmann::json reply;
+
+    cache->acquire("rooms", "videoroom", context, reply);
+    cache->complete("rooms", this->_reply, true);
+    cache->acquire("mountpoints", "streaming", context, reply);
+    cache->complete("mountpoints", this->_reply, true);
+
+    cache->invalidate("videoroom");
+
+    EXPECT_EQ(cache->acquire("rooms", "videoroom", context, reply), QueryStatus::MISS);
+    EXPECT_EQ(cache->acquire("mountpoints", "streaming", context, reply), QueryStatus::HIT);
+  }
+
+  TEST_F(QueryCacheTest, shouldSendAgainAQueryWhoseReplyNeverCame) {
+    auto cache = std::make_shared<QueryCache>(QUERY_CACHE_TTL, 1);
+    auto first = Bundle::create();
+    auto second = Bundle::create();
+    nlohmann::json reply;
+
+    EXPECT_EQ(cache->acquire("list", "scope", first, reply), QueryStatus::MISS);
+    usleep(5000);
+
+    // whoever waited for the lost reply gets the new one
+    EXPECT_EQ(cache->acquire("list", "scope", second, reply), QueryStatus::MISS);
+    EXPECT_THAT(cache->complete("list", this->_reply, true), ElementsAre(first, second));
+  }
+
+  TEST_F(QueryCacheTest, shouldHandTheWaitersOverOnAbandon) {
+    auto cache = std::make_shared<QueryCache>();
+    auto first = Bundle::create();
+    auto second = Bundle::create();
+    nlohmann::json reply;
+
+    cache->acquire("list", "scope", first, reply);
+    cache->acquire("list", "scope", second, reply);
+
+    EXPECT_THAT(cache->abandon(), ElementsAre(first, second));
+    EXPECT_EQ(cache->acquire("list", "scope", first, reply), QueryStatus::MISS);
+  }
+
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include "janus/sdp.h"
+#include "janus/candidate_filter.h"
+
+namespace Janus {
+
+  namespace {
+
+    std::string videoSection(int mid) {
+      return
+        "m=video 9 UDP/TLS/RTP/SAVPF 96 97 98 99 102\r\n"
+        "c=IN IP4 0.0.0.0\r\n"
+        "b=AS:2000\r\n"
+        "a=mid:" + std::to_string(mid) + "\r\n"
+        "a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01\r\n"
+        "a=extmap:4 urn:3gpp:video-orientation\r\n"
+        "a=rtpmap:96 VP8/90000\r\n"
+        "a=rtcp-fb:96 nack\r\n"
+        "a=rtpmap:97 rtx/90000\r\n"
+        "a=fmtp:97 apt=96\r\n"
+        "a=rtpmap:98 VP9/90000\r\n"
+        "a=fmtp:98 profile-id=0\r\n"
+        "a=rtpmap:99 rtx/90000\r\n"
+        "a=fmtp:99 apt=98\r\n"
+        "a=rtpmap:102 H264/90000\r\n"
+        "a=fmtp:102 level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42001f\r\n";
+    }
+
+    std::string sdp(int videos) {
+      std::string description =
+        "v=0\r\n"
+        "o=- 4611731400430051336 2 IN IP4 127.0.0.1\r\n"
+        "s=-\r\n"
+        "t=0 0\r\n"
+        "m=audio 9 UDP/TLS/RTP/SAVPF 111 0 8\r\n"
+        "c=IN IP4 0.0.0.0\r\n"
+        "a=mid:audio\r\n"
+        "a=extmap:1 urn:ietf:params:rtp-hdrext:ssrc-audio-level\r\n"
+        "a=rtpmap:111 opus/48000/2\r\n"
+        "a=fmtp:111 minptime=10;useinbandfec=1\r\n"
+        "a=rtpmap:0 PCMU/8000\r\n"
+        "a=rtpmap:8 PCMA/8000\r\n";
+
+      for(int mid = 0; mid < videos; mid++) {
+        description += videoSection(mid);
+      }
+
+      return description;
+    }
+
+  }
+
+  TEST(SdpTest, shouldParseTheSessionAndTheMediaSections) {
+    Sdp parsed(sdp(2));
+
+    EXPECT_EQ(parsed.session.size(), 4u);
+    ASSERT_EQ(parsed.media.size(), 3u);
+
+    EXPECT_EQ(parsed.media[0].kind(), "audio");
+    EXPECT_EQ(parsed.media[1].kind(), "video");
+    EXPECT_EQ(parsed.media[1].payloads(), std::vector<std::string>({ "96", "97", "98", "99", "102" }));
+    EXPECT_EQ(parsed.media[1].codec("102"), "H264");
+  }
+
+  TEST(SdpTest, shouldSerializeWhatItParsed) {
+    auto description = sdp(3);
+
+    EXPECT_EQ(Sdp(description).str(), description);
+  }
+
+  TEST(SdpTest, shouldAcceptBareNewLines) {
+    Sdp parsed("v=0\nm=audio 9 RTP/AVP 0\na=rtpmap:0 PCMU/8000\n");
+
+    EXPECT_EQ(parsed.str(), "v=0\r\nm=audio 9 RTP/AVP 0\r\na=rtpmap:0 PCMU/8000\r\n");
+  }
+
+  TEST(SdpTest, shouldIndexTheDescriptionInPlace) {
+    SessionDescription description(sdp(2));
+
+    ASSERT_EQ(description.mediaCount(), 3u);
+    EXPECT_TRUE(description.kind(0).equals("audio"));
+    EXPECT_TRUE(description.kind(2).equals("video"));
+    EXPECT_TRUE(description.mline(1).equals("m=video 9 UDP/TLS/RTP/SAVPF 96 97 98 99 102"));
+
+    auto buffer = description.str().data();
+    auto mline = description.mline(1);
+    EXPECT_GE(mline.data, buffer);
+    EXPECT_LT(mline.data, buffer + description.str().size());
+  }
+
+  TEST(SdpTest, shouldFindTheAttributes) {
+    SessionDescription description("v=0\r\na=ice-lite\r\nm=audio 9 RTP/AVP 0\r\na=mid:audio\r\na=rtpmap:0 PCMU/8000\r\na=sendrecv\r\n");
+
+    SdpSlice value;
+    EXPECT_TRUE(description.attribute("ice-lite", value));
+    EXPECT_EQ(value.size, 0u);
+
+    EXPECT_TRUE(description.attribute(0, "mid", value));
+    EXPECT_EQ(value.str(), "audio");
+
+    EXPECT_TRUE(description.attribute(0, "sendrecv", value));
+    EXPECT_FALSE(description.attribute(0, "send", value));
+    EXPECT_FALSE(description.attribute(0, "ice-lite", value));
+
+    auto rtpmaps = description.attributes(0, "rtpmap");
+    ASSERT_EQ(rtpmaps.size(), 1u);
+    EXPECT_EQ(rtpmaps[0].str(), "0 PCMU/8000");
+  }
+
+  TEST(SdpTest, shouldParseTheCandidatesWithoutCopies) {
+    SessionDescription description(
+      "v=0\r\n"
+      "m=audio 9 UDP/TLS/RTP/SAVPF 111\r\n"
+      "a=candidate:1 1 udp 2122260223 192.168.1.2 56143 typ host generation 0\r\n"
+      "a=candidate:2 1 udp 1686052607 1.2.3.4 56143 typ srflx raddr 192.168.1.2 rport 56143\r\n"
+    );
+
+    auto candidates = description.candidates(0);
+    ASSERT_EQ(candidates.size(), 2u);
+
+    CandidateInfo info;
+    EXPECT_TRUE(parseCandidate(candidates[0].data, candidates[0].size, info));
+    EXPECT_EQ(info.type, HOST);
+    EXPECT_TRUE(parseCandidate(candidates[1].data, candidates[1].size, info));
+    EXPECT_EQ(info.type, SRFLX);
+  }
+
+  TEST(SdpTest, shouldBuildTheModelFromTheIndex) {
+    auto text = sdp(2);
+    SessionDescription description(text);
+
+    EXPECT_EQ(Sdp(description).str(), text);
+  }
+
+  TEST(SdpTest, shouldPreferTheGivenCodecs) {
+    Sdp parsed(sdp(1));
+
+    SdpCodecPreference preference("video", { "h264", "VP9" });
+    preference.apply(parsed, SdpType::OFFER);
+
+    EXPECT_EQ(parsed.media[1].lines[0], "m=video 9 UDP/TLS/RTP/SAVPF 102 98 96 97 99");
+    EXPECT_EQ(parsed.media[0].lines[0], "m=audio 9 UDP/TLS/RTP/SAVPF 111 0 8");
+  }
+
+  TEST(SdpTest, shouldStripACodecWithItsRetransmissions) {
+    Sdp parsed(sdp(1));
+
+    SdpCodecFilter filter("video", { "VP8" });
+    filter.apply(parsed, SdpType::OFFER);
+
+    auto& video = parsed.media[1];
+    EXPECT_EQ(video.payloads(), std::vector<std::string>({ "98", "99", "102" }));
+    for(auto& line : video.lines) {
+      EXPECT_EQ(line.find("a=rtpmap:96 "), std::string::npos);
+      EXPECT_EQ(line.find("a=rtcp-fb:96 "), std::string::npos);
+      EXPECT_EQ(line.find("a=fmtp:97 "), std::string::npos);
+    }
+  }
+
+  TEST(SdpTest, shouldNeverStripEveryCodec) {
+    auto description = sdp(1);
+    Sdp parsed(description);
+
+    SdpCodecFilter filter("audio", { "opus", "PCMU", "PCMA" });
+    filter.apply(parsed, SdpType::OFFER);
+
+    EXPECT_EQ(parsed.str(), description);
+  }
+
+  TEST(SdpTest, shouldStripTheHeaderExtensions) {
+    Sdp parsed(sdp(2));
+
+    SdpExtensionFilter filter({ "urn:3gpp:video-orientation" });
+    filter.apply(parsed, SdpType::ANSWER);
+
+    EXPECT_EQ(parsed.str().find("urn:3gpp:video-orientation"), std::string::npos);
+    EXPECT_NE(parsed.str().find("transport-wide-cc"), std::string::npos);
+  }
+
+  TEST(SdpTest, shouldCapTheBandwidthAfterTheConnectionLine) {
+    Sdp parsed(sdp(1));
+
+    SdpBandwidth bandwidth("video", 512);
+    bandwidth.apply(parsed, SdpType::OFFER);
+
+    auto& video = parsed.media[1];
+    EXPECT_EQ(video.lines[1], "c=IN IP4 0.0.0.0");
+    EXPECT_EQ(video.lines[2], "b=AS:512");
+    EXPECT_EQ(video.lines[3], "b=TIAS:512000");
+    EXPECT_EQ(video.lines[4], "a=mid:0");
+  }
+
+  TEST(SdpTest, shouldLeaveTheDescriptionUntouchedWithoutTransforms) {
+    SdpPipeline pipeline;
+
+    EXPECT_EQ(pipeline.run("not really an sdp", SdpType::OFFER), "not really an sdp");
+
+    auto description = std::make_shared<SessionDescription>(sdp(1));
+    EXPECT_EQ(pipeline.run(description, SdpType::OFFER), description);
+  }
+
+  TEST(SdpTest, shouldRunTheTransformsInOrder) {
+    SdpPipeline pipeline;
+    pipeline.add(std::make_shared<SdpCodecFilter>("video", std::vector<std::string>({ "VP9" })));
+    pipeline.add(std::make_shared<SdpCodecPreference>("video", std::vector<std::string>({ "H264" })));
+
+    Sdp rewritten(pipeline.run(sdp(1), SdpType::OFFER));
+
+    EXPECT_EQ(rewritten.media[1].lines[0], "m=video 9 UDP/TLS/RTP/SAVPF 102 96 97");
+  }
+
+  TEST(SdpTest, shouldRewriteAnIndexedDescription) {
+    SdpPipeline pipeline;
+    pipeline.add(std::make_shared<SdpBandwidth>("video", 512));
+
+    auto description = std::make_shared<SessionDescription>(sdp(2));
+    auto rewritten = pipeline.run(description, SdpType::OFFER);
+
+    ASSERT_EQ(rewritten->mediaCount(), 3u);
+    EXPECT_EQ(rewritten->attributes(2, "mid")[0].str(), "1");
+    EXPECT_EQ(rewritten->str(), pipeline.run(sdp(2), SdpType::OFFER));
+    EXPECT_NE(rewritten->str().find("b=AS:512"), std::string::npos);
+  }
+
+}
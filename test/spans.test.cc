@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <thread>
+
+#include "janus/spans.h"
+#include "janus/transport.h"
+
+#include "mocks/transport_delegate.h"
+#include "mocks/http_factory.h"
+#include "mocks/http.h"
+#include "mocks/async.h"
+
+using testing::NiceMock;
+using testing::Return;
+using testing::Invoke;
+using testing::_;
+
+namespace Janus {
+
+  class SpansTest : public testing::Test {
+    protected:
+      void SetUp() override {
+        Spans::enable(true);
+        Spans::clear();
+      }
+
+      void TearDown() override {
+        Spans::enable(false);
+        Spans::clear();
+      }
+
+      std::vector<nlohmann::json> _events(const std::string& name) {
+        std::vector<nlohmann::json> events;
+        auto trace = Spans::chromeTrace();
+        for(auto& event : trace["traceEvents"]) {
+          if(event["name"] == name) {
+            events.push_back(event);
+          }
+        }
+
+        return events;
+      }
+  };
+
+  TEST_F(SpansTest, shouldRecordNothingWhileDisabled) {
+    Spans::enable(false);
+
+    Spans::record("yolo", "a transaction", 0, 10);
+    {
+      SpanScope span("scope", std::string("a transaction"));
+    }
+
+    EXPECT_EQ(Spans::chromeTrace()["traceEvents"].size(), 0u);
+  }
+
+  TEST_F(SpansTest, shouldExportCompleteAndAsyncEvents) {
+    Spans::record("network", "a transaction", 100, 350);
+    Spans::record("queue", "a transaction", 50, 100, true);
+
+    auto events = Spans::chromeTrace()["traceEvents"];
+    ASSERT_EQ(events.size(), 3u);
+
+    EXPECT_EQ(events[0]["name"], "network");
+    EXPECT_EQ(events[0]["ph"], "X");
+    EXPECT_EQ(events[0]["ts"], 100);
+    EXPECT_EQ(events[0]["dur"], 250);
+    EXPECT_EQ(events[0]["args"]["transaction"], "a transaction");
+
+    EXPECT_EQ(events[1]["ph"], "b");
+    EXPECT_EQ(events[1]["ts"], 50);
+    EXPECT_EQ(events[1]["id"], "a transaction");
+    EXPECT_EQ(events[2]["ph"], "e");
+    EXPECT_EQ(events[2]["ts"], 100);
+    EXPECT_EQ(events[2]["tid"], events[0]["tid"]);
+  }
+
+  TEST_F(SpansTest, shouldCutTheLongTransactions) {
+    Spans::record("network", "a transaction way longer than twenty four chars", 0, 1);
+
+    auto events = this->_events("network");
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0]["args"]["transaction"], "a transaction way longer");
+  }
+
+  TEST_F(SpansTest, shouldKeepTheLatestSpansOnceTheRingWraps) {
+    for(int64_t index = 0; index < SPAN_RING_SIZE + 10; index++) {
+      Spans::record("yolo", "", index, index + 1);
+    }
+
+    auto events = Spans::chromeTrace()["traceEvents"];
+    ASSERT_EQ(events.size(), (size_t) SPAN_RING_SIZE);
+    EXPECT_EQ(events[0]["ts"], 10);
+  }
+
+  TEST_F(SpansTest, shouldTellTheThreadsApart) {
+    Spans::record("main", "", 0, 1);
+    std::thread([] {
+      Spans::record("worker", "", 0, 1);
+    }).join();
+
+    EXPECT_NE(this->_events("main")[0]["tid"], this->_events("worker")[0]["tid"]);
+  }
+
+  TEST_F(SpansTest, shouldTimeTheStagesOfAnHttpTransaction) {
+    auto delegate = std::make_shared<NiceMock<TransportDelegateMock>>();
+
+    nlohmann::json reply = { { "janus", "ack" }, { "transaction", "a transaction" } };
+    auto client = std::make_shared<NiceMock<HttpMock>>();
+    ON_CALL(*client, post(_, _)).WillByDefault(Return(std::make_shared<HttpResponse>(200, reply.dump())));
+
+    auto factory = std::make_shared<NiceMock<HttpFactoryMock>>();
+    ON_CALL(*factory, create("http://base")).WillByDefault(Return(client));
+
+    auto async = std::make_shared<NiceMock<AsyncMock>>();
+    ON_CALL(*async, submit(_)).WillByDefault(Invoke([](Task task) {
+      task();
+    }));
+
+    auto transport = std::make_shared<HttpTransport>("http://base", delegate, factory, async);
+    transport->send({ { "janus", "message" }, { "transaction", "a transaction" } }, Bundle::create());
+
+    for(auto& stage : { "pool", "network", "parse", "handle" }) {
+      auto events = this->_events(stage);
+      ASSERT_EQ(events.size(), 1u) << stage;
+      EXPECT_EQ(events[0]["ph"], "X");
+      EXPECT_EQ(events[0]["args"]["transaction"], "a transaction");
+    }
+
+    auto queue = this->_events("queue");
+    ASSERT_EQ(queue.size(), 2u);
+    EXPECT_EQ(queue[0]["id"], "a transaction");
+
+    auto flow = this->_events("transaction");
+    ASSERT_EQ(flow.size(), 2u);
+    EXPECT_EQ(flow[0]["ts"], queue[0]["ts"]);
+    EXPECT_EQ(flow[1]["ts"], this->_events("handle")[0]["ts"].get<int64_t>() + this->_events("handle")[0]["dur"].get<int64_t>());
+  }
+
+  TEST_F(SpansTest, shouldKeyALongPollByTheTransactionItBringsBack) {
+    auto delegate = std::make_shared<NiceMock<TransportDelegateMock>>();
+
+    nlohmann::json event = { { "janus", "event" }, { "transaction", "an older transaction" } };
+    auto client = std::make_shared<NiceMock<HttpMock>>();
+    ON_CALL(*client, get(_)).WillByDefault(Return(std::make_shared<HttpResponse>(200, event.dump())));
+
+    auto factory = std::make_shared<NiceMock<HttpFactoryMock>>();
+    ON_CALL(*factory, create("http://base")).WillByDefault(Return(client));
+
+    // the first long poll runs, the one it queues does not
+    auto async = std::make_shared<NiceMock<AsyncMock>>();
+    int submitted = 0;
+    ON_CALL(*async, submit(_)).WillByDefault(Invoke([&submitted](Task task) {
+      if(submitted++ == 0) {
+        task();
+      }
+    }));
+
+    auto transport = std::make_shared<HttpTransport>("http://base", delegate, factory, async);
+    transport->sessionId("69");
+
+    auto network = this->_events("network");
+    ASSERT_EQ(network.size(), 1u);
+    EXPECT_EQ(network[0]["args"]["transaction"], "an older transaction");
+  }
+
+}
@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <condition_variable>
+#include <mutex>
+
+#include "janus/synthetic_peer.h"
+#include "janus/constraints_builder.hpp"
+#include "janus/bundle_impl.h"
+#include "janus/candidate_filter.h"
+#include "janus/sdp.h"
+
+#include "mocks/protocol.h"
+
+using testing::NiceMock;
+using testing::_;
+using testing::Invoke;
+
+namespace Janus {
+
+  class SyntheticPeerTest : public testing::Test {
+    protected:
+      void SetUp() override {
+        this->_owner = std::make_shared<NiceMock<ProtocolMock>>();
+
+        ON_CALL(*this->_owner, onOffer(_, _)).WillByDefault(Invoke([this](const std::string& sdp, const std::shared_ptr<Bundle>& context) {
+          this->_push("offer", sdp);
+        }));
+        ON_CALL(*this->_owner, onAnswer(_, _)).WillByDefault(Invoke([this](const std::string& sdp, const std::shared_ptr<Bundle>& context) {
+          this->_push("answer", sdp);
+        }));
+        ON_CALL(*this->_owner, onIceCandidate(_, _, _, _)).WillByDefault(Invoke([this](const std::string& mid, int32_t index, const std::string& sdp, int64_t id) {
+          this->_push("candidate", mid + " " + std::to_string(id) + " " + sdp);
+        }));
+        ON_CALL(*this->_owner, onIceCompleted(_)).WillByDefault(Invoke([this](int64_t id) {
+          this->_push("completed", std::to_string(id));
+        }));
+      }
+
+      void _push(const std::string& type, const std::string& value) {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_calls.emplace_back(type, value);
+        this->_changed.notify_all();
+      }
+
+      std::vector<std::pair<std::string, std::string>> _wait(size_t count) {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        this->_changed.wait_for(lock, std::chrono::seconds(2), [this, count] {
+          return this->_calls.size() >= count;
+        });
+
+        return this->_calls;
+      }
+
+      Constraints _constraints(bool audio, bool video, bool data) {
+        auto constraints = ConstraintsBuilder::create()->build();
+        constraints.sdp.send_audio = constraints.sdp.receive_audio = audio;
+        constraints.sdp.send_video = constraints.sdp.receive_video = video;
+        constraints.sdp.datachannel = data;
+
+        return constraints;
+      }
+
+      std::shared_ptr<NiceMock<ProtocolMock>> _owner;
+      std::vector<std::pair<std::string, std::string>> _calls;
+      std::mutex _mutex;
+      std::condition_variable _changed;
+  };
+
+  TEST_F(SyntheticPeerTest, shouldOfferTheRequestedMedia) {
+    auto factory = std::make_shared<SyntheticPeerFactory>();
+    auto peer = factory->create(1234, this->_owner);
+
+    peer->createOffer(this->_constraints(true, true, true), Bundle::create());
+
+    auto calls = this->_wait(1);
+    ASSERT_EQ(calls.size(), 1u);
+    EXPECT_EQ(calls[0].first, "offer");
+
+    SessionDescription offer(calls[0].second);
+    ASSERT_EQ(offer.mediaCount(), 3u);
+    EXPECT_EQ(offer.kind(0).str(), "audio");
+    EXPECT_EQ(offer.kind(1).str(), "video");
+    EXPECT_EQ(offer.kind(2).str(), "application");
+
+    SdpSlice value;
+    EXPECT_TRUE(offer.attribute("group", value));
+    EXPECT_EQ(value.str(), "BUNDLE 0 1 2");
+    EXPECT_TRUE(offer.attribute(0, "sendrecv", value));
+    EXPECT_TRUE(offer.attribute(1, "setup", value));
+    EXPECT_EQ(value.str(), "actpass");
+    EXPECT_EQ(offer.attributes(1, "rtpmap").size(), 6u);
+    EXPECT_EQ(offer.attributes(1, "ssrc").size(), 2u);
+  }
+
+  TEST_F(SyntheticPeerTest, shouldOfferOneRidPerSimulcastEncoding) {
+    auto factory = std::make_shared<SyntheticPeerFactory>();
+    auto peer = factory->create(1234, this->_owner);
+
+    auto constraints = this->_constraints(false, true, false);
+    constraints.sdp.receive_video = false;
+    constraints.video.encodings = ConstraintsBuilder::create()->encoding("h", 1, 0, 0)->encoding("m", 2, 0, 0)->encoding("l", 4, 0, 0)->build().video.encodings;
+    peer->createOffer(constraints, Bundle::create());
+
+    auto calls = this->_wait(1);
+    ASSERT_EQ(calls.size(), 1u);
+
+    SessionDescription offer(calls[0].second);
+    ASSERT_EQ(offer.mediaCount(), 1u);
+
+    SdpSlice value;
+    EXPECT_TRUE(offer.attribute(0, "sendonly", value));
+    EXPECT_EQ(offer.attributes(0, "rid").size(), 3u);
+    EXPECT_TRUE(offer.attribute(0, "simulcast", value));
+    EXPECT_EQ(value.str(), "send h;m;l");
+  }
+
+  TEST_F(SyntheticPeerTest, shouldMirrorTheRemoteOfferInTheAnswer) {
+    auto factory = std::make_shared<SyntheticPeerFactory>();
+    auto peer = factory->create(1234, this->_owner);
+
+    std::string remote = "v=0\r\no=- 1 1 IN IP4 127.0.0.1\r\ns=-\r\nt=0 0\r\n"
+      "m=video 9 UDP/TLS/RTP/SAVPF 102 96\r\nc=IN IP4 0.0.0.0\r\na=mid:v\r\na=sendonly\r\na=rtpmap:102 H264/90000\r\na=rtpmap:96 VP8/90000\r\n"
+      "m=audio 9 UDP/TLS/RTP/SAVPF 111\r\nc=IN IP4 0.0.0.0\r\na=mid:a\r\na=sendonly\r\na=rtpmap:111 opus/48000/2\r\n";
+    peer->setRemoteDescription(SdpType::OFFER, remote);
+
+    auto constraints = this->_constraints(true, true, false);
+    constraints.sdp.send_audio = constraints.sdp.send_video = false;
+    peer->createAnswer(constraints, Bundle::create());
+
+    auto calls = this->_wait(1);
+    ASSERT_EQ(calls.size(), 1u);
+    EXPECT_EQ(calls[0].first, "answer");
+
+    SessionDescription answer(calls[0].second);
+    ASSERT_EQ(answer.mediaCount(), 2u);
+    EXPECT_EQ(answer.mline(0).str(), "m=video 9 UDP/TLS/RTP/SAVPF 102 103");
+    EXPECT_EQ(answer.mline(1).str(), "m=audio 9 UDP/TLS/RTP/SAVPF 111");
+
+    SdpSlice value;
+    EXPECT_TRUE(answer.attribute(0, "mid", value));
+    EXPECT_EQ(value.str(), "v");
+    EXPECT_TRUE(answer.attribute(0, "recvonly", value));
+    EXPECT_TRUE(answer.attribute(1, "setup", value));
+    EXPECT_EQ(value.str(), "active");
+  }
+
+  TEST_F(SyntheticPeerTest, shouldTrickleAConfiguredBurstOnTheBundledMline) {
+    SyntheticPeerConf conf;
+    conf.hostCandidates = 2;
+    conf.tcpCandidates = false;
+    conf.srflxCandidates = 1;
+    conf.relayCandidates = 1;
+
+    auto factory = std::make_shared<SyntheticPeerFactory>(conf);
+    auto peer = factory->create(1234, this->_owner);
+
+    peer->createOffer(this->_constraints(true, true, false), Bundle::create());
+    auto offer = this->_wait(1)[0].second;
+
+    peer->setLocalDescription(SdpType::OFFER, offer);
+
+    auto calls = this->_wait(6);
+    ASSERT_EQ(calls.size(), 6u);
+    EXPECT_EQ(calls[5].first, "completed");
+    EXPECT_EQ(calls[5].second, "1234");
+
+    std::vector<CandidateType> types;
+    for(size_t index = 1; index < 5; index++) {
+      EXPECT_EQ(calls[index].first, "candidate");
+      EXPECT_EQ(calls[index].second.compare(0, 7, "0 1234 "), 0);
+
+      CandidateInfo info;
+      EXPECT_TRUE(parseCandidate(calls[index].second.substr(7), info));
+      types.push_back(info.type);
+    }
+
+    EXPECT_EQ(types, std::vector<CandidateType>({ HOST, HOST, SRFLX, RELAY }));
+  }
+
+  TEST_F(SyntheticPeerTest, shouldGatherOnEveryMlineWithoutBundle) {
+    SyntheticPeerConf conf;
+    conf.hostCandidates = 1;
+    conf.tcpCandidates = false;
+    conf.srflxCandidates = 0;
+    conf.bundle = false;
+
+    auto factory = std::make_shared<SyntheticPeerFactory>(conf);
+    auto peer = factory->create(1234, this->_owner);
+
+    peer->createOffer(this->_constraints(true, true, false), Bundle::create());
+    auto offer = this->_wait(1)[0].second;
+
+    peer->setLocalDescription(SdpType::OFFER, offer);
+
+    auto calls = this->_wait(4);
+    ASSERT_EQ(calls.size(), 4u);
+    EXPECT_EQ(calls[1].second.compare(0, 2, "0 "), 0);
+    EXPECT_EQ(calls[2].second.compare(0, 2, "1 "), 0);
+    EXPECT_EQ(calls[3].first, "completed");
+  }
+
+  TEST_F(SyntheticPeerTest, shouldSpaceTheCandidatesOfABurst) {
+    SyntheticPeerConf conf;
+    conf.gatheringDelay = 20;
+    conf.candidateInterval = 20;
+    conf.hostCandidates = 2;
+    conf.tcpCandidates = false;
+    conf.srflxCandidates = 0;
+
+    auto factory = std::make_shared<SyntheticPeerFactory>(conf);
+    auto peer = factory->create(1234, this->_owner);
+
+    auto start = std::chrono::steady_clock::now();
+    peer->setLocalDescription(SdpType::OFFER, "v=0\r\nm=audio 9 UDP/TLS/RTP/SAVPF 111\r\na=mid:0\r\n");
+
+    auto calls = this->_wait(3);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    ASSERT_EQ(calls.size(), 3u);
+    EXPECT_GE(elapsed, 60);
+  }
+
+  TEST_F(SyntheticPeerTest, shouldStayQuietOnceClosed) {
+    SyntheticPeerConf conf;
+    conf.offerDelay = 20;
+
+    auto factory = std::make_shared<SyntheticPeerFactory>(conf);
+    auto peer = factory->create(1234, this->_owner);
+
+    EXPECT_CALL(*this->_owner, onOffer(_, _)).Times(0);
+    peer->createOffer(this->_constraints(true, true, false), Bundle::create());
+    peer->close();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "janus/trace.h"
+#include "janus/janus_api.h"
+
+#include "mocks/transport_factory.h"
+#include "mocks/transport.h"
+#include "mocks/transport_delegate.h"
+#include "mocks/protocol_delegate.h"
+#include "mocks/platform.h"
+#include "mocks/plugin.h"
+#include "mocks/random.h"
+#include "mocks/janus_conf.h"
+#include "mocks/matchers.h"
+
+using testing::NiceMock;
+using testing::_;
+using testing::Return;
+using testing::SaveArg;
+using testing::IsJsonEq;
+
+namespace Janus {
+
+  class TraceTest : public testing::Test {
+    protected:
+      void SetUp() override {
+        this->_path = testing::TempDir() + "janus_trace_" + testing::UnitTest::GetInstance()->current_test_info()->name() + ".jsonl";
+        std::remove(this->_path.c_str());
+      }
+
+      void TearDown() override {
+        std::remove(this->_path.c_str());
+      }
+
+      TraceEntry _entry(int64_t at, TraceDirection direction, int64_t sequence, const nlohmann::json& message) {
+        TraceEntry entry;
+        entry.at = at;
+        entry.direction = direction;
+        entry.sequence = sequence;
+        entry.message = message;
+
+        return entry;
+      }
+
+      std::string _path;
+  };
+
+  TEST_F(TraceTest, shouldRecordTheSendsAndTheirReplies) {
+    auto transport = std::make_shared<NiceMock<TransportMock>>();
+    auto factory = std::make_shared<NiceMock<TransportFactoryMock>>();
+    auto delegate = std::make_shared<NiceMock<TransportDelegateMock>>();
+
+    std::shared_ptr<TransportDelegate> tracingDelegate;
+    EXPECT_CALL(*factory, create("http://yolo", _)).WillOnce(testing::DoAll(SaveArg<1>(&tracingDelegate), Return(transport)));
+
+    nlohmann::json create = { { "janus", "create" }, { "transaction", "yolo" } };
+    nlohmann::json success = { { "janus", "success" }, { "data", { { "id", 69 } } } };
+    nlohmann::json keepalive = { { "janus", "keepalive" } };
+
+    EXPECT_CALL(*transport, send(IsJsonEq(create), _)).Times(1);
+    EXPECT_CALL(*delegate, onMessage(IsJsonEq(success), _)).Times(1);
+    EXPECT_CALL(*delegate, onMessage(IsJsonEq(keepalive), _)).Times(1);
+
+    auto recorder = std::make_shared<TraceRecorder>(this->_path);
+    ASSERT_TRUE(recorder->good());
+
+    auto tracing = std::make_shared<TracingTransportFactory>(factory, recorder);
+    auto traced = tracing->create("http://yolo", delegate);
+
+    auto context = Bundle::create();
+    traced->send(create, context);
+    tracingDelegate->onMessage(success, context);
+    tracingDelegate->onMessage(keepalive, Bundle::create());
+
+    auto entries = readTrace(this->_path);
+    ASSERT_EQ(entries.size(), 3u);
+
+    EXPECT_EQ(entries[0].direction, TraceDirection::OUTGOING);
+    EXPECT_EQ(entries[0].sequence, 0);
+    EXPECT_EQ(entries[0].message, create);
+
+    EXPECT_EQ(entries[1].direction, TraceDirection::INCOMING);
+    EXPECT_EQ(entries[1].sequence, 0);
+    EXPECT_EQ(entries[1].message, success);
+    EXPECT_GE(entries[1].at, entries[0].at);
+
+    EXPECT_EQ(entries[2].direction, TraceDirection::INCOMING);
+    EXPECT_EQ(entries[2].sequence, TRACE_NO_REQUEST);
+    EXPECT_EQ(entries[2].message, keepalive);
+  }
+
+  TEST_F(TraceTest, shouldStartANewTraceWithEachRecorder) {
+    nlohmann::json create = { { "janus", "create" }, { "transaction", "yolo" } };
+    nlohmann::json destroy = { { "janus", "destroy" }, { "transaction", "yolo" } };
+
+    TraceRecorder(this->_path).sent(create);
+    TraceRecorder(this->_path).sent(destroy);
+
+    auto entries = readTrace(this->_path);
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].sequence, 0);
+    EXPECT_EQ(entries[0].message, destroy);
+  }
+
+  TEST_F(TraceTest, shouldSkipTheTruncatedLines) {
+    {
+      std::ofstream file(this->_path);
+      file << "{\"t\":0,\"d\":\"out\",\"s\":0,\"m\":{\"janus\":\"create\"}}\n";
+      file << "{\"t\":10,\"d\":\"in\",\"s\":0,\"m\":{\"janus\":\"success\"}}\n";
+      file << "{\"t\":20,\"d\":\"in\",\"s\":-1,\"m\":{\"janus\":\"ev";
+    }
+
+    auto entries = readTrace(this->_path);
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[1].at, 10);
+    EXPECT_EQ(entries[1].message["janus"], "success");
+  }
+
+  TEST_F(TraceTest, shouldReplayARecordingThroughTheProtocol) {
+    std::vector<TraceEntry> entries = {
+      this->_entry(0, TraceDirection::OUTGOING, 0, { { "janus", "create" }, { "transaction", "a" } }),
+      this->_entry(100, TraceDirection::INCOMING, 0, { { "janus", "success" }, { "transaction", "a" }, { "data", { { "id", 1 } } } }),
+      this->_entry(200, TraceDirection::OUTGOING, 1, { { "janus", "attach" }, { "plugin", "my yolo plugin" }, { "transaction", "b" } }),
+      this->_entry(300, TraceDirection::INCOMING, 1, { { "janus", "success" }, { "transaction", "b" }, { "data", { { "id", 2 } } } }),
+      this->_entry(400, TraceDirection::INCOMING, TRACE_NO_REQUEST, { { "janus", "event" }, { "sender", 2 }, { "plugindata", { { "data", { { "echotest", "event" } } } } } })
+    };
+
+    auto random = std::make_shared<NiceMock<RandomMock>>();
+    ON_CALL(*random, generate()).WillByDefault(Return("yolo random string"));
+
+    auto conf = std::make_shared<NiceMock<JanusConfMock>>();
+    ON_CALL(*conf, url()).WillByDefault(Return("http://yolo"));
+    ON_CALL(*conf, plugin()).WillByDefault(Return("my yolo plugin"));
+
+    auto plugin = std::make_shared<NiceMock<PluginMock>>();
+    auto platform = std::make_shared<NiceMock<PlatformMock>>();
+    ON_CALL(*platform, plugin("my yolo plugin", 2, _)).WillByDefault(Return(plugin));
+
+    auto delegate = std::make_shared<NiceMock<ProtocolDelegateMock>>();
+    EXPECT_CALL(*delegate, onReady()).Times(1);
+    EXPECT_CALL(*plugin, onEvent(_, _)).Times(1);
+
+    auto factory = std::make_shared<ReplayTransportFactory>(entries);
+    auto api = std::make_shared<JanusApi>(random, factory);
+    api->init(conf, platform, delegate);
+
+    auto stats = factory->transport()->wait(2000);
+    EXPECT_TRUE(stats.done);
+    EXPECT_FALSE(stats.stalled);
+    EXPECT_EQ(stats.delivered, 3);
+    EXPECT_EQ(stats.sent, 2);
+    EXPECT_EQ(stats.mismatched, 0);
+  }
+
+  TEST_F(TraceTest, shouldCountTheSendsThatDivergeFromTheRecording) {
+    std::vector<TraceEntry> entries = {
+      this->_entry(0, TraceDirection::OUTGOING, 0, { { "janus", "create" } }),
+      this->_entry(0, TraceDirection::OUTGOING, 1, { { "janus", "message" }, { "body", { { "request", "join" } } } }),
+      this->_entry(0, TraceDirection::INCOMING, 1, { { "janus", "ack" } })
+    };
+
+    auto delegate = std::make_shared<NiceMock<TransportDelegateMock>>();
+    EXPECT_CALL(*delegate, onMessage(_, _)).Times(1);
+
+    ReplayTransport transport(entries, ReplaySpeed::MAX_SPEED, delegate);
+    transport.send({ { "janus", "create" } }, Bundle::create());
+    transport.send({ { "janus", "message" }, { "body", { { "request", "publish" } } } }, Bundle::create());
+
+    auto stats = transport.wait(2000);
+    EXPECT_TRUE(stats.done);
+    EXPECT_EQ(stats.sent, 2);
+    EXPECT_EQ(stats.mismatched, 1);
+  }
+
+  TEST_F(TraceTest, shouldHandTheRepliesTheContextOfTheirSend) {
+    std::vector<TraceEntry> entries = {
+      this->_entry(0, TraceDirection::OUTGOING, 0, { { "janus", "create" } }),
+      this->_entry(0, TraceDirection::OUTGOING, 1, { { "janus", "attach" } }),
+      this->_entry(0, TraceDirection::INCOMING, 1, { { "janus", "success" } })
+    };
+
+    auto first = Bundle::create();
+    auto second = Bundle::create();
+
+    auto delegate = std::make_shared<NiceMock<TransportDelegateMock>>();
+    EXPECT_CALL(*delegate, onMessage(_, second)).Times(1);
+
+    ReplayTransport transport(entries, ReplaySpeed::MAX_SPEED, delegate);
+    transport.sendBatch({ TransportMessage({ { "janus", "create" } }, first), TransportMessage({ { "janus", "attach" } }, second) });
+
+    EXPECT_TRUE(transport.wait(2000).done);
+  }
+
+  TEST_F(TraceTest, shouldKeepTheRecordedPaceInRealTime) {
+    std::vector<TraceEntry> entries = {
+      this->_entry(1000, TraceDirection::OUTGOING, 0, { { "janus", "create" } }),
+      this->_entry(31000, TraceDirection::INCOMING, 0, { { "janus", "success" } }),
+      this->_entry(81000, TraceDirection::INCOMING, TRACE_NO_REQUEST, { { "janus", "keepalive" } })
+    };
+
+    auto delegate = std::make_shared<NiceMock<TransportDelegateMock>>();
+    EXPECT_CALL(*delegate, onMessage(_, _)).Times(2);
+
+    ReplayTransport transport(entries, ReplaySpeed::REAL_TIME, delegate);
+    transport.send({ { "janus", "create" } }, Bundle::create());
+
+    auto stats = transport.wait(2000);
+    EXPECT_TRUE(stats.done);
+    EXPECT_EQ(stats.delivered, 2);
+    EXPECT_GE(stats.elapsed, 80000);
+  }
+
+  TEST_F(TraceTest, shouldStopDeliveringOnceClosed) {
+    std::vector<TraceEntry> entries = {
+      this->_entry(0, TraceDirection::OUTGOING, 0, { { "janus", "destroy" } }),
+      this->_entry(0, TraceDirection::INCOMING, 0, { { "janus", "success" } }),
+      this->_entry(0, TraceDirection::INCOMING, TRACE_NO_REQUEST, { { "janus", "keepalive" } })
+    };
+
+    auto delegate = std::make_shared<NiceMock<TransportDelegateMock>>();
+    ReplayTransport transport(entries, ReplaySpeed::MAX_SPEED, delegate);
+    EXPECT_CALL(*delegate, onMessage(_, _)).WillOnce(testing::InvokeWithoutArgs([&transport] {
+      transport.close();
+    }));
+
+    transport.send({ { "janus", "destroy" } }, Bundle::create());
+
+    auto stats = transport.wait(2000);
+    EXPECT_TRUE(stats.done);
+    EXPECT_EQ(stats.delivered, 1);
+  }
+
+}
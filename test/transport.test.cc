@@ -71,6 +71,87 @@ namespace Janus {
     httpTransport->send(request, bundle);
   }
 
+  TEST_F(HttpTransportTest, shouldSendABatchWithASingleAsyncTask) {
+    auto first = Bundle::create();
+    auto second = Bundle::create();
+
+    nlohmann::json firstRequest = {
+      { "janus", "first request" }
+    };
+    nlohmann::json secondRequest = {
+      { "janus", "second request" }
+    };
+
+    EXPECT_CALL(*this->_async, submit(_)).Times(1);
+    {
+      InSequence sequence;
+
+      EXPECT_CALL(*this->_client, post("/", firstRequest.dump())).Times(1);
+      EXPECT_CALL(*this->_client, post("/", secondRequest.dump())).Times(1);
+      EXPECT_CALL(*this->_delegate, onMessage(IsJsonEq(this->_reply), Eq(first))).Times(1);
+      EXPECT_CALL(*this->_delegate, onMessage(IsJsonEq(this->_reply), Eq(second))).Times(1);
+    }
+
+    auto httpTransport = std::make_shared<HttpTransport>("http://base", this->_delegate, this->_factory, this->_async);
+    httpTransport->sendBatch({ TransportMessage(firstRequest, first), TransportMessage(secondRequest, second) });
+  }
+
+  TEST_F(HttpTransportTest, shouldDeliverTheRepliesThroughTheCallbacks) {
+    auto callbacks = std::make_shared<CallbackQueue>();
+
+    int delivered = 0;
+    ON_CALL(*this->_delegate, onMessage(_, _)).WillByDefault(Invoke([&delivered](const nlohmann::json& message, const std::shared_ptr<Bundle>& context) {
+      delivered++;
+    }));
+
+    auto httpTransport = std::make_shared<HttpTransport>("http://base", this->_delegate, this->_factory, this->_async, callbacks);
+    httpTransport->send({ { "janus", "test request" } }, Bundle::create());
+    httpTransport->sendBatch({ TransportMessage({ { "janus", "first request" } }, Bundle::create()), TransportMessage({ { "janus", "second request" } }, Bundle::create()) });
+
+    EXPECT_EQ(delivered, 0);
+    EXPECT_EQ(callbacks->drain(), 3);
+    EXPECT_EQ(delivered, 3);
+  }
+
+  TEST_F(HttpTransportTest, shouldReleaseTheClientBeforeTheDelegateRuns) {
+    auto first = std::make_shared<NiceMock<HttpMock>>();
+    auto second = std::make_shared<NiceMock<HttpMock>>();
+    auto httpReply = std::make_shared<HttpResponse>(200, this->_reply.dump());
+    ON_CALL(*first, post(_, _)).WillByDefault(Return(httpReply));
+    ON_CALL(*second, post(_, _)).WillByDefault(Return(httpReply));
+
+    auto factory = std::make_shared<NiceMock<HttpFactoryMock>>();
+    EXPECT_CALL(*factory, create("http://base")).WillOnce(Return(first)).WillOnce(Return(second));
+
+    auto httpTransport = std::make_shared<HttpTransport>("http://base", this->_delegate, factory, this->_async);
+
+    // the pool hands the clients out in turn: had the first one still been out, the second would serve both the nested requests
+    // the delegate outlives the test body, a raw pointer keeps it from owning the transport that owns it
+    bool nested = false;
+    auto transport = httpTransport.get();
+    ON_CALL(*this->_delegate, onMessage(_, _)).WillByDefault(Invoke([&nested, transport](const nlohmann::json& message, const std::shared_ptr<Bundle>& context) {
+      if(nested == true) {
+        return;
+      }
+
+      nested = true;
+      transport->send({ { "janus", "nested request" } }, Bundle::create());
+      transport->send({ { "janus", "nested request" } }, Bundle::create());
+    }));
+
+    EXPECT_CALL(*first, post(_, _)).Times(2);
+    EXPECT_CALL(*second, post(_, _)).Times(1);
+
+    httpTransport->send({ { "janus", "test request" } }, Bundle::create());
+  }
+
+  TEST_F(HttpTransportTest, shouldSkipEmptyBatches) {
+    EXPECT_CALL(*this->_async, submit(_)).Times(0);
+
+    auto httpTransport = std::make_shared<HttpTransport>("http://base", this->_delegate, this->_factory, this->_async);
+    httpTransport->sendBatch({});
+  }
+
   TEST_F(HttpTransportTest, shouldAppendTheSessionIdIfSet) {
     nlohmann::json request = {
       { "janus", "test request" }
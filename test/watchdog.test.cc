@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <future>
+#include <thread>
+
+#include "janus/metrics_impl.h"
+#include "janus/stall_watchdog.hpp"
+#include "janus/transport.h"
+#include "janus/watchdog.h"
+
+#include "mocks/transport_delegate.h"
+#include "mocks/http_factory.h"
+#include "mocks/http.h"
+#include "mocks/async.h"
+
+using testing::NiceMock;
+using testing::Return;
+using testing::Invoke;
+using testing::_;
+
+namespace Janus {
+
+  class WatchdogTest : public testing::Test {
+    protected:
+      void SetUp() override {
+        Watchdog::clear();
+      }
+
+      void TearDown() override {
+        Watchdog::stop();
+        Watchdog::clear();
+      }
+  };
+
+  TEST_F(WatchdogTest, shouldWatchNothingWhileStopped) {
+    EXPECT_EQ(Watchdog::begin(WATCHDOG_COMMAND, "yolo"), -1);
+
+    {
+      WatchdogScope watch(WATCHDOG_COMMAND, "yolo");
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    EXPECT_EQ(Watchdog::stalls().size(), 0u);
+  }
+
+  TEST_F(WatchdogTest, shouldFlagTheScopesThatRunPastTheThreshold) {
+    auto stalls = MetricsRegistry::instance().counter(METRIC_WATCHDOG_STALLS).value();
+    auto runs = MetricsRegistry::instance().histogram("watchdog.command_us").count();
+
+    // a threshold the monitor never gets to before the scopes end
+    Watchdog::start(10000);
+    {
+      WatchdogScope watch(WATCHDOG_COMMAND, "quick");
+    }
+    EXPECT_EQ(Watchdog::stalls().size(), 0u);
+
+    Watchdog::start(1);
+    {
+      WatchdogScope watch(WATCHDOG_COMMAND, "slow");
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    auto flagged = Watchdog::stalls();
+    ASSERT_EQ(flagged.size(), 1u);
+    EXPECT_EQ(flagged[0].origin, WATCHDOG_COMMAND);
+    EXPECT_EQ(flagged[0].name, "slow");
+    EXPECT_EQ(flagged[0].finished, true);
+    EXPECT_GE(flagged[0].runningUs, 20000);
+
+    EXPECT_EQ(MetricsRegistry::instance().counter(METRIC_WATCHDOG_STALLS).value(), stalls + 1);
+    EXPECT_EQ(MetricsRegistry::instance().histogram("watchdog.command_us").count(), runs + 2);
+  }
+
+  TEST_F(WatchdogTest, shouldCatchAScopeWhileItIsStillBlocked) {
+    std::promise<WatchdogStall> caught;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    Watchdog::start(5, [&caught](const WatchdogStall& stall) {
+      caught.set_value(stall);
+    });
+
+    std::thread blocked([released] {
+      WatchdogScope watch(WATCHDOG_PLUGIN, "janus.plugin.videoroom");
+      released.wait();
+    });
+
+    auto future = caught.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    auto stall = future.get();
+    EXPECT_EQ(stall.origin, WATCHDOG_PLUGIN);
+    EXPECT_EQ(stall.name, "janus.plugin.videoroom");
+    EXPECT_EQ(stall.finished, false);
+
+    auto report = Watchdog::report();
+    ASSERT_EQ(report["running"].size(), 1u);
+    EXPECT_EQ(report["running"][0]["origin"], WATCHDOG_PLUGIN);
+    EXPECT_EQ(report["stalls"].size(), 1u);
+
+    release.set_value();
+    blocked.join();
+
+    auto flagged = Watchdog::stalls();
+    ASSERT_EQ(flagged.size(), 1u);
+    EXPECT_EQ(flagged[0].finished, true);
+    EXPECT_GE(flagged[0].runningUs, stall.runningUs);
+  }
+
+  TEST_F(WatchdogTest, shouldWatchTheNestedScopesOfEveryThread) {
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    Watchdog::start(10000);
+
+    std::vector<std::thread> blocked;
+    for(auto& name : { "janus.plugin.videoroom", "janus.plugin.streaming" }) {
+      blocked.emplace_back([released, name] {
+        WatchdogScope callback(WATCHDOG_CALLBACK, "event");
+        WatchdogScope plugin(WATCHDOG_PLUGIN, name);
+        released.wait();
+      });
+    }
+
+    for(int attempt = 0; attempt < 500 && Watchdog::report()["running"].size() < 4; attempt++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto report = Watchdog::report();
+
+    release.set_value();
+    for(auto& thread : blocked) {
+      thread.join();
+    }
+
+    ASSERT_EQ(report["running"].size(), 4u);
+    std::vector<std::string> names;
+    for(auto& running : report["running"]) {
+      names.push_back(running["name"]);
+    }
+    EXPECT_THAT(names, testing::UnorderedElementsAre("event", "event", "janus.plugin.videoroom", "janus.plugin.streaming"));
+    EXPECT_EQ(Watchdog::report()["running"].size(), 0u);
+  }
+
+  TEST_F(WatchdogTest, shouldStartAndReportThroughTheBindings) {
+    StallWatchdog::start(1);
+    EXPECT_EQ(Watchdog::enabled(), true);
+
+    {
+      WatchdogScope watch(WATCHDOG_COMMAND, "slow");
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    auto report = nlohmann::json::parse(StallWatchdog::report());
+    EXPECT_EQ(report["threshold_ms"], 1);
+    ASSERT_EQ(report["stalls"].size(), 1u);
+    EXPECT_EQ(report["stalls"][0]["name"], "slow");
+
+    StallWatchdog::stop();
+    EXPECT_EQ(Watchdog::enabled(), false);
+  }
+
+  TEST_F(WatchdogTest, shouldFlagASlowDelegateOfTheTransport) {
+    auto delegate = std::make_shared<NiceMock<TransportDelegateMock>>();
+    ON_CALL(*delegate, onMessage(_, _)).WillByDefault(Invoke([](const nlohmann::json& message, const std::shared_ptr<Bundle>& context) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }));
+
+    nlohmann::json reply = { { "janus", "ack" }, { "transaction", "a transaction" } };
+    auto client = std::make_shared<NiceMock<HttpMock>>();
+    ON_CALL(*client, post(_, _)).WillByDefault(Return(std::make_shared<HttpResponse>(200, reply.dump())));
+
+    auto factory = std::make_shared<NiceMock<HttpFactoryMock>>();
+    ON_CALL(*factory, create("http://base")).WillByDefault(Return(client));
+
+    auto async = std::make_shared<NiceMock<AsyncMock>>();
+    ON_CALL(*async, submit(_)).WillByDefault(Invoke([](Task task) {
+      task();
+    }));
+
+    Watchdog::start(5);
+
+    auto transport = std::make_shared<HttpTransport>("http://base", delegate, factory, async);
+    transport->send({ { "janus", "message" }, { "transaction", "a transaction" } }, Bundle::create());
+
+    auto flagged = Watchdog::stalls();
+    ASSERT_EQ(flagged.size(), 1u);
+    EXPECT_EQ(flagged[0].origin, WATCHDOG_CALLBACK);
+    EXPECT_EQ(flagged[0].name, "ack");
+
+    EXPECT_GE(Watchdog::report()["queues"]["callback_us"]["count"].get<int64_t>(), 1);
+  }
+
+}
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include "janus/bundle_impl.h"
+#include "janus/constraints_builder.hpp"
+#include "janus/janus_event_impl.h"
+
+#include "fixtures.h"
+
+namespace Janus {
+
+  void BundleSetString(benchmark::State& state) {
+    auto bundle = Bundle::create();
+
+    for(auto _ : state) {
+      bundle->setString("command", "message");
+    }
+  }
+  BENCHMARK(BundleSetString);
+
+  void BundleGetString(benchmark::State& state) {
+    auto bundle = Bundle::create();
+    bundle->setString("command", "message");
+
+    for(auto _ : state) {
+      benchmark::DoNotOptimize(bundle->getString("command", ""));
+    }
+  }
+  BENCHMARK(BundleGetString);
+
+  // a miss inserts an empty slot in the map, so it is not as cheap as it looks
+  void BundleGetMissing(benchmark::State& state) {
+    auto bundle = Bundle::create();
+
+    for(auto _ : state) {
+      benchmark::DoNotOptimize(bundle->getInt("handleId", -1));
+    }
+  }
+  BENCHMARK(BundleGetMissing);
+
+  void BundleSetGetInt(benchmark::State& state) {
+    auto bundle = Bundle::create();
+
+    for(auto _ : state) {
+      bundle->setInt("handleId", BENCH_HANDLE_ID);
+      benchmark::DoNotOptimize(bundle->getInt("handleId", -1));
+    }
+  }
+  BENCHMARK(BundleSetGetInt);
+
+  void BundleConstraints(benchmark::State& state) {
+    auto bundle = Bundle::create();
+    auto constraints = ConstraintsBuilder::create()->encoding("h", 1, 0, 0)->encoding("m", 2, 0, 0)->encoding("l", 4, 0, 0)->build();
+
+    for(auto _ : state) {
+      bundle->setConstraints(constraints);
+      benchmark::DoNotOptimize(bundle->getConstraints());
+    }
+  }
+  BENCHMARK(BundleConstraints);
+
+  // walk the publishers of a videoroom event the way a plugin does
+  void JanusDataNavigation(benchmark::State& state) {
+    auto body = Fixtures::publishers(state.range(0))["plugindata"]["data"];
+    auto data = std::make_shared<JanusDataImpl>(body);
+
+    for(auto _ : state) {
+      int64_t sum = data->getInt("room", -1);
+      for(auto& publisher : data->getList("publishers")) {
+        sum += publisher->getInt("id", -1);
+        benchmark::DoNotOptimize(publisher->getString("display", ""));
+        benchmark::DoNotOptimize(publisher->getBool("simulcast", false));
+      }
+
+      benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+  BENCHMARK(JanusDataNavigation)->Arg(1)->Arg(10)->Arg(100);
+
+  void JanusEventConstruction(benchmark::State& state) {
+    auto body = Fixtures::publishers(state.range(0))["plugindata"]["data"];
+
+    for(auto _ : state) {
+      auto evt = std::make_shared<JanusEventImpl>(BENCH_HANDLE_ID, body);
+      benchmark::DoNotOptimize(evt);
+    }
+  }
+  BENCHMARK(JanusEventConstruction)->Arg(1)->Arg(10)->Arg(100);
+
+  // the jsep is parsed and indexed up front
+  void JanusEventConstructionWithJsep(benchmark::State& state) {
+    auto message = Fixtures::configured();
+    auto body = message["plugindata"]["data"];
+    auto jsep = message["jsep"];
+
+    for(auto _ : state) {
+      auto evt = std::make_shared<JanusEventImpl>(BENCH_HANDLE_ID, body, jsep);
+      benchmark::DoNotOptimize(evt);
+    }
+
+    state.SetBytesProcessed(state.iterations() * std::string(Fixtures::OFFER).size());
+  }
+  BENCHMARK(JanusEventConstructionWithJsep);
+
+}
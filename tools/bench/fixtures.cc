@@ -0,0 +1,220 @@
+#include "fixtures.h"
+
+#include "janus/bundle.hpp"
+#include "janus/janus_commands.hpp"
+
+namespace Janus {
+
+  namespace Fixtures {
+
+    const char* OFFER =
+      "v=0\r\n"
+      "o=- 4611731400430051336 2 IN IP4 127.0.0.1\r\n"
+      "s=-\r\n"
+      "t=0 0\r\n"
+      "a=group:BUNDLE 0 1 2\r\n"
+      "a=msid-semantic: WMS stream\r\n"
+      "m=audio 9 UDP/TLS/RTP/SAVPF 111 63 9 0 8 13 110 126\r\n"
+      "c=IN IP4 0.0.0.0\r\n"
+      "a=rtcp:9 IN IP4 0.0.0.0\r\n"
+      "a=ice-ufrag:Kx3v\r\n"
+      "a=ice-pwd:Pq8s9dV2nO1cZ5yT7wL3mK4j\r\n"
+      "a=ice-options:trickle\r\n"
+      "a=fingerprint:sha-256 19:E2:1C:3B:4A:9D:E8:5F:7A:6B:2C:0D:1E:3F:4A:5B:6C:7D:8E:9F:A0:B1:C2:D3:E4:F5:06:17:28:39:4A:5B\r\n"
+      "a=setup:actpass\r\n"
+      "a=mid:0\r\n"
+      "a=extmap:1 urn:ietf:params:rtp-hdrext:ssrc-audio-level\r\n"
+      "a=extmap:2 http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time\r\n"
+      "a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01\r\n"
+      "a=extmap:4 urn:ietf:params:rtp-hdrext:sdes:mid\r\n"
+      "a=sendrecv\r\n"
+      "a=msid:stream audio\r\n"
+      "a=rtcp-mux\r\n"
+      "a=rtpmap:111 opus/48000/2\r\n"
+      "a=rtcp-fb:111 transport-cc\r\n"
+      "a=fmtp:111 minptime=10;useinbandfec=1\r\n"
+      "a=rtpmap:63 red/48000/2\r\n"
+      "a=fmtp:63 111/111\r\n"
+      "a=rtpmap:9 G722/8000\r\n"
+      "a=rtpmap:0 PCMU/8000\r\n"
+      "a=rtpmap:8 PCMA/8000\r\n"
+      "a=rtpmap:13 CN/8000\r\n"
+      "a=rtpmap:110 telephone-event/48000\r\n"
+      "a=rtpmap:126 telephone-event/8000\r\n"
+      "a=ssrc:1001 cname:bench\r\n"
+      "a=ssrc:1001 msid:stream audio\r\n"
+      "m=video 9 UDP/TLS/RTP/SAVPF 96 97 98 99 102 103\r\n"
+      "c=IN IP4 0.0.0.0\r\n"
+      "a=rtcp:9 IN IP4 0.0.0.0\r\n"
+      "a=ice-ufrag:Kx3v\r\n"
+      "a=ice-pwd:Pq8s9dV2nO1cZ5yT7wL3mK4j\r\n"
+      "a=ice-options:trickle\r\n"
+      "a=fingerprint:sha-256 19:E2:1C:3B:4A:9D:E8:5F:7A:6B:2C:0D:1E:3F:4A:5B:6C:7D:8E:9F:A0:B1:C2:D3:E4:F5:06:17:28:39:4A:5B\r\n"
+      "a=setup:actpass\r\n"
+      "a=mid:1\r\n"
+      "a=extmap:14 urn:ietf:params:rtp-hdrext:toffset\r\n"
+      "a=extmap:2 http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time\r\n"
+      "a=extmap:13 urn:3gpp:video-orientation\r\n"
+      "a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01\r\n"
+      "a=extmap:4 urn:ietf:params:rtp-hdrext:sdes:mid\r\n"
+      "a=extmap:10 urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id\r\n"
+      "a=extmap:11 urn:ietf:params:rtp-hdrext:sdes:repaired-rtp-stream-id\r\n"
+      "a=sendonly\r\n"
+      "a=msid:stream video\r\n"
+      "a=rtcp-mux\r\n"
+      "a=rtcp-rsize\r\n"
+      "a=rtpmap:96 VP8/90000\r\n"
+      "a=rtcp-fb:96 goog-remb\r\n"
+      "a=rtcp-fb:96 transport-cc\r\n"
+      "a=rtcp-fb:96 ccm fir\r\n"
+      "a=rtcp-fb:96 nack\r\n"
+      "a=rtcp-fb:96 nack pli\r\n"
+      "a=rtpmap:97 rtx/90000\r\n"
+      "a=fmtp:97 apt=96\r\n"
+      "a=rtpmap:98 VP9/90000\r\n"
+      "a=rtcp-fb:98 transport-cc\r\n"
+      "a=fmtp:98 profile-id=0\r\n"
+      "a=rtpmap:99 rtx/90000\r\n"
+      "a=fmtp:99 apt=98\r\n"
+      "a=rtpmap:102 H264/90000\r\n"
+      "a=rtcp-fb:102 transport-cc\r\n"
+      "a=fmtp:102 level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42001f\r\n"
+      "a=rtpmap:103 rtx/90000\r\n"
+      "a=fmtp:103 apt=102\r\n"
+      "a=rid:h send\r\n"
+      "a=rid:m send\r\n"
+      "a=rid:l send\r\n"
+      "a=simulcast:send h;m;l\r\n"
+      "m=application 9 UDP/DTLS/SCTP webrtc-datachannel\r\n"
+      "c=IN IP4 0.0.0.0\r\n"
+      "a=ice-ufrag:Kx3v\r\n"
+      "a=ice-pwd:Pq8s9dV2nO1cZ5yT7wL3mK4j\r\n"
+      "a=ice-options:trickle\r\n"
+      "a=fingerprint:sha-256 19:E2:1C:3B:4A:9D:E8:5F:7A:6B:2C:0D:1E:3F:4A:5B:6C:7D:8E:9F:A0:B1:C2:D3:E4:F5:06:17:28:39:4A:5B\r\n"
+      "a=setup:actpass\r\n"
+      "a=mid:2\r\n"
+      "a=sctp-port:5000\r\n"
+      "a=max-message-size:262144\r\n";
+
+    nlohmann::json publishers(int count) {
+      auto list = nlohmann::json::array();
+      for(int index = 0; index < count; index++) {
+        list.push_back({
+          { "id", 1000 + index },
+          { "display", "publisher " + std::to_string(index) },
+          { "audio_codec", "opus" },
+          { "video_codec", "vp8" },
+          { "simulcast", true },
+          { "talking", false }
+        });
+      }
+
+      return {
+        { "janus", "event" },
+        { "session_id", BENCH_SESSION_ID },
+        { "sender", BENCH_HANDLE_ID },
+        { "plugindata", {
+          { "plugin", "janus.plugin.videoroom" },
+          { "data", { { "videoroom", "event" }, { "room", 1234 }, { "publishers", list } } }
+        } }
+      };
+    }
+
+    nlohmann::json configured() {
+      return {
+        { "janus", "event" },
+        { "session_id", BENCH_SESSION_ID },
+        { "sender", BENCH_HANDLE_ID },
+        { "transaction", "bench transaction" },
+        { "plugindata", {
+          { "plugin", "janus.plugin.videoroom" },
+          { "data", { { "videoroom", "event" }, { "room", 1234 }, { "configured", "ok" } } }
+        } },
+        { "jsep", { { "type", "answer" }, { "sdp", OFFER } } }
+      };
+    }
+
+    std::string conference(int videos) {
+      std::string description =
+        "v=0\r\n"
+        "o=- 4611731400430051336 2 IN IP4 127.0.0.1\r\n"
+        "s=-\r\n"
+        "t=0 0\r\n"
+        "m=audio 9 UDP/TLS/RTP/SAVPF 111 0 8\r\n"
+        "c=IN IP4 0.0.0.0\r\n"
+        "a=mid:audio\r\n"
+        "a=extmap:1 urn:ietf:params:rtp-hdrext:ssrc-audio-level\r\n"
+        "a=rtpmap:111 opus/48000/2\r\n"
+        "a=fmtp:111 minptime=10;useinbandfec=1\r\n"
+        "a=rtpmap:0 PCMU/8000\r\n"
+        "a=rtpmap:8 PCMA/8000\r\n";
+
+      for(int mid = 0; mid < videos; mid++) {
+        description +=
+          "m=video 9 UDP/TLS/RTP/SAVPF 96 97 98 99 102\r\n"
+          "c=IN IP4 0.0.0.0\r\n"
+          "b=AS:2000\r\n"
+          "a=mid:" + std::to_string(mid) + "\r\n"
+          "a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01\r\n"
+          "a=extmap:4 urn:3gpp:video-orientation\r\n"
+          "a=rtpmap:96 VP8/90000\r\n"
+          "a=rtcp-fb:96 nack\r\n"
+          "a=rtpmap:97 rtx/90000\r\n"
+          "a=fmtp:97 apt=96\r\n"
+          "a=rtpmap:98 VP9/90000\r\n"
+          "a=fmtp:98 profile-id=0\r\n"
+          "a=rtpmap:99 rtx/90000\r\n"
+          "a=fmtp:99 apt=98\r\n"
+          "a=rtpmap:102 H264/90000\r\n"
+          "a=fmtp:102 level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42001f\r\n"
+          "a=candidate:1 1 udp 2122260223 192.168.1.2 5000" + std::to_string(mid % 10) + " typ host\r\n";
+      }
+
+      return description;
+    }
+
+    std::vector<TraceEntry> session(int events) {
+      std::vector<TraceEntry> entries;
+      auto push = [&entries](TraceDirection direction, int64_t sequence, const nlohmann::json& message) {
+        TraceEntry entry;
+        entry.at = entries.size() * 1000;
+        entry.direction = direction;
+        entry.sequence = sequence;
+        entry.message = message;
+
+        entries.push_back(entry);
+      };
+
+      push(TraceDirection::OUTGOING, 0, { { "janus", "create" }, { "transaction", "bench transaction" } });
+      push(TraceDirection::INCOMING, 0, { { "janus", "success" }, { "data", { { "id", BENCH_SESSION_ID } } } });
+      push(TraceDirection::OUTGOING, 1, { { "janus", "attach" }, { "plugin", "janus.plugin.bench" }, { "transaction", "bench transaction" } });
+      push(TraceDirection::INCOMING, 1, { { "janus", "success" }, { "data", { { "id", BENCH_HANDLE_ID } } } });
+
+      auto event = publishers(10);
+      for(int index = 0; index < events; index++) {
+        push(TraceDirection::INCOMING, TRACE_NO_REQUEST, index % 10 == 0 ? configured() : event);
+      }
+
+      return entries;
+    }
+
+  }
+
+  std::shared_ptr<JanusApi> readyApi() {
+    auto api = std::make_shared<JanusApi>(std::make_shared<BenchRandom>(), std::make_shared<BenchTransportFactory>());
+    api->init(std::make_shared<BenchConf>(), std::make_shared<BenchPlatform>(), std::make_shared<BenchDelegate>());
+
+    auto create = Bundle::create();
+    create->setString("command", JanusCommands::CREATE);
+    create->setString("plugin", "janus.plugin.bench");
+    api->onMessage({ { "janus", "success" }, { "data", { { "id", BENCH_SESSION_ID } } } }, create);
+
+    auto attach = Bundle::create();
+    attach->setString("command", JanusCommands::ATTACH);
+    attach->setString("plugin", "janus.plugin.bench");
+    api->onMessage({ { "janus", "success" }, { "data", { { "id", BENCH_HANDLE_ID } } } }, attach);
+
+    return api;
+  }
+
+}
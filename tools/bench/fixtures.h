@@ -0,0 +1,132 @@
+/*!
+ * janus-client SDK
+ *
+ * fixtures.h
+ * The Benchmark Fixtures
+ * This module defines the inert collaborators and the sample payloads the benchmarks feed to the library hot paths.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "janus/janus_api.h"
+#include "janus/janus_conf.hpp"
+#include "janus/protocol_delegate.hpp"
+#include "janus/janus_error.hpp"
+#include "janus/plugin.hpp"
+#include "janus/random.h"
+#include "janus/trace.h"
+#include "janus/transport.h"
+
+#define BENCH_SESSION_ID 276911837174840
+#define BENCH_HANDLE_ID 276911837174841
+
+namespace Janus {
+
+  namespace Fixtures {
+
+    // a chrome-like offer: audio, simulcast video and a datachannel, bundled
+    extern const char* OFFER;
+
+    // a videoroom event listing a few publishers
+    nlohmann::json publishers(int count);
+
+    // the same event janus sends back to the publisher, with the answer
+    nlohmann::json configured();
+
+    // a conference offer: audio, then one VP8/VP9/H264 video section per feed
+    std::string conference(int videos);
+
+    // a recorded session: create, attach, then a stream of videoroom events
+    std::vector<TraceEntry> session(int events);
+
+  }
+
+  class BenchRandom : public Random {
+    public:
+      std::string generate() {
+        return "bench transaction";
+      }
+  };
+
+  class BenchTransport : public Transport {
+    public:
+      void sessionId(const std::string& id) {}
+      void close() {}
+
+      TransportType type() {
+        return TransportType::HTTP;
+      }
+
+      void send(const nlohmann::json& message, const std::shared_ptr<Bundle>& context) {}
+      void sendBatch(const std::vector<TransportMessage>& messages) {}
+  };
+
+  class BenchTransportFactory : public TransportFactory {
+    public:
+      std::shared_ptr<Transport> create(const std::string& url, const std::shared_ptr<TransportDelegate>& delegate) {
+        return std::make_shared<BenchTransport>();
+      }
+  };
+
+  class BenchConf : public JanusConf {
+    public:
+      std::string url() {
+        return "http://bench";
+      }
+
+      std::string plugin() {
+        return "janus.plugin.bench";
+      }
+  };
+
+  class BenchDelegate : public ProtocolDelegate {
+    public:
+      void onReady() {}
+      void onClose() {}
+      void onError(const JanusError& error, const std::shared_ptr<Bundle>& context) {}
+      void onEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context) {}
+      void onHangup(const std::string& reason) {}
+  };
+
+  class BenchPlugin : public Plugin {
+    public:
+      void onEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context) {}
+      void onHangup(const std::string& reason, const std::shared_ptr<Bundle>& context) {}
+      void onClose() {}
+      void command(const std::string& command, const std::shared_ptr<Bundle>& payload) {}
+      void onOffer(const std::string& sdp, const std::shared_ptr<Bundle>& context) {}
+      void onAnswer(const std::string& sdp, const std::shared_ptr<Bundle>& context) {}
+  };
+
+  class BenchPlatform : public PlatformImpl {
+    public:
+      void protocol(const std::shared_ptr<Protocol>& protocol) {}
+      std::shared_ptr<Protocol> protocol() {
+        return nullptr;
+      }
+
+      void pluginFactory(const std::string& id, const std::shared_ptr<PluginFactory>& factory) {}
+      std::shared_ptr<Plugin> plugin(const std::string& id, int64_t handleId, const std::shared_ptr<Protocol>& owner) {
+        return std::make_shared<BenchPlugin>();
+      }
+
+      std::shared_ptr<PeerFactory> peerFactory() {
+        return nullptr;
+      }
+
+      int32_t drainCallbacks(int64_t timeoutMs) {
+        return 0;
+      }
+  };
+
+  // a JanusApi past its create and attach replies, so every message walks the plugin path
+  std::shared_ptr<JanusApi> readyApi();
+
+}
@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+
+#include "janus/async.h"
+#include "janus/metrics_impl.h"
+#include "janus/random.h"
+#include "janus/spans.h"
+#include "janus/watchdog.h"
+
+namespace Janus {
+
+  namespace {
+
+    // every benchmark thread shares the same queue, like the transports of a Janus instance do
+    AsyncImpl& sharedAsync() {
+      static AsyncImpl async;
+
+      return async;
+    }
+
+    std::atomic<int64_t> executed { 0 };
+
+  }
+
+  void AsyncSubmit(benchmark::State& state) {
+    auto& async = sharedAsync();
+
+    for(auto _ : state) {
+      async.submit([]() {
+        executed.fetch_add(1, std::memory_order_relaxed);
+      });
+    }
+
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(AsyncSubmit)->ThreadRange(1, 8)->UseRealTime();
+
+  void RandomGenerate(benchmark::State& state) {
+    RandomImpl random;
+
+    for(auto _ : state) {
+      benchmark::DoNotOptimize(random.generate());
+    }
+  }
+  BENCHMARK(RandomGenerate);
+
+  // what every instrumented stage costs when nobody asked for spans
+  void SpansScopeDisabled(benchmark::State& state) {
+    Spans::enable(false);
+    std::string transaction = "bench transaction";
+
+    for(auto _ : state) {
+      SpanScope span("bench", transaction);
+    }
+  }
+  BENCHMARK(SpansScopeDisabled);
+
+  void SpansRecord(benchmark::State& state) {
+    Spans::enable(true);
+    std::string transaction = "bench transaction";
+
+    for(auto _ : state) {
+      Spans::record("bench", transaction, 0, 1);
+    }
+
+    Spans::enable(false);
+  }
+  BENCHMARK(SpansRecord)->ThreadRange(1, 8)->UseRealTime();
+
+  // what every watched scope costs when nobody started the watchdog
+  void WatchdogScopeDisabled(benchmark::State& state) {
+    Watchdog::stop();
+    std::string name = "bench";
+
+    for(auto _ : state) {
+      WatchdogScope watch(WATCHDOG_COMMAND, name);
+    }
+  }
+  BENCHMARK(WatchdogScopeDisabled);
+
+  void WatchdogScopeEnabled(benchmark::State& state) {
+    if(state.thread_index() == 0) {
+      Watchdog::start(1000);
+    }
+    std::string name = "bench";
+
+    for(auto _ : state) {
+      WatchdogScope watch(WATCHDOG_COMMAND, name);
+    }
+
+    if(state.thread_index() == 0) {
+      Watchdog::stop();
+    }
+  }
+  BENCHMARK(WatchdogScopeEnabled)->ThreadRange(1, 8)->UseRealTime();
+
+  void MetricsCounterAdd(benchmark::State& state) {
+    auto& counter = MetricsRegistry::instance().counter("bench.counter");
+
+    for(auto _ : state) {
+      counter.add();
+    }
+  }
+  BENCHMARK(MetricsCounterAdd)->ThreadRange(1, 8)->UseRealTime();
+
+  void MetricsHistogramRecord(benchmark::State& state) {
+    auto& histogram = MetricsRegistry::instance().histogram("bench.histogram");
+    int64_t value = 0;
+
+    for(auto _ : state) {
+      histogram.record(value++ & 0xffff);
+    }
+  }
+  BENCHMARK(MetricsHistogramRecord)->ThreadRange(1, 8)->UseRealTime();
+
+}
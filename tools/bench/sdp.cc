@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include "janus/sdp.h"
+
+#include "fixtures.h"
+
+namespace Janus {
+
+  // the rewrite a conference subscriber runs on every offer, the argument is the number of video sections
+  void SdpPipelineRun(benchmark::State& state) {
+    auto description = Fixtures::conference(state.range(0));
+
+    SdpPipeline pipeline;
+    pipeline.add(std::make_shared<SdpCodecFilter>("video", std::vector<std::string>({ "VP9" })));
+    pipeline.add(std::make_shared<SdpCodecPreference>("video", std::vector<std::string>({ "H264" })));
+    pipeline.add(std::make_shared<SdpExtensionFilter>(std::vector<std::string>({ "urn:3gpp:video-orientation" })));
+    pipeline.add(std::make_shared<SdpBandwidth>("video", 512));
+
+    for(auto _ : state) {
+      benchmark::DoNotOptimize(pipeline.run(description, SdpType::OFFER));
+    }
+
+    state.SetBytesProcessed(state.iterations() * description.size());
+  }
+  BENCHMARK(SdpPipelineRun)->Arg(8)->Arg(64);
+
+  // the line split every transform works on
+  void SdpParse(benchmark::State& state) {
+    auto description = Fixtures::conference(state.range(0));
+
+    for(auto _ : state) {
+      Sdp parsed(description);
+      benchmark::DoNotOptimize(parsed.media.size());
+    }
+
+    state.SetBytesProcessed(state.iterations() * description.size());
+  }
+  BENCHMARK(SdpParse)->Arg(8)->Arg(64);
+
+  // the read only index: the mids and the candidates of every section, with no copies
+  void SessionDescriptionIndex(benchmark::State& state) {
+    auto description = Fixtures::conference(state.range(0));
+
+    for(auto _ : state) {
+      SessionDescription indexed(description);
+
+      SdpSlice mid;
+      size_t candidates = 0;
+      for(size_t media = 0; media < indexed.mediaCount(); media++) {
+        indexed.attribute(media, "mid", mid);
+        candidates += indexed.candidates(media).size();
+      }
+      benchmark::DoNotOptimize(candidates);
+    }
+
+    state.SetBytesProcessed(state.iterations() * description.size());
+  }
+  BENCHMARK(SessionDescriptionIndex)->Arg(8)->Arg(64);
+
+}
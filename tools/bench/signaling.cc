@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+#include "janus/bundle.hpp"
+#include "janus/janus_api.h"
+#include "janus/trace.h"
+
+#include "fixtures.h"
+
+namespace Janus {
+
+  void MessagesCreate(benchmark::State& state) {
+    for(auto _ : state) {
+      benchmark::DoNotOptimize(Messages::create("bench transaction").dump());
+    }
+  }
+  BENCHMARK(MessagesCreate);
+
+  void MessagesTrickle(benchmark::State& state) {
+    auto candidate = "candidate:1 1 udp 2122260223 192.168.1.2 50000 typ host generation 0 ufrag Kx3v network-id 1";
+
+    for(auto _ : state) {
+      benchmark::DoNotOptimize(Messages::trickle("bench transaction", BENCH_HANDLE_ID, "0", 0, candidate).dump());
+    }
+  }
+  BENCHMARK(MessagesTrickle);
+
+  // a publish carries the whole offer, so the dump is mostly string escaping
+  void MessagesMessageWithJsep(benchmark::State& state) {
+    nlohmann::json body = {
+      { "body", { { "request", "publish" }, { "audio", true }, { "video", true } } },
+      { "jsep", { { "type", "offer" }, { "sdp", Fixtures::OFFER } } }
+    };
+
+    for(auto _ : state) {
+      benchmark::DoNotOptimize(Messages::message("bench transaction", BENCH_HANDLE_ID, body).dump());
+    }
+  }
+  BENCHMARK(MessagesMessageWithJsep);
+
+  void MessagesSetupTiming(benchmark::State& state) {
+    HandleTimeline timeline;
+    for(auto& stage : { "attach", "prepare", "request", "join", "offer", "answer_applied", "first_candidate", "trickle_complete", "webrtcup", "media" }) {
+      timeline.mark(stage);
+    }
+    timeline.requests = { "join", "configure" };
+    CandidateStats candidates;
+
+    for(auto _ : state) {
+      benchmark::DoNotOptimize(Messages::setupTiming(BENCH_HANDLE_ID, timeline, candidates).dump());
+    }
+  }
+  BENCHMARK(MessagesSetupTiming);
+
+  void JanusApiOnMessageAck(benchmark::State& state) {
+    auto api = readyApi();
+    nlohmann::json message = { { "janus", "ack" }, { "session_id", BENCH_SESSION_ID }, { "transaction", "bench transaction" } };
+    auto context = Bundle::create();
+
+    for(auto _ : state) {
+      api->onMessage(message, context);
+    }
+  }
+  BENCHMARK(JanusApiOnMessageAck);
+
+  void JanusApiOnMessageEvent(benchmark::State& state) {
+    auto api = readyApi();
+    auto message = Fixtures::publishers(state.range(0));
+    auto context = Bundle::create();
+
+    for(auto _ : state) {
+      api->onMessage(message, context);
+    }
+  }
+  BENCHMARK(JanusApiOnMessageEvent)->Arg(1)->Arg(10)->Arg(100);
+
+  void JanusApiOnMessageEventWithJsep(benchmark::State& state) {
+    auto api = readyApi();
+    auto message = Fixtures::configured();
+    auto context = Bundle::create();
+
+    for(auto _ : state) {
+      api->onMessage(message, context);
+    }
+  }
+  BENCHMARK(JanusApiOnMessageEventWithJsep);
+
+  void JanusApiOnMessageError(benchmark::State& state) {
+    auto api = readyApi();
+    nlohmann::json message = { { "janus", "error" }, { "transaction", "bench transaction" }, { "error", { { "code", 458 }, { "reason", "No such session" } } } };
+    auto context = Bundle::create();
+
+    for(auto _ : state) {
+      api->onMessage(message, context);
+    }
+  }
+  BENCHMARK(JanusApiOnMessageError);
+
+  // a whole session through the protocol as fast as it goes, set JANUS_BENCH_TRACE to replay one you recorded
+  void JanusApiReplay(benchmark::State& state) {
+    auto path = std::getenv("JANUS_BENCH_TRACE");
+    auto entries = path != nullptr ? readTrace(path) : Fixtures::session(1000);
+
+    int64_t delivered = 0;
+    for(auto _ : state) {
+      auto factory = std::make_shared<ReplayTransportFactory>(entries, ReplaySpeed::MAX_SPEED);
+      auto api = std::make_shared<JanusApi>(std::make_shared<BenchRandom>(), factory);
+      api->init(std::make_shared<BenchConf>(), std::make_shared<BenchPlatform>(), std::make_shared<BenchDelegate>());
+
+      auto stats = factory->transport()->wait(REPLAY_STEP_TIMEOUT);
+      if(stats.stalled == true || stats.done == false) {
+        state.SkipWithError("the replay stalled");
+        break;
+      }
+
+      delivered += stats.delivered;
+    }
+
+    state.SetItemsProcessed(delivered);
+  }
+  BENCHMARK(JanusApiReplay)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}
@@ -0,0 +1,474 @@
+#include "load_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "janus/bundle.hpp"
+#include "janus/janus_commands.hpp"
+#include "janus/janus_data.hpp"
+#include "janus/janus_error.hpp"
+#include "janus/janus_event.hpp"
+#include "janus/janus_p_types.hpp"
+#include "janus/janus_plugins.hpp"
+#include "janus/platform.hpp"
+
+#define LOADGEN_SAMPLE_INTERVAL 100
+#define LOADGEN_CLOSE_TIMEOUT 10000
+
+namespace Janus {
+
+  namespace {
+
+    LatencySummary summarize(std::vector<int64_t> samples) {
+      LatencySummary summary;
+      if(samples.empty() == true) {
+        return summary;
+      }
+
+      std::sort(samples.begin(), samples.end());
+
+      // nearest rank
+      auto rank = [&samples](double percentile) {
+        auto index = (size_t) std::ceil(percentile * samples.size());
+        return samples[std::max(index, (size_t) 1) - 1];
+      };
+
+      summary.count = samples.size();
+      summary.p50 = rank(0.50);
+      summary.p99 = rank(0.99);
+      summary.max = samples.back();
+
+      return summary;
+    }
+
+    int64_t statusField(const std::string& field) {
+      std::ifstream status("/proc/self/status");
+      std::string line;
+
+      while(std::getline(status, line)) {
+        if(line.compare(0, field.size() + 1, field + ":") != 0) {
+          continue;
+        }
+
+        std::istringstream value(line.substr(field.size() + 1));
+        int64_t parsed = -1;
+        value >> parsed;
+
+        return parsed;
+      }
+
+      return -1;
+    }
+
+    std::string milliseconds(int64_t micros) {
+      std::ostringstream out;
+      out << std::fixed << std::setprecision(2) << micros / 1000.0;
+
+      return out.str();
+    }
+
+  }
+
+  /* LoadReport */
+
+  double LoadReport::setupRate() const {
+    return this->elapsed == 0 ? 0 : this->connected * 1000.0 / this->elapsed;
+  }
+
+  double LoadReport::commandRate() const {
+    return this->elapsed == 0 ? 0 : this->commands * 1000.0 / this->elapsed;
+  }
+
+  nlohmann::json LoadReport::json() const {
+    nlohmann::json summaries = nlohmann::json::object();
+    for(auto& entry : this->latencies) {
+      summaries[entry.first] = {
+        { "count", entry.second.count },
+        { "p50_us", entry.second.p50 },
+        { "p99_us", entry.second.p99 },
+        { "max_us", entry.second.max }
+      };
+    }
+
+    return {
+      { "scenario", this->scenario },
+      { "sessions", this->sessions },
+      { "ready", this->ready },
+      { "connected", this->connected },
+      { "failed", this->failed },
+      { "closed", this->closed },
+      { "commands", this->commands },
+      { "elapsed_ms", this->elapsed },
+      { "setups_per_second", this->setupRate() },
+      { "commands_per_second", this->commandRate() },
+      { "peak_threads", this->threads },
+      { "peak_rss_kb", this->rss },
+      { "latencies", summaries }
+    };
+  }
+
+  std::string LoadReport::str() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+
+    out << "scenario    " << this->scenario << "\n";
+    out << "sessions    " << this->sessions << " (" << this->ready << " ready, " << this->connected << " connected, " << this->failed << " failed, " << this->closed << " closed)\n";
+    out << "elapsed     " << this->elapsed << " ms\n";
+    out << "throughput  " << this->setupRate() << " setups/s, " << this->commandRate() << " commands/s\n";
+    out << "threads     " << this->threads << " peak\n";
+    out << "rss         " << this->rss / 1024.0 << " MB peak\n";
+
+    out << "\n" << std::left << std::setw(24) << "latency" << std::right << std::setw(8) << "count" << std::setw(12) << "p50 ms" << std::setw(12) << "p99 ms" << std::setw(12) << "max ms" << "\n";
+    for(auto& entry : this->latencies) {
+      out << std::left << std::setw(24) << entry.first << std::right << std::setw(8) << entry.second.count;
+      out << std::setw(12) << milliseconds(entry.second.p50) << std::setw(12) << milliseconds(entry.second.p99) << std::setw(12) << milliseconds(entry.second.max) << "\n";
+    }
+
+    return out.str();
+  }
+
+  /* LoadRecorder */
+
+  void LoadRecorder::record(const std::string& name, int64_t micros, bool command) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_latencies[name].push_back(micros);
+    if(command == true) {
+      this->_commands++;
+    }
+  }
+
+  void LoadRecorder::ready() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_ready++;
+  }
+
+  void LoadRecorder::connected() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_connected++;
+    this->_changed.notify_all();
+  }
+
+  void LoadRecorder::failed() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_failed++;
+    this->_changed.notify_all();
+  }
+
+  void LoadRecorder::closed() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_closed++;
+    this->_changed.notify_all();
+  }
+
+  bool LoadRecorder::waitSettled(int64_t target, const LoadClock::time_point& deadline) {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+
+    return this->_changed.wait_until(lock, deadline, [this, target] {
+      return this->_connected + this->_failed >= target;
+    });
+  }
+
+  bool LoadRecorder::waitClosed(const LoadClock::time_point& deadline) {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+
+    // only the sessions that got ready are closed
+    return this->_changed.wait_until(lock, deadline, [this] {
+      return this->_closed >= this->_ready;
+    });
+  }
+
+  void LoadRecorder::fill(LoadReport& report) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    report.ready = this->_ready;
+    report.connected = this->_connected;
+    report.failed = this->_failed;
+    report.closed = this->_closed;
+    report.commands = this->_commands;
+
+    for(auto& entry : this->_latencies) {
+      report.latencies[entry.first] = summarize(entry.second);
+    }
+  }
+
+  /* LoadSession */
+
+  LoadSession::LoadSession(int64_t id, LoadRole role, const LoadOptions& options, const std::shared_ptr<PeerFactory>& peerFactory, const std::shared_ptr<LoadRecorder>& recorder) {
+    this->_id = id;
+    this->_role = role;
+    this->_options = options;
+    this->_peerFactory = peerFactory;
+    this->_recorder = recorder;
+  }
+
+  void LoadSession::start() {
+    auto platform = Platform::create(this->_peerFactory);
+    this->_janus = Janus::create(this->shared_from_this(), platform, this->shared_from_this());
+
+    this->_start = LoadClock::now();
+    this->_janus->init();
+  }
+
+  void LoadSession::stop() {
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      if(this->_ready == false) {
+        return;
+      }
+    }
+
+    this->_janus->close();
+  }
+
+  std::string LoadSession::url() {
+    return this->_options.url;
+  }
+
+  std::string LoadSession::plugin() {
+    return this->_role == LoadRole::ECHO ? JanusPlugins::ECHO_TEST : JanusPlugins::VIDEOROOM;
+  }
+
+  void LoadSession::onReady() {
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      this->_ready = true;
+    }
+
+    this->_recorder->ready();
+    this->_recorder->record("ready", this->_elapsed(this->_start), false);
+
+    auto payload = Bundle::create();
+    payload->setBool("audio", true);
+    payload->setBool("video", true);
+    payload->setBool("datachannel", false);
+
+    if(this->_role == LoadRole::ECHO) {
+      this->_command("call", JanusCommands::CALL, payload);
+
+      return;
+    }
+
+    payload->setInt("room", this->_options.room);
+
+    if(this->_role == LoadRole::PUBLISHER) {
+      payload->setString("ptype", JanusPTypes::PUBLISHER);
+      payload->setString("display", "loadgen-" + std::to_string(this->_id));
+      if(this->_options.scenario == LOADGEN_FANOUT) {
+        payload->setInt("id", this->_options.feed);
+      }
+
+      this->_command("join", JanusCommands::JOIN, payload);
+
+      return;
+    }
+
+    payload->setInt("feed", this->_options.feed);
+    payload->setBool("offer_data", false);
+    this->_command("subscribe", JanusCommands::SUBSCRIBE, payload);
+  }
+
+  void LoadSession::onClose() {
+    this->_recorder->closed();
+  }
+
+  void LoadSession::onError(const JanusError& error, const std::shared_ptr<Bundle>& context) {
+    this->_answered(context);
+    this->_settle(false);
+  }
+
+  void LoadSession::onEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context) {
+    this->_answered(context);
+
+    auto data = event->data();
+
+    if(data->getInt("error_code", 0) != 0) {
+      this->_settle(false);
+
+      return;
+    }
+
+    // the stages of the handle setup, each since Janus::init
+    if(data->getString("janus", "") == "setup-timing") {
+      for(auto& stage : { "create", "attach", "prepare", "request", "join", "offer", "answer_applied", "first_candidate", "trickle_complete", "webrtcup", "media" }) {
+        auto mark = data->getInt(stage, -1);
+        if(mark >= 0) {
+          this->_recorder->record(std::string("setup.") + stage, mark * 1000, false);
+        }
+      }
+
+      return;
+    }
+
+    if(data->getString("videoroom", "") == "joined" && this->_role == LoadRole::PUBLISHER) {
+      auto payload = Bundle::create();
+      payload->setBool("audio", true);
+      payload->setBool("video", true);
+      payload->setBool("datachannel", false);
+
+      this->_command("publish", JanusCommands::PUBLISH, payload);
+
+      return;
+    }
+
+    if(data->getString("janus", "") == "webrtcup") {
+      this->_settle(true);
+    }
+  }
+
+  void LoadSession::onHangup(const std::string& reason) {}
+
+  void LoadSession::_command(const std::string& name, const std::string& command, const std::shared_ptr<Bundle>& payload) {
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+
+      auto sequence = ++this->_sequence;
+      payload->setInt("loadgen", sequence);
+      this->_pending[sequence] = { name, LoadClock::now() };
+    }
+
+    this->_janus->dispatch(command, payload);
+  }
+
+  // the first callback carrying the payload of a command answers it, an ack for most of them
+  void LoadSession::_answered(const std::shared_ptr<Bundle>& context) {
+    auto sequence = context->getInt("loadgen", -1);
+    if(sequence == -1) {
+      return;
+    }
+
+    Pending pending;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+
+      auto entry = this->_pending.find(sequence);
+      if(entry == this->_pending.end()) {
+        return;
+      }
+
+      pending = entry->second;
+      this->_pending.erase(entry);
+    }
+
+    this->_recorder->record(pending.name, this->_elapsed(pending.start), true);
+  }
+
+  void LoadSession::_settle(bool connected) {
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      if(this->_settled == true) {
+        return;
+      }
+
+      this->_settled = true;
+    }
+
+    if(connected == false) {
+      this->_recorder->failed();
+
+      return;
+    }
+
+    this->_recorder->record("media", this->_elapsed(this->_start), false);
+    this->_recorder->connected();
+  }
+
+  int64_t LoadSession::_elapsed(const LoadClock::time_point& start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(LoadClock::now() - start).count();
+  }
+
+  /* LoadGenerator */
+
+  LoadGenerator::LoadGenerator(const LoadOptions& options, const std::shared_ptr<PeerFactory>& peerFactory) {
+    this->_options = options;
+    this->_peerFactory = peerFactory;
+    this->_recorder = std::make_shared<LoadRecorder>();
+  }
+
+  LoadReport LoadGenerator::run() {
+    LoadReport report;
+    report.scenario = this->_options.scenario;
+    report.sessions = this->_options.sessions;
+
+    auto start = LoadClock::now();
+    auto deadline = start + std::chrono::milliseconds(this->_options.timeout);
+
+    auto settle = [this, &report, &deadline](int64_t target) {
+      while(LoadClock::now() < deadline) {
+        auto next = std::min(deadline, LoadClock::now() + std::chrono::milliseconds(LOADGEN_SAMPLE_INTERVAL));
+        auto settled = this->_recorder->waitSettled(target, next);
+        this->_sample(report);
+
+        if(settled == true) {
+          return;
+        }
+      }
+    };
+
+    int64_t first = 0;
+    auto role = this->_options.scenario == LOADGEN_ECHOTEST ? LoadRole::ECHO : LoadRole::PUBLISHER;
+
+    // the subscribers need a feed to subscribe to
+    if(this->_options.scenario == LOADGEN_FANOUT) {
+      this->_spawn(first++, LoadRole::PUBLISHER);
+      settle(1);
+
+      role = LoadRole::SUBSCRIBER;
+    }
+
+    for(auto id = first; id < this->_options.sessions && LoadClock::now() < deadline; id++) {
+      this->_spawn(id, role);
+
+      if(this->_options.ramp > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(1000000 / this->_options.ramp));
+        this->_sample(report);
+      }
+    }
+
+    settle(this->_sessions.size());
+    report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(LoadClock::now() - start).count();
+
+    auto holding = LoadClock::now() + std::chrono::milliseconds(this->_options.hold);
+    while(LoadClock::now() < holding) {
+      std::this_thread::sleep_for(std::min(std::chrono::duration_cast<std::chrono::milliseconds>(holding - LoadClock::now()), std::chrono::milliseconds(LOADGEN_SAMPLE_INTERVAL)));
+      this->_sample(report);
+    }
+
+    for(auto& session : this->_sessions) {
+      session->stop();
+    }
+
+    this->_recorder->waitClosed(LoadClock::now() + std::chrono::milliseconds(LOADGEN_CLOSE_TIMEOUT));
+
+    this->_recorder->fill(report);
+
+    return report;
+  }
+
+  int64_t LoadGenerator::processThreads() {
+    return statusField("Threads");
+  }
+
+  int64_t LoadGenerator::processRss() {
+    return statusField("VmRSS");
+  }
+
+  std::shared_ptr<LoadSession> LoadGenerator::_spawn(int64_t id, LoadRole role) {
+    auto session = std::make_shared<LoadSession>(id, role, this->_options, this->_peerFactory, this->_recorder);
+    this->_sessions.push_back(session);
+
+    session->start();
+
+    return session;
+  }
+
+  void LoadGenerator::_sample(LoadReport& report) {
+    report.threads = std::max(report.threads, LoadGenerator::processThreads());
+    report.rss = std::max(report.rss, LoadGenerator::processRss());
+  }
+
+}
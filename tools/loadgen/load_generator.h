@@ -0,0 +1,177 @@
+/*!
+ * janus-client SDK
+ *
+ * load_generator.h
+ * The Load Generator
+ * This module drives many concurrent janus sessions through a scenario and reports throughput, command latencies, threads and memory.
+ *
+ * Copyright 2019 Pasquale Boemio <pau@helloiampau.io>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "janus/janus.hpp"
+#include "janus/janus_conf.hpp"
+#include "janus/peer_factory.hpp"
+#include "janus/protocol_delegate.hpp"
+
+#define LOADGEN_ECHOTEST "echotest"
+#define LOADGEN_VIDEOROOM "videoroom"
+#define LOADGEN_FANOUT "fanout"
+
+#define LOADGEN_ROOM 1234
+#define LOADGEN_FEED 1
+
+namespace Janus {
+
+  using LoadClock = std::chrono::steady_clock;
+
+  struct LoadOptions {
+    std::string url = "";
+    std::string scenario = LOADGEN_ECHOTEST;
+    int64_t sessions = 100;
+    // sessions started per second, 0 starts them all at once
+    int64_t ramp = 0;
+    // how long the sessions stay up once set up, in milliseconds
+    int64_t hold = 0;
+    int64_t timeout = 60000;
+    int64_t room = LOADGEN_ROOM;
+    int64_t feed = LOADGEN_FEED;
+  };
+
+  // microseconds
+  struct LatencySummary {
+    int64_t count = 0;
+    int64_t p50 = 0;
+    int64_t p99 = 0;
+    int64_t max = 0;
+  };
+
+  struct LoadReport {
+    std::string scenario;
+    int64_t sessions = 0;
+    int64_t ready = 0;
+    int64_t connected = 0;
+    int64_t failed = 0;
+    int64_t closed = 0;
+    int64_t commands = 0;
+    int64_t elapsed = 0;
+
+    int64_t threads = 0;
+    int64_t rss = 0;
+
+    std::map<std::string, LatencySummary> latencies;
+
+    double setupRate() const;
+    double commandRate() const;
+
+    nlohmann::json json() const;
+    std::string str() const;
+  };
+
+  // shared by every session, it outlives the generator because a late reply can still reach a session
+  class LoadRecorder {
+    public:
+      void record(const std::string& name, int64_t micros, bool command);
+      void ready();
+      void connected();
+      void failed();
+      void closed();
+
+      // waits until the settled sessions reach the target, false on timeout
+      bool waitSettled(int64_t target, const LoadClock::time_point& deadline);
+      bool waitClosed(const LoadClock::time_point& deadline);
+
+      void fill(LoadReport& report);
+
+    private:
+      std::map<std::string, std::vector<int64_t>> _latencies;
+      int64_t _ready = 0;
+      int64_t _connected = 0;
+      int64_t _failed = 0;
+      int64_t _closed = 0;
+      int64_t _commands = 0;
+
+      std::mutex _mutex;
+      std::condition_variable _changed;
+  };
+
+  enum class LoadRole {
+    ECHO,
+    PUBLISHER,
+    SUBSCRIBER
+  };
+
+  class LoadSession : public ProtocolDelegate, public JanusConf, public std::enable_shared_from_this<LoadSession> {
+    public:
+      LoadSession(int64_t id, LoadRole role, const LoadOptions& options, const std::shared_ptr<PeerFactory>& peerFactory, const std::shared_ptr<LoadRecorder>& recorder);
+
+      void start();
+      void stop();
+
+      std::string url();
+      std::string plugin();
+
+      void onReady();
+      void onClose();
+      void onError(const JanusError& error, const std::shared_ptr<Bundle>& context);
+      void onEvent(const std::shared_ptr<JanusEvent>& event, const std::shared_ptr<Bundle>& context);
+      void onHangup(const std::string& reason);
+
+    private:
+      struct Pending {
+        std::string name;
+        LoadClock::time_point start;
+      };
+
+      void _command(const std::string& name, const std::string& command, const std::shared_ptr<Bundle>& payload);
+      void _answered(const std::shared_ptr<Bundle>& context);
+      void _settle(bool connected);
+      int64_t _elapsed(const LoadClock::time_point& start);
+
+      int64_t _id;
+      LoadRole _role;
+      LoadOptions _options;
+      std::shared_ptr<PeerFactory> _peerFactory;
+      std::shared_ptr<LoadRecorder> _recorder;
+
+      std::shared_ptr<Janus> _janus;
+      LoadClock::time_point _start;
+
+      std::map<int64_t, Pending> _pending;
+      int64_t _sequence = 0;
+      bool _ready = false;
+      bool _settled = false;
+      std::mutex _mutex;
+  };
+
+  class LoadGenerator {
+    public:
+      LoadGenerator(const LoadOptions& options, const std::shared_ptr<PeerFactory>& peerFactory);
+
+      LoadReport run();
+
+      static int64_t processThreads();
+      // kilobytes
+      static int64_t processRss();
+
+    private:
+      std::shared_ptr<LoadSession> _spawn(int64_t id, LoadRole role);
+      void _sample(LoadReport& report);
+
+      LoadOptions _options;
+      std::shared_ptr<PeerFactory> _peerFactory;
+      std::shared_ptr<LoadRecorder> _recorder;
+      std::vector<std::shared_ptr<LoadSession>> _sessions;
+  };
+
+}
@@ -0,0 +1,167 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "janus/spans.h"
+#include "janus/synthetic_peer.h"
+#include "janus/watchdog.h"
+
+#include "emulator/janus_emulator.h"
+
+#include "load_generator.h"
+
+namespace {
+
+  void usage(const char* name) {
+    std::cerr << "usage: " << name << " [options]\n"
+      << "  --scenario NAME   echotest, videoroom (join and publish) or fanout (one publisher, many subscribers), default echotest\n"
+      << "  --sessions N      concurrent sessions, default 100\n"
+      << "  --ramp N          sessions started per second, default 0 (all at once)\n"
+      << "  --hold MS         how long the sessions stay up once set up, default 0\n"
+      << "  --timeout MS      how long the sessions have to set up, default 60000\n"
+      << "  --room ID         the videoroom to join, default 1234\n"
+      << "  --feed ID         the feed the fanout publisher gets, default 1\n"
+      << "  --url URL         a janus gateway, default an in-process emulator\n"
+      << "  --latency MS      emulator latency for every request\n"
+      << "  --jitter MS       emulator jitter for every request\n"
+      << "  --loss RATIO      emulator loss ratio for the asynchronous events\n"
+      << "  --peer-delay MS   how long the synthetic peers take to create an offer or an answer\n"
+      << "  --gathering MS    how long the synthetic peers take to find their first candidate\n"
+      << "  --interval MS     the time between two candidates of a burst\n"
+      << "  --relay N         relay candidates in every burst, default 0\n"
+      << "  --spans FILE      write the transaction spans as Chrome trace events\n"
+      << "  --watchdog MS     report the commands, requests and callbacks running longer than MS, and the queue ages\n"
+      << "  --json            print the report as JSON\n";
+  }
+
+}
+
+int main(int argc, char** argv) {
+  Janus::LoadOptions options;
+  Janus::GatewayRule rule;
+  Janus::SyntheticPeerConf peerConf;
+  bool json = false;
+  std::string spans;
+  int64_t watchdog = 0;
+
+  for(int index = 1; index < argc; index++) {
+    std::string arg = argv[index];
+    auto next = [&index, argc, argv, &arg]() -> std::string {
+      if(index + 1 >= argc) {
+        std::cerr << arg << " needs a value\n";
+        std::exit(2);
+      }
+
+      return argv[++index];
+    };
+
+    if(arg == "--scenario") {
+      options.scenario = next();
+    } else if(arg == "--sessions") {
+      options.sessions = std::stoll(next());
+    } else if(arg == "--ramp") {
+      options.ramp = std::stoll(next());
+    } else if(arg == "--hold") {
+      options.hold = std::stoll(next());
+    } else if(arg == "--timeout") {
+      options.timeout = std::stoll(next());
+    } else if(arg == "--room") {
+      options.room = std::stoll(next());
+    } else if(arg == "--feed") {
+      options.feed = std::stoll(next());
+    } else if(arg == "--url") {
+      options.url = next();
+    } else if(arg == "--latency") {
+      rule.latency = std::stoll(next());
+    } else if(arg == "--jitter") {
+      rule.jitter = std::stoll(next());
+    } else if(arg == "--loss") {
+      rule.loss = std::stod(next());
+    } else if(arg == "--peer-delay") {
+      peerConf.offerDelay = peerConf.answerDelay = std::stoll(next());
+    } else if(arg == "--gathering") {
+      peerConf.gatheringDelay = std::stoll(next());
+    } else if(arg == "--interval") {
+      peerConf.candidateInterval = std::stoll(next());
+    } else if(arg == "--relay") {
+      peerConf.relayCandidates = std::stoi(next());
+    } else if(arg == "--spans") {
+      spans = next();
+    } else if(arg == "--watchdog") {
+      watchdog = std::stoll(next());
+    } else if(arg == "--json") {
+      json = true;
+    } else {
+      usage(argv[0]);
+      return arg == "--help" ? 0 : 2;
+    }
+  }
+
+  if(options.scenario != LOADGEN_ECHOTEST && options.scenario != LOADGEN_VIDEOROOM && options.scenario != LOADGEN_FANOUT) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::shared_ptr<Janus::JanusEmulator> emulator;
+  if(options.url.empty() == true) {
+    emulator = std::make_shared<Janus::JanusEmulator>();
+    emulator->gateway()->script({ rule });
+    emulator->start();
+
+    options.url = emulator->url();
+  }
+
+  Janus::Spans::enable(spans.empty() == false);
+  if(watchdog > 0) {
+    Janus::Watchdog::start(watchdog);
+  }
+
+  auto peerFactory = std::make_shared<Janus::SyntheticPeerFactory>(peerConf);
+  Janus::LoadGenerator generator(options, peerFactory);
+  auto report = generator.run();
+
+  if(spans.empty() == false) {
+    Janus::Spans::enable(false);
+    std::ofstream(spans) << Janus::Spans::chromeTrace().dump();
+  }
+
+  nlohmann::json stalls;
+  if(watchdog > 0) {
+    stalls = Janus::Watchdog::report();
+    Janus::Watchdog::stop();
+  }
+
+  if(json == true) {
+    auto out = report.json();
+    if(watchdog > 0) {
+      out["watchdog"] = stalls;
+    }
+
+    std::cout << out.dump(2) << std::endl;
+  } else {
+    std::cout << "gateway     " << (emulator != nullptr ? "in-process emulator (counted in threads and rss)" : options.url) << "\n";
+    std::cout << report.str();
+
+    if(watchdog > 0) {
+      auto& queues = stalls["queues"];
+      std::cout << "queues      async p50 " << queues["async_us"]["p50"] << " us, p99 " << queues["async_us"]["p99"] << " us; "
+        << "callbacks p50 " << queues["callback_us"]["p50"] << " us, p99 " << queues["callback_us"]["p99"] << " us\n";
+      std::cout << "stalls      " << stalls["stalls"].size() << " over " << watchdog << " ms\n";
+      for(auto& stall : stalls["stalls"]) {
+        std::cout << "  " << std::left << std::setw(10) << stall["origin"].get<std::string>() << std::setw(24) << stall["name"].get<std::string>()
+          << stall["running_us"].get<int64_t>() / 1000 << " ms" << (stall["finished"] == true ? "" : " (still running)") << "\n";
+      }
+    }
+
+    std::cout << std::flush;
+  }
+
+  // the sessions that never closed still have a long poll in flight, nothing is torn down
+  std::fflush(nullptr);
+  std::_Exit(report.failed == 0 && report.connected == report.sessions ? 0 : 1);
+}